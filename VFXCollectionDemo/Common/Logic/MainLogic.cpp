@@ -61,9 +61,12 @@ void Common::Logic::MainLogic::Render()
 	auto scene = sceneManager->GetCurrentScene();
 	
 	auto commandList = renderer->StartFrame();
-	scene->RenderShadows(commandList);
+	scene->RenderShadows(commandList, renderer);
+
+	commandList = renderer->GetCommandList();
 	scene->Render(commandList, renderer);
 
+	commandList = renderer->GetCommandList();
 	renderer->SetRenderToBackBuffer(commandList);
 	scene->RenderToBackBuffer(commandList);
 
@@ -4,6 +4,8 @@
 #include "../SceneEntity/VFXLuxSparkles.h"
 #include "../SceneEntity/VFXLuxDistorters.h"
 #include "../../Graphics/Assets/MaterialBuilder.h"
+#include "../../Graphics/Assets/GeometryUtilities.h"
+#include "../../Graphics/Assets/VertexCompressor.h"
 #include "../../Graphics/Assets/Loaders/DDSLoader.h"
 #include "../../Graphics/Assets/Generators/NoiseGenerator.h"
 #include "../../Graphics/Assets/Generators/TurbulenceMapGenerator.h"
@@ -16,14 +18,14 @@ using namespace Graphics::Assets::Generators;
 using namespace Common::Logic::SceneEntity;
 
 Common::Logic::Scene::Scene_0_Lux::Scene_0_Lux()
-	: isLoaded(false), terrain(nullptr), vegetationSystem(nullptr), lightingSystem(nullptr),
+	: isLoaded(false), terrain(nullptr), vegetationSystem(nullptr), lightingSystem(nullptr), lightClusterBuilder(nullptr),
 	camera(nullptr), postProcessManager(nullptr), mutableConstantsBuffer{}, mutableConstantsId{},
 	vfxAtlasId{}, perlinNoiseId{}, particleSimulationCSId{}, environmentWorld{}, timer{},
 	_deltaTime{}, fps(60.0f), cpuTimeCounter{}, prevTimePoint{}, frameCounter{}, vfxLux{},
 	vfxLuxSparkles{}, vfxLuxDistorters{}, areaLightId{}, ambientLightId{}, depthPassVSId{},
 	depthCubePassVSId{}, depthCubePassGSId{}, depthPassMaterial{}, depthCubePassMaterial{},
 	lightParticleBufferId{}, particleLightSimulationCSId{}, renderSize{}, turbulenceMapId{},
-	volumeNoiseId{}
+	volumeNoiseId{}, lightClusteringCSId{}
 {
 	environmentPosition = float3(0.0f, 0.0f, 0.0f);
 	cameraPosition = float3(0.0f, 0.0f, 5.0f);
@@ -85,6 +87,13 @@ void Common::Logic::Scene::Scene_0_Lux::Unload(Graphics::DirectX12Renderer* rend
 
 	delete lightingSystem;
 
+	if (lightClusterBuilder != nullptr)
+	{
+		lightClusterBuilder->Release(resourceManager);
+		delete lightClusterBuilder;
+		lightClusterBuilder = nullptr;
+	}
+
 	terrain->Release(resourceManager);
 	delete terrain;
 
@@ -102,6 +111,7 @@ void Common::Logic::Scene::Scene_0_Lux::Unload(Graphics::DirectX12Renderer* rend
 
 	resourceManager->DeleteResource<Shader>(particleSimulationCSId);
 	resourceManager->DeleteResource<Shader>(particleLightSimulationCSId);
+	resourceManager->DeleteResource<Shader>(lightClusteringCSId);
 
 	delete camera;
 
@@ -190,19 +200,69 @@ void Common::Logic::Scene::Scene_0_Lux::Update()
 	ambientLightDesc.intensity = AMBIENT_LIGHT_INTENSITY + std::pow(std::max(std::sin(timer * 0.4f), 0.0f), 120.0f) * 0.05f;
 
 	lightingSystem->UpdateSourceDesc(ambientLightId);
+	lightingSystem->Update();
+
+	AxisAlignedBox receiverBounds{};
+	AxisAlignedBox vegetationBounds{};
+	BoundingSphere boundingSphere{};
+
+	if (terrain->GetBounds(receiverBounds, boundingSphere))
+	{
+		auto casterBounds = vegetationSystem->GetBounds(vegetationBounds, boundingSphere) ?
+			GeometryUtilities::MergeBoxes(receiverBounds, vegetationBounds) : receiverBounds;
+
+		lightingSystem->UpdateCascades(camera, casterBounds, receiverBounds);
+	}
 
 	terrain->Update(camera, timer);
+
+	if (lightClusterBuilder != nullptr)
+		lightClusterBuilder->Update(camera, renderSize);
 }
 
-void Common::Logic::Scene::Scene_0_Lux::RenderShadows(ID3D12GraphicsCommandList* commandList)
+void Common::Logic::Scene::Scene_0_Lux::RenderShadows(ID3D12GraphicsCommandList* commandList,
+	Graphics::DirectX12Renderer* renderer)
 {
 	lightingSystem->BeforeStartRenderShadowMaps(commandList);
-	lightingSystem->StartRenderShadowMap(areaLightId, commandList);
 
-	auto& areaLightDesc = lightingSystem->GetSourceDesc(areaLightId);
+	AxisAlignedBox bounds{};
+	BoundingSphere boundingSphere{};
+
+	auto terrainFaceMask = terrain->GetBounds(bounds, boundingSphere) ?
+		lightingSystem->AddShadowCaster(areaLightId, bounds, true) : 0u;
+	auto vegetationFaceMask = vegetationSystem->GetBounds(bounds, boundingSphere) ?
+		lightingSystem->AddShadowCaster(areaLightId, bounds, false) : 0u;
+
+	if (lightingSystem->StartRenderShadowMap(areaLightId, commandList))
+	{
+		auto staticCastersLightDesc = lightingSystem->GetSourceDesc(areaLightId);
+
+		lightingSystem->StartRenderDynamicShadowCasters(areaLightId);
+
+		auto dynamicCastersLightDesc = lightingSystem->GetSourceDesc(areaLightId);
+
+		commandList = renderer->RecordParallel(commandList,
+			{
+				[this, terrainFaceMask, staticCastersLightDesc](ID3D12GraphicsCommandList* terrainCommandList)
+				{
+					if (terrainFaceMask == 0u)
+						return;
+
+					lightingSystem->SetShadowMapTarget(areaLightId, terrainCommandList);
+					terrain->DrawShadowsCube(terrainCommandList, staticCastersLightDesc);
+				},
+				[this, vegetationFaceMask, dynamicCastersLightDesc](ID3D12GraphicsCommandList* vegetationCommandList)
+				{
+					lightingSystem->CopyStaticShadowMapFaces(areaLightId, vegetationCommandList);
 
-	terrain->DrawShadowsCube(commandList, areaLightDesc.GetLightMatrixStartIndex());
-	vegetationSystem->DrawShadowsCube(commandList, areaLightDesc.GetLightMatrixStartIndex());
+					if (vegetationFaceMask == 0u)
+						return;
+
+					lightingSystem->SetShadowMapTarget(areaLightId, vegetationCommandList);
+					vegetationSystem->DrawShadowsCube(vegetationCommandList, dynamicCastersLightDesc);
+				}
+			});
+	}
 
 	lightingSystem->EndRenderShadowMaps(commandList);
 }
@@ -213,18 +273,45 @@ void Common::Logic::Scene::Scene_0_Lux::Render(ID3D12GraphicsCommandList* comman
 	vfxLuxSparkles->OnCompute(commandList);
 	vfxLuxDistorters->OnCompute(commandList);
 
+	if (lightClusterBuilder != nullptr)
+		lightClusterBuilder->OnCompute(commandList);
+
 	if constexpr (DEPTH_PREPASS_ENABLED)
 	{
 		postProcessManager->SetDepthPrepass(commandList);
 
-		terrain->DrawDepthPrepass(commandList);
-		vegetationSystem->DrawDepthPrepass(commandList);
+		commandList = renderer->RecordParallel(commandList,
+			{
+				[this](ID3D12GraphicsCommandList* terrainCommandList)
+				{
+					postProcessManager->BindDepthPrepass(terrainCommandList);
+					terrain->DrawDepthPrepass(terrainCommandList);
+				},
+				[this](ID3D12GraphicsCommandList* vegetationCommandList)
+				{
+					postProcessManager->BindDepthPrepass(vegetationCommandList);
+					vegetationSystem->DrawDepthPrepass(vegetationCommandList);
+				}
+			});
 	}
 
 	postProcessManager->SetGBuffer(commandList);
 
-	terrain->Draw(commandList);
-	vegetationSystem->Draw(commandList);
+	commandList = renderer->RecordParallel(commandList,
+		{
+			[this](ID3D12GraphicsCommandList* terrainCommandList)
+			{
+				postProcessManager->BindGBuffer(terrainCommandList);
+				terrain->Draw(terrainCommandList);
+			},
+			[this](ID3D12GraphicsCommandList* vegetationCommandList)
+			{
+				postProcessManager->BindGBuffer(vegetationCommandList);
+				vegetationSystem->Draw(vegetationCommandList);
+			}
+		});
+
+	postProcessManager->BindGBuffer(commandList);
 
 	lightingSystem->EndUsingShadowMaps(commandList);
 
@@ -295,6 +382,9 @@ void Common::Logic::Scene::Scene_0_Lux::LoadShaders(ID3D12Device* device, Graphi
 	particleLightSimulationCSId = resourceManager->CreateShaderResource(device, "Resources\\Shaders\\ParticleLightSimulationCS.hlsl",
 		ShaderType::COMPUTE_SHADER, ShaderVersion::SM_6_5);
 
+	lightClusteringCSId = resourceManager->CreateShaderResource(device, "Resources\\Shaders\\LightClusteringCS.hlsl",
+		ShaderType::COMPUTE_SHADER, ShaderVersion::SM_6_5);
+
 	depthPassVSId = resourceManager->CreateShaderResource(device, "Resources\\Shaders\\DepthPassVS.hlsl",
 		ShaderType::VERTEX_SHADER, ShaderVersion::SM_6_5, defines);
 
@@ -382,6 +472,7 @@ void Common::Logic::Scene::Scene_0_Lux::CreateLights(ID3D12GraphicsCommandList*
 	areaLight.type = LightType::AREA_LIGHT;
 	areaLight.range = AREA_LIGHT_RANGE;
 	areaLight.castShadows = true;
+	areaLight.shadowCacheMode = ShadowCacheMode::STATIC_CACHED;
 
 	areaLightId = lightingSystem->CreateLight(areaLight);
 
@@ -411,8 +502,11 @@ void Common::Logic::Scene::Scene_0_Lux::CreateMaterials(ID3D12Device* device, Gr
 		Graphics::VertexFormat::TANGENT |
 		Graphics::VertexFormat::TEXCOORD0;
 
+	if constexpr (TERRAIN_QUANTIZATION_ENABLED)
+		terrainVertexFormat = VertexCompressor::GetCompressedFormat(terrainVertexFormat);
+
 	MaterialBuilder materialBuilder{};
-	materialBuilder.SetRootConstants(0u, 17u);
+	materialBuilder.SetRootConstants(0u, 18u);
 	materialBuilder.SetConstantBuffer(1u, lightMatricesConstantsResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_GEOMETRY);
 	materialBuilder.SetCullMode(D3D12_CULL_MODE_FRONT);
 	materialBuilder.SetBlendMode(Graphics::DirectX12Utilities::CreateBlendDesc(Graphics::DefaultBlendSetup::BLEND_OPAQUE));
@@ -445,6 +539,23 @@ void Common::Logic::Scene::Scene_0_Lux::CreateObjects(ID3D12GraphicsCommandList*
 
 	shaderDefines.push_back({ L"PARTICLE_LIGHT_SOURCE_NUMBER", lightParticleNumberString.c_str() });
 
+	if constexpr (USING_PARTICLE_LIGHT && CLUSTERED_LIGHTING_ENABLED)
+	{
+		shaderDefines.push_back({ L"CLUSTERED_LIGHTING", nullptr });
+
+		LightClusterDesc lightClusterDesc{};
+		lightClusterDesc.clustersPerWidth = LIGHT_CLUSTERS_PER_WIDTH;
+		lightClusterDesc.clustersPerHeight = LIGHT_CLUSTERS_PER_HEIGHT;
+		lightClusterDesc.depthSlicesNumber = LIGHT_CLUSTER_DEPTH_SLICES;
+		lightClusterDesc.maxLightsPerCluster = MAX_LIGHTS_PER_CLUSTER;
+		lightClusterDesc.lightsNumber = FIREFLIES_NUMBER;
+		lightClusterDesc.lightBufferId = lightParticleBufferId;
+		lightClusterDesc.lightClusteringCSId = lightClusteringCSId;
+
+		lightClusterBuilder = new LightClusterBuilder(commandList, renderer, lightClusterDesc);
+		lightClusterBuilder->Update(camera, renderSize);
+	}
+
 	auto& areaLightDesc = lightingSystem->GetSourceDesc(areaLightId);
 
 	SceneEntity::RenderingScheme renderingScheme{};
@@ -472,15 +583,26 @@ void Common::Logic::Scene::Scene_0_Lux::CreateObjects(ID3D12GraphicsCommandList*
 	terrainDesc.verticesPerWidth = 256u;
 	terrainDesc.verticesPerHeight = 256u;
 	terrainDesc.size = float3(20.0f, 20.0f, 1.0f);
+	terrainDesc.lodDistance = TERRAIN_LOD_DISTANCE;
 	terrainDesc.map0Tiling = float2(4.0f, 4.0f);
 	terrainDesc.map1Tiling = float2(4.0f, 4.0f);
 	terrainDesc.map2Tiling = float2(4.0f, 4.0f);
 	terrainDesc.map3Tiling = float2(4.0f, 4.0f);
 	terrainDesc.lightConstantBufferId = lightingSystem->GetLightConstantBufferId();
 	terrainDesc.hasParticleLighting = USING_PARTICLE_LIGHT;
+	terrainDesc.hasClusteredLighting = lightClusterBuilder != nullptr;
 	terrainDesc.hasDepthPrepass = DEPTH_PREPASS_ENABLED;
 	terrainDesc.outputVelocity = renderingScheme.enableFSR || renderingScheme.enableMotionBlur;
+	terrainDesc.quantizeVertices = TERRAIN_QUANTIZATION_ENABLED;
 	terrainDesc.lightParticleBufferId = lightParticleBufferId;
+
+	if (lightClusterBuilder != nullptr)
+	{
+		terrainDesc.lightClusterConstantBufferId = lightClusterBuilder->GetConstantBufferId();
+		terrainDesc.lightClusterCountBufferId = lightClusterBuilder->GetLightCountBufferId();
+		terrainDesc.lightClusterIndexBufferId = lightClusterBuilder->GetLightIndexBufferId();
+	}
+
 	terrainDesc.shaderDefines = &shaderDefines;
 	terrainDesc.shadowMapIds.push_back(areaLightDesc.GetShadowMapId());
 	terrainDesc.materialDepthPass = depthPassMaterial;
@@ -508,6 +630,7 @@ void Common::Logic::Scene::Scene_0_Lux::CreateObjects(ID3D12GraphicsCommandList*
 	vegetationSystemDesc.hasDepthPass = false;
 	vegetationSystemDesc.hasDepthCubePass = true;
 	vegetationSystemDesc.hasParticleLighting = USING_PARTICLE_LIGHT;
+	vegetationSystemDesc.hasClusteredLighting = lightClusterBuilder != nullptr;
 	vegetationSystemDesc.outputVelocity = renderingScheme.enableFSR || renderingScheme.enableMotionBlur;
 	vegetationSystemDesc.lightParticleBufferId = lightParticleBufferId;
 	vegetationSystemDesc.lightMatricesNumber = lightingSystem->GetLightMatricesNumber();
@@ -515,9 +638,22 @@ void Common::Logic::Scene::Scene_0_Lux::CreateObjects(ID3D12GraphicsCommandList*
 	vegetationSystemDesc.windDirection = &windDirection;
 	vegetationSystemDesc.windStrength = &windStrength;
 	vegetationSystemDesc.perlinNoiseTiling = float2(2.5f, 2.5f);
+	vegetationSystemDesc.cellSize = VEGETATION_CELL_SIZE;
+	vegetationSystemDesc.densityFalloffStart = VEGETATION_DENSITY_FALLOFF_START;
+	vegetationSystemDesc.densityFalloffEnd = VEGETATION_DENSITY_FALLOFF_END;
+	vegetationSystemDesc.scattering = VegetationScattering::BLUE_NOISE;
+	vegetationSystemDesc.blueNoiseDistance = VEGETATION_BLUE_NOISE_DISTANCE;
 	vegetationSystemDesc.perlinNoiseId = perlinNoiseId;
 	vegetationSystemDesc.lightConstantBufferId = lightingSystem->GetLightConstantBufferId();
 	vegetationSystemDesc.lightMatricesConstantBufferId = lightingSystem->GetLightMatricesConstantBufferId();
+
+	if (lightClusterBuilder != nullptr)
+	{
+		vegetationSystemDesc.lightClusterConstantBufferId = lightClusterBuilder->GetConstantBufferId();
+		vegetationSystemDesc.lightClusterCountBufferId = lightClusterBuilder->GetLightCountBufferId();
+		vegetationSystemDesc.lightClusterIndexBufferId = lightClusterBuilder->GetLightIndexBufferId();
+	}
+
 	vegetationSystemDesc.shadowMapIds.push_back(areaLightDesc.GetShadowMapId());
 	vegetationSystemDesc.shaderDefines = &shaderDefines;
 	vegetationSystemDesc.vegetationCacheFileName = "Resources\\Meshes\\Lux_Vegetation.bin";
@@ -13,6 +13,7 @@
 #include "../SceneEntity/Terrain.h"
 #include "../SceneEntity/VegetationSystem.h"
 #include "../SceneEntity/LightingSystem.h"
+#include "../SceneEntity/LightClusterBuilder.h"
 
 #include "IScene.h"
 
@@ -30,7 +31,7 @@ namespace Common::Logic::Scene
 		void OnResize(Graphics::DirectX12Renderer* renderer) override;
 
 		void Update() override;
-		void RenderShadows(ID3D12GraphicsCommandList* commandList) override;
+		void RenderShadows(ID3D12GraphicsCommandList* commandList, Graphics::DirectX12Renderer* renderer) override;
 		void Render(ID3D12GraphicsCommandList* commandList, Graphics::DirectX12Renderer* renderer) override;
 		void RenderToBackBuffer(ID3D12GraphicsCommandList* commandList) override;
 
@@ -65,11 +66,20 @@ namespace Common::Logic::Scene
 
 		static constexpr float AMBIENT_LIGHT_INTENSITY = 0.15f;
 
+		static constexpr float TERRAIN_LOD_DISTANCE = 3.0f;
+
+		static constexpr float VEGETATION_CELL_SIZE = 1.0f;
+		static constexpr float VEGETATION_DENSITY_FALLOFF_START = 8.0f;
+		static constexpr float VEGETATION_DENSITY_FALLOFF_END = 16.0f;
+		static constexpr float VEGETATION_BLUE_NOISE_DISTANCE = 0.065f;
+
 		static constexpr bool DEPTH_PREPASS_ENABLED = true;
 		static constexpr bool FSR_ENABLED = false;
 		static constexpr bool MOTION_BLUR_ENABLED = true;
 		static constexpr bool VOLUMETRIC_FOG_ENABLED = true;
 		static constexpr bool USING_PARTICLE_LIGHT = true;
+		static constexpr bool CLUSTERED_LIGHTING_ENABLED = true;
+		static constexpr bool TERRAIN_QUANTIZATION_ENABLED = true;
 
 		static constexpr float WHITE_CUTOFF = 1.7f;
 		static constexpr float BRIGHT_THRESHOLD = 2.0f;
@@ -89,6 +99,11 @@ namespace Common::Logic::Scene
 		static constexpr uint32_t FIREFLIES_NUMBER = 20u;
 		static constexpr uint32_t SPARKLES_NUMBER = 50u;
 
+		static constexpr uint32_t LIGHT_CLUSTERS_PER_WIDTH = 16u;
+		static constexpr uint32_t LIGHT_CLUSTERS_PER_HEIGHT = 9u;
+		static constexpr uint32_t LIGHT_CLUSTER_DEPTH_SLICES = 24u;
+		static constexpr uint32_t MAX_LIGHTS_PER_CLUSTER = 32u;
+
 		static constexpr uint32_t NOISE_SIZE_X = 128u;
 		static constexpr uint32_t NOISE_SIZE_Y = 128u;
 		static constexpr uint32_t NOISE_SIZE_Z = 64u;
@@ -139,6 +154,7 @@ namespace Common::Logic::Scene
 
 		Graphics::Resources::ResourceID particleSimulationCSId;
 		Graphics::Resources::ResourceID particleLightSimulationCSId;
+		Graphics::Resources::ResourceID lightClusteringCSId;
 
 		SceneEntity::Camera* camera;
 
@@ -151,6 +167,7 @@ namespace Common::Logic::Scene
 		SceneEntity::Terrain* terrain;
 		SceneEntity::VegatationSystem* vegetationSystem;
 		SceneEntity::LightingSystem* lightingSystem;
+		SceneEntity::LightClusterBuilder* lightClusterBuilder;
 
 		SceneEntity::IDrawable* vfxLux;
 		SceneEntity::IDrawable* vfxLuxSparkles;
@@ -220,6 +220,7 @@ void Common::Logic::Scene::Scene_1_WhiteRoom::Update()
 	light1Desc.position.z = 2.5f + std::cos(timer * 0.9f) * 1.5f;
 
 	lightingSystem->UpdateSourceDesc(pointLight1Id);
+	lightingSystem->Update();
 
 	mutableConstantsBuffer->invViewProjection = camera->GetInvViewProjection();
 	mutableConstantsBuffer->cameraPosition = camera->GetPosition();
@@ -243,7 +244,8 @@ void Common::Logic::Scene::Scene_1_WhiteRoom::Update()
 	prevTimePoint = currentTimePoint;
 }
 
-void Common::Logic::Scene::Scene_1_WhiteRoom::RenderShadows(ID3D12GraphicsCommandList* commandList)
+void Common::Logic::Scene::Scene_1_WhiteRoom::RenderShadows(ID3D12GraphicsCommandList* commandList,
+	Graphics::DirectX12Renderer* renderer)
 {
 
 }
@@ -640,20 +642,26 @@ void Common::Logic::Scene::Scene_1_WhiteRoom::LoadMesh(std::filesystem::path fil
 	}
 
 	if (loadCache)
-	{
-		LoadCache(fileCachePath, desc, verticesData, indicesData);
-	}
-	else
+		loadCache = LoadCache(fileCachePath, desc, verticesData, indicesData);
+
+	if (!loadCache)
 	{
 		OBJLoader::Load(filePath, false, true, desc, verticesData, indicesData);
 		SaveCache(fileCachePath, desc, verticesData, indicesData);
 	}
 }
 
-void Common::Logic::Scene::Scene_1_WhiteRoom::LoadCache(std::filesystem::path filePath, MeshDesc& meshDesc,
+bool Common::Logic::Scene::Scene_1_WhiteRoom::LoadCache(std::filesystem::path filePath, MeshDesc& meshDesc,
 	std::vector<uint8_t>& verticesData, std::vector<uint8_t>& indicesData)
 {
 	std::ifstream meshFile(filePath, std::ios::binary);
+
+	MeshCacheHeader header{};
+	meshFile.read(reinterpret_cast<char*>(&header), sizeof(MeshCacheHeader));
+
+	if (!meshFile || header.magic != Mesh::CACHE_MAGIC || header.version != Mesh::CACHE_VERSION)
+		return false;
+
 	meshFile.read(reinterpret_cast<char*>(&meshDesc), sizeof(MeshDesc));
 
 	auto vertexBufferSize = static_cast<size_t>(meshDesc.verticesNumber) * VertexStride(meshDesc.vertexFormat);
@@ -664,12 +672,17 @@ void Common::Logic::Scene::Scene_1_WhiteRoom::LoadCache(std::filesystem::path fi
 	indexBufferSize *= meshDesc.indexFormat == IndexFormat::UINT16_INDEX ? 2u : 4u;
 	indicesData.resize(indexBufferSize);
 	meshFile.read(reinterpret_cast<char*>(indicesData.data()), indexBufferSize);
+
+	return static_cast<bool>(meshFile);
 }
 
 void Common::Logic::Scene::Scene_1_WhiteRoom::SaveCache(std::filesystem::path filePath, const MeshDesc& meshDesc,
 	const std::vector<uint8_t>& verticesData, const std::vector<uint8_t>& indicesData)
 {
+	MeshCacheHeader header{ Mesh::CACHE_MAGIC, Mesh::CACHE_VERSION };
+
 	std::ofstream meshFile(filePath, std::ios::binary);
+	meshFile.write(reinterpret_cast<const char*>(&header), sizeof(MeshCacheHeader));
 	meshFile.write(reinterpret_cast<const char*>(&meshDesc), sizeof(MeshDesc));
 	meshFile.write(reinterpret_cast<const char*>(verticesData.data()), verticesData.size());
 	meshFile.write(reinterpret_cast<const char*>(indicesData.data()), indicesData.size());
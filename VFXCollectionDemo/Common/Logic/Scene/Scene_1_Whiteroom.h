@@ -28,7 +28,7 @@ namespace Common::Logic::Scene
 		void OnResize(Graphics::DirectX12Renderer* renderer) override;
 
 		void Update() override;
-		void RenderShadows(ID3D12GraphicsCommandList* commandList) override;
+		void RenderShadows(ID3D12GraphicsCommandList* commandList, Graphics::DirectX12Renderer* renderer) override;
 		void Render(ID3D12GraphicsCommandList* commandList, Graphics::DirectX12Renderer* renderer) override;
 		void RenderToBackBuffer(ID3D12GraphicsCommandList* commandList) override;
 
@@ -59,7 +59,7 @@ namespace Common::Logic::Scene
 		void LoadMesh(std::filesystem::path filePath, std::filesystem::path fileCachePath,
 			std::vector<uint8_t>& verticesData, std::vector<uint8_t>& indicesData, Graphics::Assets::MeshDesc& desc);
 
-		void LoadCache(std::filesystem::path filePath, Graphics::Assets::MeshDesc& meshDesc,
+		bool LoadCache(std::filesystem::path filePath, Graphics::Assets::MeshDesc& meshDesc,
 			std::vector<uint8_t>& verticesData, std::vector<uint8_t>& indicesData);
 
 		void SaveCache(std::filesystem::path filePath, const Graphics::Assets::MeshDesc& meshDesc,
@@ -30,7 +30,8 @@ void Common::Logic::Scene::Scene_Empty::Update()
 
 }
 
-void Common::Logic::Scene::Scene_Empty::RenderShadows(ID3D12GraphicsCommandList* commandList)
+void Common::Logic::Scene::Scene_Empty::RenderShadows(ID3D12GraphicsCommandList* commandList,
+	Graphics::DirectX12Renderer* renderer)
 {
 
 }
@@ -17,7 +17,7 @@ namespace Common::Logic::Scene
 		void OnResize(Graphics::DirectX12Renderer* renderer) override;
 
 		void Update() override;
-		void RenderShadows(ID3D12GraphicsCommandList* commandList) override;
+		void RenderShadows(ID3D12GraphicsCommandList* commandList, Graphics::DirectX12Renderer* renderer) override;
 		void Render(ID3D12GraphicsCommandList* commandList, Graphics::DirectX12Renderer* renderer) override;
 		void RenderToBackBuffer(ID3D12GraphicsCommandList* commandList) override;
 
@@ -25,6 +25,7 @@ void Common::Logic::SceneEntity::Camera::Update(const float3& position, const fl
 	viewProjection = view * projection;
 	invView = XMMatrixInverse(nullptr, view);
 	invViewProjection = XMMatrixInverse(nullptr, viewProjection);
+	frustum.Update(viewProjection);
 
 	auto _direction = _lookAt - _positionV;
 	_direction = XMVector3Normalize(_direction);
@@ -44,6 +45,7 @@ void Common::Logic::SceneEntity::Camera::UpdateProjection(float fovY, float aspe
 
 	viewProjection = view * projection;
 	invViewProjection = XMMatrixInverse(nullptr, viewProjection);
+	frustum.Update(viewProjection);
 
 	baseProjection = projection;
 }
@@ -86,6 +88,11 @@ const float4x4& Common::Logic::SceneEntity::Camera::GetInvViewProjection() const
 	return invViewProjection;
 }
 
+const Graphics::Assets::Frustum& Common::Logic::SceneEntity::Camera::GetFrustum() const
+{
+	return frustum;
+}
+
 const float3& Common::Logic::SceneEntity::Camera::GetPosition() const
 {
 	return _position;
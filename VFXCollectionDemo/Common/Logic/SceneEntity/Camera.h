@@ -2,6 +2,7 @@
 
 #include "../../../Includes.h"
 #include "../../../Graphics/DirectX12Includes.h"
+#include "../../../Graphics/Assets/Frustum.h"
 
 namespace Common::Logic::SceneEntity
 {
@@ -25,6 +26,8 @@ namespace Common::Logic::SceneEntity
 		const float4x4& GetInvProjection() const;
 		const float4x4& GetInvViewProjection() const;
 
+		const Graphics::Assets::Frustum& GetFrustum() const;
+
 		const float3& GetPosition() const;
 		const float3& GetDirection() const;
 
@@ -44,6 +47,8 @@ namespace Common::Logic::SceneEntity
 		float4x4 invProjection;
 		float4x4 invViewProjection;
 
+		Graphics::Assets::Frustum frustum;
+
 		float3 _position;
 		float3 direction;
 
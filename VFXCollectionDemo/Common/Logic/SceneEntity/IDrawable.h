@@ -4,6 +4,7 @@
 #include "../../../Graphics/DirectX12Includes.h"
 #include "../../../Graphics/Resources/ResourceManager.h"
 #include "../../../Graphics/VertexFormat.h"
+#include "../../../Graphics/Assets/MeshDesc.h"
 
 namespace Common::Logic::SceneEntity
 {
@@ -21,6 +22,11 @@ namespace Common::Logic::SceneEntity
 		virtual void DrawShadowsCube(ID3D12GraphicsCommandList* commandList, uint32_t lightMatrixStartIndex) = 0;
 		virtual void Draw(ID3D12GraphicsCommandList* commandList) = 0;
 
+		virtual bool GetBounds(Graphics::Assets::AxisAlignedBox& bounds, Graphics::Assets::BoundingSphere& boundingSphere) const
+		{
+			return false;
+		}
+
 		virtual void Release(Graphics::Resources::ResourceManager* resourceManager) = 0;
 	};
 }
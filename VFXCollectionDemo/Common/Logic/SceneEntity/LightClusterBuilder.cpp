@@ -0,0 +1,245 @@
+#include "LightClusterBuilder.h"
+#include "../../../Graphics/Assets/ComputeObjectBuilder.h"
+
+using namespace DirectX;
+using namespace Graphics;
+using namespace Graphics::Resources;
+using namespace Graphics::Assets;
+
+Common::Logic::SceneEntity::LightClusterBuilder::LightClusterBuilder(ID3D12GraphicsCommandList* commandList,
+	Graphics::DirectX12Renderer* renderer, const LightClusterDesc& desc)
+	: _desc(desc), constantsBuffer{}, constantBufferId{}, lightCountBufferId{}, lightIndexBufferId{},
+	lightCountBufferGPUResource{}, lightIndexBufferGPUResource{}, lightClustering{}
+{
+	_desc.clustersPerWidth = std::max(_desc.clustersPerWidth, 1u);
+	_desc.clustersPerHeight = std::max(_desc.clustersPerHeight, 1u);
+	_desc.depthSlicesNumber = std::max(_desc.depthSlicesNumber, 1u);
+	_desc.maxLightsPerCluster = std::max(_desc.maxLightsPerCluster, 1u);
+
+	clustersNumber = _desc.clustersPerWidth * _desc.clustersPerHeight * _desc.depthSlicesNumber;
+
+	auto device = renderer->GetDevice();
+	auto resourceManager = renderer->GetResourceManager();
+
+	lightBufferGPUResource = resourceManager->GetResource<RWBuffer>(_desc.lightBufferId)->resource;
+
+	CreateConstantBuffers(device, resourceManager);
+	CreateBuffers(device, commandList, resourceManager);
+	CreateComputeObject(device, resourceManager);
+}
+
+Common::Logic::SceneEntity::LightClusterBuilder::~LightClusterBuilder()
+{
+
+}
+
+void Common::Logic::SceneEntity::LightClusterBuilder::Update(const Camera* camera, const uint2& renderSize)
+{
+	SetConstants(camera->GetView(), camera->GetFovY(), camera->GetAspectRatio(), camera->GetZNear(),
+		camera->GetZFar(), renderSize, _desc, *constantsBuffer);
+}
+
+void Common::Logic::SceneEntity::LightClusterBuilder::OnCompute(ID3D12GraphicsCommandList* commandList)
+{
+	auto numGroups = (clustersNumber + THREADS_PER_GROUP - 1u) / THREADS_PER_GROUP;
+
+	lightBufferGPUResource->Barrier(commandList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE |
+		D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+	lightCountBufferGPUResource->Barrier(commandList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	lightIndexBufferGPUResource->Barrier(commandList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+	lightClustering->Set(commandList);
+	lightClustering->Dispatch(commandList, numGroups, 1u, 1u);
+
+	lightCountBufferGPUResource->Barrier(commandList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+	lightIndexBufferGPUResource->Barrier(commandList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+}
+
+Graphics::Resources::ResourceID Common::Logic::SceneEntity::LightClusterBuilder::GetConstantBufferId() const
+{
+	return constantBufferId;
+}
+
+Graphics::Resources::ResourceID Common::Logic::SceneEntity::LightClusterBuilder::GetLightCountBufferId() const
+{
+	return lightCountBufferId;
+}
+
+Graphics::Resources::ResourceID Common::Logic::SceneEntity::LightClusterBuilder::GetLightIndexBufferId() const
+{
+	return lightIndexBufferId;
+}
+
+void Common::Logic::SceneEntity::LightClusterBuilder::Release(Graphics::Resources::ResourceManager* resourceManager)
+{
+	resourceManager->DeleteResource<ConstantBuffer>(constantBufferId);
+	resourceManager->DeleteResource<RWBuffer>(lightCountBufferId);
+	resourceManager->DeleteResource<RWBuffer>(lightIndexBufferId);
+
+	delete lightClustering;
+}
+
+void Common::Logic::SceneEntity::LightClusterBuilder::SetConstants(const float4x4& view, float fovY, float aspectRatio,
+	float zNear, float zFar, const uint2& renderSize, const LightClusterDesc& desc, LightClusterConstants& constants)
+{
+	auto tanHalfFovY = std::tan(fovY * 0.5f);
+
+	constants.view = view;
+	constants.tanHalfFov = float2(tanHalfFovY * aspectRatio, tanHalfFovY);
+	constants.renderSize = float2(static_cast<float>(renderSize.x), static_cast<float>(renderSize.y));
+	constants.zNear = zNear;
+	constants.zFar = zFar;
+	constants.depthScale = static_cast<float>(desc.depthSlicesNumber) / std::log(zFar / zNear);
+	constants.lightsNumber = desc.lightsNumber;
+	constants.clustersNumber = uint3(desc.clustersPerWidth, desc.clustersPerHeight, desc.depthSlicesNumber);
+	constants.maxLightsPerCluster = desc.maxLightsPerCluster;
+}
+
+void Common::Logic::SceneEntity::LightClusterBuilder::Build(const LightClusterConstants& constants,
+	const std::vector<PointLight>& lights, std::vector<uint32_t>& lightCounts, std::vector<uint32_t>& lightIndices)
+{
+	auto clustersNumber = constants.clustersNumber.x * constants.clustersNumber.y * constants.clustersNumber.z;
+	auto lightsNumber = std::min(constants.lightsNumber, static_cast<uint32_t>(lights.size()));
+
+	lightCounts.assign(clustersNumber, 0u);
+	lightIndices.assign(static_cast<size_t>(clustersNumber) * constants.maxLightsPerCluster, 0u);
+
+	std::vector<float3> viewPositions(lightsNumber);
+
+	for (uint32_t lightIndex = 0u; lightIndex < lightsNumber; lightIndex++)
+		XMStoreFloat3(&viewPositions[lightIndex], XMVector3TransformCoord(XMLoadFloat3(&lights[lightIndex].position), constants.view));
+
+	for (uint32_t clusterIndex = 0u; clusterIndex < clustersNumber; clusterIndex++)
+	{
+		float3 minCorner{};
+		float3 maxCorner{};
+		GetClusterBounds(constants, clusterIndex, minCorner, maxCorner);
+
+		auto& lightCount = lightCounts[clusterIndex];
+		auto clusterLightIndices = lightIndices.data() + static_cast<size_t>(clusterIndex) * constants.maxLightsPerCluster;
+
+		for (uint32_t lightIndex = 0u; lightIndex < lightsNumber && lightCount < constants.maxLightsPerCluster; lightIndex++)
+		{
+			const auto& light = lights[lightIndex];
+
+			if (light.color.x <= 0.0f && light.color.y <= 0.0f && light.color.z <= 0.0f)
+				continue;
+
+			if (!IntersectsSphere(viewPositions[lightIndex], light.range, minCorner, maxCorner))
+				continue;
+
+			clusterLightIndices[lightCount] = lightIndex;
+			lightCount++;
+		}
+	}
+}
+
+uint32_t Common::Logic::SceneEntity::LightClusterBuilder::GetClusterIndex(const LightClusterConstants& constants,
+	const float2& screenPosition, float viewDepth)
+{
+	const auto& clusters = constants.clustersNumber;
+
+	auto tileX = static_cast<uint32_t>(std::max(screenPosition.x / constants.renderSize.x * clusters.x, 0.0f));
+	auto tileY = static_cast<uint32_t>(std::max(screenPosition.y / constants.renderSize.y * clusters.y, 0.0f));
+	auto slice = static_cast<uint32_t>(std::max(std::log(std::max(viewDepth, constants.zNear) / constants.zNear) *
+		constants.depthScale, 0.0f));
+
+	tileX = std::min(tileX, clusters.x - 1u);
+	tileY = std::min(tileY, clusters.y - 1u);
+	slice = std::min(slice, clusters.z - 1u);
+
+	return tileX + (tileY + slice * clusters.y) * clusters.x;
+}
+
+void Common::Logic::SceneEntity::LightClusterBuilder::GetClusterBounds(const LightClusterConstants& constants,
+	uint32_t clusterIndex, float3& minCorner, float3& maxCorner)
+{
+	const auto& clusters = constants.clustersNumber;
+
+	auto tileX = clusterIndex % clusters.x;
+	auto tileY = (clusterIndex / clusters.x) % clusters.y;
+	auto slice = clusterIndex / (clusters.x * clusters.y);
+
+	auto nearDepth = constants.zNear * std::exp(static_cast<float>(slice) / constants.depthScale);
+	auto farDepth = constants.zNear * std::exp(static_cast<float>(slice + 1u) / constants.depthScale);
+
+	auto minX = (static_cast<float>(tileX) / clusters.x * 2.0f - 1.0f) * constants.tanHalfFov.x;
+	auto maxX = (static_cast<float>(tileX + 1u) / clusters.x * 2.0f - 1.0f) * constants.tanHalfFov.x;
+	auto minY = (1.0f - static_cast<float>(tileY + 1u) / clusters.y * 2.0f) * constants.tanHalfFov.y;
+	auto maxY = (1.0f - static_cast<float>(tileY) / clusters.y * 2.0f) * constants.tanHalfFov.y;
+
+	minCorner.x = std::min(minX * nearDepth, minX * farDepth);
+	minCorner.y = std::min(minY * nearDepth, minY * farDepth);
+	minCorner.z = -farDepth;
+
+	maxCorner.x = std::max(maxX * nearDepth, maxX * farDepth);
+	maxCorner.y = std::max(maxY * nearDepth, maxY * farDepth);
+	maxCorner.z = -nearDepth;
+}
+
+void Common::Logic::SceneEntity::LightClusterBuilder::CreateConstantBuffers(ID3D12Device* device,
+	Graphics::Resources::ResourceManager* resourceManager)
+{
+	BufferDesc bufferDesc{};
+	bufferDesc.data.resize(sizeof(LightClusterConstants), 0u);
+	bufferDesc.flag = BufferFlag::IS_CONSTANT_DYNAMIC;
+
+	constantBufferId = resourceManager->CreateBufferResource(device, nullptr, BufferResourceType::CONSTANT_BUFFER, bufferDesc);
+
+	auto constantBufferResource = resourceManager->GetResource<ConstantBuffer>(constantBufferId);
+	constantsBuffer = reinterpret_cast<LightClusterConstants*>(constantBufferResource->resourceCPUAddress);
+}
+
+void Common::Logic::SceneEntity::LightClusterBuilder::CreateBuffers(ID3D12Device* device,
+	ID3D12GraphicsCommandList* commandList, Graphics::Resources::ResourceManager* resourceManager)
+{
+	BufferDesc lightCountBufferDesc{};
+	lightCountBufferDesc.data.resize(clustersNumber * sizeof(uint32_t), 0u);
+	lightCountBufferDesc.dataStride = sizeof(uint32_t);
+	lightCountBufferDesc.numElements = clustersNumber;
+	lightCountBufferDesc.flag = BufferFlag::STRUCTURED;
+
+	lightCountBufferId = resourceManager->CreateBufferResource(device, commandList,
+		BufferResourceType::RW_BUFFER, lightCountBufferDesc);
+
+	BufferDesc lightIndexBufferDesc{};
+	lightIndexBufferDesc.data.resize(clustersNumber * _desc.maxLightsPerCluster * sizeof(uint32_t), 0u);
+	lightIndexBufferDesc.dataStride = sizeof(uint32_t);
+	lightIndexBufferDesc.numElements = clustersNumber * _desc.maxLightsPerCluster;
+	lightIndexBufferDesc.flag = BufferFlag::STRUCTURED;
+
+	lightIndexBufferId = resourceManager->CreateBufferResource(device, commandList,
+		BufferResourceType::RW_BUFFER, lightIndexBufferDesc);
+
+	lightCountBufferGPUResource = resourceManager->GetResource<RWBuffer>(lightCountBufferId)->resource;
+	lightIndexBufferGPUResource = resourceManager->GetResource<RWBuffer>(lightIndexBufferId)->resource;
+}
+
+void Common::Logic::SceneEntity::LightClusterBuilder::CreateComputeObject(ID3D12Device* device,
+	Graphics::Resources::ResourceManager* resourceManager)
+{
+	auto constantBufferResource = resourceManager->GetResource<ConstantBuffer>(constantBufferId);
+	auto lightBufferResource = resourceManager->GetResource<RWBuffer>(_desc.lightBufferId);
+	auto lightCountBufferResource = resourceManager->GetResource<RWBuffer>(lightCountBufferId);
+	auto lightIndexBufferResource = resourceManager->GetResource<RWBuffer>(lightIndexBufferId);
+	auto lightClusteringResource = resourceManager->GetResource<Shader>(_desc.lightClusteringCSId);
+
+	ComputeObjectBuilder computeObjectBuilder{};
+	computeObjectBuilder.SetConstantBuffer(4u, constantBufferResource->resourceGPUAddress);
+	computeObjectBuilder.SetBuffer(0u, lightBufferResource->resourceGPUAddress);
+	computeObjectBuilder.SetRWBuffer(0u, lightCountBufferResource->resourceGPUAddress);
+	computeObjectBuilder.SetRWBuffer(1u, lightIndexBufferResource->resourceGPUAddress);
+	computeObjectBuilder.SetShader(lightClusteringResource->bytecode);
+
+	lightClustering = computeObjectBuilder.Compose(device);
+}
+
+bool Common::Logic::SceneEntity::LightClusterBuilder::IntersectsSphere(const float3& center, float radius,
+	const float3& minCorner, const float3& maxCorner)
+{
+	auto closestX = std::clamp(center.x, minCorner.x, maxCorner.x) - center.x;
+	auto closestY = std::clamp(center.y, minCorner.y, maxCorner.y) - center.y;
+	auto closestZ = std::clamp(center.z, minCorner.z, maxCorner.z) - center.z;
+
+	return closestX * closestX + closestY * closestY + closestZ * closestZ <= radius * radius;
+}
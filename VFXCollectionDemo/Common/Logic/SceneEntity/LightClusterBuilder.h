@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../../../Includes.h"
+#include "../../../Graphics/Assets/ComputeObject.h"
+#include "../../../Graphics/DirectX12Renderer.h"
+#include "LightDesc.h"
+#include "Camera.h"
+
+namespace Common::Logic::SceneEntity
+{
+	struct LightClusterDesc
+	{
+	public:
+		uint32_t clustersPerWidth;
+		uint32_t clustersPerHeight;
+		uint32_t depthSlicesNumber;
+		uint32_t maxLightsPerCluster;
+		uint32_t lightsNumber;
+
+		Graphics::Resources::ResourceID lightBufferId;
+		Graphics::Resources::ResourceID lightClusteringCSId;
+	};
+
+	struct LightClusterConstants
+	{
+	public:
+		float4x4 view;
+
+		float2 tanHalfFov;
+		float2 renderSize;
+
+		float zNear;
+		float zFar;
+		float depthScale;
+		uint32_t lightsNumber;
+
+		uint3 clustersNumber;
+		uint32_t maxLightsPerCluster;
+	};
+
+	class LightClusterBuilder final
+	{
+	public:
+		LightClusterBuilder(ID3D12GraphicsCommandList* commandList, Graphics::DirectX12Renderer* renderer,
+			const LightClusterDesc& desc);
+		~LightClusterBuilder();
+
+		void Update(const Camera* camera, const uint2& renderSize);
+		void OnCompute(ID3D12GraphicsCommandList* commandList);
+
+		Graphics::Resources::ResourceID GetConstantBufferId() const;
+		Graphics::Resources::ResourceID GetLightCountBufferId() const;
+		Graphics::Resources::ResourceID GetLightIndexBufferId() const;
+
+		void Release(Graphics::Resources::ResourceManager* resourceManager);
+
+		static void SetConstants(const float4x4& view, float fovY, float aspectRatio, float zNear, float zFar,
+			const uint2& renderSize, const LightClusterDesc& desc, LightClusterConstants& constants);
+
+		static void Build(const LightClusterConstants& constants, const std::vector<PointLight>& lights,
+			std::vector<uint32_t>& lightCounts, std::vector<uint32_t>& lightIndices);
+
+		static uint32_t GetClusterIndex(const LightClusterConstants& constants, const float2& screenPosition, float viewDepth);
+		static void GetClusterBounds(const LightClusterConstants& constants, uint32_t clusterIndex,
+			float3& minCorner, float3& maxCorner);
+
+		static constexpr uint32_t THREADS_PER_GROUP = 64u;
+
+	private:
+		LightClusterBuilder() = delete;
+
+		void CreateConstantBuffers(ID3D12Device* device, Graphics::Resources::ResourceManager* resourceManager);
+		void CreateBuffers(ID3D12Device* device, ID3D12GraphicsCommandList* commandList,
+			Graphics::Resources::ResourceManager* resourceManager);
+		void CreateComputeObject(ID3D12Device* device, Graphics::Resources::ResourceManager* resourceManager);
+
+		static bool IntersectsSphere(const float3& center, float radius, const float3& minCorner, const float3& maxCorner);
+
+		LightClusterDesc _desc;
+		LightClusterConstants* constantsBuffer;
+
+		uint32_t clustersNumber;
+
+		Graphics::Resources::GPUResource* lightBufferGPUResource;
+		Graphics::Resources::GPUResource* lightCountBufferGPUResource;
+		Graphics::Resources::GPUResource* lightIndexBufferGPUResource;
+
+		Graphics::Resources::ResourceID constantBufferId;
+		Graphics::Resources::ResourceID lightCountBufferId;
+		Graphics::Resources::ResourceID lightIndexBufferId;
+
+		Graphics::Assets::ComputeObject* lightClustering;
+	};
+}
@@ -2,6 +2,7 @@
 
 #include "../../../Includes.h"
 #include "../../../Graphics/Resources/ResourceManager.h"
+#include "../../../Graphics/Assets/Frustum.h"
 
 namespace Common::Logic::SceneEntity
 {
@@ -16,13 +17,21 @@ namespace Common::Logic::SceneEntity
 		AMBIENT_LIGHT = 4u
 	};
 
+	enum class ShadowCacheMode : uint32_t
+	{
+		NONE = 0u,
+		CACHED = 1u,
+		STATIC_CACHED = 2u
+	};
+
 	struct DirectionalLight
 	{
 	public:
 		float3 direction;
-		float padding0;
+		uint32_t cascadesNumber;
 		float3 color;
-		float padding1;
+		uint32_t lightMatrixStartIndex;
+		float4 cascadeSplits;
 	};
 
 	struct PointLight
@@ -74,6 +83,31 @@ namespace Common::Logic::SceneEntity
 			return shadowMapId;
 		}
 
+		const float4x4& GetViewProjection(uint32_t index = 0u) const
+		{
+			return viewProjections[index];
+		}
+
+		Graphics::Assets::Frustum GetFrustum(uint32_t index = 0u) const
+		{
+			return Graphics::Assets::Frustum(viewProjections[index]);
+		}
+
+		uint32_t GetShadowFaceMask() const
+		{
+			return shadowFaceMask;
+		}
+
+		uint32_t GetShadowFacesNumber() const
+		{
+			return shadowFacesNumber;
+		}
+
+		const float4& GetCascadeSplits() const
+		{
+			return cascadeSplits;
+		}
+
 		float3 position;
 		float radius;
 		float3 color;
@@ -84,6 +118,8 @@ namespace Common::Logic::SceneEntity
 		float range;
 		bool castShadows;
 		LightType type;
+		ShadowCacheMode shadowCacheMode;
+		uint32_t cascadesNumber;
 
 	private:
 		Graphics::Resources::ResourceID shadowMapId;
@@ -92,6 +128,9 @@ namespace Common::Logic::SceneEntity
 		uint32_t lightMatrixStartIndex;
 		void* lightBufferStartAddress;
 		float4x4* viewProjections;
+		uint32_t shadowFaceMask;
+		uint32_t shadowFacesNumber;
+		float4 cascadeSplits;
 
 		friend class LightingSystem;
 	};
@@ -2,12 +2,14 @@
 
 using namespace Graphics;
 using namespace Graphics::Resources;
+using namespace Graphics::Assets;
 using namespace DirectX;
 
 Common::Logic::SceneEntity::LightingSystem::LightingSystem(DirectX12Renderer* renderer)
 	: _renderer(renderer), isLightConstantBufferBuilded(false), lightConstantBufferId{},
 	lightMatricesConstantBufferId{}, lightParticleBufferId{}, lightMatricesNumber{},
-	lightParticleNumber{}, isLightParticleBufferBuilded{}
+	lightParticleNumber{}, isLightParticleBufferBuilded{}, shadowCacheStatistics{}, lightUpdateRequestsNumber{},
+	lightUpdateStatistics{}
 {
 	viewport.TopLeftX = 0.0f;
 	viewport.TopLeftY = 0.0f;
@@ -23,6 +25,13 @@ Common::Logic::SceneEntity::LightingSystem::LightingSystem(DirectX12Renderer* re
 	cubeViewport.MinDepth = 0.0f;
 	cubeViewport.MaxDepth = 1.0f;
 
+	cascadeViewport.TopLeftX = 0.0f;
+	cascadeViewport.TopLeftY = 0.0f;
+	cascadeViewport.Width = static_cast<float>(CASCADE_SHADOW_MAP_SIZE);
+	cascadeViewport.Height = static_cast<float>(CASCADE_SHADOW_MAP_SIZE);
+	cascadeViewport.MinDepth = 0.0f;
+	cascadeViewport.MaxDepth = 1.0f;
+
 	scissorRectangle.left = 0;
 	scissorRectangle.top = 0;
 	scissorRectangle.right = SHADOW_MAP_SIZE;
@@ -32,6 +41,11 @@ Common::Logic::SceneEntity::LightingSystem::LightingSystem(DirectX12Renderer* re
 	cubeScissorRectangle.top = 0;
 	cubeScissorRectangle.right = CUBE_SHADOW_MAP_SIZE;
 	cubeScissorRectangle.bottom = CUBE_SHADOW_MAP_SIZE;
+
+	cascadeScissorRectangle.left = 0;
+	cascadeScissorRectangle.top = 0;
+	cascadeScissorRectangle.right = CASCADE_SHADOW_MAP_SIZE;
+	cascadeScissorRectangle.bottom = CASCADE_SHADOW_MAP_SIZE;
 }
 
 Common::Logic::SceneEntity::LightingSystem::~LightingSystem()
@@ -45,10 +59,17 @@ Common::Logic::SceneEntity::LightID Common::Logic::SceneEntity::LightingSystem::
 	lights.push_back(desc);
 
 	auto& light = lights[id];
+	auto& cache = shadowCaches.emplace_back();
+	lightUpdateStates.emplace_back();
+
+	light.cascadesNumber = light.type == LightType::DIRECTIONAL_LIGHT ?
+		std::clamp(light.cascadesNumber, 1u, ShadowCascades::MAX_CASCADES_NUMBER) : 0u;
+	light.cascadeSplits = float4(SHADOW_MAP_Z_FAR, SHADOW_MAP_Z_FAR, SHADOW_MAP_Z_FAR, SHADOW_MAP_Z_FAR);
+	light.shadowFacesNumber = GetShadowFacesNumber(light);
 
 	if (light.castShadows)
 	{
-		light.shadowMapId = CreateShadowMap(light.type == LightType::POINT_LIGHT || light.type == LightType::AREA_LIGHT);
+		light.shadowMapId = CreateShadowMap(light);
 		
 		auto resourceManager = _renderer->GetResourceManager();
 		auto shadowMap = resourceManager->GetResource<DepthStencilTarget>(light.shadowMapId);
@@ -58,7 +79,16 @@ Common::Logic::SceneEntity::LightID Common::Logic::SceneEntity::LightingSystem::
 		barriers.reserve(barriers.size() + 1u);
 
 		light.lightMatrixStartIndex = lightMatricesNumber;
-		lightMatricesNumber += (light.type == LightType::POINT_LIGHT || light.type == LightType::AREA_LIGHT) ? 6u : 1u;
+		lightMatricesNumber += light.shadowFacesNumber;
+
+		cache.facesNumber = light.shadowFacesNumber;
+		light.shadowFaceMask = GetAllFacesMask(cache);
+
+		if (light.shadowCacheMode == ShadowCacheMode::STATIC_CACHED)
+		{
+			cache.cacheId = CreateShadowMap(light);
+			cache.cacheResource = resourceManager->GetResource<DepthStencilTarget>(cache.cacheId)->resource;
+		}
 	}
 
 	return id;
@@ -94,12 +124,14 @@ Graphics::Resources::ResourceID Common::Logic::SceneEntity::LightingSystem::GetL
 
 void Common::Logic::SceneEntity::LightingSystem::UpdateSourceDesc(LightID id)
 {
-	auto& light = lights[id];
+	auto& state = lightUpdateStates[id];
+	lightUpdateRequestsNumber++;
 
-	SetLightBufferElement(light);
+	if (state.isPending)
+		return;
 
-	if (light.castShadows)
-		SetupViewProjectMatrices(light);
+	state.isPending = true;
+	pendingLights.push_back(id);
 }
 
 Common::Logic::SceneEntity::LightDesc& Common::Logic::SceneEntity::LightingSystem::GetSourceDesc(LightID id)
@@ -107,6 +139,87 @@ Common::Logic::SceneEntity::LightDesc& Common::Logic::SceneEntity::LightingSyste
 	return lights[id];
 }
 
+void Common::Logic::SceneEntity::LightingSystem::Update()
+{
+	if (!isLightConstantBufferBuilded)
+		return;
+
+	lightUpdateStatistics = {};
+	lightUpdateStatistics.updatesRequested = lightUpdateRequestsNumber;
+	lightUpdateStatistics.updatesCoalesced = lightUpdateRequestsNumber - static_cast<uint32_t>(pendingLights.size());
+
+	for (auto id : pendingLights)
+	{
+		auto& light = lights[id];
+		auto& state = lightUpdateStates[id];
+		state.isPending = false;
+
+		auto isMoved = IsChanged(light.position, state.position) || IsChanged(light.direction, state.direction);
+		auto isBufferChanged = isMoved || IsChanged(light.color, state.color) || light.intensity != state.intensity ||
+			light.radius != state.radius || light.range != state.range || light.cosPhi2 != state.cosPhi2 ||
+			light.cosTheta2 != state.cosTheta2;
+
+		if (isBufferChanged)
+		{
+			SetLightBufferElement(light);
+			lightUpdateStatistics.bufferWrites++;
+		}
+		else
+			lightUpdateStatistics.bufferWritesSkipped++;
+
+		if (light.castShadows && light.type != LightType::AMBIENT_LIGHT && !IsCascaded(light))
+		{
+			if (isMoved)
+			{
+				SetupViewProjectMatrices(light);
+				lightUpdateStatistics.matricesRebuilt += light.shadowFacesNumber;
+			}
+			else
+				lightUpdateStatistics.matricesSkipped += light.shadowFacesNumber;
+		}
+
+		SaveUpdateState(light, state);
+	}
+
+	pendingLights.clear();
+	lightUpdateRequestsNumber = 0u;
+}
+
+void Common::Logic::SceneEntity::LightingSystem::UpdateCascades(const Camera* camera, const AxisAlignedBox& casterBounds,
+	const AxisAlignedBox& receiverBounds)
+{
+	if (!isLightConstantBufferBuilded)
+		return;
+
+	ShadowCascadesDesc cascadesDesc{};
+	cascadesDesc.cameraView = camera->GetView();
+	cascadesDesc.fovY = camera->GetFovY();
+	cascadesDesc.aspectRatio = camera->GetAspectRatio();
+	cascadesDesc.zNear = camera->GetZNear();
+	cascadesDesc.zFar = std::min(camera->GetZFar(), SHADOW_MAP_Z_FAR);
+	cascadesDesc.splitLambda = ShadowCascades::DEFAULT_SPLIT_LAMBDA;
+	cascadesDesc.shadowMapSize = CASCADE_SHADOW_MAP_SIZE;
+	cascadesDesc.casterBounds = casterBounds;
+	cascadesDesc.receiverBounds = receiverBounds;
+
+	std::array<float, ShadowCascades::MAX_CASCADES_NUMBER> splits{};
+
+	for (auto& light : lights)
+	{
+		if (!light.castShadows || !IsCascaded(light))
+			continue;
+
+		cascadesDesc.lightDirection = light.direction;
+		cascadesDesc.cascadesNumber = light.cascadesNumber;
+
+		splits.fill(cascadesDesc.zFar);
+		ShadowCascades::Build(cascadesDesc, light.viewProjections, splits.data());
+
+		light.cascadeSplits = float4(splits[0u], splits[1u], splits[2u], splits[3u]);
+		SetLightBufferElement(light);
+	}
+}
+
 uint32_t Common::Logic::SceneEntity::LightingSystem::GetLightMatricesNumber() const
 {
 	return lightMatricesNumber;
@@ -139,12 +252,24 @@ Graphics::Resources::ResourceID Common::Logic::SceneEntity::LightingSystem::GetL
 void Common::Logic::SceneEntity::LightingSystem::BeforeStartRenderShadowMaps(ID3D12GraphicsCommandList* commandList)
 {
 	barriers.clear();
+	shadowCacheStatistics = {};
 
-	for (auto& lightDesc : lights)
+	for (size_t lightIndex = 0u; lightIndex < lights.size(); lightIndex++)
 	{
+		auto& lightDesc = lights[lightIndex];
+
 		if (!lightDesc.castShadows)
 			continue;
 
+		auto& cache = shadowCaches[lightIndex];
+		cache.dynamicFaceMask = 0u;
+
+		for (uint32_t faceIndex = 0u; faceIndex < cache.facesNumber; faceIndex++)
+		{
+			cache.frustums[faceIndex].Update(lightDesc.viewProjections[faceIndex]);
+			cache.staticCasterHashes[faceIndex] = 0u;
+		}
+
 		D3D12_RESOURCE_BARRIER barrier;
 		if (lightDesc.shadowMapResource->GetEndBarrier(barrier))
 			barriers.push_back(barrier);
@@ -154,7 +279,94 @@ void Common::Logic::SceneEntity::LightingSystem::BeforeStartRenderShadowMaps(ID3
 		commandList->ResourceBarrier(static_cast<uint32_t>(barriers.size()), barriers.data());
 }
 
-void Common::Logic::SceneEntity::LightingSystem::StartRenderShadowMap(LightID id, ID3D12GraphicsCommandList* commandList)
+uint32_t Common::Logic::SceneEntity::LightingSystem::AddShadowCaster(LightID id, const AxisAlignedBox& bounds,
+	bool isStatic)
+{
+	auto& cache = shadowCaches[id];
+	uint32_t faceMask = 0u;
+
+	for (uint32_t faceIndex = 0u; faceIndex < cache.facesNumber; faceIndex++)
+	{
+		if (!cache.frustums[faceIndex].Intersects(bounds))
+			continue;
+
+		faceMask |= 1u << faceIndex;
+
+		if (isStatic)
+			cache.staticCasterHashes[faceIndex] = HashBounds(cache.staticCasterHashes[faceIndex], bounds);
+	}
+
+	if (faceMask == 0u)
+		shadowCacheStatistics.castersCulled++;
+	else if (!isStatic)
+		cache.dynamicFaceMask |= faceMask;
+
+	return faceMask;
+}
+
+bool Common::Logic::SceneEntity::LightingSystem::StartRenderShadowMap(LightID id, ID3D12GraphicsCommandList* commandList)
+{
+	auto& lightDesc = lights[id];
+	auto& cache = shadowCaches[id];
+	auto allFacesMask = GetAllFacesMask(cache);
+
+	uint32_t dirtyFaceMask = allFacesMask;
+
+	if (lightDesc.shadowCacheMode != ShadowCacheMode::NONE)
+	{
+		dirtyFaceMask = allFacesMask & ~cache.validFaceMask;
+
+		for (uint32_t faceIndex = 0u; faceIndex < cache.facesNumber; faceIndex++)
+		{
+			const auto& cachedMatrix = cache.viewProjections[faceIndex];
+			const auto& matrix = lightDesc.viewProjections[faceIndex];
+
+			auto isMatrixChanged = !XMVector4Equal(cachedMatrix.r[0u], matrix.r[0u]) || !XMVector4Equal(cachedMatrix.r[1u], matrix.r[1u]) ||
+				!XMVector4Equal(cachedMatrix.r[2u], matrix.r[2u]) || !XMVector4Equal(cachedMatrix.r[3u], matrix.r[3u]);
+
+			if (isMatrixChanged || cache.staticCasterHashes[faceIndex] != cache.cachedStaticCasterHashes[faceIndex])
+				dirtyFaceMask |= 1u << faceIndex;
+		}
+
+		if (dirtyFaceMask == 0u && cache.dynamicFaceMask == 0u && cache.lastDynamicFaceMask == 0u)
+		{
+			lightDesc.shadowFaceMask = 0u;
+			cache.isRendering = false;
+			shadowCacheStatistics.facesSkipped += cache.facesNumber;
+
+			return false;
+		}
+
+		if (lightDesc.shadowCacheMode == ShadowCacheMode::CACHED)
+			dirtyFaceMask = allFacesMask;
+	}
+
+	commandList->ClearDepthStencilView(lightDesc.shadowMapCPUDescriptor, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0u, 0u, nullptr);
+
+	auto restoreFaceMask = allFacesMask & ~dirtyFaceMask;
+
+	if (lightDesc.shadowCacheMode == ShadowCacheMode::STATIC_CACHED && restoreFaceMask != 0u)
+	{
+		GetShadowMapFacesCopyBarriers(lightDesc.shadowMapResource, cache.cacheResource, cache.copyBarriers,
+			cache.restoreBarriers);
+		RecordShadowMapFacesCopy(lightDesc.shadowMapResource, cache.cacheResource, restoreFaceMask,
+			cache.copyBarriers, cache.restoreBarriers, commandList);
+	}
+
+	SetShadowMapTarget(id, commandList);
+
+	cache.staticFaceMask = dirtyFaceMask;
+	cache.isRendering = true;
+	lightDesc.shadowFaceMask = dirtyFaceMask;
+
+	auto renderedFacesNumber = static_cast<uint32_t>(std::popcount(dirtyFaceMask));
+	shadowCacheStatistics.facesRendered += renderedFacesNumber;
+	shadowCacheStatistics.facesSkipped += cache.facesNumber - renderedFacesNumber;
+
+	return true;
+}
+
+void Common::Logic::SceneEntity::LightingSystem::SetShadowMapTarget(LightID id, ID3D12GraphicsCommandList* commandList)
 {
 	auto& lightDesc = lights[id];
 
@@ -163,16 +375,60 @@ void Common::Logic::SceneEntity::LightingSystem::StartRenderShadowMap(LightID id
 		commandList->RSSetViewports(1u, &cubeViewport);
 		commandList->RSSetScissorRects(1u, &cubeScissorRectangle);
 	}
+	else if (IsCascaded(lightDesc))
+	{
+		commandList->RSSetViewports(1u, &cascadeViewport);
+		commandList->RSSetScissorRects(1u, &cascadeScissorRectangle);
+	}
 	else
 	{
 		commandList->RSSetViewports(1u, &viewport);
 		commandList->RSSetScissorRects(1u, &scissorRectangle);
 	}
 
-	commandList->ClearDepthStencilView(lightDesc.shadowMapCPUDescriptor, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0u, 0u, nullptr);
 	commandList->OMSetRenderTargets(0u, nullptr, true, &lightDesc.shadowMapCPUDescriptor);
 }
 
+void Common::Logic::SceneEntity::LightingSystem::StartRenderDynamicShadowCasters(LightID id)
+{
+	auto& lightDesc = lights[id];
+	auto& cache = shadowCaches[id];
+
+	cache.copyFaceMask = 0u;
+
+	if (lightDesc.shadowCacheMode == ShadowCacheMode::NONE || !cache.isRendering)
+		return;
+
+	if (lightDesc.shadowCacheMode == ShadowCacheMode::STATIC_CACHED && cache.staticFaceMask != 0u)
+	{
+		cache.copyFaceMask = cache.staticFaceMask;
+		GetShadowMapFacesCopyBarriers(cache.cacheResource, lightDesc.shadowMapResource, cache.copyBarriers,
+			cache.restoreBarriers);
+	}
+
+	for (uint32_t faceIndex = 0u; faceIndex < cache.facesNumber; faceIndex++)
+	{
+		cache.viewProjections[faceIndex] = lightDesc.viewProjections[faceIndex];
+		cache.cachedStaticCasterHashes[faceIndex] = cache.staticCasterHashes[faceIndex];
+	}
+
+	cache.validFaceMask = GetAllFacesMask(cache);
+	cache.lastDynamicFaceMask = cache.dynamicFaceMask;
+
+	lightDesc.shadowFaceMask = lightDesc.shadowCacheMode == ShadowCacheMode::STATIC_CACHED ?
+		cache.dynamicFaceMask : cache.validFaceMask;
+}
+
+void Common::Logic::SceneEntity::LightingSystem::CopyStaticShadowMapFaces(LightID id,
+	ID3D12GraphicsCommandList* commandList) const
+{
+	auto& cache = shadowCaches[id];
+
+	if (cache.copyFaceMask != 0u)
+		RecordShadowMapFacesCopy(cache.cacheResource, lights[id].shadowMapResource, cache.copyFaceMask,
+			cache.copyBarriers, cache.restoreBarriers, commandList);
+}
+
 void Common::Logic::SceneEntity::LightingSystem::EndRenderShadowMaps(ID3D12GraphicsCommandList* commandList)
 {
 	barriers.clear();
@@ -210,15 +466,36 @@ void Common::Logic::SceneEntity::LightingSystem::EndUsingShadowMaps(ID3D12Graphi
 		commandList->ResourceBarrier(static_cast<uint32_t>(barriers.size()), barriers.data());
 }
 
+const Common::Logic::SceneEntity::ShadowCacheStatistics& Common::Logic::SceneEntity::LightingSystem::GetShadowCacheStatistics() const noexcept
+{
+	return shadowCacheStatistics;
+}
+
+const Common::Logic::SceneEntity::LightUpdateStatistics& Common::Logic::SceneEntity::LightingSystem::GetLightUpdateStatistics() const noexcept
+{
+	return lightUpdateStatistics;
+}
+
 void Common::Logic::SceneEntity::LightingSystem::Clear()
 {
 	auto resourceManager = _renderer->GetResourceManager();
 
-	for (auto& lightDesc : lights)
-		if (lightDesc.castShadows)
-			resourceManager->DeleteResource<DepthStencilTarget>(lightDesc.shadowMapId);
+	for (size_t lightIndex = 0u; lightIndex < lights.size(); lightIndex++)
+	{
+		if (!lights[lightIndex].castShadows)
+			continue;
+
+		resourceManager->DeleteResource<DepthStencilTarget>(lights[lightIndex].shadowMapId);
+
+		if (shadowCaches[lightIndex].cacheResource != nullptr)
+			resourceManager->DeleteResource<DepthStencilTarget>(shadowCaches[lightIndex].cacheId);
+	}
 
 	lights.clear();
+	shadowCaches.clear();
+	lightUpdateStates.clear();
+	pendingLights.clear();
+	lightUpdateRequestsNumber = 0u;
 
 	resourceManager->DeleteResource<ConstantBuffer>(lightConstantBufferId);
 	resourceManager->DeleteResource<ConstantBuffer>(lightMatricesConstantBufferId);
@@ -259,7 +536,10 @@ void Common::Logic::SceneEntity::LightingSystem::SetLightBufferElement(LightDesc
 	{
 		auto light = reinterpret_cast<DirectionalLight*>(desc.lightBufferStartAddress);
 		light->direction = desc.direction;
+		light->cascadesNumber = desc.cascadesNumber;
 		light->color = float3(desc.color.x * desc.intensity, desc.color.y * desc.intensity, desc.color.z * desc.intensity);
+		light->lightMatrixStartIndex = desc.lightMatrixStartIndex;
+		light->cascadeSplits = desc.cascadeSplits;
 	}
 	else if (desc.type == LightType::POINT_LIGHT)
 	{
@@ -293,16 +573,38 @@ void Common::Logic::SceneEntity::LightingSystem::SetLightBufferElement(LightDesc
 	}
 }
 
-Graphics::Resources::ResourceID Common::Logic::SceneEntity::LightingSystem::CreateShadowMap(bool isCube)
+void Common::Logic::SceneEntity::LightingSystem::SaveUpdateState(const LightDesc& desc, LightUpdateState& state)
+{
+	state.position = desc.position;
+	state.direction = desc.direction;
+	state.color = desc.color;
+	state.intensity = desc.intensity;
+	state.radius = desc.radius;
+	state.range = desc.range;
+	state.cosPhi2 = desc.cosPhi2;
+	state.cosTheta2 = desc.cosTheta2;
+}
+
+bool Common::Logic::SceneEntity::LightingSystem::IsChanged(const float3& value, const float3& lastValue)
 {
+	return value.x != lastValue.x || value.y != lastValue.y || value.z != lastValue.z;
+}
+
+Graphics::Resources::ResourceID Common::Logic::SceneEntity::LightingSystem::CreateShadowMap(const LightDesc& desc)
+{
+	auto isCube = desc.type == LightType::POINT_LIGHT || desc.type == LightType::AREA_LIGHT;
+	auto isCascaded = IsCascaded(desc);
+	auto size = isCube ? CUBE_SHADOW_MAP_SIZE : isCascaded ? CASCADE_SHADOW_MAP_SIZE : SHADOW_MAP_SIZE;
+
 	TextureDesc shadowMapDesc{};
-	shadowMapDesc.width = isCube ? CUBE_SHADOW_MAP_SIZE : SHADOW_MAP_SIZE;
-	shadowMapDesc.height = isCube ? CUBE_SHADOW_MAP_SIZE : SHADOW_MAP_SIZE;
-	shadowMapDesc.depth = isCube ? 6u : 1u;
+	shadowMapDesc.width = size;
+	shadowMapDesc.height = size;
+	shadowMapDesc.depth = GetShadowFacesNumber(desc);
 	shadowMapDesc.mipLevels = 1u;
 	shadowMapDesc.depthBit = 32u;
 	shadowMapDesc.dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-	shadowMapDesc.srvDimension = isCube ? D3D12_SRV_DIMENSION_TEXTURECUBE : D3D12_SRV_DIMENSION_TEXTURE2D;
+	shadowMapDesc.srvDimension = isCube ? D3D12_SRV_DIMENSION_TEXTURECUBE :
+		isCascaded ? D3D12_SRV_DIMENSION_TEXTURE2DARRAY : D3D12_SRV_DIMENSION_TEXTURE2D;
 	
 	auto resourceManager = _renderer->GetResourceManager();
 	auto shadowMapId = resourceManager->CreateTextureResource(_renderer->GetDevice(), nullptr,
@@ -311,6 +613,19 @@ Graphics::Resources::ResourceID Common::Logic::SceneEntity::LightingSystem::Crea
 	return shadowMapId;
 }
 
+uint32_t Common::Logic::SceneEntity::LightingSystem::GetShadowFacesNumber(const LightDesc& desc) const
+{
+	if (desc.type == LightType::POINT_LIGHT || desc.type == LightType::AREA_LIGHT)
+		return CUBE_FACES_NUMBER;
+
+	return IsCascaded(desc) ? desc.cascadesNumber : 1u;
+}
+
+bool Common::Logic::SceneEntity::LightingSystem::IsCascaded(const LightDesc& desc) const
+{
+	return desc.type == LightType::DIRECTIONAL_LIGHT;
+}
+
 void Common::Logic::SceneEntity::LightingSystem::CreateConstantBuffers()
 {
 	BufferDesc lightBufferDesc{};
@@ -342,14 +657,91 @@ void Common::Logic::SceneEntity::LightingSystem::CreateConstantBuffers()
 	auto lightMatricesConstantBufferResource = resourceManager->GetResource<ConstantBuffer>(lightMatricesConstantBufferId);
 	auto lightMatricesConstantBufferPtr = reinterpret_cast<float4x4*>(lightMatricesConstantBufferResource->resourceCPUAddress);
 
-	for (auto& lightDesc : lights)
+	for (size_t lightIndex = 0u; lightIndex < lights.size(); lightIndex++)
 	{
-		lightDesc.viewProjections = lightMatricesConstantBufferPtr;
+		auto& lightDesc = lights[lightIndex];
+		SaveUpdateState(lightDesc, lightUpdateStates[lightIndex]);
+
+		if (!lightDesc.castShadows)
+			continue;
+
+		lightDesc.viewProjections = lightMatricesConstantBufferPtr + lightDesc.lightMatrixStartIndex;
 		SetupViewProjectMatrices(lightDesc);
+	}
+}
+
+void Common::Logic::SceneEntity::LightingSystem::GetShadowMapFacesCopyBarriers(GPUResource* destination, GPUResource* source,
+	std::vector<D3D12_RESOURCE_BARRIER>& copyBarriers, std::vector<D3D12_RESOURCE_BARRIER>& restoreBarriers)
+{
+	copyBarriers.clear();
+	restoreBarriers.clear();
+
+	D3D12_RESOURCE_BARRIER barrier;
+	if (destination->GetBarrier(D3D12_RESOURCE_STATE_COPY_DEST, barrier))
+		copyBarriers.push_back(barrier);
+
+	if (source->GetBarrier(D3D12_RESOURCE_STATE_COPY_SOURCE, barrier))
+		copyBarriers.push_back(barrier);
+
+	if (destination->GetBarrier(D3D12_RESOURCE_STATE_DEPTH_WRITE, barrier))
+		restoreBarriers.push_back(barrier);
+
+	if (source->GetBarrier(D3D12_RESOURCE_STATE_DEPTH_WRITE, barrier))
+		restoreBarriers.push_back(barrier);
+}
+
+void Common::Logic::SceneEntity::LightingSystem::RecordShadowMapFacesCopy(GPUResource* destination, GPUResource* source,
+	uint32_t faceMask, const std::vector<D3D12_RESOURCE_BARRIER>& copyBarriers,
+	const std::vector<D3D12_RESOURCE_BARRIER>& restoreBarriers, ID3D12GraphicsCommandList* commandList) const
+{
+	if (!copyBarriers.empty())
+		commandList->ResourceBarrier(static_cast<uint32_t>(copyBarriers.size()), copyBarriers.data());
+
+	D3D12_TEXTURE_COPY_LOCATION destinationLocation{};
+	destinationLocation.pResource = destination->GetResource();
+	destinationLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+
+	D3D12_TEXTURE_COPY_LOCATION sourceLocation{};
+	sourceLocation.pResource = source->GetResource();
+	sourceLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+
+	for (uint32_t faceIndex = 0u; faceIndex < CUBE_FACES_NUMBER; faceIndex++)
+	{
+		if ((faceMask & (1u << faceIndex)) == 0u)
+			continue;
 
-		auto isCube = lightDesc.type == LightType::POINT_LIGHT || lightDesc.type == LightType::AREA_LIGHT;
-		lightMatricesConstantBufferPtr += isCube ? 6u : 1u;
+		destinationLocation.SubresourceIndex = faceIndex;
+		sourceLocation.SubresourceIndex = faceIndex;
+
+		commandList->CopyTextureRegion(&destinationLocation, 0u, 0u, 0u, &sourceLocation, nullptr);
 	}
+
+	if (!restoreBarriers.empty())
+		commandList->ResourceBarrier(static_cast<uint32_t>(restoreBarriers.size()), restoreBarriers.data());
+}
+
+uint64_t Common::Logic::SceneEntity::LightingSystem::HashBounds(uint64_t hash, const AxisAlignedBox& bounds) const
+{
+	constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+	constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+	if (hash == 0u)
+		hash = FNV_OFFSET_BASIS;
+
+	auto bytes = reinterpret_cast<const uint8_t*>(&bounds);
+
+	for (size_t byteIndex = 0u; byteIndex < sizeof(AxisAlignedBox); byteIndex++)
+	{
+		hash ^= bytes[byteIndex];
+		hash *= FNV_PRIME;
+	}
+
+	return hash;
+}
+
+uint32_t Common::Logic::SceneEntity::LightingSystem::GetAllFacesMask(const ShadowCacheState& cache) const
+{
+	return (1u << cache.facesNumber) - 1u;
 }
 
 void Common::Logic::SceneEntity::LightingSystem::SetupViewProjectMatrices(LightDesc& desc)
@@ -357,39 +749,32 @@ void Common::Logic::SceneEntity::LightingSystem::SetupViewProjectMatrices(LightD
 	if (desc.type == LightType::POINT_LIGHT || desc.type == LightType::AREA_LIGHT)
 	{
 		desc.viewProjections[0u] = BuildViewProjectMatrix(desc.position, float3(1.0f, 0.0f, 0.0f),
-			float3(0.0f, 0.0f, 1.0f), CUBE_SHADOW_MAP_SIZE, false);
+			float3(0.0f, 0.0f, 1.0f));
 		desc.viewProjections[1u] = BuildViewProjectMatrix(desc.position, float3(-1.0f, 0.0f, 0.0f),
-			float3(0.0f, 0.0f, 1.0f), CUBE_SHADOW_MAP_SIZE, false);
+			float3(0.0f, 0.0f, 1.0f));
 		desc.viewProjections[2u] = BuildViewProjectMatrix(desc.position, float3(0.0f, 0.0f, 1.0f),
-			float3(0.0f, -1.0f, 0.0f), CUBE_SHADOW_MAP_SIZE, false);
+			float3(0.0f, -1.0f, 0.0f));
 		desc.viewProjections[3u] = BuildViewProjectMatrix(desc.position, float3(0.0f, 0.0f, -1.0f),
-			float3(0.0f, 1.0f, 0.0f), CUBE_SHADOW_MAP_SIZE, false);
+			float3(0.0f, 1.0f, 0.0f));
 		desc.viewProjections[4u] = BuildViewProjectMatrix(desc.position, float3(0.0f, 1.0f, 0.0f),
-			float3(0.0f, 0.0f, 1.0f), CUBE_SHADOW_MAP_SIZE, false);
+			float3(0.0f, 0.0f, 1.0f));
 		desc.viewProjections[5u] = BuildViewProjectMatrix(desc.position, float3(0.0f, -1.0f, 0.0f),
-			float3(0.0f, 0.0f, 1.0f), CUBE_SHADOW_MAP_SIZE, false);
-	}
-	else if (desc.type != LightType::AMBIENT_LIGHT)
-	{
-		*desc.viewProjections = BuildViewProjectMatrix(desc.position, desc.direction,
-			float3(0.0f, 0.0f, 1.0f), CUBE_SHADOW_MAP_SIZE, desc.type == LightType::DIRECTIONAL_LIGHT);
+			float3(0.0f, 0.0f, 1.0f));
 	}
+	else if (desc.type == LightType::SPOT_LIGHT)
+		desc.viewProjections[0u] = BuildViewProjectMatrix(desc.position, desc.direction, float3(0.0f, 0.0f, 1.0f));
 }
 
 float4x4 Common::Logic::SceneEntity::LightingSystem::BuildViewProjectMatrix(const float3& position,
-	const float3& direction, const float3& up, uint32_t size, bool isDirectional)
+	const float3& direction, const float3& up)
 {
 	auto positionN = XMLoadFloat3(&position);
 	auto directionN = XMLoadFloat3(&direction);
 	auto upN = XMLoadFloat3(&up);
 
 	auto view = XMMatrixLookToRH(positionN, directionN, upN);
-	float4x4 projection{};
-
-	if (isDirectional)
-		projection = XMMatrixOrthographicRH(static_cast<float>(size), static_cast<float>(size), SHADOW_MAP_Z_NEAR, SHADOW_MAP_Z_FAR);
-	else
-		projection = XMMatrixPerspectiveFovRH(static_cast<float>(std::numbers::pi * 0.5), 1.0f, SHADOW_MAP_Z_NEAR, SHADOW_MAP_Z_FAR);
+	float4x4 projection = XMMatrixPerspectiveFovRH(static_cast<float>(std::numbers::pi * 0.5), 1.0f,
+		SHADOW_MAP_Z_NEAR, SHADOW_MAP_Z_FAR);
 
 	return view * projection;
 }
@@ -2,10 +2,31 @@
 
 #include "../../../Includes.h"
 #include "../../../Graphics/DirectX12Renderer.h"
+#include "../../../Graphics/Assets/ShadowCascades.h"
 #include "LightDesc.h"
+#include "Camera.h"
 
 namespace Common::Logic::SceneEntity
 {
+	struct ShadowCacheStatistics
+	{
+	public:
+		uint32_t facesRendered;
+		uint32_t facesSkipped;
+		uint32_t castersCulled;
+	};
+
+	struct LightUpdateStatistics
+	{
+	public:
+		uint32_t updatesRequested;
+		uint32_t updatesCoalesced;
+		uint32_t bufferWrites;
+		uint32_t bufferWritesSkipped;
+		uint32_t matricesRebuilt;
+		uint32_t matricesSkipped;
+	};
+
 	class LightingSystem final
 	{
 	public:
@@ -19,6 +40,9 @@ namespace Common::Logic::SceneEntity
 
 		void UpdateSourceDesc(LightID id);
 		LightDesc& GetSourceDesc(LightID id);
+		void Update();
+		void UpdateCascades(const Camera* camera, const Graphics::Assets::AxisAlignedBox& casterBounds,
+			const Graphics::Assets::AxisAlignedBox& receiverBounds);
 		
 		uint32_t GetLightMatricesNumber() const;
 
@@ -26,45 +50,112 @@ namespace Common::Logic::SceneEntity
 		Graphics::Resources::ResourceID GetLightMatricesConstantBufferId();
 
 		void BeforeStartRenderShadowMaps(ID3D12GraphicsCommandList* commandList);
-		void StartRenderShadowMap(LightID id, ID3D12GraphicsCommandList* commandList);
+		uint32_t AddShadowCaster(LightID id, const Graphics::Assets::AxisAlignedBox& bounds, bool isStatic);
+		bool StartRenderShadowMap(LightID id, ID3D12GraphicsCommandList* commandList);
+		void SetShadowMapTarget(LightID id, ID3D12GraphicsCommandList* commandList);
+		void StartRenderDynamicShadowCasters(LightID id);
+		void CopyStaticShadowMapFaces(LightID id, ID3D12GraphicsCommandList* commandList) const;
 
 		void EndRenderShadowMaps(ID3D12GraphicsCommandList* commandList);
 		void EndUsingShadowMaps(ID3D12GraphicsCommandList* commandList);
 
+		const ShadowCacheStatistics& GetShadowCacheStatistics() const noexcept;
+		const LightUpdateStatistics& GetLightUpdateStatistics() const noexcept;
+
 		void Clear();
 
 		static constexpr uint32_t SHADOW_MAP_SIZE = 2048u;
 		static constexpr uint32_t CUBE_SHADOW_MAP_SIZE = 1024u;
+		static constexpr uint32_t CASCADE_SHADOW_MAP_SIZE = 1024u;
 
 		static constexpr float SHADOW_MAP_Z_NEAR = 0.01f;
 		static constexpr float SHADOW_MAP_Z_FAR = 1000.0f;
 
+		static constexpr uint32_t CUBE_FACES_NUMBER = 6u;
+
 	private:
 		LightingSystem() = delete;
 
+		struct ShadowCacheState
+		{
+		public:
+			std::array<Graphics::Assets::Frustum, CUBE_FACES_NUMBER> frustums;
+			std::array<float4x4, CUBE_FACES_NUMBER> viewProjections;
+			std::array<uint64_t, CUBE_FACES_NUMBER> staticCasterHashes;
+			std::array<uint64_t, CUBE_FACES_NUMBER> cachedStaticCasterHashes;
+
+			uint32_t facesNumber;
+			uint32_t validFaceMask;
+			uint32_t staticFaceMask;
+			uint32_t dynamicFaceMask;
+			uint32_t lastDynamicFaceMask;
+			uint32_t copyFaceMask;
+			bool isRendering;
+
+			std::vector<D3D12_RESOURCE_BARRIER> copyBarriers;
+			std::vector<D3D12_RESOURCE_BARRIER> restoreBarriers;
+
+			Graphics::Resources::ResourceID cacheId;
+			Graphics::Resources::GPUResource* cacheResource;
+		};
+
+		struct LightUpdateState
+		{
+		public:
+			float3 position;
+			float3 direction;
+			float3 color;
+			float intensity;
+			float radius;
+			float range;
+			float cosPhi2;
+			float cosTheta2;
+			bool isPending;
+		};
+
 		uint32_t GetSizeOfType(LightType type);
 		uint32_t CalculateLightBufferSize();
 
 		void SetLightBufferElement(LightDesc& desc);
+		void SaveUpdateState(const LightDesc& desc, LightUpdateState& state);
+		static bool IsChanged(const float3& value, const float3& lastValue);
 
-		Graphics::Resources::ResourceID CreateShadowMap(bool isCube);
+		Graphics::Resources::ResourceID CreateShadowMap(const LightDesc& desc);
+		uint32_t GetShadowFacesNumber(const LightDesc& desc) const;
+		bool IsCascaded(const LightDesc& desc) const;
 		void CreateConstantBuffers();
 
+		void GetShadowMapFacesCopyBarriers(Graphics::Resources::GPUResource* destination,
+			Graphics::Resources::GPUResource* source, std::vector<D3D12_RESOURCE_BARRIER>& copyBarriers,
+			std::vector<D3D12_RESOURCE_BARRIER>& restoreBarriers);
+		void RecordShadowMapFacesCopy(Graphics::Resources::GPUResource* destination, Graphics::Resources::GPUResource* source,
+			uint32_t faceMask, const std::vector<D3D12_RESOURCE_BARRIER>& copyBarriers,
+			const std::vector<D3D12_RESOURCE_BARRIER>& restoreBarriers, ID3D12GraphicsCommandList* commandList) const;
+		uint64_t HashBounds(uint64_t hash, const Graphics::Assets::AxisAlignedBox& bounds) const;
+		uint32_t GetAllFacesMask(const ShadowCacheState& cache) const;
+
 		void SetupViewProjectMatrices(LightDesc& desc);
-		float4x4 BuildViewProjectMatrix(const float3& position, const float3& direction,
-			const float3& up, uint32_t size, bool isDirectional);
+		float4x4 BuildViewProjectMatrix(const float3& position, const float3& direction, const float3& up);
 
 		D3D12_VIEWPORT viewport;
 		D3D12_VIEWPORT cubeViewport;
+		D3D12_VIEWPORT cascadeViewport;
 		D3D12_RECT scissorRectangle;
 		D3D12_RECT cubeScissorRectangle;
+		D3D12_RECT cascadeScissorRectangle;
 
 		bool isLightConstantBufferBuilded;
 		bool isLightParticleBufferBuilded;
 		uint32_t lightParticleNumber;
 		uint32_t lightMatricesNumber;
+		uint32_t lightUpdateRequestsNumber;
 
 		std::vector<LightDesc> lights;
+		std::vector<LightUpdateState> lightUpdateStates;
+		std::vector<LightID> pendingLights;
+		std::vector<ShadowCacheState> shadowCaches;
+		ShadowCacheStatistics shadowCacheStatistics;
+		LightUpdateStatistics lightUpdateStatistics;
 		std::vector<D3D12_RESOURCE_BARRIER> barriers;
 
 		Graphics::Resources::ResourceID lightConstantBufferId;
@@ -50,6 +50,16 @@ void Common::Logic::SceneEntity::MeshObject::Draw(ID3D12GraphicsCommandList* com
 	_mesh->Draw(commandList);
 }
 
+bool Common::Logic::SceneEntity::MeshObject::GetBounds(Graphics::Assets::AxisAlignedBox& bounds,
+	Graphics::Assets::BoundingSphere& boundingSphere) const
+{
+	const auto& meshDesc = _mesh->GetDesc();
+	bounds = meshDesc.bounds;
+	boundingSphere = meshDesc.boundingSphere;
+
+	return true;
+}
+
 void Common::Logic::SceneEntity::MeshObject::Release(Graphics::Resources::ResourceManager* resourceManager)
 {
 
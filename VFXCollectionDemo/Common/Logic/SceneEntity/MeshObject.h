@@ -24,6 +24,8 @@ namespace Common::Logic::SceneEntity
 		void DrawShadowsCube(ID3D12GraphicsCommandList* commandList, uint32_t lightMatrixStartIndex) override;
 		void Draw(ID3D12GraphicsCommandList* commandList) override;
 
+		bool GetBounds(Graphics::Assets::AxisAlignedBox& bounds, Graphics::Assets::BoundingSphere& boundingSphere) const override;
+
 		void Release(Graphics::Resources::ResourceManager* resourceManager) override;
 
 	private:
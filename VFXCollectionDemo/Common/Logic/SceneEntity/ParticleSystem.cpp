@@ -1,8 +1,10 @@
 #include "ParticleSystem.h"
 #include "../../../Graphics/Assets/ComputeObjectBuilder.h"
 #include "../../../Graphics/Assets/Loaders/HLSLLoader.h"
+#include "../../../Graphics/Assets/GeometryUtilities.h"
 #include "../../Utilities.h"
 
+using namespace DirectX;
 using namespace Graphics;
 using namespace Graphics::Resources;
 using namespace Graphics::Assets;
@@ -21,6 +23,7 @@ Common::Logic::SceneEntity::ParticleSystem::ParticleSystem(ID3D12GraphicsCommand
 	auto device = renderer->GetDevice();
 	auto resourceManager = renderer->GetResourceManager();
 
+	frameAllocator = renderer->GetFrameAllocator();
 	particleLightBufferGPUResource = resourceManager->GetResource<RWBuffer>(_desc.particleLightBufferId)->resource;
 
 	CreateConstantBuffers(device, commandList, resourceManager);
@@ -31,6 +34,8 @@ Common::Logic::SceneEntity::ParticleSystem::ParticleSystem(ID3D12GraphicsCommand
 	auto particleBufferResource = resourceManager->GetResource<RWBuffer>(particleBufferId);
 
 	_material->UpdateBuffer(0u, particleBufferResource->resourceGPUAddress);
+
+	*mutableConstantsBuffer = mutableConstants;
 }
 
 Common::Logic::SceneEntity::ParticleSystem::~ParticleSystem()
@@ -40,15 +45,17 @@ Common::Logic::SceneEntity::ParticleSystem::~ParticleSystem()
 
 void Common::Logic::SceneEntity::ParticleSystem::Update(float time, float deltaTime)
 {
-	mutableConstantsBuffer->emitterOrigin = *_desc.emitterOrigin;
-	mutableConstantsBuffer->time = time;
-	mutableConstantsBuffer->deltaTime = deltaTime;
+	mutableConstants.emitterOrigin = *_desc.emitterOrigin;
+	mutableConstants.time = time;
+	mutableConstants.deltaTime = deltaTime;
 
-	mutableConstantsBuffer->random0 = Utilities::Random4(randomEngine);
-	mutableConstantsBuffer->random1 = Utilities::Random4(randomEngine);
+	mutableConstants.random0 = Utilities::Random4(randomEngine);
+	mutableConstants.random1 = Utilities::Random4(randomEngine);
 
 	for (uint32_t forceIndex = 0u; forceIndex < _desc.forcesNumber; forceIndex++)
-		mutableConstantsBuffer->forces[forceIndex] = _desc.forces[forceIndex];
+		mutableConstants.forces[forceIndex] = _desc.forces[forceIndex];
+
+	UploadMutableConstants();
 }
 
 void Common::Logic::SceneEntity::ParticleSystem::OnCompute(ID3D12GraphicsCommandList* commandList)
@@ -56,17 +63,20 @@ void Common::Logic::SceneEntity::ParticleSystem::OnCompute(ID3D12GraphicsCommand
 	auto numGroups = static_cast<uint32_t>(std::lroundf(std::ceilf(_desc.maxParticlesNumber / static_cast<float>(THREADS_PER_GROUP))));
 
 	if (_desc.hasLightSources)
-		particleLightBufferGPUResource->Barrier(commandList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+		particleLightBufferGPUResource->Barrier(barrierBatch, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 
-	particleBufferGPUResource->EndBarrier(commandList);
+	particleBufferGPUResource->EndBarrier(barrierBatch);
+	barrierBatch.Flush(commandList);
 
 	particleSimulation->Set(commandList);
 	particleSimulation->Dispatch(commandList, numGroups, 1u, 1u);
 
-	particleBufferGPUResource->BeginBarrier(commandList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+	particleBufferGPUResource->BeginBarrier(barrierBatch, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
 	if (_desc.hasLightSources)
-		particleLightBufferGPUResource->Barrier(commandList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		particleLightBufferGPUResource->Barrier(barrierBatch, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+	barrierBatch.Flush(commandList);
 }
 
 void Common::Logic::SceneEntity::ParticleSystem::DrawDepthPrepass(ID3D12GraphicsCommandList* commandList)
@@ -88,13 +98,48 @@ void Common::Logic::SceneEntity::ParticleSystem::DrawShadowsCube(ID3D12GraphicsC
 
 void Common::Logic::SceneEntity::ParticleSystem::Draw(ID3D12GraphicsCommandList* commandList)
 {
-	particleBufferGPUResource->UAVBarrier(commandList);
-	particleBufferGPUResource->EndBarrier(commandList);
-	
+	particleBufferGPUResource->UAVBarrier(barrierBatch);
+	particleBufferGPUResource->EndBarrier(barrierBatch);
+	barrierBatch.Flush(commandList);
+
 	_material->Set(commandList);
 	_mesh->Draw(commandList, _desc.maxParticlesNumber);
 
-	particleBufferGPUResource->BeginBarrier(commandList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	particleBufferGPUResource->BeginBarrier(barrierBatch, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	barrierBatch.Flush(commandList);
+	barrierBatch.EndFrame();
+}
+
+bool Common::Logic::SceneEntity::ParticleSystem::GetBounds(AxisAlignedBox& bounds, BoundingSphere& boundingSphere) const
+{
+	auto maxSpeed = std::max(XMVectorGetX(XMVector3Length(XMLoadFloat3(&_desc.minParticleVelocity))),
+		XMVectorGetX(XMVector3Length(XMLoadFloat3(&_desc.maxParticleVelocity))));
+
+	auto maxSize = std::max(_desc.maxSize.x, _desc.maxSize.y);
+	auto extentV = XMLoadFloat3(&_desc.emitterRadius) + XMVectorAbs(XMLoadFloat3(&_desc.emitterRadiusOffset));
+	extentV += XMVectorReplicate(maxSpeed * _desc.maxLifeSec + maxSize);
+
+	auto originV = XMLoadFloat3(_desc.emitterOrigin);
+	auto minCornerV = originV - extentV;
+	auto maxCornerV = originV + extentV;
+
+	for (uint32_t forceIndex = 0u; forceIndex < _desc.forcesNumber; forceIndex++)
+	{
+		auto forcePositionV = XMLoadFloat3(&_desc.forces[forceIndex].position);
+		minCornerV = XMVectorMin(minCornerV, forcePositionV - XMVectorReplicate(maxSize));
+		maxCornerV = XMVectorMax(maxCornerV, forcePositionV + XMVectorReplicate(maxSize));
+	}
+
+	XMStoreFloat3(&bounds.minCorner, minCornerV);
+	XMStoreFloat3(&bounds.maxCorner, maxCornerV);
+	boundingSphere = GeometryUtilities::CalculateBoundingSphere(bounds);
+
+	return true;
+}
+
+const Graphics::Resources::BarrierBatch& Common::Logic::SceneEntity::ParticleSystem::GetBarrierBatch() const
+{
+	return barrierBatch;
 }
 
 void Common::Logic::SceneEntity::ParticleSystem::Release(Graphics::Resources::ResourceManager* resourceManager)
@@ -116,44 +161,59 @@ void Common::Logic::SceneEntity::ParticleSystem::CreateConstantBuffers(ID3D12Dev
 
 	auto mutableConstantsResource = resourceManager->GetResource<ConstantBuffer>(mutableConstantsId);
 	mutableConstantsBuffer = reinterpret_cast<MutableConstants*>(mutableConstantsResource->resourceCPUAddress);
-	mutableConstantsBuffer->emitterOrigin = *_desc.emitterOrigin;
-	mutableConstantsBuffer->emitterRadiusOffset = _desc.emitterRadiusOffset;
-	mutableConstantsBuffer->emitterRadius = _desc.emitterRadius;
-	mutableConstantsBuffer->minParticleVelocity = _desc.minParticleVelocity;
-	mutableConstantsBuffer->particleDamping = _desc.particleDamping;
-	mutableConstantsBuffer->maxParticleVelocity = _desc.maxParticleVelocity;
-	mutableConstantsBuffer->particleTurbulence = std::clamp(_desc.particleTurbulence, 0.0f, 1.0f);
-	mutableConstantsBuffer->minRotation = _desc.minRotation;
-	mutableConstantsBuffer->maxRotation = _desc.maxRotation;
-	mutableConstantsBuffer->minRotationSpeed = _desc.minRotationSpeed;
-	mutableConstantsBuffer->maxRotationSpeed = _desc.maxRotationSpeed;
-	mutableConstantsBuffer->minSize = _desc.minSize;
-	mutableConstantsBuffer->maxSize = _desc.maxSize;
-	mutableConstantsBuffer->minLifeSec = _desc.minLifeSec;
-	mutableConstantsBuffer->maxLifeSec = _desc.maxLifeSec;
-	mutableConstantsBuffer->time = 0.0f;
-	mutableConstantsBuffer->deltaTime = 0.0f;
-	mutableConstantsBuffer->averageParticleEmit = _desc.averageParticleEmitPerSecond;
-	mutableConstantsBuffer->maxParticlesNumber = _desc.maxParticlesNumber;
-	mutableConstantsBuffer->perlinNoiseSize = _desc.perlinNoiseSize;
-	mutableConstantsBuffer->maxLightIntensity = _desc.maxLightIntensity;
-	mutableConstantsBuffer->lightRange = _desc.lightRange;
-	mutableConstantsBuffer->padding = {};
-
-	mutableConstantsBuffer->random0 = Utilities::Random4(randomEngine);
-	mutableConstantsBuffer->random1 = Utilities::Random4(randomEngine);
+	mutableConstantsAddress = mutableConstantsResource->resourceGPUAddress;
+
+	mutableConstants = {};
+	mutableConstants.emitterOrigin = *_desc.emitterOrigin;
+	mutableConstants.emitterRadiusOffset = _desc.emitterRadiusOffset;
+	mutableConstants.emitterRadius = _desc.emitterRadius;
+	mutableConstants.minParticleVelocity = _desc.minParticleVelocity;
+	mutableConstants.particleDamping = _desc.particleDamping;
+	mutableConstants.maxParticleVelocity = _desc.maxParticleVelocity;
+	mutableConstants.particleTurbulence = std::clamp(_desc.particleTurbulence, 0.0f, 1.0f);
+	mutableConstants.minRotation = _desc.minRotation;
+	mutableConstants.maxRotation = _desc.maxRotation;
+	mutableConstants.minRotationSpeed = _desc.minRotationSpeed;
+	mutableConstants.maxRotationSpeed = _desc.maxRotationSpeed;
+	mutableConstants.minSize = _desc.minSize;
+	mutableConstants.maxSize = _desc.maxSize;
+	mutableConstants.minLifeSec = _desc.minLifeSec;
+	mutableConstants.maxLifeSec = _desc.maxLifeSec;
+	mutableConstants.time = 0.0f;
+	mutableConstants.deltaTime = 0.0f;
+	mutableConstants.averageParticleEmit = _desc.averageParticleEmitPerSecond;
+	mutableConstants.maxParticlesNumber = _desc.maxParticlesNumber;
+	mutableConstants.perlinNoiseSize = _desc.perlinNoiseSize;
+	mutableConstants.maxLightIntensity = _desc.maxLightIntensity;
+	mutableConstants.lightRange = _desc.lightRange;
+	mutableConstants.padding = {};
+
+	mutableConstants.random0 = Utilities::Random4(randomEngine);
+	mutableConstants.random1 = Utilities::Random4(randomEngine);
 
 	for (uint32_t attractorIndex = 0u; attractorIndex < MAX_FORCES_NUMBER; attractorIndex++)
 		if (attractorIndex < _desc.forcesNumber)
-			mutableConstantsBuffer->forces[attractorIndex] = _desc.forces[attractorIndex];
+			mutableConstants.forces[attractorIndex] = _desc.forces[attractorIndex];
 		else
 		{
-			auto& force = mutableConstantsBuffer->forces[attractorIndex];
+			auto& force = mutableConstants.forces[attractorIndex];
 			force = {};
 			force.nAccelerationCoeff = 1.0f;
 		}
 }
 
+void Common::Logic::SceneEntity::ParticleSystem::UploadMutableConstants()
+{
+	FrameAllocation constantsAllocation{};
+
+	if (!frameAllocator->AllocateConstants(mutableConstants, constantsAllocation))
+		return;
+
+	auto constantsAddress = constantsAllocation.gpuAddress;
+
+	particleSimulation->UpdateConstantBuffer(0u, constantsAddress);
+}
+
 void Common::Logic::SceneEntity::ParticleSystem::CreateBuffers(ID3D12Device* device,
 	ID3D12GraphicsCommandList* commandList, Graphics::Resources::ResourceManager* resourceManager)
 {
@@ -99,6 +99,10 @@ namespace Common::Logic::SceneEntity
 		void DrawShadowsCube(ID3D12GraphicsCommandList* commandList, uint32_t lightMatrixStartIndex) override;
 		void Draw(ID3D12GraphicsCommandList* commandList) override;
 
+		bool GetBounds(Graphics::Assets::AxisAlignedBox& bounds, Graphics::Assets::BoundingSphere& boundingSphere) const override;
+
+		const Graphics::Resources::BarrierBatch& GetBarrierBatch() const;
+
 		void Release(Graphics::Resources::ResourceManager* resourceManager) override;
 
 		static constexpr uint32_t MAX_FORCES_NUMBER = 4u;
@@ -109,6 +113,8 @@ namespace Common::Logic::SceneEntity
 		void CreateConstantBuffers(ID3D12Device* device, ID3D12GraphicsCommandList* commandList,
 			Graphics::Resources::ResourceManager* resourceManager);
 
+		void UploadMutableConstants();
+
 		void CreateBuffers(ID3D12Device* device, ID3D12GraphicsCommandList* commandList,
 			Graphics::Resources::ResourceManager* resourceManager);
 
@@ -167,13 +173,19 @@ namespace Common::Logic::SceneEntity
 
 		static constexpr uint32_t THREADS_PER_GROUP = 64u;
 
+		MutableConstants mutableConstants;
 		MutableConstants* mutableConstantsBuffer;
+		D3D12_GPU_VIRTUAL_ADDRESS mutableConstantsAddress;
+
+		Graphics::FrameAllocator* frameAllocator;
 
 		ParticleSystemDesc _desc;
 
 		Graphics::Resources::GPUResource* particleBufferGPUResource;
 		Graphics::Resources::GPUResource* particleLightBufferGPUResource;
 
+		Graphics::Resources::BarrierBatch barrierBatch;
+
 		Graphics::Resources::ResourceID mutableConstantsId;
 		Graphics::Resources::ResourceID particleBufferId;
 
@@ -13,8 +13,11 @@ using namespace DirectX::PackedVector;
 Common::Logic::SceneEntity::PostProcessManager::PostProcessManager(ID3D12GraphicsCommandList* commandList,
 	Graphics::DirectX12Renderer* renderer, Camera* camera, LightingSystem* lightingSystem,
 	const std::vector<DxcDefine>& lightDefines, const RenderingScheme& renderingScheme)
-	: _camera(camera), _renderingScheme(renderingScheme), viewport{}, scissorRectangle{}
+	: _camera(camera), frameDeltaTime(0.0f), _renderingScheme(renderingScheme), viewport{}, scissorRectangle{},
+	postProcessGraph(nullptr), hdrGraph(nullptr)
 {
+	firstAliasingGroup = 1u + managersCounter.fetch_add(1u) * ALIASING_GROUPS_PER_MANAGER;
+
 	auto width = renderer->GetWidth();
 	auto height = renderer->GetHeight();
 
@@ -81,6 +84,9 @@ Common::Logic::SceneEntity::PostProcessManager::PostProcessManager(ID3D12Graphic
 
 	LoadShaders(device, resourceManager, lightDefines);
 
+	CreatePostProcessGraph(device, commandList, renderer);
+	CreateHDRGraph();
+
 	CreateMaterials(device, resourceManager, renderer);
 	CreateComputeObjects(device, resourceManager, lightingSystem);
 
@@ -109,8 +115,6 @@ Common::Logic::SceneEntity::PostProcessManager::PostProcessManager(ID3D12Graphic
 
 		_fsr = new FSR(device, fsrDesc);
 	}
-
-	barriers.reserve(MAX_SIMULTANEOUS_BARRIER_NUMBER);
 }
 
 Common::Logic::SceneEntity::PostProcessManager::~PostProcessManager()
@@ -120,6 +124,12 @@ Common::Logic::SceneEntity::PostProcessManager::~PostProcessManager()
 
 void Common::Logic::SceneEntity::PostProcessManager::Release(ResourceManager* resourceManager)
 {
+	postProcessGraph->Release(resourceManager);
+	hdrGraph->Release(resourceManager);
+
+	delete postProcessGraph;
+	delete hdrGraph;
+
 	delete toneMappingMaterial;
 	
 	delete luminanceComputeObject;
@@ -135,11 +145,7 @@ void Common::Logic::SceneEntity::PostProcessManager::Release(ResourceManager* re
 		delete _fsr;
 		delete copyAlphaMaterial;
 
-		if (_renderingScheme.enableVolumetricFog)
-			resourceManager->DeleteResource<RWTexture>(temporaryRWTexture1Id);
-
 		resourceManager->DeleteResource<Shader>(copyAlphaPSId);
-		resourceManager->DeleteResource<RenderTarget>(sceneAlphaTargetId);
 	}
 
 	resourceManager->DeleteResource<RenderTarget>(sceneColorTargetId);
@@ -206,9 +212,6 @@ void Common::Logic::SceneEntity::PostProcessManager::OnResize(Graphics::DirectX1
 		scissorRectangle.bottom = static_cast<uint32_t>(viewport.Height);
 		targetsWidth = scissorRectangle.right;
 		targetsHeight = scissorRectangle.bottom;
-
-		if (_renderingScheme.enableVolumetricFog)
-			resourceManager->DeleteResource<RWTexture>(temporaryRWTexture1Id);
 	}
 
 	if (_renderingScheme.enableVolumetricFog)
@@ -222,9 +225,6 @@ void Common::Logic::SceneEntity::PostProcessManager::OnResize(Graphics::DirectX1
 	resourceManager->DeleteResource<RenderTarget>(sceneColorTargetId);
 	resourceManager->DeleteResource<DepthStencilTarget>(sceneDepthTargetId);
 
-	if (_renderingScheme.enableFSR)
-		resourceManager->DeleteResource<RenderTarget>(sceneAlphaTargetId);
-
 	if (_renderingScheme.enableFSR || _renderingScheme.enableMotionBlur)
 		resourceManager->DeleteResource<RenderTarget>(sceneMotionTargetId);
 
@@ -235,8 +235,10 @@ void Common::Logic::SceneEntity::PostProcessManager::OnResize(Graphics::DirectX1
 	auto commandList = renderer->StartCreatingResources();
 	CreateTargets(renderer->GetDevice(), commandList, resourceManager, targetsWidth, targetsHeight);
 	CreateBuffers(renderer->GetDevice(), commandList, resourceManager, width, height);
+	CreatePostProcessGraph(renderer->GetDevice(), commandList, renderer);
 	renderer->EndCreatingResources();
 
+	CreateHDRGraph();
 	UpdateObjects(renderer);
 }
 
@@ -254,50 +256,39 @@ void Common::Logic::SceneEntity::PostProcessManager::SetDepthPrepass(ID3D12Graph
 	if (!_renderingScheme.enableDepthPrepass)
 		return;
 
-	if (_renderingScheme.enableFSR || _renderingScheme.enableVolumetricFog)
-		sceneDepthTargetGPUResource->EndBarrier(commandList);
-
-	commandList->RSSetViewports(1u, &viewport);
-	commandList->RSSetScissorRects(1u, &scissorRectangle);
-
 	commandList->ClearDepthStencilView(sceneDepthTargetDescriptor, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0u, 0u, nullptr);
-	commandList->OMSetRenderTargets(0u, nullptr, true, &sceneDepthTargetDescriptor);
+
+	BindDepthPrepass(commandList);
 }
 
 void Common::Logic::SceneEntity::PostProcessManager::SetGBuffer(ID3D12GraphicsCommandList* commandList)
 {
-	if (!_renderingScheme.enableDepthPrepass)
-	{
-		commandList->RSSetViewports(1u, &viewport);
-		commandList->RSSetScissorRects(1u, &scissorRectangle);
-	}
-
-	D3D12_RESOURCE_BARRIER barrier{};
-	barriers.clear();
+	commandList->ClearRenderTargetView(sceneColorTargetDescriptor, CLEAR_COLOR, 0u, nullptr);
 
-	if (sceneColorTargetGPUResource->GetEndBarrier(barrier))
-		barriers.push_back(barrier);
+	if (!_renderingScheme.enableDepthPrepass)
+		commandList->ClearDepthStencilView(sceneDepthTargetDescriptor, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0u, 0u, nullptr);
 
-	if ((_renderingScheme.enableFSR || _renderingScheme.enableVolumetricFog) &&
-		!_renderingScheme.enableDepthPrepass && sceneDepthTargetGPUResource->GetEndBarrier(barrier))
-		barriers.push_back(barrier);
+	if (_renderingScheme.enableFSR)
+		commandList->ClearRenderTargetView(sceneMotionTargetDescriptor, CLEAR_COLOR, 0u, nullptr);
 
-	if ((_renderingScheme.enableFSR || _renderingScheme.enableMotionBlur) &&
-		sceneMotionTargetGPUResource->GetEndBarrier(barrier))
-		barriers.push_back(barrier);
+	BindGBuffer(commandList);
+}
 
-	if (!barriers.empty())
-		commandList->ResourceBarrier(static_cast<uint32_t>(barriers.size()), barriers.data());
+void Common::Logic::SceneEntity::PostProcessManager::BindDepthPrepass(ID3D12GraphicsCommandList* commandList)
+{
+	commandList->RSSetViewports(1u, &viewport);
+	commandList->RSSetScissorRects(1u, &scissorRectangle);
 
-	commandList->ClearRenderTargetView(sceneColorTargetDescriptor, CLEAR_COLOR, 0u, nullptr);
+	commandList->OMSetRenderTargets(0u, nullptr, true, &sceneDepthTargetDescriptor);
+}
 
-	if (!_renderingScheme.enableDepthPrepass)
-		commandList->ClearDepthStencilView(sceneDepthTargetDescriptor, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0u, 0u, nullptr);
+void Common::Logic::SceneEntity::PostProcessManager::BindGBuffer(ID3D12GraphicsCommandList* commandList)
+{
+	commandList->RSSetViewports(1u, &viewport);
+	commandList->RSSetScissorRects(1u, &scissorRectangle);
 
 	if (_renderingScheme.enableFSR)
 	{
-		commandList->ClearRenderTargetView(sceneMotionTargetDescriptor, CLEAR_COLOR, 0u, nullptr);
-
 		D3D12_CPU_DESCRIPTOR_HANDLE mrt[2u]
 		{
 			sceneColorTargetDescriptor,
@@ -315,12 +306,6 @@ void Common::Logic::SceneEntity::PostProcessManager::SetMotionBuffer(ID3D12Graph
 	if (!_renderingScheme.enableFSR && !_renderingScheme.enableMotionBlur)
 		return;
 
-	D3D12_RESOURCE_BARRIER barrier{};
-	barriers.clear();
-
-	if (!barriers.empty())
-		commandList->ResourceBarrier(static_cast<uint32_t>(barriers.size()), barriers.data());
-
 	if (!_renderingScheme.enableFSR)
 		commandList->ClearRenderTargetView(sceneMotionTargetDescriptor, CLEAR_COLOR, 0u, nullptr);
 
@@ -330,162 +315,39 @@ void Common::Logic::SceneEntity::PostProcessManager::SetMotionBuffer(ID3D12Graph
 void Common::Logic::SceneEntity::PostProcessManager::Render(ID3D12GraphicsCommandList* commandList,
 	Graphics::DirectX12Renderer* renderer, float deltaTime)
 {
-	D3D12_RESOURCE_BARRIER barrier{};
+	frameDeltaTime = deltaTime;
 
-	if (_renderingScheme.enableVolumetricFog)
-	{
-		if (_renderingScheme.enableFSR)
-			temporaryRWTexture1GPUResource->EndBarrier(commandList);
-
-		SetVolumetricFog(commandList);
-	}
-
-	if (_renderingScheme.enableFSR)
-	{
-		barriers.clear();
-
-		if (sceneMotionTargetGPUResource->GetBeginBarrier(D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, barrier))
-			barriers.push_back(barrier);
-		
-		if (_renderingScheme.enableVolumetricFog)
-		{
-			temporaryRWTexture1GPUResource->GetUAVBarrier(barrier);
-			barriers.push_back(barrier);
-
-			if (temporaryRWTexture1GPUResource->GetBarrier(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, barrier))
-				barriers.push_back(barrier);
-		}
-		else
-		{
-			if (sceneColorTargetGPUResource->GetBarrier(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, barrier))
-				barriers.push_back(barrier);
-		}
+	auto branchesNumber = postProcessGraph->GetBranchesNumber();
 
-		if (sceneAlphaTargetGPUResource->GetEndBarrier(barrier))
-			barriers.push_back(barrier);
-
-		if (!barriers.empty())
-			commandList->ResourceBarrier(static_cast<uint32_t>(barriers.size()), barriers.data());
-
-		commandList->OMSetRenderTargets(1u, &sceneAlphaTargetDescriptor, true, nullptr);
-
-		copyAlphaMaterial->Set(commandList);
-		quadMesh->Draw(commandList);
-	}
-
-	barriers.clear();
-
-	if (_renderingScheme.enableFSR)
-	{
-		if (sceneMotionTargetGPUResource->GetEndBarrier(barrier))
-			barriers.push_back(barrier);
-	}
-	else
-	{
-		if (_renderingScheme.enableMotionBlur &&
-			sceneMotionTargetGPUResource->GetBarrier(D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, barrier))
-			barriers.push_back(barrier);
-	}
-
-	if (_renderingScheme.enableFSR && _renderingScheme.enableVolumetricFog)
-	{
-		temporaryRWTexture1GPUResource->GetUAVBarrier(barrier);
-		barriers.push_back(barrier);
-
-		if (temporaryRWTexture1GPUResource->GetBarrier(D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, barrier))
-			barriers.push_back(barrier);
-	}
-	else
-	{
-		if (sceneColorTargetGPUResource->GetBarrier(D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, barrier))
-			barriers.push_back(barrier);
-	}
-
-	if (temporaryRWTexture0GPUResource->GetEndBarrier(barrier))
-		barriers.push_back(barrier);
-
-	if ((_renderingScheme.enableFSR || _renderingScheme.enableVolumetricFog) &&
-		sceneDepthTargetGPUResource->GetBarrier(D3D12_RESOURCE_STATE_DEPTH_READ |
-		D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, barrier))
-		barriers.push_back(barrier);
-	
-	if (_renderingScheme.enableFSR &&
-		sceneAlphaTargetGPUResource->GetBarrier(D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, barrier))
-		barriers.push_back(barrier);
-
-	if (!barriers.empty())
-		commandList->ResourceBarrier(static_cast<uint32_t>(barriers.size()), barriers.data());
-
-	if (_renderingScheme.enableFSR)
-	{
-		SetFSR(commandList, deltaTime);
-
-		renderer->ResetDescriptorHeaps(commandList);
-
-		barriers.clear();
+	if (branchesNumber == 0u)
+		return;
 
-		temporaryRWTexture0GPUResource->GetUAVBarrier(barrier);
-		barriers.push_back(barrier);
+	postProcessGraph->Execute(0u, commandList);
 
-		if (_renderingScheme.enableVolumetricFog &&
-			temporaryRWTexture1GPUResource->GetBeginBarrier(D3D12_RESOURCE_STATE_UNORDERED_ACCESS, barrier))
-			barriers.push_back(barrier);
+	std::vector<Graphics::CommandRecordFunction> branchRecordFunctions;
 
-		commandList->ResourceBarrier(static_cast<uint32_t>(barriers.size()), barriers.data());
-	}
-	
-	if (_renderingScheme.enableMotionBlur)
-		SetMotionBlur(commandList);
+	for (uint32_t branchIndex = 1u; branchIndex < branchesNumber; branchIndex++)
+		branchRecordFunctions.push_back([this, branchIndex](ID3D12GraphicsCommandList* branchCommandList)
+			{
+				postProcessGraph->Execute(branchIndex, branchCommandList);
+			});
 
-	SetHDR(commandList);
+	renderer->RecordParallel(commandList, branchRecordFunctions);
 }
 
 void Common::Logic::SceneEntity::PostProcessManager::RenderToBackBuffer(ID3D12GraphicsCommandList* commandList)
 {
-	D3D12_RESOURCE_BARRIER barrier{};
-	barriers.clear();
-
-	luminanceBufferGPUResource->GetUAVBarrier(barrier);
-	barriers.push_back(barrier);
-	bloomBufferGPUResource->GetUAVBarrier(barrier);
-	barriers.push_back(barrier);
-
-	if (temporaryRWTexture0GPUResource->GetEndBarrier(barrier))
-		barriers.push_back(barrier);
-	if (luminanceBufferGPUResource->GetEndBarrier(barrier))
-		barriers.push_back(barrier);
-	if (bloomBufferGPUResource->GetEndBarrier(barrier))
-		barriers.push_back(barrier);
-
-	if (_renderingScheme.enableFSR)
-	{
-		commandList->RSSetViewports(1u, &afterFSRViewport);
-		commandList->RSSetScissorRects(1u, &afterFSRScissorRectangle);
-	}
-
-	commandList->ResourceBarrier(static_cast<uint32_t>(barriers.size()), barriers.data());
-
-	toneMappingMaterial->Set(commandList);
-	toneMappingMaterial->SetRootConstants(commandList, 0u, 12u, &toneMappingConstants);
-	quadMesh->DrawOnly(commandList);
-
-	barriers.clear();
-
-	if (sceneColorTargetGPUResource->GetBeginBarrier(D3D12_RESOURCE_STATE_RENDER_TARGET, barrier))
-		barriers.push_back(barrier);
-
-	if ((_renderingScheme.enableFSR || _renderingScheme.enableMotionBlur) &&
-		sceneMotionTargetGPUResource->GetBeginBarrier(D3D12_RESOURCE_STATE_RENDER_TARGET, barrier))
-		barriers.push_back(barrier);
+	hdrGraph->Execute(0u, commandList);
+}
 
-	if (temporaryRWTexture0GPUResource->GetBeginBarrier(D3D12_RESOURCE_STATE_UNORDERED_ACCESS, barrier))
-		barriers.push_back(barrier);
-	if (luminanceBufferGPUResource->GetBeginBarrier(D3D12_RESOURCE_STATE_UNORDERED_ACCESS, barrier))
-		barriers.push_back(barrier);
-	if (bloomBufferGPUResource->GetBeginBarrier(D3D12_RESOURCE_STATE_UNORDERED_ACCESS, barrier))
-		barriers.push_back(barrier);
+const Graphics::RenderGraph* Common::Logic::SceneEntity::PostProcessManager::GetPostProcessGraph() const
+{
+	return postProcessGraph;
+}
 
-	commandList->ResourceBarrier(static_cast<uint32_t>(barriers.size()), barriers.data());
+const Graphics::RenderGraph* Common::Logic::SceneEntity::PostProcessManager::GetHDRGraph() const
+{
+	return hdrGraph;
 }
 
 const Graphics::Assets::Mesh* Common::Logic::SceneEntity::PostProcessManager::GetFullscreenQuadMesh() const
@@ -569,27 +431,6 @@ void Common::Logic::SceneEntity::PostProcessManager::CreateTargets(ID3D12Device*
 	sceneColorTargetId = resourceManager->CreateTextureResource(device, commandList,
 		TextureResourceType::RENDER_TARGET, sceneTargetDesc);
 
-	if (_renderingScheme.enableFSR)
-	{
-		if (_renderingScheme.enableVolumetricFog)
-		{
-			temporaryRWTexture1Id = resourceManager->CreateTextureResource(device, commandList,
-				TextureResourceType::RW_TEXTURE, sceneTargetDesc);
-
-			auto temporaryRWTextureResource = resourceManager->GetResource<RWTexture>(temporaryRWTexture1Id);
-			temporaryRWTexture1GPUResource = temporaryRWTextureResource->resource;
-		}
-
-		sceneTargetDesc.format = DXGI_FORMAT_R8_UNORM;
-
-		sceneAlphaTargetId = resourceManager->CreateTextureResource(device, commandList,
-			TextureResourceType::RENDER_TARGET, sceneTargetDesc);
-
-		auto sceneAlphaTargetResource = resourceManager->GetResource<RenderTarget>(sceneAlphaTargetId);
-		sceneAlphaTargetGPUResource = sceneAlphaTargetResource->resource;
-		sceneAlphaTargetDescriptor = sceneAlphaTargetResource->rtvDescriptor.cpuDescriptor;
-	}
-
 	if (_renderingScheme.enableFSR || _renderingScheme.enableMotionBlur)
 	{
 		sceneTargetDesc.format = DXGI_FORMAT_R16G16_FLOAT;
@@ -651,6 +492,7 @@ void Common::Logic::SceneEntity::PostProcessManager::CreateBuffers(ID3D12Device*
 
 	auto temporaryRWTextureResource = resourceManager->GetResource<RWTexture>(temporaryRWTexture0Id);
 	temporaryRWTexture0GPUResource = temporaryRWTextureResource->resource;
+	temporaryRWTexture0GPUResource->Barrier(commandList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 
 	auto luminanceBufferResource = resourceManager->GetResource<RWBuffer>(luminanceBufferId);
 	auto bloomBufferResource = resourceManager->GetResource<RWBuffer>(bloomBufferId);
@@ -1033,6 +875,200 @@ void Common::Logic::SceneEntity::PostProcessManager::UpdateObjects(Graphics::Dir
 	}
 }
 
+void Common::Logic::SceneEntity::PostProcessManager::CreatePostProcessGraph(ID3D12Device* device,
+	ID3D12GraphicsCommandList* commandList, Graphics::DirectX12Renderer* renderer)
+{
+	auto resourceManager = renderer->GetResourceManager();
+
+	if (postProcessGraph != nullptr)
+	{
+		postProcessGraph->Release(resourceManager);
+		delete postProcessGraph;
+	}
+
+	postProcessGraph = new Graphics::RenderGraph(firstAliasingGroup);
+
+	auto sceneColorId = postProcessGraph->ImportResource("SceneColor", sceneColorTargetGPUResource,
+		D3D12_RESOURCE_STATE_RENDER_TARGET);
+	auto sceneDepthId = postProcessGraph->ImportResource("SceneDepth", sceneDepthTargetGPUResource,
+		D3D12_RESOURCE_STATE_DEPTH_WRITE);
+	auto hdrColorId = postProcessGraph->ImportResource("HDRColor", temporaryRWTexture0GPUResource,
+		D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+	auto sceneMotionId = Graphics::RenderGraph::INVALID_INDEX;
+
+	if (_renderingScheme.enableFSR || _renderingScheme.enableMotionBlur)
+		sceneMotionId = postProcessGraph->ImportResource("SceneMotion", sceneMotionTargetGPUResource,
+			D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+	TextureDesc transientDesc{};
+	transientDesc.width = static_cast<uint32_t>(scissorRectangle.right);
+	transientDesc.height = static_cast<uint32_t>(scissorRectangle.bottom);
+	transientDesc.depth = 1u;
+	transientDesc.depthBit = 32u;
+	transientDesc.mipLevels = 1u;
+	transientDesc.dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+	transientDesc.srvDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+
+	auto transientPixelsNumber = static_cast<uint64_t>(transientDesc.width) * transientDesc.height;
+
+	auto fogColorId = Graphics::RenderGraph::INVALID_INDEX;
+	auto reactiveMaskId = Graphics::RenderGraph::INVALID_INDEX;
+	auto fsrColorId = sceneColorId;
+
+	if (_renderingScheme.enableFSR)
+	{
+		if (_renderingScheme.enableVolumetricFog)
+		{
+			transientDesc.format = DXGI_FORMAT_R16G16B16A16_FLOAT;
+
+			fogColorId = postProcessGraph->CreateTransientResource("FogColor",
+				{ TextureResourceType::RW_TEXTURE, transientDesc, transientPixelsNumber * 4u * sizeof(uint16_t) });
+
+			fsrColorId = fogColorId;
+		}
+
+		transientDesc.format = DXGI_FORMAT_R8_UNORM;
+
+		reactiveMaskId = postProcessGraph->CreateTransientResource("ReactiveMask",
+			{ TextureResourceType::RENDER_TARGET, transientDesc, transientPixelsNumber });
+	}
+
+	if (_renderingScheme.enableVolumetricFog)
+	{
+		auto volumetricFogPass = postProcessGraph->AddPass("VolumetricFog", [this](ID3D12GraphicsCommandList* passCommandList)
+			{
+				SetVolumetricFog(passCommandList);
+			});
+
+		postProcessGraph->Read(volumetricFogPass, sceneDepthId, D3D12_RESOURCE_STATE_DEPTH_READ |
+			D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		postProcessGraph->Read(volumetricFogPass, sceneColorId, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		postProcessGraph->Write(volumetricFogPass, _renderingScheme.enableFSR ? fogColorId : hdrColorId,
+			D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	}
+
+	if (_renderingScheme.enableFSR)
+	{
+		auto copyAlphaPass = postProcessGraph->AddPass("CopyAlpha", [this](ID3D12GraphicsCommandList* passCommandList)
+			{
+				passCommandList->RSSetViewports(1u, &viewport);
+				passCommandList->RSSetScissorRects(1u, &scissorRectangle);
+				passCommandList->OMSetRenderTargets(1u, &sceneAlphaTargetDescriptor, true, nullptr);
+
+				copyAlphaMaterial->Set(passCommandList);
+				quadMesh->Draw(passCommandList);
+			});
+
+		postProcessGraph->Read(copyAlphaPass, fsrColorId, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		postProcessGraph->Write(copyAlphaPass, reactiveMaskId, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+		auto fsrPass = postProcessGraph->AddPass("FSR", [this, renderer](ID3D12GraphicsCommandList* passCommandList)
+			{
+				SetFSR(passCommandList, frameDeltaTime);
+
+				renderer->ResetDescriptorHeaps(passCommandList);
+			});
+
+		postProcessGraph->Read(fsrPass, fsrColorId, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		postProcessGraph->Read(fsrPass, sceneDepthId, D3D12_RESOURCE_STATE_DEPTH_READ |
+			D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		postProcessGraph->Read(fsrPass, sceneMotionId, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		postProcessGraph->Read(fsrPass, reactiveMaskId, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		postProcessGraph->Write(fsrPass, hdrColorId, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	}
+
+	if (_renderingScheme.enableMotionBlur)
+	{
+		auto motionBlurPass = postProcessGraph->AddPass("MotionBlur", [this](ID3D12GraphicsCommandList* passCommandList)
+			{
+				SetMotionBlur(passCommandList);
+			});
+
+		postProcessGraph->Read(motionBlurPass, sceneMotionId, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+
+		if (_renderingScheme.enableFSR || _renderingScheme.enableVolumetricFog)
+			postProcessGraph->Read(motionBlurPass, hdrColorId, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+		else
+			postProcessGraph->Read(motionBlurPass, sceneColorId, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+
+		postProcessGraph->Write(motionBlurPass, hdrColorId, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	}
+
+	postProcessGraph->Compile();
+	postProcessGraph->Realize(device, commandList, resourceManager);
+
+	if (_renderingScheme.enableFSR)
+	{
+		if (_renderingScheme.enableVolumetricFog)
+		{
+			temporaryRWTexture1Id = postProcessGraph->GetResourceID(fogColorId);
+			temporaryRWTexture1GPUResource = postProcessGraph->GetGPUResource(fogColorId);
+		}
+
+		sceneAlphaTargetId = postProcessGraph->GetResourceID(reactiveMaskId);
+		sceneAlphaTargetGPUResource = postProcessGraph->GetGPUResource(reactiveMaskId);
+
+		auto sceneAlphaTargetResource = resourceManager->GetResource<RenderTarget>(sceneAlphaTargetId);
+		sceneAlphaTargetDescriptor = sceneAlphaTargetResource->rtvDescriptor.cpuDescriptor;
+	}
+}
+
+void Common::Logic::SceneEntity::PostProcessManager::CreateHDRGraph()
+{
+	delete hdrGraph;
+
+	hdrGraph = new Graphics::RenderGraph(0u);
+
+	Graphics::RenderGraphResourceID hdrColorId;
+
+	if (_renderingScheme.enableFSR ||
+		_renderingScheme.enableMotionBlur ||
+		_renderingScheme.enableVolumetricFog)
+		hdrColorId = hdrGraph->ImportResource("HDRColor", temporaryRWTexture0GPUResource, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	else
+		hdrColorId = hdrGraph->ImportResource("HDRColor", sceneColorTargetGPUResource, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+	auto luminanceId = hdrGraph->ImportResource("Luminance", luminanceBufferGPUResource, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	auto bloomId = hdrGraph->ImportResource("Bloom", bloomBufferGPUResource, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+	auto luminancePass = hdrGraph->AddPass("Luminance", [this](ID3D12GraphicsCommandList* commandList)
+		{
+			SetLuminance(commandList);
+		});
+
+	hdrGraph->Read(luminancePass, hdrColorId, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+	hdrGraph->Write(luminancePass, luminanceId, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+	auto bloomHorizontalPass = hdrGraph->AddPass("BloomHorizontal", [this](ID3D12GraphicsCommandList* commandList)
+		{
+			SetBloomHorizontal(commandList);
+		});
+
+	hdrGraph->Read(bloomHorizontalPass, hdrColorId, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+	hdrGraph->Read(bloomHorizontalPass, luminanceId, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+	hdrGraph->Write(bloomHorizontalPass, bloomId, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+	auto bloomVerticalPass = hdrGraph->AddPass("BloomVertical", [this](ID3D12GraphicsCommandList* commandList)
+		{
+			SetBloomVertical(commandList);
+		});
+
+	hdrGraph->Read(bloomVerticalPass, bloomId, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	hdrGraph->Write(bloomVerticalPass, bloomId, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+	auto toneMappingPass = hdrGraph->AddPass("ToneMapping", [this](ID3D12GraphicsCommandList* commandList)
+		{
+			SetToneMapping(commandList);
+		}, true);
+
+	hdrGraph->Read(toneMappingPass, hdrColorId, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+	hdrGraph->Read(toneMappingPass, luminanceId, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+	hdrGraph->Read(toneMappingPass, bloomId, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+	hdrGraph->Compile();
+}
+
 void Common::Logic::SceneEntity::PostProcessManager::SetMotionBlur(ID3D12GraphicsCommandList* commandList)
 {
 	motionBlurConstants.widthU = _width;
@@ -1096,32 +1132,8 @@ void Common::Logic::SceneEntity::PostProcessManager::SetFSR(ID3D12GraphicsComman
 	_fsr->Dispatch(commandList, deltaTime);
 }
 
-void Common::Logic::SceneEntity::PostProcessManager::SetHDR(ID3D12GraphicsCommandList* commandList)
+void Common::Logic::SceneEntity::PostProcessManager::SetLuminance(ID3D12GraphicsCommandList* commandList)
 {
-	D3D12_RESOURCE_BARRIER barrier{};
-	barriers.clear();
-
-	if (_renderingScheme.enableMotionBlur ||
-		_renderingScheme.enableVolumetricFog)
-	{
-		temporaryRWTexture0GPUResource->GetUAVBarrier(barrier);
-		barriers.push_back(barrier);
-	}
-
-	if (temporaryRWTexture0GPUResource->GetBarrier(D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, barrier))
-		barriers.push_back(barrier);
-	if (luminanceBufferGPUResource->GetEndBarrier(barrier))
-		barriers.push_back(barrier);
-	if ((_renderingScheme.enableFSR || _renderingScheme.enableVolumetricFog) &&
-		sceneDepthTargetGPUResource->GetBeginBarrier(D3D12_RESOURCE_STATE_DEPTH_WRITE, barrier))
-		barriers.push_back(barrier);
-
-	if (_renderingScheme.enableFSR &&
-		sceneAlphaTargetGPUResource->GetBeginBarrier(D3D12_RESOURCE_STATE_RENDER_TARGET, barrier))
-		barriers.push_back(barrier);
-
-	commandList->ResourceBarrier(static_cast<uint32_t>(barriers.size()), barriers.data());
-
 	hdrConstants.width = _width;
 	hdrConstants.area = motionBlurConstants.area;
 	uint32_t remain = hdrConstants.area % THREADS_PER_GROUP;
@@ -1147,42 +1159,27 @@ void Common::Logic::SceneEntity::PostProcessManager::SetHDR(ID3D12GraphicsComman
 		luminanceIterationComputeObject->SetRootConstant(commandList, 0u, &hdrConstants.area);
 		luminanceIterationComputeObject->Dispatch(commandList, numGroupsX, 1u, 1u);
 	}
+}
 
-	barriers.clear();
-
-	luminanceBufferGPUResource->GetUAVBarrier(barrier);
-	barriers.push_back(barrier);
-
-	if (luminanceBufferGPUResource->GetBarrier(D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, barrier))
-		barriers.push_back(barrier);
-	if (bloomBufferGPUResource->GetEndBarrier(barrier))
-		barriers.push_back(barrier);
-
-	commandList->ResourceBarrier(static_cast<uint32_t>(barriers.size()), barriers.data());
-
+void Common::Logic::SceneEntity::PostProcessManager::SetBloomHorizontal(ID3D12GraphicsCommandList* commandList)
+{
 	toneMappingConstants.width = _width;
 	toneMappingConstants.area = _width * _height;
 	toneMappingConstants.halfWidth = _width / 2u;
 	toneMappingConstants.quartArea = _width * _height / 4u;
 
-	numGroupsF = std::ceil(toneMappingConstants.quartArea / static_cast<float>(THREADS_PER_GROUP - HALF_BLUR_SAMPLES_NUMBER * 2u));
-	numGroupsX = std::max(static_cast<uint32_t>(numGroupsF), 1u);
+	float numGroupsF = std::ceil(toneMappingConstants.quartArea / static_cast<float>(THREADS_PER_GROUP - HALF_BLUR_SAMPLES_NUMBER * 2u));
+	uint32_t numGroupsX = std::max(static_cast<uint32_t>(numGroupsF), 1u);
 
 	bloomHorizontalObject->Set(commandList);
 	bloomHorizontalObject->SetRootConstants(commandList, 0u, 7u, &toneMappingConstants);
 	bloomHorizontalObject->Dispatch(commandList, numGroupsX, 1u, 1u);
+}
 
-	barriers.clear();
-
-	if (temporaryRWTexture0GPUResource->GetBeginBarrier(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, barrier))
-		barriers.push_back(barrier);
-	if (luminanceBufferGPUResource->GetBeginBarrier(D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, barrier))
-		barriers.push_back(barrier);
-
-	bloomBufferGPUResource->GetUAVBarrier(barrier);
-	barriers.push_back(barrier);
-
-	commandList->ResourceBarrier(static_cast<uint32_t>(barriers.size()), barriers.data());
+void Common::Logic::SceneEntity::PostProcessManager::SetBloomVertical(ID3D12GraphicsCommandList* commandList)
+{
+	float numGroupsF = std::ceil(toneMappingConstants.quartArea / static_cast<float>(THREADS_PER_GROUP - HALF_BLUR_SAMPLES_NUMBER * 2u));
+	uint32_t numGroupsX = std::max(static_cast<uint32_t>(numGroupsF), 1u);
 
 	uint32_t verticalBlurConstants[3]
 	{
@@ -1194,8 +1191,17 @@ void Common::Logic::SceneEntity::PostProcessManager::SetHDR(ID3D12GraphicsComman
 	bloomVerticalObject->Set(commandList);
 	bloomVerticalObject->SetRootConstants(commandList, 0u, 3u, &verticalBlurConstants);
 	bloomVerticalObject->Dispatch(commandList, numGroupsX, 1u, 1u);
+}
 
-	quadMesh->SetInputAssemblerOnly(commandList);
+void Common::Logic::SceneEntity::PostProcessManager::SetToneMapping(ID3D12GraphicsCommandList* commandList)
+{
+	if (_renderingScheme.enableFSR)
+	{
+		commandList->RSSetViewports(1u, &afterFSRViewport);
+		commandList->RSSetScissorRects(1u, &afterFSRScissorRectangle);
+	}
 
-	bloomBufferGPUResource->BeginBarrier(commandList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+	toneMappingMaterial->Set(commandList);
+	toneMappingMaterial->SetRootConstants(commandList, 0u, 12u, &toneMappingConstants);
+	quadMesh->Draw(commandList);
 }
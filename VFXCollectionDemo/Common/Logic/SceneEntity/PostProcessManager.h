@@ -5,6 +5,7 @@
 #include "LightingSystem.h"
 #include "FSR.h"
 #include "../../../Graphics/DirectX12Renderer.h"
+#include "../../../Graphics/RenderGraph.h"
 #include "../../../Graphics/Assets/Material.h"
 #include "../../../Graphics/Assets/ComputeObject.h"
 #include "../../../Graphics/Assets/Mesh.h"
@@ -54,6 +55,8 @@ namespace Common::Logic::SceneEntity
 
 		void SetDepthPrepass(ID3D12GraphicsCommandList* commandList);
 		void SetGBuffer(ID3D12GraphicsCommandList* commandList);
+		void BindDepthPrepass(ID3D12GraphicsCommandList* commandList);
+		void BindGBuffer(ID3D12GraphicsCommandList* commandList);
 
 		void SetMotionBuffer(ID3D12GraphicsCommandList* commandList);
 
@@ -61,6 +64,8 @@ namespace Common::Logic::SceneEntity
 		void RenderToBackBuffer(ID3D12GraphicsCommandList* commandList);
 
 		const Graphics::Assets::Mesh* GetFullscreenQuadMesh() const;
+		const Graphics::RenderGraph* GetPostProcessGraph() const;
+		const Graphics::RenderGraph* GetHDRGraph() const;
 
 		static constexpr uint32_t FSR_SIZE_NUMERATOR = 3u;
 		static constexpr uint32_t FSR_SIZE_DENOMINATOR = 4u;
@@ -89,11 +94,17 @@ namespace Common::Logic::SceneEntity
 			LightingSystem* lightingSystem);
 
 		void UpdateObjects(Graphics::DirectX12Renderer* renderer);
+		void CreatePostProcessGraph(ID3D12Device* device, ID3D12GraphicsCommandList* commandList,
+			Graphics::DirectX12Renderer* renderer);
+		void CreateHDRGraph();
 
 		void SetMotionBlur(ID3D12GraphicsCommandList* commandList);
 		void SetVolumetricFog(ID3D12GraphicsCommandList* commandList);
 		void SetFSR(ID3D12GraphicsCommandList* commandList, float deltaTime);
-		void SetHDR(ID3D12GraphicsCommandList* commandList);
+		void SetLuminance(ID3D12GraphicsCommandList* commandList);
+		void SetBloomHorizontal(ID3D12GraphicsCommandList* commandList);
+		void SetBloomVertical(ID3D12GraphicsCommandList* commandList);
+		void SetToneMapping(ID3D12GraphicsCommandList* commandList);
 
 		struct QuadVertex
 		{
@@ -164,9 +175,9 @@ namespace Common::Logic::SceneEntity
 
 		static constexpr bool SHARPNESS_ENABLED = true;
 
+		static constexpr uint32_t ALIASING_GROUPS_PER_MANAGER = 4u;
 		static constexpr uint32_t THREADS_PER_GROUP = 64u;
 		static constexpr uint32_t HALF_BLUR_SAMPLES_NUMBER = 8u;
-		static constexpr uint32_t MAX_SIMULTANEOUS_BARRIER_NUMBER = 5u;
 
 		VolumetricFogConstants* volumetricFogConstants;
 		MotionBlurConstants motionBlurConstants;
@@ -179,6 +190,11 @@ namespace Common::Logic::SceneEntity
 		uint32_t _width;
 		uint32_t _height;
 
+		uint32_t firstAliasingGroup;
+		float frameDeltaTime;
+
+		inline static std::atomic<uint32_t> managersCounter = 0u;
+
 		D3D12_VIEWPORT viewport;
 		D3D12_VIEWPORT afterFSRViewport;
 		D3D12_RECT scissorRectangle;
@@ -191,7 +207,8 @@ namespace Common::Logic::SceneEntity
 
 		RenderingScheme _renderingScheme;
 
-		std::vector<D3D12_RESOURCE_BARRIER> barriers;
+		Graphics::RenderGraph* postProcessGraph;
+		Graphics::RenderGraph* hdrGraph;
 
 		Graphics::Resources::GPUResource* sceneColorTargetGPUResource;
 		Graphics::Resources::GPUResource* sceneDepthTargetGPUResource;
@@ -3,8 +3,11 @@
 #include "../../../Graphics/Assets/Loaders/OBJLoader.h"
 #include "../../../Graphics/Assets/Loaders/DDSLoader.h"
 #include "../../../Graphics/Assets/GeometryUtilities.h"
+#include "../../../Graphics/Assets/VertexCompressor.h"
+#include "../../../Graphics/Assets/HeightMapResampler.h"
 #include "LightingSystem.h"
 #include "PostProcessManager.h"
+#include "../../TaskScheduler.h"
 
 using namespace DirectX;
 using namespace DirectX::PackedVector;
@@ -15,11 +18,20 @@ using namespace Graphics::Assets::Loaders;
 
 Common::Logic::SceneEntity::Terrain::Terrain(ID3D12GraphicsCommandList* commandList,
 	Graphics::DirectX12Renderer* renderer, const TerrainDesc& desc)
+	: materialDepthPrepass(nullptr)
 {
-	verticesPerWidth = desc.verticesPerWidth;
-	verticesPerHeight = desc.verticesPerHeight;
+	frameAllocator = renderer->GetFrameAllocator();
 
-	depthPassConstants.world = DirectX::XMMatrixTranslation(desc.origin.x, desc.origin.y, desc.origin.z);
+	patchesPerWidth = (std::max(desc.verticesPerWidth, 2u) - 2u) / PATCH_CELLS + 1u;
+	patchesPerHeight = (std::max(desc.verticesPerHeight, 2u) - 2u) / PATCH_CELLS + 1u;
+
+	verticesPerWidth = patchesPerWidth * PATCH_CELLS + 1u;
+	verticesPerHeight = patchesPerHeight * PATCH_CELLS + 1u;
+
+	lodDistance = desc.lodDistance;
+
+	world = DirectX::XMMatrixTranslation(desc.origin.x, desc.origin.y, desc.origin.z);
+	depthPassConstants.world = world;
 
 	minCorner = desc.origin;
 	minCorner.x -= desc.size.x * 0.5f;
@@ -27,6 +39,9 @@ Common::Logic::SceneEntity::Terrain::Terrain(ID3D12GraphicsCommandList* commandL
 
 	mapSize = desc.size;
 
+	quantizeVertices = desc.quantizeVertices;
+	quantizationDesc = {};
+
 	materialDepthPass = desc.materialDepthPass;
 	materialDepthCubePass = desc.materialDepthCubePass;
 
@@ -35,6 +50,9 @@ Common::Logic::SceneEntity::Terrain::Terrain(ID3D12GraphicsCommandList* commandL
 	auto device = renderer->GetDevice();
 	auto resourceManager = renderer->GetResourceManager();
 
+	std::vector<uint32_t> patchIndices;
+	BuildPatchIndices(patchIndices);
+
 	auto loadCache = std::filesystem::exists(desc.terrainFileName);
 
 	if (loadCache)
@@ -46,17 +64,29 @@ Common::Logic::SceneEntity::Terrain::Terrain(ID3D12GraphicsCommandList* commandL
 	}
 
 	if (loadCache)
-		LoadCache(desc.terrainFileName, device, commandList, resourceManager);
-	else
+		loadCache = LoadCache(desc.terrainFileName, device, commandList, resourceManager);
+
+	if (!loadCache)
 	{
 		LoadNormalHeightData(desc.heightMapFileName);
-		GenerateMesh(desc.terrainFileName, desc.blendMapFileName, commandList, renderer);
+		GenerateMesh(desc.terrainFileName, desc.blendMapFileName, patchIndices, commandList, renderer);
 	}
 
+	BuildPatches();
+
+#ifdef _DEBUG
+	ValidateHeightFieldSampler(patchIndices);
+#endif
+
+	if (quantizeVertices)
+		depthPassConstants.world = VertexCompressor::GetDequantizationMatrix(quantizationDesc) * world;
+
 	CreateConstantBuffers(device, commandList, resourceManager, desc);
 	LoadShaders(device, resourceManager, desc);
 	LoadTextures(device, commandList, resourceManager, desc);
 	CreateMaterial(device, resourceManager, desc);
+
+	*mutableConstantsBuffer = mutableConstants;
 }
 
 Common::Logic::SceneEntity::Terrain::~Terrain()
@@ -66,48 +96,22 @@ Common::Logic::SceneEntity::Terrain::~Terrain()
 
 const float4x4& Common::Logic::SceneEntity::Terrain::GetWorld() const
 {
-	return depthPassConstants.world;
+	return world;
 }
 
 float Common::Logic::SceneEntity::Terrain::GetHeight(const float2& position) const
 {
-	uint32_t index00;
-	uint32_t index10;
-	uint32_t index01;
-	uint32_t index11;
-
-	float4 barycentric;
-
-	FetchCoord(position, index00, index10, index01, index11, barycentric);
-
-	auto height = normalHeightData[index00].m128_f32[3u] * barycentric.x;
-	height += normalHeightData[index10].m128_f32[3u] * barycentric.y;
-	height += normalHeightData[index01].m128_f32[3u] * barycentric.z;
-	height += normalHeightData[index11].m128_f32[3u] * barycentric.w;
-
-	return height + minCorner.z;
+	return heightFieldSampler.GetHeight(position);
 }
 
 float3 Common::Logic::SceneEntity::Terrain::GetNormal(const float2& position) const
 {
-	uint32_t index00;
-	uint32_t index10;
-	uint32_t index01;
-	uint32_t index11;
-
-	float4 barycentric;
-
-	FetchCoord(position, index00, index10, index01, index11, barycentric);
-
-	auto normalV = normalHeightData[index00] * barycentric.x;
-	normalV += normalHeightData[index10] * barycentric.y;
-	normalV += normalHeightData[index01] * barycentric.z;
-	normalV += normalHeightData[index11] * barycentric.w;
-
-	float3 normal;
-	XMStoreFloat3(&normal, XMVector3Normalize(normalV));
+	return heightFieldSampler.GetNormal(position);
+}
 
-	return normal;
+const Graphics::Assets::HeightFieldSampler& Common::Logic::SceneEntity::Terrain::GetHeightFieldSampler() const noexcept
+{
+	return heightFieldSampler;
 }
 
 const float3& Common::Logic::SceneEntity::Terrain::GetSize() const noexcept
@@ -120,44 +124,89 @@ const float3& Common::Logic::SceneEntity::Terrain::GetMinCorner() const noexcept
 	return minCorner;
 }
 
+bool Common::Logic::SceneEntity::Terrain::GetBounds(AxisAlignedBox& bounds, BoundingSphere& boundingSphere) const
+{
+	const auto& meshDesc = mesh->GetDesc();
+	bounds = meshDesc.bounds;
+	boundingSphere = meshDesc.boundingSphere;
+
+	return true;
+}
+
 void Common::Logic::SceneEntity::Terrain::Update(const Camera* camera, float time)
 {
-	mutableConstantsBuffer->lastViewProjection = mutableConstantsBuffer->viewProjection;
-	mutableConstantsBuffer->viewProjection = camera->GetViewProjection();
-	mutableConstantsBuffer->cameraPosition = camera->GetPosition();
-	mutableConstantsBuffer->time = time;
+	mutableConstants.lastViewProjection = mutableConstants.viewProjection;
+	mutableConstants.viewProjection = camera->GetViewProjection();
+	mutableConstants.cameraPosition = camera->GetPosition();
+	mutableConstants.time = time;
+
+	UploadMutableConstants();
+
+	cameraFrustum = camera->GetFrustum();
+	SelectPatches(mutableConstants.cameraPosition, &cameraFrustum, 1u, 1u, visiblePatches);
 }
 
 void Common::Logic::SceneEntity::Terrain::DrawDepthPrepass(ID3D12GraphicsCommandList* commandList)
 {
 	materialDepthPrepass->Set(commandList);
-	mesh->Draw(commandList);
+	DrawPatches(commandList, visiblePatches);
 }
 
 void Common::Logic::SceneEntity::Terrain::DrawShadows(ID3D12GraphicsCommandList* commandList,
-	uint32_t lightMatrixStartIndex)
+	const LightDesc& lightDesc)
 {
-	depthPassConstants.lightMatrixStartIndex = lightMatrixStartIndex;
+	if ((lightDesc.GetShadowFaceMask() & 1u) == 0u)
+		return;
+
+	shadowFrustums[0u] = lightDesc.GetFrustum();
+
+	// Shadow LODs follow the light, not the camera: terrain is a static caster, and its cached shadow map is only
+	// re-rendered when the light or the casters change, so a camera-dependent LOD would go stale in the cache.
+	SelectPatches(lightDesc.position, shadowFrustums.data(), 1u, 1u, shadowPatches);
+
+	depthPassConstants.lightMatrixStartIndex = lightDesc.GetLightMatrixStartIndex();
 
 	materialDepthPass->Set(commandList);
 	materialDepthPass->SetRootConstants(commandList, 0u, 17u, &depthPassConstants);
-	mesh->Draw(commandList);
+	DrawPatches(commandList, shadowPatches);
 }
 
 void Common::Logic::SceneEntity::Terrain::DrawShadowsCube(ID3D12GraphicsCommandList* commandList,
-	uint32_t lightMatrixStartIndex)
+	const LightDesc& lightDesc)
 {
-	depthPassConstants.lightMatrixStartIndex = lightMatrixStartIndex;
+	if (lightDesc.GetShadowFaceMask() == 0u)
+		return;
+
+	auto facesNumber = std::min(lightDesc.GetShadowFacesNumber(), CUBE_FACES_NUMBER);
+
+	for (uint32_t faceIndex = 0u; faceIndex < facesNumber; faceIndex++)
+		shadowFrustums[faceIndex] = lightDesc.GetFrustum(faceIndex);
+
+	SelectPatches(lightDesc.position, shadowFrustums.data(), facesNumber, lightDesc.GetShadowFaceMask(), shadowPatches);
+
+	depthPassConstants.lightMatrixStartIndex = lightDesc.GetLightMatrixStartIndex();
+	depthPassConstants.faceMask = 0u;
 
 	materialDepthCubePass->Set(commandList);
-	materialDepthCubePass->SetRootConstants(commandList, 0u, 17u, &depthPassConstants);
-	mesh->Draw(commandList);
+	mesh->SetInputAssemblerOnly(commandList);
+
+	for (const auto& drawItem : shadowPatches)
+	{
+		if (drawItem.faceMask != depthPassConstants.faceMask)
+		{
+			depthPassConstants.faceMask = drawItem.faceMask;
+			materialDepthCubePass->SetRootConstants(commandList, 0u, 18u, &depthPassConstants);
+		}
+
+		const auto& range = patchIndexRanges[drawItem.rangeIndex];
+		mesh->DrawRange(commandList, range.indicesNumber, range.startIndex, static_cast<int32_t>(patches[drawItem.patchIndex].baseVertex));
+	}
 }
 
 void Common::Logic::SceneEntity::Terrain::Draw(ID3D12GraphicsCommandList* commandList)
 {
 	material->Set(commandList);
-	mesh->Draw(commandList);
+	DrawPatches(commandList, visiblePatches);
 }
 
 void Common::Logic::SceneEntity::Terrain::Release(Graphics::Resources::ResourceManager* resourceManager)
@@ -186,70 +235,62 @@ void Common::Logic::SceneEntity::Terrain::LoadNormalHeightData(const std::filesy
 	TextureDesc desc{};
 	DDSLoader::Load(heightMapFileName, desc);
 
-	auto pixelNumber = static_cast<uint32_t>(desc.width * desc.height);
+	std::vector<float> sourceHeights;
+	auto sourceWidth = static_cast<uint32_t>(desc.width);
+	auto sourceHeight = desc.height;
+
+	if (!HeightMapResampler::Decode(desc, sourceHeights))
+	{
+#ifdef _DEBUG
+		auto message = heightMapFileName.generic_string() + ": unsupported height map format\n";
+		OutputDebugStringA(message.c_str());
+#endif
+
+		sourceHeights.assign(1u, 0.0f);
+		sourceWidth = 1u;
+		sourceHeight = 1u;
+	}
+
+	std::vector<float> heights;
+	HeightMapResampler::Resample(sourceHeights, sourceWidth, sourceHeight, verticesPerWidth, verticesPerHeight, heights);
+
 	auto verticesNumber = static_cast<uint32_t>(static_cast<uint64_t>(verticesPerWidth) * verticesPerHeight);
 
 	normalHeightData.resize(verticesNumber);
-	
-	auto lastPtr = reinterpret_cast<const uint8_t*>(desc.data.data() + pixelNumber - 1);
-	auto heightPtr = reinterpret_cast<const uint8_t*>(desc.data.data());
-	auto cellSize = float2(mapSize.x / verticesPerWidth, mapSize.y / verticesPerHeight);
 
-	auto incrementX = static_cast<uint32_t>(std::ceil(static_cast<float>(desc.width) / verticesPerWidth));
-	auto incrementY = static_cast<uint32_t>(std::ceil(static_cast<float>(desc.height) / verticesPerHeight));
-	incrementY *= static_cast<uint32_t>(desc.width);
+	auto cellSize = float2(mapSize.x / (verticesPerWidth - 1), mapSize.y / (verticesPerHeight - 1));
+	auto heightScale = XMVectorReplicate(mapSize.z);
+	auto gradientScale = XMVectorSet(-mapSize.z / (2.0f * cellSize.x), -mapSize.z / (2.0f * cellSize.y), 0.0f, 0.0f);
+	auto upVector = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
 	
-	for (uint32_t indexY = 0u; indexY < verticesPerHeight; indexY++)
+	TaskScheduler::GetShared()->ParallelFor(0u, verticesPerHeight, ROWS_PER_TASK, [&](uint32_t startRow, uint32_t endRow)
 	{
-		for (uint32_t indexX = 0u; indexX < verticesPerWidth; indexX++)
+		for (uint32_t indexY = startRow; indexY < endRow; indexY++)
 		{
-			auto offset = static_cast<uint32_t>(static_cast<float>(indexX * desc.width) / verticesPerWidth);
-			offset += static_cast<uint32_t>(desc.width * static_cast<uint64_t>(static_cast<float>(indexY * desc.height) / verticesPerHeight));
-			auto height = *std::min(heightPtr + offset, lastPtr) * mapSize.z / 255.0f;
-
-			auto heightX = *(std::min(heightPtr + offset + incrementX, lastPtr)) * mapSize.z / 255.0f;
-			auto heightY = *(std::min(heightPtr + offset + ((heightPtr + incrementY) <= lastPtr ? incrementY : 0u), lastPtr)) * mapSize.z / 255.0f;
-
-			auto position = XMVectorSet
-			(
-				cellSize.x * indexX + minCorner.x,
-				cellSize.y * indexY + minCorner.y,
-				height + minCorner.y,
-				0.0f
-			);
-
-			auto positionX = XMVectorSet
-			(
-				position.m128_f32[0u] + cellSize.x,
-				position.m128_f32[1u],
-				heightX + minCorner.y,
-				0.0f
-			);
-
-			auto positionY = XMVectorSet
-			(
-				position.m128_f32[0u],
-				position.m128_f32[1u] + cellSize.y,
-				heightY + minCorner.y,
-				0.0f
-			);
+			auto rowDown = heights.data() + static_cast<size_t>(indexY > 0u ? indexY - 1u : indexY) * verticesPerWidth;
+			auto row = heights.data() + static_cast<size_t>(indexY) * verticesPerWidth;
+			auto rowUp = heights.data() + static_cast<size_t>(std::min(indexY + 1u, verticesPerHeight - 1u)) * verticesPerWidth;
 
-			auto Vx = positionX - position;
-			auto Vy = positionY - position;
-
-			auto normal = XMVector3Cross(Vx, Vy);
-			normal = XMVector3Normalize(normal);
+			for (uint32_t indexX = 0u; indexX < verticesPerWidth; indexX++)
+			{
+				auto indexLeft = indexX > 0u ? indexX - 1u : indexX;
+				auto indexRight = std::min(indexX + 1u, verticesPerWidth - 1u);
 
-			auto dataIndex = indexX + indexY * verticesPerWidth;
+				auto gradient = XMVectorSet(row[indexRight] - row[indexLeft], rowUp[indexX] - rowDown[indexX], 0.0f, 0.0f);
+				auto normal = XMVector3Normalize(XMVectorMultiplyAdd(gradient, gradientScale, upVector));
+				auto height = XMVectorReplicate(row[indexX]) * heightScale;
 
-			normalHeightData[dataIndex] = XMVectorSet(normal.m128_f32[0u], normal.m128_f32[1u], normal.m128_f32[2u], height);
+				normalHeightData[indexX + indexY * verticesPerWidth] = XMVectorSelect(normal, height, g_XMSelect0001);
+			}
 		}
-	}
+	});
+
+	heightFieldSampler.Reset(normalHeightData.data(), verticesPerWidth, verticesPerHeight, minCorner, mapSize);
 }
 
 void Common::Logic::SceneEntity::Terrain::GenerateMesh(const std::filesystem::path& terrainFileName,
-	const std::filesystem::path& blendMapFileName, ID3D12GraphicsCommandList* commandList,
-	Graphics::DirectX12Renderer* renderer)
+	const std::filesystem::path& blendMapFileName, const std::vector<uint32_t>& patchIndices,
+	ID3D12GraphicsCommandList* commandList, Graphics::DirectX12Renderer* renderer)
 {
 	auto verticesNumber = static_cast<uint32_t>(verticesPerWidth * verticesPerHeight);
 	
@@ -261,61 +302,96 @@ void Common::Logic::SceneEntity::Terrain::GenerateMesh(const std::filesystem::pa
 	auto cellSize = float2(mapSize.x / (verticesPerWidth - 1), mapSize.y / (verticesPerHeight - 1));
 
 	auto vertices = reinterpret_cast<TerrainVertex*>(vbDesc.data.data());
-	
-	for (uint32_t vertexIndexY = 0u; vertexIndexY < verticesPerHeight; vertexIndexY++)
+
+	TaskScheduler::GetShared()->ParallelFor(0u, verticesPerHeight, ROWS_PER_TASK, [&](uint32_t startRow, uint32_t endRow)
 	{
-		for (uint32_t vertexIndexX = 0u; vertexIndexX < verticesPerWidth; vertexIndexX++)
-		{
-			uint32_t vertexIndex = vertexIndexX + vertexIndexY * verticesPerWidth;
+		std::vector<float2> rowPositions(verticesPerWidth);
+		std::vector<float> rowHeights(verticesPerWidth);
+		std::vector<float3> rowNormals(verticesPerWidth);
 
-			auto& vertex = vertices[vertexIndex];
+		for (uint32_t vertexIndexY = startRow; vertexIndexY < endRow; vertexIndexY++)
+		{
+			for (uint32_t vertexIndexX = 0u; vertexIndexX < verticesPerWidth; vertexIndexX++)
+				rowPositions[vertexIndexX] = float2(vertexIndexX * cellSize.x + minCorner.x, vertexIndexY * cellSize.y + minCorner.y);
 
-			auto positionXY = float2(vertexIndexX * cellSize.x, vertexIndexY * cellSize.y);
-			positionXY.x += minCorner.x;
-			positionXY.y += minCorner.y;
+			heightFieldSampler.Sample(rowPositions.data(), rowPositions.size(), rowHeights.data(), rowNormals.data());
 
-			vertex.position.x = positionXY.x;
-			vertex.position.y = positionXY.y;
-			vertex.position.z = GetHeight(positionXY);
+			for (uint32_t vertexIndexX = 0u; vertexIndexX < verticesPerWidth; vertexIndexX++)
+			{
+				uint32_t vertexIndex = vertexIndexX + vertexIndexY * verticesPerWidth;
 
-			auto normal = GetNormal(positionXY);
+				auto& vertex = vertices[vertexIndex];
 
-			vertex.normalX = XMConvertFloatToHalf(normal.x);
-			vertex.normalY = XMConvertFloatToHalf(normal.y);
-			vertex.normalZ = XMConvertFloatToHalf(normal.z);
-			vertex.normalW = XMConvertFloatToHalf(0.0f);
+				vertex.position.x = rowPositions[vertexIndexX].x;
+				vertex.position.y = rowPositions[vertexIndexX].y;
+				vertex.position.z = rowHeights[vertexIndexX];
 
-			auto tangent = GeometryUtilities::CalculateTangent(normal);
+				const auto& normal = rowNormals[vertexIndexX];
+				auto tangent = GeometryUtilities::CalculateTangent(normal);
 
-			vertex.tangentX = XMConvertFloatToHalf(tangent.x);
-			vertex.tangentY = XMConvertFloatToHalf(tangent.y);
-			vertex.tangentZ = XMConvertFloatToHalf(tangent.z);
-			vertex.tangentW = XMConvertFloatToHalf(0.0f);
+				auto texCoord = XMVectorSet
+				(
+					static_cast<float>(vertexIndexX) / (verticesPerWidth - 1),
+					static_cast<float>(vertexIndexY) / (verticesPerHeight - 1),
+					0.0f,
+					0.0f
+				);
 
-			float2 texCoord
-			{
-				static_cast<float>(vertexIndexX) / (verticesPerWidth - 1),
-				static_cast<float>(vertexIndexY) / (verticesPerHeight - 1)
-			};
+				auto normalHalf = GeometryUtilities::VectorToHalf4(XMLoadFloat3(&normal));
+				auto tangentHalf = GeometryUtilities::VectorToHalf4(XMLoadFloat3(&tangent));
+				auto texCoordHalf = static_cast<uint32_t>(GeometryUtilities::VectorToHalf4(texCoord));
 
-			vertex.texCoordX = XMConvertFloatToHalf(texCoord.x);
-			vertex.texCoordY = XMConvertFloatToHalf(texCoord.y);
+				std::memcpy(&vertex.normalX, &normalHalf, sizeof(uint64_t));
+				std::memcpy(&vertex.tangentX, &tangentHalf, sizeof(uint64_t));
+				std::memcpy(&vertex.texCoordX, &texCoordHalf, sizeof(uint32_t));
+			}
 		}
-	}
+	});
 
-	auto cellsNumber = static_cast<uint32_t>((verticesPerWidth - 1) * (verticesPerHeight - 1));
-	auto indicesNumber = cellsNumber * 6u;
+	auto indicesNumber = static_cast<uint32_t>(patchIndices.size());
+	auto maxPatchIndex = PATCH_CELLS + PATCH_CELLS * verticesPerWidth;
 
 	BufferDesc ibDesc{};
-	ibDesc.dataStride = indicesNumber < std::numeric_limits<uint16_t>::max() ? 2u : 4u;
+	ibDesc.dataStride = maxPatchIndex < std::numeric_limits<uint16_t>::max() ? 2u : 4u;
 	ibDesc.numElements = indicesNumber;
 	ibDesc.data.resize(static_cast<size_t>(ibDesc.numElements) * ibDesc.dataStride);
 
 	if (ibDesc.dataStride == 2u)
-		FillIndices(reinterpret_cast<uint16_t*>(ibDesc.data.data()), indicesNumber);
+		FillIndices(reinterpret_cast<uint16_t*>(ibDesc.data.data()), patchIndices);
 	else
-		FillIndices(reinterpret_cast<uint32_t*>(ibDesc.data.data()), indicesNumber);
+		FillIndices(reinterpret_cast<uint32_t*>(ibDesc.data.data()), patchIndices);
 	
+	MeshDesc meshDesc{};
+	meshDesc.vertexFormat = VertexFormat::POSITION | VertexFormat::NORMAL | VertexFormat::TANGENT |
+		VertexFormat::TEXCOORD0;
+
+	meshDesc.topology = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+	meshDesc.indexFormat = ibDesc.dataStride == 2u ? IndexFormat::UINT16_INDEX : IndexFormat::UINT32_INDEX;
+	meshDesc.verticesNumber = verticesNumber;
+	meshDesc.indicesNumber = indicesNumber;
+
+	GeometryUtilities::CalculateBounds(vbDesc.data.data(), verticesNumber, sizeof(TerrainVertex), meshDesc.bounds,
+		meshDesc.boundingSphere);
+
+	if (quantizeVertices)
+	{
+		MeshDesc compressedMeshDesc{};
+		std::vector<uint8_t> compressedVerticesData;
+		VertexCompressionReport compressionReport{};
+
+		VertexCompressor::Compress(meshDesc, vbDesc.data, compressedMeshDesc, quantizationDesc,
+			compressedVerticesData, compressionReport);
+
+		meshDesc = compressedMeshDesc;
+		vbDesc.dataStride = compressionReport.targetStride;
+		vbDesc.data = std::move(compressedVerticesData);
+
+#ifdef _DEBUG
+		auto reportMessage = terrainFileName.generic_string() + ": " + VertexCompressor::FormatReport(compressionReport);
+		OutputDebugStringA(reportMessage.c_str());
+#endif
+	}
+
 	auto device = renderer->GetDevice();
 	auto resourceManager = renderer->GetResourceManager();
 
@@ -325,15 +401,6 @@ void Common::Logic::SceneEntity::Terrain::GenerateMesh(const std::filesystem::pa
 	auto indexBufferId = resourceManager->CreateBufferResource(device, commandList,
 		BufferResourceType::INDEX_BUFFER, ibDesc);
 
-	MeshDesc meshDesc{};
-	meshDesc.vertexFormat = VertexFormat::POSITION | VertexFormat::NORMAL | VertexFormat::TANGENT |
-		VertexFormat::TEXCOORD0 | VertexFormat::BLENDWEIGHT;
-
-	meshDesc.topology = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
-	meshDesc.indexFormat = ibDesc.dataStride == 2u ? IndexFormat::UINT16_INDEX : IndexFormat::UINT32_INDEX;
-	meshDesc.verticesNumber = verticesNumber;
-	meshDesc.indicesNumber = indicesNumber;
-
 	mesh = new Mesh(meshDesc, vertexBufferId, indexBufferId, resourceManager);
 
 	SaveCache(terrainFileName, meshDesc, vbDesc.data, ibDesc.data);
@@ -351,15 +418,39 @@ void Common::Logic::SceneEntity::Terrain::CreateConstantBuffers(ID3D12Device* de
 
 	auto mutableConstantsResource = resourceManager->GetResource<ConstantBuffer>(mutableConstantsId);
 	mutableConstantsBuffer = reinterpret_cast<MutableConstants*>(mutableConstantsResource->resourceCPUAddress);
-	mutableConstantsBuffer->mapTiling0 = desc.map0Tiling;
-	mutableConstantsBuffer->mapTiling1 = desc.map1Tiling;
-	mutableConstantsBuffer->mapTiling2 = desc.map2Tiling;
-	mutableConstantsBuffer->mapTiling3 = desc.map3Tiling;
-	mutableConstantsBuffer->zNear = LightingSystem::SHADOW_MAP_Z_NEAR;
-	mutableConstantsBuffer->zFar = LightingSystem::SHADOW_MAP_Z_FAR;
-	mutableConstantsBuffer->mipBias = std::log2(PostProcessManager::FSR_SIZE_NUMERATOR /
+	mutableConstantsAddress = mutableConstantsResource->resourceGPUAddress;
+
+	mutableConstants = {};
+	mutableConstants.mapTiling0 = desc.map0Tiling;
+	mutableConstants.mapTiling1 = desc.map1Tiling;
+	mutableConstants.mapTiling2 = desc.map2Tiling;
+	mutableConstants.mapTiling3 = desc.map3Tiling;
+	mutableConstants.zNear = LightingSystem::SHADOW_MAP_Z_NEAR;
+	mutableConstants.zFar = LightingSystem::SHADOW_MAP_Z_FAR;
+	mutableConstants.mipBias = std::log2(PostProcessManager::FSR_SIZE_NUMERATOR /
 		static_cast<float>(PostProcessManager::FSR_SIZE_DENOMINATOR)) - 1.0f;
-	mutableConstantsBuffer->padding = {};
+	mutableConstants.padding = {};
+	mutableConstants.positionOffset = quantizationDesc.positionOffset;
+	mutableConstants.padding1 = {};
+	mutableConstants.positionScale = quantizationDesc.positionScale;
+	mutableConstants.padding2 = {};
+}
+
+void Common::Logic::SceneEntity::Terrain::UploadMutableConstants()
+{
+	FrameAllocation constantsAllocation{};
+
+	// The persistent buffer may still be read by frames in flight, so an exhausted frame budget
+	// skips the upload and leaves the materials on the last uploaded constants.
+	if (!frameAllocator->AllocateConstants(mutableConstants, constantsAllocation))
+		return;
+
+	auto constantsAddress = constantsAllocation.gpuAddress;
+
+	material->UpdateConstantBuffer(1u, constantsAddress);
+
+	if (materialDepthPrepass != nullptr)
+		materialDepthPrepass->UpdateConstantBuffer(1u, constantsAddress);
 }
 
 void Common::Logic::SceneEntity::Terrain::LoadShaders(ID3D12Device* device,
@@ -370,6 +461,9 @@ void Common::Logic::SceneEntity::Terrain::LoadShaders(ID3D12Device* device,
 	if (desc.outputVelocity)
 		defines.push_back({ L"OUTPUT_VELOCITY", nullptr });
 
+	if (quantizeVertices)
+		defines.push_back({ L"QUANTIZED_VERTICES", nullptr });
+
 	defines.insert(defines.end(),
 		std::make_move_iterator(desc.shaderDefines->begin()),
 		std::make_move_iterator(desc.shaderDefines->end()));
@@ -448,16 +542,33 @@ void Common::Logic::SceneEntity::Terrain::CreateMaterial(ID3D12Device* device, R
 
 	for (uint32_t shadowMapIndex = 0u; shadowMapIndex < desc.shadowMapIds.size(); shadowMapIndex++)
 	{
-		auto shadowMapResource = resourceManager->GetResource<Texture>(desc.shadowMapIds[shadowMapIndex]);
+		auto shadowMapResource = resourceManager->GetResource<DepthStencilTarget>(desc.shadowMapIds[shadowMapIndex]);
 		materialBuilder.SetTexture(9u + shadowMapIndex, shadowMapResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
 	}
 
+	if (desc.hasCascadedShadows)
+	{
+		auto lightMatricesConstantBufferResource = resourceManager->GetResource<ConstantBuffer>(desc.lightMatricesConstantBufferId);
+		materialBuilder.SetConstantBuffer(2u, lightMatricesConstantBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_PIXEL);
+	}
+
 	if (desc.hasParticleLighting)
 	{
 		auto particleLightBufferResource = resourceManager->GetResource<RWBuffer>(desc.lightParticleBufferId);
 		materialBuilder.SetBuffer(10u, particleLightBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_PIXEL);
 	}
 
+	if (desc.hasParticleLighting && desc.hasClusteredLighting)
+	{
+		auto lightClusterConstantBufferResource = resourceManager->GetResource<ConstantBuffer>(desc.lightClusterConstantBufferId);
+		auto lightClusterCountBufferResource = resourceManager->GetResource<RWBuffer>(desc.lightClusterCountBufferId);
+		auto lightClusterIndexBufferResource = resourceManager->GetResource<RWBuffer>(desc.lightClusterIndexBufferId);
+
+		materialBuilder.SetConstantBuffer(4u, lightClusterConstantBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_PIXEL);
+		materialBuilder.SetBuffer(11u, lightClusterCountBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_PIXEL);
+		materialBuilder.SetBuffer(12u, lightClusterIndexBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_PIXEL);
+	}
+
 	materialBuilder.SetSampler(0u, samplerLinearResource->samplerDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
 	materialBuilder.SetSampler(1u, samplerShadowResource->samplerDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
 
@@ -489,16 +600,33 @@ void Common::Logic::SceneEntity::Terrain::CreateMaterial(ID3D12Device* device, R
 	}
 }
 
-void Common::Logic::SceneEntity::Terrain::LoadCache(const std::filesystem::path& fileName, ID3D12Device* device,
+bool Common::Logic::SceneEntity::Terrain::LoadCache(const std::filesystem::path& fileName, ID3D12Device* device,
 	ID3D12GraphicsCommandList* commandList, Graphics::Resources::ResourceManager* resourceManager)
 {
-	MeshDesc meshDesc{};
-
 	std::ifstream terrainFile(fileName, std::ios::binary);
+
+	MeshCacheHeader header{};
+	terrainFile.read(reinterpret_cast<char*>(&header), sizeof(MeshCacheHeader));
+
+	if (!terrainFile || header.magic != CACHE_MAGIC || header.version != CACHE_VERSION)
+		return false;
+
+	MeshDesc meshDesc{};
 	terrainFile.read(reinterpret_cast<char*>(&meshDesc), sizeof(MeshDesc));
 
+	auto isQuantized = (meshDesc.vertexFormat & VertexFormat::POSITION_QUANTIZED) == VertexFormat::POSITION_QUANTIZED;
+
+	if (isQuantized != quantizeVertices)
+		return false;
+
+	if (meshDesc.verticesNumber != verticesPerWidth * verticesPerHeight || meshDesc.indicesNumber != patchIndicesNumber)
+		return false;
+
+	if (isQuantized)
+		terrainFile.read(reinterpret_cast<char*>(&quantizationDesc), sizeof(VertexQuantizationDesc));
+
 	BufferDesc vbDesc{};
-	vbDesc.dataStride = sizeof(TerrainVertex);
+	vbDesc.dataStride = isQuantized ? VertexStride(meshDesc.vertexFormat) : sizeof(TerrainVertex);
 	vbDesc.numElements = meshDesc.verticesNumber;
 
 	auto vertexBufferSize = static_cast<size_t>(meshDesc.verticesNumber) * vbDesc.dataStride;
@@ -520,6 +648,8 @@ void Common::Logic::SceneEntity::Terrain::LoadCache(const std::filesystem::path&
 
 	terrainFile.read(reinterpret_cast<char*>(normalHeightData.data()), sizeof(float4) * normalHeightDataSize);
 
+	heightFieldSampler.Reset(normalHeightData.data(), verticesPerWidth, verticesPerHeight, minCorner, mapSize);
+
 	auto vertexBufferId = resourceManager->CreateBufferResource(device, commandList,
 		BufferResourceType::VERTEX_BUFFER, vbDesc);
 
@@ -527,13 +657,22 @@ void Common::Logic::SceneEntity::Terrain::LoadCache(const std::filesystem::path&
 		BufferResourceType::INDEX_BUFFER, ibDesc);
 
 	mesh = new Mesh(meshDesc, vertexBufferId, indexBufferId, resourceManager);
+
+	return true;
 }
 
 void Common::Logic::SceneEntity::Terrain::SaveCache(const std::filesystem::path& fileName,
 	const MeshDesc& meshDesc, const std::vector<uint8_t>& verticesData, const std::vector<uint8_t>& indicesData) const
 {
+	MeshCacheHeader header{ CACHE_MAGIC, CACHE_VERSION };
+
 	std::ofstream meshFile(fileName, std::ios::binary);
+	meshFile.write(reinterpret_cast<const char*>(&header), sizeof(MeshCacheHeader));
 	meshFile.write(reinterpret_cast<const char*>(&meshDesc), sizeof(MeshDesc));
+
+	if ((meshDesc.vertexFormat & VertexFormat::POSITION_QUANTIZED) == VertexFormat::POSITION_QUANTIZED)
+		meshFile.write(reinterpret_cast<const char*>(&quantizationDesc), sizeof(VertexQuantizationDesc));
+
 	meshFile.write(reinterpret_cast<const char*>(verticesData.data()), verticesData.size());
 	meshFile.write(reinterpret_cast<const char*>(indicesData.data()), indicesData.size());
 
@@ -543,54 +682,369 @@ void Common::Logic::SceneEntity::Terrain::SaveCache(const std::filesystem::path&
 	meshFile.write(reinterpret_cast<const char*>(normalHeightData.data()), normalHeightDataSize * sizeof(float4));
 }
 
-void Common::Logic::SceneEntity::Terrain::FetchCoord(const float2& position, uint32_t& index00, uint32_t& index10,
-	uint32_t& index01, uint32_t& index11, float4& barycentricCoord) const
+void Common::Logic::SceneEntity::Terrain::BuildPatchIndices(std::vector<uint32_t>& patchIndices)
 {
-	float2 fetchedPosition
+	patchIndexRanges.resize(LOD_LEVELS_NUMBER * STITCH_MASKS_NUMBER);
+	patchIndices.clear();
+
+	for (uint32_t lod = 0u; lod < LOD_LEVELS_NUMBER; lod++)
 	{
-		(position.x - minCorner.x) / mapSize.x,
-		(position.y - minCorner.y) / mapSize.y
+		auto step = 1u << lod;
+		auto doubleStep = step * 2u;
+
+		for (uint32_t stitchMask = 0u; stitchMask < STITCH_MASKS_NUMBER; stitchMask++)
+		{
+			auto getIndex = [&](uint32_t indexX, uint32_t indexY)
+			{
+				if (indexX == 0u && (stitchMask & STITCH_LEFT) != 0u)
+					indexY = indexY / doubleStep * doubleStep;
+
+				if (indexX == PATCH_CELLS && (stitchMask & STITCH_RIGHT) != 0u)
+					indexY = indexY / doubleStep * doubleStep;
+
+				if (indexY == 0u && (stitchMask & STITCH_BOTTOM) != 0u)
+					indexX = indexX / doubleStep * doubleStep;
+
+				if (indexY == PATCH_CELLS && (stitchMask & STITCH_TOP) != 0u)
+					indexX = indexX / doubleStep * doubleStep;
+
+				return indexX + indexY * verticesPerWidth;
+			};
+
+			auto addTriangle = [&](uint32_t index0, uint32_t index1, uint32_t index2)
+			{
+				if (index0 == index1 || index1 == index2 || index0 == index2)
+					return;
+
+				patchIndices.push_back(index0);
+				patchIndices.push_back(index1);
+				patchIndices.push_back(index2);
+			};
+
+			auto& range = patchIndexRanges[lod * STITCH_MASKS_NUMBER + stitchMask];
+			range.startIndex = static_cast<uint32_t>(patchIndices.size());
+
+			for (uint32_t cellIndexY = 0u; cellIndexY < PATCH_CELLS; cellIndexY += step)
+				for (uint32_t cellIndexX = 0u; cellIndexX < PATCH_CELLS; cellIndexX += step)
+				{
+					auto index00 = getIndex(cellIndexX, cellIndexY);
+					auto index10 = getIndex(cellIndexX + step, cellIndexY);
+					auto index01 = getIndex(cellIndexX, cellIndexY + step);
+					auto index11 = getIndex(cellIndexX + step, cellIndexY + step);
+
+					addTriangle(index00, index10, index01);
+					addTriangle(index01, index10, index11);
+				}
+
+			range.indicesNumber = static_cast<uint32_t>(patchIndices.size()) - range.startIndex;
+		}
+	}
+
+	patchIndicesNumber = static_cast<uint32_t>(patchIndices.size());
+}
+
+void Common::Logic::SceneEntity::Terrain::BuildPatches()
+{
+	auto cellSize = float2(mapSize.x / (verticesPerWidth - 1), mapSize.y / (verticesPerHeight - 1));
+	auto worldOffset = world.r[3u];
+
+	patches.resize(static_cast<size_t>(patchesPerWidth) * patchesPerHeight);
+	patchLods.resize(patches.size());
+
+	std::vector<float2> rowPositions(PATCH_CELLS + 1u);
+	std::vector<float> rowHeights(PATCH_CELLS + 1u);
+
+	for (uint32_t patchIndexY = 0u; patchIndexY < patchesPerHeight; patchIndexY++)
+	{
+		for (uint32_t patchIndexX = 0u; patchIndexX < patchesPerWidth; patchIndexX++)
+		{
+			auto startX = patchIndexX * PATCH_CELLS;
+			auto startY = patchIndexY * PATCH_CELLS;
+
+			auto minHeight = std::numeric_limits<float>::max();
+			auto maxHeight = -std::numeric_limits<float>::max();
+
+			for (uint32_t vertexIndexY = startY; vertexIndexY <= startY + PATCH_CELLS; vertexIndexY++)
+			{
+				for (uint32_t vertexIndexX = startX; vertexIndexX <= startX + PATCH_CELLS; vertexIndexX++)
+					rowPositions[vertexIndexX - startX] = float2(vertexIndexX * cellSize.x + minCorner.x,
+						vertexIndexY * cellSize.y + minCorner.y);
+
+				heightFieldSampler.GetHeights(rowPositions.data(), rowPositions.size(), rowHeights.data());
+
+				for (auto height : rowHeights)
+				{
+					minHeight = std::min(minHeight, height);
+					maxHeight = std::max(maxHeight, height);
+				}
+			}
+
+			auto localMinCorner = XMVectorSet(startX * cellSize.x + minCorner.x, startY * cellSize.y + minCorner.y,
+				minHeight, 0.0f);
+
+			auto localMaxCorner = XMVectorSet((startX + PATCH_CELLS) * cellSize.x + minCorner.x,
+				(startY + PATCH_CELLS) * cellSize.y + minCorner.y, maxHeight, 0.0f);
+
+			auto& patch = patches[patchIndexX + patchIndexY * patchesPerWidth];
+			patch.baseVertex = startX + startY * verticesPerWidth;
+
+			XMStoreFloat3(&patch.bounds.minCorner, localMinCorner + worldOffset);
+			XMStoreFloat3(&patch.bounds.maxCorner, localMaxCorner + worldOffset);
+		}
+	}
+
+	quadtreeNodes.clear();
+	quadtreeNodes.resize(1u);
+
+	BuildQuadtreeNode(0u, uint4(0u, 0u, patchesPerWidth, patchesPerHeight));
+}
+
+void Common::Logic::SceneEntity::Terrain::ValidateHeightFieldSampler(const std::vector<uint32_t>& patchIndices) const
+{
+	const auto& range = patchIndexRanges[0u];
+
+	auto trianglesNumber = static_cast<uint64_t>(patches.size()) * (range.indicesNumber / 3u);
+	auto triangleStep = std::max<uint64_t>(trianglesNumber / VALIDATION_TRIANGLES_NUMBER, 1u);
+
+	auto cellSize = float2(mapSize.x / (verticesPerWidth - 1), mapSize.y / (verticesPerHeight - 1));
+	auto tolerance = VALIDATION_HEIGHT_TOLERANCE * std::max(mapSize.z, 1.0f);
+
+	std::array<float3, 3u> barycentrics
+	{
+		float3(1.0f / 3.0f, 1.0f / 3.0f, 1.0f / 3.0f),
+		float3(0.7f, 0.2f, 0.1f),
+		float3(0.1f, 0.1f, 0.8f)
 	};
 
-	auto positionAverage = float3(fetchedPosition.x * verticesPerWidth, fetchedPosition.y * verticesPerHeight, 0.0f);
-	
-	auto positionMin = float2(std::floor(positionAverage.x), std::floor(positionAverage.y));
-	auto positionMax = float2(positionMin.x + 1.0f, positionMin.y + 1.0f);
+	std::vector<float2> positions;
+	std::vector<float> triangleHeights;
 
-	index00 = std::min(static_cast<uint32_t>(std::lroundf(std::min(positionMin.x, verticesPerWidth - 1.0f) +
-		positionMin.y * verticesPerWidth)), static_cast<uint32_t>(normalHeightData.size()) - 1u);
+	for (uint64_t triangleIndex = 0u; triangleIndex < trianglesNumber; triangleIndex += triangleStep)
+	{
+		const auto& patch = patches[triangleIndex / (range.indicesNumber / 3u)];
+		auto firstIndex = range.startIndex + static_cast<uint32_t>(triangleIndex % (range.indicesNumber / 3u)) * 3u;
 
-	index10 = std::min(static_cast<uint32_t>(std::lroundf(std::min(positionMax.x, verticesPerWidth - 1.0f) +
-		positionMax.y * verticesPerWidth)), static_cast<uint32_t>(normalHeightData.size()) - 1u);
+		std::array<float3, 3u> vertices;
 
-	index01 = std::min(index00 + verticesPerWidth, static_cast<uint32_t>(normalHeightData.size()) - 1u);
-	index11 = std::min(index10 + verticesPerWidth, static_cast<uint32_t>(normalHeightData.size()) - 1u);
+		for (uint32_t cornerIndex = 0u; cornerIndex < 3u; cornerIndex++)
+		{
+			auto vertexIndex = patch.baseVertex + patchIndices[firstIndex + cornerIndex];
 
-	auto cellSize = float2(positionMax.x - positionMin.x, positionMax.y - positionMin.y);
-	
-	auto position00 = float3(positionMin.x, positionMin.y, 0.0f);
-	auto position01 = float3(positionMin.x, positionMax.y, 0.0f);
-	auto position11 = float3(positionMax.x, positionMax.y, 0.0f);
-	auto position10 = float3(positionMax.x, positionMin.y, 0.0f);
-	
-	auto linearY = (positionAverage.x - positionMin.x) * cellSize.y / cellSize.x + positionMin.y;
+			vertices[cornerIndex].x = (vertexIndex % verticesPerWidth) * cellSize.x + minCorner.x;
+			vertices[cornerIndex].y = (vertexIndex / verticesPerWidth) * cellSize.y + minCorner.y;
+			vertices[cornerIndex].z = XMVectorGetW(normalHeightData[vertexIndex]) + minCorner.z;
+		}
 
-	if (positionAverage.y > linearY)
+		for (const auto& barycentric : barycentrics)
+		{
+			positions.emplace_back
+			(
+				vertices[0u].x * barycentric.x + vertices[1u].x * barycentric.y + vertices[2u].x * barycentric.z,
+				vertices[0u].y * barycentric.x + vertices[1u].y * barycentric.y + vertices[2u].y * barycentric.z
+			);
+
+			triangleHeights.push_back(vertices[0u].z * barycentric.x + vertices[1u].z * barycentric.y +
+				vertices[2u].z * barycentric.z);
+		}
+	}
+
+	std::vector<float> batchHeights(positions.size());
+	heightFieldSampler.GetHeights(positions.data(), positions.size(), batchHeights.data());
+
+	uint32_t errorsNumber = 0u;
+
+	for (size_t sampleIndex = 0u; sampleIndex < positions.size(); sampleIndex++)
 	{
-		auto barycentrics = GeometryUtilities::CalculateBarycentric(position00, position01, position11, positionAverage);
+		auto height = heightFieldSampler.GetHeight(positions[sampleIndex]);
 
-		barycentricCoord.x = barycentrics.x;
-		barycentricCoord.y = barycentrics.y;
-		barycentricCoord.z = barycentrics.z;
-		barycentricCoord.w = 0.0f;
+		if (std::abs(height - triangleHeights[sampleIndex]) > tolerance ||
+			std::abs(batchHeights[sampleIndex] - triangleHeights[sampleIndex]) > tolerance)
+			errorsNumber++;
 	}
-	else
+
+	if (errorsNumber > 0u)
 	{
-		auto barycentrics = GeometryUtilities::CalculateBarycentric(position11, position10, position00, positionAverage);
+		auto message = "Terrain::ValidateHeightFieldSampler: " + std::to_string(errorsNumber) + " of " +
+			std::to_string(positions.size()) + " sampled heights differ from the rendered triangles\n";
+
+		OutputDebugStringA(message.c_str());
+	}
+}
+
+void Common::Logic::SceneEntity::Terrain::BuildQuadtreeNode(uint32_t nodeIndex, const uint4& patchRectangle)
+{
+	auto sizeX = patchRectangle.z - patchRectangle.x;
+	auto sizeY = patchRectangle.w - patchRectangle.y;
 
-		barycentricCoord.x = barycentrics.z;
-		barycentricCoord.y = 0.0f;
-		barycentricCoord.z = barycentrics.x;
-		barycentricCoord.w = barycentrics.y;
+	if (sizeX == 1u && sizeY == 1u)
+	{
+		auto patchIndex = patchRectangle.x + patchRectangle.y * patchesPerWidth;
+
+		auto& node = quadtreeNodes[nodeIndex];
+		node.bounds = patches[patchIndex].bounds;
+		node.firstChild = 0u;
+		node.childrenNumber = 0u;
+		node.patchIndex = patchIndex;
+
+		return;
+	}
+
+	auto middleX = patchRectangle.x + (sizeX + 1u) / 2u;
+	auto middleY = patchRectangle.y + (sizeY + 1u) / 2u;
+
+	std::array<uint4, 4u> childRectangles
+	{
+		uint4(patchRectangle.x, patchRectangle.y, middleX, middleY),
+		uint4(middleX, patchRectangle.y, patchRectangle.z, middleY),
+		uint4(patchRectangle.x, middleY, middleX, patchRectangle.w),
+		uint4(middleX, middleY, patchRectangle.z, patchRectangle.w)
+	};
+
+	auto firstChild = static_cast<uint32_t>(quadtreeNodes.size());
+	uint32_t childrenNumber = 0u;
+
+	for (const auto& childRectangle : childRectangles)
+		if (childRectangle.x < childRectangle.z && childRectangle.y < childRectangle.w)
+			childrenNumber++;
+
+	quadtreeNodes.resize(quadtreeNodes.size() + childrenNumber);
+
+	auto childIndex = firstChild;
+	auto bounds = patches[patchRectangle.x + patchRectangle.y * patchesPerWidth].bounds;
+
+	for (const auto& childRectangle : childRectangles)
+	{
+		if (childRectangle.x >= childRectangle.z || childRectangle.y >= childRectangle.w)
+			continue;
+
+		BuildQuadtreeNode(childIndex, childRectangle);
+		bounds = GeometryUtilities::MergeBoxes(bounds, quadtreeNodes[childIndex].bounds);
+
+		childIndex++;
+	}
+
+	auto& node = quadtreeNodes[nodeIndex];
+	node.bounds = bounds;
+	node.firstChild = firstChild;
+	node.childrenNumber = childrenNumber;
+	node.patchIndex = 0u;
+}
+
+void Common::Logic::SceneEntity::Terrain::SelectPatches(const float3& viewPosition, const Frustum* frustums,
+	uint32_t frustumsNumber, uint32_t activeFaceMask, std::vector<PatchDrawItem>& drawItems)
+{
+	for (uint32_t patchIndex = 0u; patchIndex < patches.size(); patchIndex++)
+		patchLods[patchIndex] = CalculateLod(patches[patchIndex].bounds, viewPosition);
+
+	auto isChanged = true;
+
+	while (isChanged)
+	{
+		isChanged = false;
+
+		for (uint32_t patchIndexY = 0u; patchIndexY < patchesPerHeight; patchIndexY++)
+			for (uint32_t patchIndexX = 0u; patchIndexX < patchesPerWidth; patchIndexX++)
+			{
+				auto patchIndex = patchIndexX + patchIndexY * patchesPerWidth;
+				auto lod = patchLods[patchIndex];
+
+				if (patchIndexX > 0u)
+					lod = std::min(lod, patchLods[patchIndex - 1u] + 1u);
+
+				if (patchIndexX + 1u < patchesPerWidth)
+					lod = std::min(lod, patchLods[patchIndex + 1u] + 1u);
+
+				if (patchIndexY > 0u)
+					lod = std::min(lod, patchLods[patchIndex - patchesPerWidth] + 1u);
+
+				if (patchIndexY + 1u < patchesPerHeight)
+					lod = std::min(lod, patchLods[patchIndex + patchesPerWidth] + 1u);
+
+				if (lod != patchLods[patchIndex])
+				{
+					patchLods[patchIndex] = lod;
+					isChanged = true;
+				}
+			}
+	}
+
+	drawItems.clear();
+	traversalStack.clear();
+	traversalStack.push_back(uint2(0u, activeFaceMask & ((1u << frustumsNumber) - 1u)));
+
+	while (!traversalStack.empty())
+	{
+		auto [nodeIndex, parentMask] = traversalStack.back();
+		traversalStack.pop_back();
+
+		const auto& node = quadtreeNodes[nodeIndex];
+		uint32_t faceMask = 0u;
+
+		for (uint32_t frustumIndex = 0u; frustumIndex < frustumsNumber; frustumIndex++)
+			if ((parentMask & (1u << frustumIndex)) != 0u && frustums[frustumIndex].Intersects(node.bounds))
+				faceMask |= 1u << frustumIndex;
+
+		if (faceMask == 0u)
+			continue;
+
+		if (node.childrenNumber == 0u)
+		{
+			auto patchIndexX = node.patchIndex % patchesPerWidth;
+			auto patchIndexY = node.patchIndex / patchesPerWidth;
+
+			PatchDrawItem drawItem{};
+			drawItem.patchIndex = node.patchIndex;
+			drawItem.rangeIndex = patchLods[node.patchIndex] * STITCH_MASKS_NUMBER + CalculateStitchMask(patchIndexX, patchIndexY);
+			drawItem.faceMask = faceMask;
+
+			drawItems.push_back(drawItem);
+
+			continue;
+		}
+
+		for (uint32_t childIndex = 0u; childIndex < node.childrenNumber; childIndex++)
+			traversalStack.push_back(uint2(node.firstChild + childIndex, faceMask));
+	}
+}
+
+uint32_t Common::Logic::SceneEntity::Terrain::CalculateLod(const AxisAlignedBox& bounds, const float3& viewPosition) const
+{
+	auto distance = GeometryUtilities::DistanceToBox(bounds, viewPosition);
+	auto lod = static_cast<uint32_t>(std::log2(std::max(distance / lodDistance, 1.0f)));
+
+	return std::min(lod, LOD_LEVELS_NUMBER - 1u);
+}
+
+uint32_t Common::Logic::SceneEntity::Terrain::CalculateStitchMask(uint32_t patchIndexX, uint32_t patchIndexY) const
+{
+	auto patchIndex = patchIndexX + patchIndexY * patchesPerWidth;
+	auto lod = patchLods[patchIndex];
+
+	uint32_t stitchMask = 0u;
+
+	if (patchIndexX > 0u && patchLods[patchIndex - 1u] > lod)
+		stitchMask |= STITCH_LEFT;
+
+	if (patchIndexX + 1u < patchesPerWidth && patchLods[patchIndex + 1u] > lod)
+		stitchMask |= STITCH_RIGHT;
+
+	if (patchIndexY > 0u && patchLods[patchIndex - patchesPerWidth] > lod)
+		stitchMask |= STITCH_BOTTOM;
+
+	if (patchIndexY + 1u < patchesPerHeight && patchLods[patchIndex + patchesPerWidth] > lod)
+		stitchMask |= STITCH_TOP;
+
+	return stitchMask;
+}
+
+void Common::Logic::SceneEntity::Terrain::DrawPatches(ID3D12GraphicsCommandList* commandList,
+	const std::vector<PatchDrawItem>& drawItems) const
+{
+	mesh->SetInputAssemblerOnly(commandList);
+
+	for (const auto& drawItem : drawItems)
+	{
+		const auto& range = patchIndexRanges[drawItem.rangeIndex];
+		mesh->DrawRange(commandList, range.indicesNumber, range.startIndex, static_cast<int32_t>(patches[drawItem.patchIndex].baseVertex));
 	}
 }
@@ -3,6 +3,8 @@
 #include "../../../Includes.h"
 #include "../../../Graphics/Assets/Material.h"
 #include "../../../Graphics/Assets/Mesh.h"
+#include "../../../Graphics/Assets/Frustum.h"
+#include "../../../Graphics/Assets/HeightFieldSampler.h"
 #include "../../../Graphics/DirectX12Renderer.h"
 #include "LightingSystem.h"
 #include "Camera.h"
@@ -15,6 +17,7 @@ namespace Common::Logic::SceneEntity
 		uint32_t verticesPerWidth;
 		uint32_t verticesPerHeight;
 		float3 size;
+		float lodDistance;
 
 		float2 map0Tiling;
 		float2 map1Tiling;
@@ -23,10 +26,17 @@ namespace Common::Logic::SceneEntity
 
 		bool hasDepthPrepass;
 		bool hasParticleLighting;
+		bool hasClusteredLighting;
+		bool hasCascadedShadows;
 		bool outputVelocity;
+		bool quantizeVertices;
 
 		Graphics::Resources::ResourceID lightConstantBufferId;
 		Graphics::Resources::ResourceID lightParticleBufferId;
+		Graphics::Resources::ResourceID lightMatricesConstantBufferId;
+		Graphics::Resources::ResourceID lightClusterConstantBufferId;
+		Graphics::Resources::ResourceID lightClusterCountBufferId;
+		Graphics::Resources::ResourceID lightClusterIndexBufferId;
 		std::vector<Graphics::Resources::ResourceID> shadowMapIds;
 		const std::vector<DxcDefine>* shaderDefines;
 		
@@ -56,29 +66,92 @@ namespace Common::Logic::SceneEntity
 		const float4x4& GetWorld() const;
 		float GetHeight(const float2& position) const;
 		float3 GetNormal(const float2& position) const;
+		const Graphics::Assets::HeightFieldSampler& GetHeightFieldSampler() const noexcept;
 
 		const float3& GetSize() const noexcept;
 		const float3& GetMinCorner() const noexcept;
 
+		bool GetBounds(Graphics::Assets::AxisAlignedBox& bounds, Graphics::Assets::BoundingSphere& boundingSphere) const;
+
 		void Update(const Camera* camera, float time);
 		void DrawDepthPrepass(ID3D12GraphicsCommandList* commandList);
-		void DrawShadows(ID3D12GraphicsCommandList* commandList, uint32_t lightMatrixStartIndex);
-		void DrawShadowsCube(ID3D12GraphicsCommandList* commandList, uint32_t lightMatrixStartIndex);
+		void DrawShadows(ID3D12GraphicsCommandList* commandList, const LightDesc& lightDesc);
+		void DrawShadowsCube(ID3D12GraphicsCommandList* commandList, const LightDesc& lightDesc);
 		void Draw(ID3D12GraphicsCommandList* commandList);
 
 		void Release(Graphics::Resources::ResourceManager* resourceManager);
 
+		static constexpr uint32_t PATCH_CELLS = 32u;
+		static constexpr uint32_t LOD_LEVELS_NUMBER = 4u;
+		static constexpr uint32_t STITCH_MASKS_NUMBER = 16u;
+		static constexpr uint32_t CUBE_FACES_NUMBER = 6u;
+		static constexpr uint32_t ROWS_PER_TASK = 16u;
+		static constexpr uint32_t VALIDATION_TRIANGLES_NUMBER = 4096u;
+		static constexpr float VALIDATION_HEIGHT_TOLERANCE = 1e-4f;
+
+		static constexpr uint32_t CACHE_MAGIC = 0x4E525254u;
+		static constexpr uint32_t CACHE_VERSION = 1u;
+
+		static constexpr uint32_t STITCH_LEFT = 1u;
+		static constexpr uint32_t STITCH_RIGHT = 2u;
+		static constexpr uint32_t STITCH_BOTTOM = 4u;
+		static constexpr uint32_t STITCH_TOP = 8u;
+
 	private:
 		Terrain() = delete;
 
+		struct TerrainPatch
+		{
+		public:
+			Graphics::Assets::AxisAlignedBox bounds;
+			uint32_t baseVertex;
+		};
+
+		struct QuadtreeNode
+		{
+		public:
+			Graphics::Assets::AxisAlignedBox bounds;
+			uint32_t firstChild;
+			uint32_t childrenNumber;
+			uint32_t patchIndex;
+		};
+
+		struct PatchIndexRange
+		{
+		public:
+			uint32_t startIndex;
+			uint32_t indicesNumber;
+		};
+
+		struct PatchDrawItem
+		{
+		public:
+			uint32_t patchIndex;
+			uint32_t rangeIndex;
+			uint32_t faceMask;
+		};
+
 		void LoadNormalHeightData(const std::filesystem::path& heightMapFileName);
 		void GenerateMesh(const std::filesystem::path& terrainFileName,
-			const std::filesystem::path& blendMapFileName, ID3D12GraphicsCommandList* commandList,
-			Graphics::DirectX12Renderer* renderer);
+			const std::filesystem::path& blendMapFileName, const std::vector<uint32_t>& patchIndices,
+			ID3D12GraphicsCommandList* commandList, Graphics::DirectX12Renderer* renderer);
+
+		void BuildPatchIndices(std::vector<uint32_t>& patchIndices);
+		void BuildPatches();
+		void ValidateHeightFieldSampler(const std::vector<uint32_t>& patchIndices) const;
+		void BuildQuadtreeNode(uint32_t nodeIndex, const uint4& patchRectangle);
+
+		void SelectPatches(const float3& viewPosition, const Graphics::Assets::Frustum* frustums,
+			uint32_t frustumsNumber, uint32_t activeFaceMask, std::vector<PatchDrawItem>& drawItems);
+		uint32_t CalculateLod(const Graphics::Assets::AxisAlignedBox& bounds, const float3& viewPosition) const;
+		uint32_t CalculateStitchMask(uint32_t patchIndexX, uint32_t patchIndexY) const;
+		void DrawPatches(ID3D12GraphicsCommandList* commandList, const std::vector<PatchDrawItem>& drawItems) const;
 		
 		void CreateConstantBuffers(ID3D12Device* device, ID3D12GraphicsCommandList* commandList,
 			Graphics::Resources::ResourceManager* resourceManager, const TerrainDesc& desc);
 
+		void UploadMutableConstants();
+
 		void LoadShaders(ID3D12Device* device, Graphics::Resources::ResourceManager* resourceManager,
 			const TerrainDesc& desc);
 
@@ -88,43 +161,19 @@ namespace Common::Logic::SceneEntity
 		void CreateMaterial(ID3D12Device* device, Graphics::Resources::ResourceManager* resourceManager,
 			const TerrainDesc& desc);
 
-		void LoadCache(const std::filesystem::path& fileName, ID3D12Device* device,
+		bool LoadCache(const std::filesystem::path& fileName, ID3D12Device* device,
 			ID3D12GraphicsCommandList* commandList, Graphics::Resources::ResourceManager* resourceManager);
 		void SaveCache(const std::filesystem::path& fileName, const Graphics::Assets::MeshDesc& meshDesc,
 			const std::vector<uint8_t>& verticesData, const std::vector<uint8_t>& indicesData) const;
 
-		void FetchCoord(const float2& position, uint32_t& index00, uint32_t& index10,
-			uint32_t& index01, uint32_t& index11, float4& barycentricCoord) const;
-
 		template<typename T>
-		void FillIndices(T* indicesPtr, uint32_t indicesNumber)
+		void FillIndices(T* indicesPtr, const std::vector<uint32_t>& patchIndices)
 		{
-			auto cellsPerWidth = verticesPerWidth - 1;
-			auto cellsPerHeight = verticesPerHeight - 1;
-
-			for (uint32_t cellIndexY = 0u; cellIndexY < cellsPerHeight; cellIndexY++)
-				for (uint32_t cellIndexX = 0u; cellIndexX < cellsPerWidth; cellIndexX++)
-				{
-					auto startIndex = cellIndexX + cellIndexY * verticesPerWidth;
-
-					*indicesPtr = startIndex;
-					indicesPtr++;
-
-					*indicesPtr = startIndex + 1u;
-					indicesPtr++;
-
-					*indicesPtr = startIndex + verticesPerWidth;
-					indicesPtr++;
-
-					*indicesPtr = startIndex + verticesPerWidth;
-					indicesPtr++;
-
-					*indicesPtr = startIndex + 1u;
-					indicesPtr++;
-
-					*indicesPtr = startIndex + verticesPerWidth + 1u;
-					indicesPtr++;
-				}
+			for (auto index : patchIndices)
+			{
+				*indicesPtr = static_cast<T>(index);
+				indicesPtr++;
+			}
 		}
 
 		struct TerrainVertex
@@ -160,6 +209,11 @@ namespace Common::Logic::SceneEntity
 			float mipBias;
 			float padding;
 
+			float3 positionOffset;
+			float padding1;
+			float3 positionScale;
+			float padding2;
+
 			float4x4 lastViewProjection;
 		};
 
@@ -167,22 +221,46 @@ namespace Common::Logic::SceneEntity
 		{
 			float4x4 world;
 			uint32_t lightMatrixStartIndex;
+			uint32_t faceMask;
 		};
 
 		DepthPassConstants depthPassConstants;
+		float4x4 world;
+		Graphics::Assets::VertexQuantizationDesc quantizationDesc;
 
 		std::vector<floatN> normalHeightData;
+		Graphics::Assets::HeightFieldSampler heightFieldSampler;
+
+		std::vector<TerrainPatch> patches;
+		std::vector<QuadtreeNode> quadtreeNodes;
+		std::vector<PatchIndexRange> patchIndexRanges;
+		std::vector<uint32_t> patchLods;
+		std::vector<uint2> traversalStack;
+		std::vector<PatchDrawItem> visiblePatches;
+		std::vector<PatchDrawItem> shadowPatches;
+
+		Graphics::Assets::Frustum cameraFrustum;
+		std::array<Graphics::Assets::Frustum, CUBE_FACES_NUMBER> shadowFrustums;
 
 		uint32_t verticesPerWidth;
 		uint32_t verticesPerHeight;
+		uint32_t patchesPerWidth;
+		uint32_t patchesPerHeight;
+		uint32_t patchIndicesNumber;
+		float lodDistance;
 		
 		float3 minCorner;
 		float3 mapSize;
 
 		bool hasDepthPass;
 		bool hasDepthPassCube;
+		bool quantizeVertices;
 
+		MutableConstants mutableConstants;
 		MutableConstants* mutableConstantsBuffer;
+		D3D12_GPU_VIRTUAL_ADDRESS mutableConstantsAddress;
+
+		Graphics::FrameAllocator* frameAllocator;
 
 		Graphics::Resources::ResourceID lightConstantBufferId;
 		Graphics::Resources::ResourceID mutableConstantsId;
@@ -17,6 +17,7 @@ Common::Logic::SceneEntity::VFXLux::VFXLux(ID3D12GraphicsCommandList* commandLis
 	auto resourceManager = renderer->GetResourceManager();
 
 	_camera = camera;
+	bindlessRootSignature = renderer->GetBindlessRootSignature();
 	
 	CreateConstantBuffers(device, commandList, resourceManager, position);
 	LoadShaders(device, resourceManager);
@@ -146,17 +147,24 @@ void Common::Logic::SceneEntity::VFXLux::CreateConstantBuffers(ID3D12Device* dev
 
 void Common::Logic::SceneEntity::VFXLux::LoadShaders(ID3D12Device* device, Graphics::Resources::ResourceManager* resourceManager)
 {
+	auto shaderVersion = bindlessRootSignature != nullptr ? ShaderVersion::SM_6_6 : ShaderVersion::SM_6_5;
+
+	std::vector<DxcDefine> defines;
+
+	if (bindlessRootSignature != nullptr)
+		defines.push_back({ L"BINDLESS", nullptr });
+
 	vfxLuxCircleVSId = resourceManager->CreateShaderResource(device, "Resources\\Shaders\\FX\\VFXLuxCircleVS.hlsl",
-		ShaderType::VERTEX_SHADER, ShaderVersion::SM_6_5);
+		ShaderType::VERTEX_SHADER, shaderVersion);
 
 	vfxLuxHaloVSId = resourceManager->CreateShaderResource(device, "Resources\\Shaders\\FX\\VFXLuxHaloVS.hlsl",
-		ShaderType::VERTEX_SHADER, ShaderVersion::SM_6_5);
+		ShaderType::VERTEX_SHADER, shaderVersion);
 
 	vfxLuxHaloPSId = resourceManager->CreateShaderResource(device, "Resources\\Shaders\\FX\\VFXLuxHaloPS.hlsl",
-		ShaderType::PIXEL_SHADER, ShaderVersion::SM_6_5);
+		ShaderType::PIXEL_SHADER, shaderVersion, defines);
 
 	vfxLuxCirclePSId = resourceManager->CreateShaderResource(device, "Resources\\Shaders\\FX\\VFXLuxCirclePS.hlsl",
-		ShaderType::PIXEL_SHADER, ShaderVersion::SM_6_5);
+		ShaderType::PIXEL_SHADER, shaderVersion, defines);
 }
 
 void Common::Logic::SceneEntity::VFXLux::LoadTextures(ID3D12Device* device, ID3D12GraphicsCommandList* commandList,
@@ -336,12 +344,28 @@ void Common::Logic::SceneEntity::VFXLux::CreateMaterials(ID3D12Device* device, R
 	auto blendSetup = Graphics::DefaultBlendSetup::BLEND_TRANSPARENT;
 	auto blendAddSetup = Graphics::DefaultBlendSetup::BLEND_PREMULT_ALPHA_ADDITIVE;
 
+	auto isBindless = bindlessRootSignature != nullptr;
+	auto srvType = DescriptorType::CBV_SRV_UAV;
+	auto samplerType = DescriptorType::SAMPLER;
+
 	MaterialBuilder materialBuilder{};
 	materialBuilder.SetConstantBuffer(0u, circleConstantsResource->resourceGPUAddress);
-	materialBuilder.SetTexture(0u, haloSpectrumResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
-	materialBuilder.SetTexture(1u, volumeNoiseResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
-	materialBuilder.SetTexture(2u, perlinNoiseResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
-	materialBuilder.SetSampler(0u, samplerLinearResource->samplerDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
+
+	if (isBindless)
+	{
+		materialBuilder.SetBindlessIndex(0u, resourceManager->GetBindlessIndex(srvType, haloSpectrumResource->srvDescriptor));
+		materialBuilder.SetBindlessIndex(1u, resourceManager->GetBindlessIndex(srvType, volumeNoiseResource->srvDescriptor));
+		materialBuilder.SetBindlessIndex(2u, resourceManager->GetBindlessIndex(srvType, perlinNoiseResource->srvDescriptor));
+		materialBuilder.SetBindlessIndex(3u, resourceManager->GetBindlessIndex(samplerType, samplerLinearResource->samplerDescriptor));
+	}
+	else
+	{
+		materialBuilder.SetTexture(0u, haloSpectrumResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
+		materialBuilder.SetTexture(1u, volumeNoiseResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
+		materialBuilder.SetTexture(2u, perlinNoiseResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
+		materialBuilder.SetSampler(0u, samplerLinearResource->samplerDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
+	}
+
 	materialBuilder.SetCullMode(D3D12_CULL_MODE_NONE);
 	materialBuilder.SetBlendMode(Graphics::DirectX12Utilities::CreateBlendDesc(blendSetup));
 	materialBuilder.SetDepthStencilFormat(32u, false);
@@ -350,12 +374,24 @@ void Common::Logic::SceneEntity::VFXLux::CreateMaterials(ID3D12Device* device, R
 	materialBuilder.SetVertexShader(vfxLuxCircleVS->bytecode);
 	materialBuilder.SetPixelShader(vfxLuxCirclePS->bytecode);
 
-	circleMaterial = materialBuilder.ComposeStandard(device);
+	circleMaterial = isBindless ? materialBuilder.ComposeBindless(device, bindlessRootSignature) :
+		materialBuilder.ComposeStandard(device);
 
 	materialBuilder.SetConstantBuffer(0u, haloConstantsResource->resourceGPUAddress);
-	materialBuilder.SetTexture(0u, perlinNoiseResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
-	materialBuilder.SetTexture(1u, haloSpectrumResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
-	materialBuilder.SetSampler(0u, samplerLinearResource->samplerDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
+
+	if (isBindless)
+	{
+		materialBuilder.SetBindlessIndex(0u, resourceManager->GetBindlessIndex(srvType, perlinNoiseResource->srvDescriptor));
+		materialBuilder.SetBindlessIndex(1u, resourceManager->GetBindlessIndex(srvType, haloSpectrumResource->srvDescriptor));
+		materialBuilder.SetBindlessIndex(2u, resourceManager->GetBindlessIndex(samplerType, samplerLinearResource->samplerDescriptor));
+	}
+	else
+	{
+		materialBuilder.SetTexture(0u, perlinNoiseResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
+		materialBuilder.SetTexture(1u, haloSpectrumResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
+		materialBuilder.SetSampler(0u, samplerLinearResource->samplerDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
+	}
+
 	materialBuilder.SetCullMode(D3D12_CULL_MODE_NONE);
 	materialBuilder.SetBlendMode(Graphics::DirectX12Utilities::CreateBlendDesc(blendSetup));
 	materialBuilder.SetDepthStencilFormat(32u, false);
@@ -364,7 +400,8 @@ void Common::Logic::SceneEntity::VFXLux::CreateMaterials(ID3D12Device* device, R
 	materialBuilder.SetVertexShader(vfxLuxHaloVS->bytecode);
 	materialBuilder.SetPixelShader(vfxLuxHaloPS->bytecode);
 
-	haloMaterial = materialBuilder.ComposeStandard(device);
+	haloMaterial = isBindless ? materialBuilder.ComposeBindless(device, bindlessRootSignature) :
+		materialBuilder.ComposeStandard(device);
 }
 
 uint8_t Common::Logic::SceneEntity::VFXLux::FloatToColorChannel(float value)
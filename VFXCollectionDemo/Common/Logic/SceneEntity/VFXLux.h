@@ -178,6 +178,7 @@ namespace Common::Logic::SceneEntity
 		VFXHaloConstants* haloConstants;
 
 		Camera* _camera;
+		ID3D12RootSignature* bindlessRootSignature;
 		
 		Graphics::Resources::ResourceID circleConstantsId;
 		Graphics::Resources::ResourceID haloConstantsId;
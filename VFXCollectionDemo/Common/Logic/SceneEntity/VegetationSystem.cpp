@@ -5,7 +5,10 @@
 #include "../../../Graphics/Assets/Loaders/OBJLoader.h"
 #include "../../../Graphics/Assets/Loaders/DDSLoader.h"
 #include "../../../Graphics/Assets/GeometryUtilities.h"
+#include "../../../Graphics/Assets/VertexCompressor.h"
+#include "../../../Graphics/Assets/Generators/PoissonDiskGenerator.h"
 #include "../../Utilities.h"
+#include "../../TaskScheduler.h"
 
 using namespace DirectX;
 using namespace DirectX::PackedVector;
@@ -14,18 +17,17 @@ using namespace Graphics;
 using namespace Graphics::Resources;
 using namespace Graphics::Assets;
 using namespace Graphics::Assets::Loaders;
+using namespace Graphics::Assets::Generators;
 
 Common::Logic::SceneEntity::VegatationSystem::VegatationSystem(ID3D12GraphicsCommandList* commandList,
 	Graphics::DirectX12Renderer* renderer, const VegetationSystemDesc& desc, const Camera* camera)
-	: materialDepthPass(nullptr), materialDepthCubePass(nullptr)
+	: materialDepthPrepass(nullptr), materialDepthPass(nullptr), materialDepthCubePass(nullptr)
 {
 	_camera = camera;
+	frameAllocator = renderer->GetFrameAllocator();
 	lightConstantBufferId = desc.lightConstantBufferId;
 	lightMatricesConstantBufferId = desc.lightMatricesConstantBufferId;
 
-	std::random_device randomDevice;
-	randomEngine = std::mt19937(randomDevice());
-
 	auto device = renderer->GetDevice();
 	auto resourceManager = renderer->GetResourceManager();
 
@@ -35,6 +37,8 @@ Common::Logic::SceneEntity::VegatationSystem::VegatationSystem(ID3D12GraphicsCom
 	LoadShaders(device, resourceManager, desc);
 	LoadTextures(device, commandList, resourceManager, desc);
 	CreateMaterials(device, resourceManager, desc);
+
+	*mutableConstantsBuffer = mutableConstants;
 }
 
 Common::Logic::SceneEntity::VegatationSystem::~VegatationSystem()
@@ -44,16 +48,23 @@ Common::Logic::SceneEntity::VegatationSystem::~VegatationSystem()
 
 void Common::Logic::SceneEntity::VegatationSystem::Update(float time, float deltaTime)
 {
-	mutableConstantsBuffer->lastTime = mutableConstantsBuffer->time;
-	mutableConstantsBuffer->lastWindDirection = mutableConstantsBuffer->windDirection;
-	mutableConstantsBuffer->lastWindStrength = mutableConstantsBuffer->windStrength;
-	mutableConstantsBuffer->lastViewProjection = mutableConstantsBuffer->viewProjection;
+	mutableConstants.lastTime = mutableConstants.time;
+	mutableConstants.lastWindDirection = mutableConstants.windDirection;
+	mutableConstants.lastWindStrength = mutableConstants.windStrength;
+	mutableConstants.lastViewProjection = mutableConstants.viewProjection;
+
+	mutableConstants.viewProjection = _camera->GetViewProjection();
+	mutableConstants.cameraPosition = _camera->GetPosition();
+	mutableConstants.time = time;
+	mutableConstants.windDirection = *windDirection;
+	mutableConstants.windStrength = *windStrength;
+
+	UploadMutableConstants();
 
-	mutableConstantsBuffer->viewProjection = _camera->GetViewProjection();
-	mutableConstantsBuffer->cameraPosition = _camera->GetPosition();
-	mutableConstantsBuffer->time = time;
-	mutableConstantsBuffer->windDirection = *windDirection;
-	mutableConstantsBuffer->windStrength = *windStrength;
+	UpdateCellDensities(mutableConstants.cameraPosition);
+
+	cameraFrustum = _camera->GetFrustum();
+	SelectCells(&cameraFrustum, 1u, ALL_FACES_MASK, visibleCells);
 }
 
 void Common::Logic::SceneEntity::VegatationSystem::OnCompute(ID3D12GraphicsCommandList* commandList)
@@ -64,7 +75,7 @@ void Common::Logic::SceneEntity::VegatationSystem::OnCompute(ID3D12GraphicsComma
 void Common::Logic::SceneEntity::VegatationSystem::DrawDepthPrepass(ID3D12GraphicsCommandList* commandList)
 {
 	materialDepthPrepass->Set(commandList);
-	_mesh->Draw(commandList, instancesNumber);
+	DrawCells(commandList, materialDepthPrepass, visibleCells);
 }
 
 void Common::Logic::SceneEntity::VegatationSystem::DrawShadows(ID3D12GraphicsCommandList* commandList,
@@ -72,25 +83,66 @@ void Common::Logic::SceneEntity::VegatationSystem::DrawShadows(ID3D12GraphicsCom
 {
 	auto lightMatrixIndex = lightMatrixStartIndex;
 
+	SelectCells(nullptr, 0u, ALL_FACES_MASK, shadowCells);
+
 	materialDepthPass->Set(commandList);
 	materialDepthPass->SetRootConstant(commandList, 0u, &lightMatrixIndex);
-	_mesh->Draw(commandList, instancesNumber);
+	DrawCells(commandList, materialDepthPass, shadowCells);
 }
 
 void Common::Logic::SceneEntity::VegatationSystem::DrawShadowsCube(ID3D12GraphicsCommandList* commandList,
 	uint32_t lightMatrixStartIndex)
 {
-	auto lightMatrixIndex = lightMatrixStartIndex;
+	SelectCells(nullptr, 0u, ALL_FACES_MASK, shadowCells);
+	DrawCellsCube(commandList, lightMatrixStartIndex, shadowCells);
+}
 
-	materialDepthCubePass->Set(commandList);
-	materialDepthCubePass->SetRootConstant(commandList, 0u, &lightMatrixIndex);
-	_mesh->Draw(commandList, instancesNumber);
+void Common::Logic::SceneEntity::VegatationSystem::DrawShadows(ID3D12GraphicsCommandList* commandList,
+	const LightDesc& lightDesc)
+{
+	if ((lightDesc.GetShadowFaceMask() & 1u) == 0u)
+		return;
+
+	auto lightMatrixIndex = lightDesc.GetLightMatrixStartIndex();
+
+	shadowFrustums[0u] = lightDesc.GetFrustum();
+	SelectCells(shadowFrustums.data(), 1u, 1u, shadowCells);
+
+	materialDepthPass->Set(commandList);
+	materialDepthPass->SetRootConstant(commandList, 0u, &lightMatrixIndex);
+	DrawCells(commandList, materialDepthPass, shadowCells);
+}
+
+void Common::Logic::SceneEntity::VegatationSystem::DrawShadowsCube(ID3D12GraphicsCommandList* commandList,
+	const LightDesc& lightDesc)
+{
+	if (lightDesc.GetShadowFaceMask() == 0u)
+		return;
+
+	auto facesNumber = std::min(lightDesc.GetShadowFacesNumber(), CUBE_FACES_NUMBER);
+
+	for (uint32_t faceIndex = 0u; faceIndex < facesNumber; faceIndex++)
+		shadowFrustums[faceIndex] = lightDesc.GetFrustum(faceIndex);
+
+	SelectCells(shadowFrustums.data(), facesNumber, lightDesc.GetShadowFaceMask(), shadowCells);
+	DrawCellsCube(commandList, lightDesc.GetLightMatrixStartIndex(), shadowCells);
 }
 
 void Common::Logic::SceneEntity::VegatationSystem::Draw(ID3D12GraphicsCommandList* commandList)
 {
 	_material->Set(commandList);
-	_mesh->Draw(commandList, instancesNumber);
+	DrawCells(commandList, _material, visibleCells);
+}
+
+bool Common::Logic::SceneEntity::VegatationSystem::GetBounds(AxisAlignedBox& bounds, BoundingSphere& boundingSphere) const
+{
+	if (vegetationBounds.minCorner.x > vegetationBounds.maxCorner.x)
+		return false;
+
+	bounds = vegetationBounds;
+	boundingSphere = GeometryUtilities::CalculateBoundingSphere(vegetationBounds);
+
+	return true;
 }
 
 void Common::Logic::SceneEntity::VegatationSystem::Release(Graphics::Resources::ResourceManager* resourceManager)
@@ -207,29 +259,53 @@ void Common::Logic::SceneEntity::VegatationSystem::CreateConstantBuffers(ID3D12D
 
 	auto mutableConstantsResource = resourceManager->GetResource<ConstantBuffer>(mutableConstantsId);
 	mutableConstantsBuffer = reinterpret_cast<MutableConstants*>(mutableConstantsResource->resourceCPUAddress);
-	mutableConstantsBuffer->viewProjection = _camera->GetViewProjection();
-	mutableConstantsBuffer->cameraPosition = _camera->GetPosition();
-	mutableConstantsBuffer->time = 0.0f;
-	mutableConstantsBuffer->atlasElementSize.x = 1.0f / desc.atlasRows;
-	mutableConstantsBuffer->atlasElementSize.y = 1.0f / desc.atlasColumns;
-	mutableConstantsBuffer->perlinNoiseTiling = desc.perlinNoiseTiling;
-	mutableConstantsBuffer->windDirection = *desc.windDirection;
-	mutableConstantsBuffer->windStrength = *desc.windStrength;
-	mutableConstantsBuffer->zNear = LightingSystem::SHADOW_MAP_Z_NEAR;
-	mutableConstantsBuffer->zFar = LightingSystem::SHADOW_MAP_Z_FAR;
-	mutableConstantsBuffer->lastTime = 0.0f;
-
-	mutableConstantsBuffer->mipBias = std::log2(PostProcessManager::FSR_SIZE_NUMERATOR /
+	mutableConstantsAddress = mutableConstantsResource->resourceGPUAddress;
+
+	mutableConstants = {};
+	mutableConstants.viewProjection = _camera->GetViewProjection();
+	mutableConstants.cameraPosition = _camera->GetPosition();
+	mutableConstants.time = 0.0f;
+	mutableConstants.atlasElementSize.x = 1.0f / desc.atlasRows;
+	mutableConstants.atlasElementSize.y = 1.0f / desc.atlasColumns;
+	mutableConstants.perlinNoiseTiling = desc.perlinNoiseTiling;
+	mutableConstants.windDirection = *desc.windDirection;
+	mutableConstants.windStrength = *desc.windStrength;
+	mutableConstants.zNear = LightingSystem::SHADOW_MAP_Z_NEAR;
+	mutableConstants.zFar = LightingSystem::SHADOW_MAP_Z_FAR;
+	mutableConstants.lastTime = 0.0f;
+
+	mutableConstants.mipBias = std::log2(PostProcessManager::FSR_SIZE_NUMERATOR /
 		static_cast<float>(PostProcessManager::FSR_SIZE_DENOMINATOR)) - 2.0f;
 
-	mutableConstantsBuffer->lastWindDirection = mutableConstantsBuffer->windDirection;
-	mutableConstantsBuffer->lastWindStrength = mutableConstantsBuffer->windStrength;
-	mutableConstantsBuffer->lastViewProjection = mutableConstantsBuffer->viewProjection;
+	mutableConstants.lastWindDirection = mutableConstants.windDirection;
+	mutableConstants.lastWindStrength = mutableConstants.windStrength;
+	mutableConstants.lastViewProjection = mutableConstants.viewProjection;
 
 	windDirection = desc.windDirection;
 	windStrength = desc.windStrength;
 }
 
+void Common::Logic::SceneEntity::VegatationSystem::UploadMutableConstants()
+{
+	FrameAllocation constantsAllocation{};
+
+	if (!frameAllocator->AllocateConstants(mutableConstants, constantsAllocation))
+		return;
+
+	auto constantsAddress = constantsAllocation.gpuAddress;
+
+	_material->UpdateConstantBuffer(1u, constantsAddress);
+
+	if (materialDepthPrepass != nullptr)
+		materialDepthPrepass->UpdateConstantBuffer(1u, constantsAddress);
+
+	if (materialDepthPass != nullptr)
+		materialDepthPass->UpdateConstantBuffer(1u, constantsAddress);
+
+	if (materialDepthCubePass != nullptr)
+		materialDepthCubePass->UpdateConstantBuffer(1u, constantsAddress);
+}
+
 void Common::Logic::SceneEntity::VegatationSystem::CreateBuffers(ID3D12Device* device,
 	ID3D12GraphicsCommandList* commandList, Graphics::Resources::ResourceManager* resourceManager,
 	const VegetationSystemDesc& desc)
@@ -247,39 +323,56 @@ void Common::Logic::SceneEntity::VegatationSystem::CreateBuffers(ID3D12Device* d
 		loadCache = cacheFileTimestamp >= mapFileTimestamp;
 	}
 
-	if (std::filesystem::exists(desc.vegetationCacheFileName))
-	{
-		LoadCache(desc.vegetationCacheFileName, bufferDesc.data);
-		instancesNumber = static_cast<uint32_t>(bufferDesc.data.size() / bufferDesc.dataStride);
-	}
-	else
-	{
-		TextureDesc vegetationMapDesc{};
-		DDSLoader::Load(desc.vegetationMapFileName, vegetationMapDesc);
+	if (loadCache)
+		loadCache = LoadCache(desc.vegetationCacheFileName, desc, bufferDesc.data);
 
-		instancesNumber = static_cast<uint32_t>(vegetationMapDesc.width * vegetationMapDesc.height * QUADS_PER_GRASS);
+	if (!loadCache)
+	{
+		auto terrain = desc.terrain;
+		auto& minCorner = terrain->GetMinCorner();
+		auto& size = terrain->GetSize();
 
-		bufferDesc.data.resize(static_cast<size_t>(bufferDesc.dataStride) * instancesNumber);
+		quantizationDesc.positionOffset = float3(minCorner.x - GRASS_SCATTERING, minCorner.y - GRASS_SCATTERING, minCorner.z);
+		quantizationDesc.positionScale = float3(size.x + 2.0f * GRASS_SCATTERING, size.y + 2.0f * GRASS_SCATTERING, size.z);
 
-		XMUBYTE4 mask{};
-		mask.z = 255u;
+		TextureDesc vegetationMapDesc{};
+		DDSLoader::Load(desc.vegetationMapFileName, vegetationMapDesc);
 
 		VegetationBufferDesc vbDesc
 		{
-			bufferDesc.data.data(),
+			bufferDesc.data,
 			vegetationMapDesc,
 			desc,
 			desc.grassSizeMin,
 			desc.grassSizeMax
 		};
 
-		FillVegetationBuffer(vbDesc, instancesNumber);
-		
-		bufferDesc.data.resize(static_cast<size_t>(bufferDesc.dataStride) * instancesNumber);
+		if (desc.scattering == VegetationScattering::BLUE_NOISE)
+		{
+			vbDesc.blueNoiseTileSize = desc.blueNoiseDistance * BLUE_NOISE_TILE_SCALE;
+
+			PoissonDiskGenerator poissonDiskGenerator{};
+			poissonDiskGenerator.Generate(vbDesc.blueNoiseTileSize, desc.blueNoiseDistance, RANDOM_SEED,
+				vbDesc.blueNoisePoints);
+
+			vbDesc.blueNoiseTiles.x = static_cast<uint32_t>(std::ceil(size.x / vbDesc.blueNoiseTileSize));
+			vbDesc.blueNoiseTiles.y = static_cast<uint32_t>(std::ceil(size.y / vbDesc.blueNoiseTileSize));
+		}
+
+		uint32_t grassNumber{};
+		FillVegetationBuffer(vbDesc, grassNumber);
 
-		SaveCache(desc.vegetationCacheFileName, bufferDesc.data.data(), bufferDesc.data.size());
+		SaveCache(desc.vegetationCacheFileName, desc, bufferDesc.data.data(), bufferDesc.data.size());
 	}
 
+	BuildCells(bufferDesc.data, desc.cellSize);
+
+	densityFalloffStart = desc.densityFalloffStart;
+	densityFalloffEnd = desc.densityFalloffEnd;
+
+	mutableConstants.positionOffset = quantizationDesc.positionOffset;
+	mutableConstants.positionScale = quantizationDesc.positionScale;
+
 	bufferDesc.numElements = static_cast<uint32_t>(bufferDesc.data.size() / bufferDesc.dataStride);
 
 	vegetationBufferId = resourceManager->CreateBufferResource(device, commandList, BufferResourceType::BUFFER, bufferDesc);
@@ -375,6 +468,7 @@ void Common::Logic::SceneEntity::VegatationSystem::CreateMaterials(ID3D12Device*
 	MaterialBuilder materialBuilder{};
 	materialBuilder.SetConstantBuffer(0u, lightConstantBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_PIXEL);
 	materialBuilder.SetConstantBuffer(1u, mutableConstantsResource->resourceGPUAddress);
+	materialBuilder.SetRootConstants(DRAW_CONSTANTS_REGISTER, 1u, D3D12_SHADER_VISIBILITY_VERTEX);
 	materialBuilder.SetBuffer(0u, vegetationBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_VERTEX);
 	materialBuilder.SetTexture(1u, perlinNoiseResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_VERTEX);
 	materialBuilder.SetTexture(2u, albedoResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
@@ -382,16 +476,33 @@ void Common::Logic::SceneEntity::VegatationSystem::CreateMaterials(ID3D12Device*
 
 	for (uint32_t shadowMapIndex = 0u; shadowMapIndex < desc.shadowMapIds.size(); shadowMapIndex++)
 	{
-		auto shadowMapResource = resourceManager->GetResource<Texture>(desc.shadowMapIds[shadowMapIndex]);
+		auto shadowMapResource = resourceManager->GetResource<DepthStencilTarget>(desc.shadowMapIds[shadowMapIndex]);
 		materialBuilder.SetTexture(4u + shadowMapIndex, shadowMapResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
 	}
 
+	if (desc.hasCascadedShadows)
+	{
+		auto lightMatricesConstantBufferResource = resourceManager->GetResource<ConstantBuffer>(lightMatricesConstantBufferId);
+		materialBuilder.SetConstantBuffer(2u, lightMatricesConstantBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_PIXEL);
+	}
+
 	if (desc.hasParticleLighting)
 	{
 		auto particleLightBufferResource = resourceManager->GetResource<RWBuffer>(desc.lightParticleBufferId);
 		materialBuilder.SetBuffer(5u, particleLightBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_PIXEL);
 	}
 
+	if (desc.hasParticleLighting && desc.hasClusteredLighting)
+	{
+		auto lightClusterConstantBufferResource = resourceManager->GetResource<ConstantBuffer>(desc.lightClusterConstantBufferId);
+		auto lightClusterCountBufferResource = resourceManager->GetResource<RWBuffer>(desc.lightClusterCountBufferId);
+		auto lightClusterIndexBufferResource = resourceManager->GetResource<RWBuffer>(desc.lightClusterIndexBufferId);
+
+		materialBuilder.SetConstantBuffer(4u, lightClusterConstantBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_PIXEL);
+		materialBuilder.SetBuffer(6u, lightClusterCountBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_PIXEL);
+		materialBuilder.SetBuffer(7u, lightClusterIndexBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_PIXEL);
+	}
+
 	materialBuilder.SetSampler(0u, samplerLinearResource->samplerDescriptor.gpuDescriptor);
 	materialBuilder.SetSampler(1u, samplerShadowResource->samplerDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
 	materialBuilder.SetCullMode(D3D12_CULL_MODE_BACK);
@@ -413,6 +524,7 @@ void Common::Logic::SceneEntity::VegatationSystem::CreateMaterials(ID3D12Device*
 		auto vegetationDepthPassPS = resourceManager->GetResource<Shader>(vegetationDepthPassPSId);
 
 		materialBuilder.SetConstantBuffer(1u, mutableConstantsResource->resourceGPUAddress);
+		materialBuilder.SetRootConstants(DRAW_CONSTANTS_REGISTER, 1u, D3D12_SHADER_VISIBILITY_VERTEX);
 		materialBuilder.SetBuffer(0u, vegetationBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_VERTEX);
 		materialBuilder.SetTexture(1u, perlinNoiseResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_VERTEX);
 		materialBuilder.SetTexture(2u, normalResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_PIXEL);
@@ -436,6 +548,7 @@ void Common::Logic::SceneEntity::VegatationSystem::CreateMaterials(ID3D12Device*
 
 		materialBuilder.SetRootConstants(0u, 1u, D3D12_SHADER_VISIBILITY_VERTEX);
 		materialBuilder.SetConstantBuffer(1u, mutableConstantsResource->resourceGPUAddress);
+		materialBuilder.SetRootConstants(DRAW_CONSTANTS_REGISTER, 1u, D3D12_SHADER_VISIBILITY_VERTEX);
 		materialBuilder.SetConstantBuffer(2u, lightMatricesConstantBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_VERTEX);
 		materialBuilder.SetBuffer(0u, vegetationBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_VERTEX);
 		materialBuilder.SetTexture(1u, perlinNoiseResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_VERTEX);
@@ -459,8 +572,9 @@ void Common::Logic::SceneEntity::VegatationSystem::CreateMaterials(ID3D12Device*
 		auto vegetationDepthCubePassGS = resourceManager->GetResource<Shader>(vegetationDepthCubePassGSId);
 		auto vegetationDepthCubePassPS = resourceManager->GetResource<Shader>(vegetationDepthCubePassPSId);
 
-		materialBuilder.SetRootConstants(0u, 1u, D3D12_SHADER_VISIBILITY_GEOMETRY);
+		materialBuilder.SetRootConstants(0u, 2u, D3D12_SHADER_VISIBILITY_GEOMETRY);
 		materialBuilder.SetConstantBuffer(1u, mutableConstantsResource->resourceGPUAddress);
+		materialBuilder.SetRootConstants(DRAW_CONSTANTS_REGISTER, 1u, D3D12_SHADER_VISIBILITY_VERTEX);
 		materialBuilder.SetConstantBuffer(2u, lightMatricesConstantBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_GEOMETRY);
 		materialBuilder.SetBuffer(0u, vegetationBufferResource->resourceGPUAddress, D3D12_SHADER_VISIBILITY_VERTEX);
 		materialBuilder.SetTexture(1u, perlinNoiseResource->srvDescriptor.gpuDescriptor, D3D12_SHADER_VISIBILITY_VERTEX);
@@ -481,48 +595,81 @@ void Common::Logic::SceneEntity::VegatationSystem::CreateMaterials(ID3D12Device*
 void Common::Logic::SceneEntity::VegatationSystem::FillVegetationBuffer(const VegetationBufferDesc& desc,
 	uint32_t& resultGrassNumber)
 {
-	auto vegetations = reinterpret_cast<Vegetation*>(desc.buffer);
+	auto candidatesNumber = GetCandidatesNumber(desc);
+
+	auto blocksNumber = (candidatesNumber + CANDIDATES_PER_BLOCK - 1u) / CANDIDATES_PER_BLOCK;
+	std::vector<uint32_t> blockOffsets(static_cast<size_t>(blocksNumber) + 1u, 0u);
+
+	auto taskScheduler = TaskScheduler::GetShared();
+
+	taskScheduler->ParallelFor(0u, blocksNumber, 1u, [&](uint32_t startBlock, uint32_t endBlock)
+	{
+		std::vector<GrassPlacement> placements;
+
+		for (auto blockIndex = startBlock; blockIndex < endBlock; blockIndex++)
+		{
+			auto startCandidateIndex = blockIndex * CANDIDATES_PER_BLOCK;
+			auto endCandidateIndex = std::min(startCandidateIndex + CANDIDATES_PER_BLOCK, candidatesNumber);
+
+			CollectPlacements(desc, startCandidateIndex, endCandidateIndex, placements);
+
+			blockOffsets[static_cast<size_t>(blockIndex) + 1u] = static_cast<uint32_t>(placements.size());
+		}
+	});
+
+	for (uint32_t blockIndex = 0u; blockIndex < blocksNumber; blockIndex++)
+		blockOffsets[static_cast<size_t>(blockIndex) + 1u] += blockOffsets[blockIndex];
+
+	resultGrassNumber = blockOffsets[blocksNumber];
+	desc.buffer.resize(sizeof(Vegetation) * resultGrassNumber);
+
+	taskScheduler->ParallelFor(0u, blocksNumber, 1u, [&](uint32_t startBlock, uint32_t endBlock)
+	{
+		for (auto blockIndex = startBlock; blockIndex < endBlock; blockIndex++)
+		{
+			auto startCandidateIndex = blockIndex * CANDIDATES_PER_BLOCK;
+			auto endCandidateIndex = std::min(startCandidateIndex + CANDIDATES_PER_BLOCK, candidatesNumber);
+
+			FillVegetationBlock(desc, startCandidateIndex, endCandidateIndex, blockOffsets[blockIndex]);
+		}
+	});
+}
+
+void Common::Logic::SceneEntity::VegatationSystem::FillVegetationBlock(const VegetationBufferDesc& desc,
+	uint32_t startCandidateIndex, uint32_t endCandidateIndex, uint32_t startGrassIndex) const
+{
+	auto vegetations = reinterpret_cast<Vegetation*>(desc.buffer.data());
 	const auto& grassTable = desc.vegetationSystemDesc.grassTable;
-	
-	auto mapSize = static_cast<uint32_t>(desc.vegetationMapDesc.width * desc.vegetationMapDesc.height);
+	const auto& heightFieldSampler = desc.vegetationSystemDesc.terrain->GetHeightFieldSampler();
+
 	auto vegetationDataPtr = reinterpret_cast<const XMUBYTE4*>(desc.vegetationMapDesc.data.data());
 
-	auto origin = XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f);
-	auto identityQuaternion = XMQuaternionIdentity();
-	auto capQuaternion = XMQuaternionRotationAxis(XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f),
-		static_cast<float>(std::numbers::pi * 0.5f));
-
-	auto upVector = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
-	
-	floatN position{};
-	floatN upVectorTarget{};
-	floatN rolling{};
-	floatN rotation{};
-	float2 atlasElementOffset{};
-	float2 capAtlasElementOffset{};
-	float windInfluence{};
-	bool isCap{};
-
-	uint32_t grassIndex = 0u;
-
-	for (uint32_t mapPointIndex = 0u; mapPointIndex < mapSize; mapPointIndex++)
-	{
-		capAtlasElementOffset = {};
-		
-		auto vegetationDataV = *(vegetationDataPtr + mapPointIndex);
-		
-		if (vegetationDataV.z == 0u)
-			continue;
+	auto atlasRows = desc.vegetationSystemDesc.atlasRows;
+
+	std::vector<GrassPlacement> placements;
+	CollectPlacements(desc, startCandidateIndex, endCandidateIndex, placements);
+
+	std::vector<float2> planarPositions(placements.size());
+
+	for (size_t placementIndex = 0u; placementIndex < placements.size(); placementIndex++)
+		planarPositions[placementIndex] = placements[placementIndex].planarPosition;
 
-		auto randomX = Utilities::Random(randomEngine);
-		auto randomY = Utilities::Random(randomEngine);
-		auto randomZ = Utilities::Random(randomEngine);
+	std::vector<float> heights(planarPositions.size());
+	std::vector<float3> normals(planarPositions.size());
 
-		isCap = vegetationDataV.z > 16u;
+	heightFieldSampler.Sample(planarPositions.data(), planarPositions.size(), heights.data(), normals.data());
+
+	for (uint32_t tuftIndex = 0u; tuftIndex < placements.size(); tuftIndex++)
+	{
+		const auto& placement = placements[tuftIndex];
+		auto vegetationDataV = vegetationDataPtr[placement.mapPointIndex];
+
+		auto isCap = vegetationDataV.z > 16u;
 		uint32_t grassId = vegetationDataV.z - (isCap ? 17 : 1);
 
 		float3 grassSize{};
-		
+		float windInfluence{};
+
 		if (grassTable.contains(grassId + 1u))
 		{
 			const auto& grassData = grassTable.at(grassId + 1u);
@@ -542,60 +689,161 @@ void Common::Logic::SceneEntity::VegatationSystem::FillVegetationBuffer(const Ve
 			windInfluence = isCap ? GRASS_CAP_WIND_INFLUENCE : GRASS_WIND_INFLUENCE;
 		}
 
-		auto scale = XMLoadFloat3(&grassSize);
-		
-		uint32_t quadsNumber = isCap ? 1u : QUADS_PER_GRASS;
+		if (isCap)
+		{
+			auto maxScale = std::max(grassSize.x, std::max(grassSize.y, grassSize.z));
+			grassSize.x = maxScale;
+			grassSize.y = maxScale;
+		}
+
+		const auto& planarPosition = placement.planarPosition;
+		auto position = float3(planarPosition.x, planarPosition.y, heights[tuftIndex]);
+		auto quantizedPosition = VertexCompressor::QuantizePosition(position, quantizationDesc);
+
+		float3 upVector{};
+		XMStoreFloat3(&upVector, GetUpVector(normals[tuftIndex]));
+
+		auto yaw = static_cast<uint32_t>(std::lround(placement.yaw * YAW_QUANTIZATION_MAX));
+
+		auto& vegetation = vegetations[startGrassIndex + tuftIndex];
+		vegetation.positionXY = static_cast<uint32_t>(quantizedPosition & 0xFFFFFFFFull);
+		vegetation.positionZYaw = static_cast<uint32_t>(quantizedPosition >> 32u) | (yaw << 16u);
+		vegetation.upVector = VertexCompressor::EncodeOctahedral(upVector);
+		vegetation.scaleXY = XMHALF2(grassSize.x, grassSize.y);
+		vegetation.heightWindInfluence = XMHALF2(isCap ? -grassSize.z : grassSize.z, windInfluence);
+		vegetation.atlasCell = (grassId % atlasRows) | ((grassId / atlasRows) << 16u);
+	}
+}
+
+uint32_t Common::Logic::SceneEntity::VegatationSystem::GetCandidatesNumber(const VegetationBufferDesc& desc) const
+{
+	if (desc.vegetationSystemDesc.scattering == VegetationScattering::BLUE_NOISE)
+		return desc.blueNoiseTiles.x * desc.blueNoiseTiles.y * static_cast<uint32_t>(desc.blueNoisePoints.size());
+
+	return static_cast<uint32_t>(desc.vegetationMapDesc.width * desc.vegetationMapDesc.height);
+}
+
+void Common::Logic::SceneEntity::VegatationSystem::CollectPlacements(const VegetationBufferDesc& desc,
+	uint32_t startCandidateIndex, uint32_t endCandidateIndex, std::vector<GrassPlacement>& placements) const
+{
+	placements.clear();
+
+	if (desc.vegetationSystemDesc.scattering != VegetationScattering::BLUE_NOISE)
+	{
+		auto vegetationDataPtr = reinterpret_cast<const XMUBYTE4*>(desc.vegetationMapDesc.data.data());
 
-		for (uint32_t quadIndex = 0u; quadIndex < quadsNumber; quadIndex++)
+		for (auto mapPointIndex = startCandidateIndex; mapPointIndex < endCandidateIndex; mapPointIndex++)
 		{
-			auto& vegetation = vegetations[grassIndex];
+			if (vegetationDataPtr[mapPointIndex].z == 0u)
+				continue;
 
-			if (quadIndex == 0u)
-			{
-				GetLocationData(desc, mapPointIndex, isCap, position, upVectorTarget);
-				rotation = CalculateRotation(upVector, upVectorTarget);
-				rolling = XMQuaternionRotationAxis(upVectorTarget, static_cast<float>(std::numbers::pi * 2.0 / 3.0));
-
-				atlasElementOffset.x = (grassId % desc.vegetationSystemDesc.atlasRows) /
-					static_cast<float>(desc.vegetationSystemDesc.atlasRows);
-
-				atlasElementOffset.y = static_cast<float>(grassId / desc.vegetationSystemDesc.atlasRows) /
-					desc.vegetationSystemDesc.atlasColumns;
-
-				if (isCap)
-				{
-					auto maxScale = std::max(scale.m128_f32[0], std::max(scale.m128_f32[1], scale.m128_f32[2]));
-					scale = XMVectorSet(maxScale, maxScale, maxScale, 1.0f);
-					position.m128_f32[2] += grassSize.z * 0.05f;
-					rotation = XMQuaternionMultiply(capQuaternion, rotation);
-				}
-			}
-			else
-				rotation = XMQuaternionMultiply(rotation, rolling);
+			HashedRandom random(RANDOM_SEED, mapPointIndex);
+
+			GrassPlacement placement{};
+			placement.mapPointIndex = mapPointIndex;
+			placement.planarPosition = GetPlanarPosition(desc, mapPointIndex, random);
+			placement.yaw = Utilities::Random(random);
 
-			vegetation.world = XMMatrixTransformation(origin, rotation, scale, origin, rotation, position);
+			placements.push_back(placement);
+		}
 
-			vegetation.atlasElementOffset = atlasElementOffset;
-			vegetation.windInfluence = windInfluence;
-			vegetation.height = isCap ? -grassSize.z : grassSize.z;
+		return;
+	}
 
-			grassIndex++;
+	auto terrain = desc.vegetationSystemDesc.terrain;
+	auto& minCorner = terrain->GetMinCorner();
+	auto& size = terrain->GetSize();
+
+	auto pointsPerTile = static_cast<uint32_t>(desc.blueNoisePoints.size());
+
+	for (auto candidateIndex = startCandidateIndex; candidateIndex < endCandidateIndex; candidateIndex++)
+	{
+		auto tileIndex = candidateIndex / pointsPerTile;
+		const auto& point = desc.blueNoisePoints[candidateIndex % pointsPerTile];
+
+		auto planarPosition = float2
+		(
+			minCorner.x + (tileIndex % desc.blueNoiseTiles.x) * desc.blueNoiseTileSize + point.x,
+			minCorner.y + (tileIndex / desc.blueNoiseTiles.x) * desc.blueNoiseTileSize + point.y
+		);
+
+		if (planarPosition.x > minCorner.x + size.x || planarPosition.y > minCorner.y + size.y)
+			continue;
+
+		HashedRandom random(RANDOM_SEED, candidateIndex);
+
+		GrassPlacement placement{};
+		placement.planarPosition = planarPosition;
+
+		if (!SampleVegetationMap(desc, planarPosition, Utilities::Random(random), placement.mapPointIndex))
+			continue;
+
+		placement.yaw = Utilities::Random(random);
+
+		placements.push_back(placement);
+	}
+}
+
+bool Common::Logic::SceneEntity::VegatationSystem::SampleVegetationMap(const VegetationBufferDesc& desc,
+	const float2& planarPosition, float threshold, uint32_t& mapPointIndex) const
+{
+	auto terrain = desc.vegetationSystemDesc.terrain;
+	auto& minCorner = terrain->GetMinCorner();
+	auto& size = terrain->GetSize();
+
+	auto mapWidth = static_cast<uint32_t>(desc.vegetationMapDesc.width);
+	auto mapHeight = static_cast<uint32_t>(desc.vegetationMapDesc.height);
+	auto vegetationDataPtr = reinterpret_cast<const XMUBYTE4*>(desc.vegetationMapDesc.data.data());
+
+	auto mapX = std::clamp((planarPosition.x - minCorner.x) / size.x * mapWidth, 0.0f,
+		static_cast<float>(mapWidth - 1u));
+	auto mapY = std::clamp((planarPosition.y - minCorner.y) / size.y * mapHeight, 0.0f,
+		static_cast<float>(mapHeight - 1u));
+
+	auto x0 = static_cast<uint32_t>(mapX);
+	auto y0 = static_cast<uint32_t>(mapY);
+	auto x1 = std::min(x0 + 1u, mapWidth - 1u);
+	auto y1 = std::min(y0 + 1u, mapHeight - 1u);
+
+	auto fractionX = mapX - x0;
+	auto fractionY = mapY - y0;
+
+	std::array<uint32_t, 4u> indices{ y0 * mapWidth + x0, y0 * mapWidth + x1, y1 * mapWidth + x0, y1 * mapWidth + x1 };
+	std::array<float, 4u> weights
+	{
+		(1.0f - fractionX) * (1.0f - fractionY),
+		fractionX * (1.0f - fractionY),
+		(1.0f - fractionX) * fractionY,
+		fractionX * fractionY
+	};
+
+	auto coverage = 0.0f;
+	auto maxWeight = -1.0f;
+
+	for (uint32_t sampleIndex = 0u; sampleIndex < indices.size(); sampleIndex++)
+	{
+		if (vegetationDataPtr[indices[sampleIndex]].z == 0u)
+			continue;
+
+		coverage += weights[sampleIndex];
+
+		if (weights[sampleIndex] > maxWeight)
+		{
+			maxWeight = weights[sampleIndex];
+			mapPointIndex = indices[sampleIndex];
 		}
 	}
 
-	resultGrassNumber = grassIndex;
+	return coverage > threshold;
 }
 
-void Common::Logic::SceneEntity::VegatationSystem::GetLocationData(const VegetationBufferDesc& desc,
-	uint32_t mapPointIndex, bool isCap, floatN& position, floatN& upVector)
+float2 Common::Logic::SceneEntity::VegatationSystem::GetPlanarPosition(const VegetationBufferDesc& desc,
+	uint32_t mapPointIndex, Common::HashedRandom& random) const
 {
-	auto mapSize = static_cast<uint32_t>(desc.vegetationMapDesc.width * desc.vegetationMapDesc.height);
-	auto randomX = Utilities::Random(randomEngine) * 2.0f - 1.0f;
-	auto randomY = Utilities::Random(randomEngine) * 2.0f - 1.0f;
+	auto randomX = Utilities::Random(random) * 2.0f - 1.0f;
+	auto randomY = Utilities::Random(random) * 2.0f - 1.0f;
 	auto offset = float2(randomX * GRASS_SCATTERING, randomY * GRASS_SCATTERING);
 
-	auto absoluteUpVector = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
-
 	auto terrain = desc.vegetationSystemDesc.terrain;
 	auto& minCorner = terrain->GetMinCorner();
 	auto& size = terrain->GetSize();
@@ -606,43 +854,208 @@ void Common::Logic::SceneEntity::VegatationSystem::GetLocationData(const Vegetat
 	auto yCoeff = static_cast<float>(mapPointIndex / static_cast<uint32_t>(desc.vegetationMapDesc.width));
 	yCoeff /= desc.vegetationMapDesc.height;
 
-	auto planarPosition = float2(minCorner.x + size.x * xCoeff + offset.x, minCorner.y + size.y * yCoeff + offset.y);
-	auto height = terrain->GetHeight(planarPosition);
-	auto normal = terrain->GetNormal(planarPosition);
+	return float2(minCorner.x + size.x * xCoeff + offset.x, minCorner.y + size.y * yCoeff + offset.y);
+}
+
+floatN Common::Logic::SceneEntity::VegatationSystem::GetUpVector(const float3& normal) const
+{
+	auto absoluteUpVector = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
 
 	auto normalV = XMLoadFloat3(&normal);
 	normalV = XMVectorLerp(normalV, absoluteUpVector, 0.25f);
 	normalV = XMVector3Normalize(normalV);
-			
-	XMStoreFloat3(&normal, normalV);
 
 	if (XMVector3Dot(normalV, normalV).m128_f32[0u] < std::numeric_limits<float>::epsilon())
-		normal = float3(0.0f, 0.0f, 1.0f);
+		return absoluteUpVector;
 
-	position = XMVectorSet(planarPosition.x, planarPosition.y, height, 0.0f);
-	upVector = XMLoadFloat3(&normal);
+	return normalV;
 }
 
-floatN Common::Logic::SceneEntity::VegatationSystem::CalculateRotation(const floatN& upVector, const floatN& upVectorTarget)
+void Common::Logic::SceneEntity::VegatationSystem::BuildCells(std::vector<uint8_t>& buffer, float cellSize)
 {
-	auto rotation = XMQuaternionRotationAxis(upVector,
-		Utilities::Random(randomEngine) * static_cast<float>(std::numbers::pi * 2.0));
-	
-	auto angle = XMVector3Dot(upVectorTarget, upVector);
-	
-	if (std::abs(angle.m128_f32[0u] - 1.0f) < std::numeric_limits<float>::epsilon())
+	auto grassNumber = static_cast<uint32_t>(buffer.size() / sizeof(Vegetation));
+	auto vegetations = reinterpret_cast<const Vegetation*>(buffer.data());
+
+	const auto& positionOffset = quantizationDesc.positionOffset;
+	const auto& positionScale = quantizationDesc.positionScale;
+
+	if (cellSize <= 0.0f)
+		cellSize = std::max(positionScale.x, positionScale.y);
+
+	auto cellsPerWidth = std::max(static_cast<uint32_t>(std::ceil(positionScale.x / cellSize)), 1u);
+	auto cellsPerHeight = std::max(static_cast<uint32_t>(std::ceil(positionScale.y / cellSize)), 1u);
+
+	AxisAlignedBox emptyBounds{};
+	emptyBounds.minCorner = float3(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+		std::numeric_limits<float>::max());
+	emptyBounds.maxCorner = float3(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(),
+		-std::numeric_limits<float>::max());
+
+	cells.assign(static_cast<size_t>(cellsPerWidth) * cellsPerHeight, VegetationCell{ emptyBounds, 0u, 0u });
+	cellGrassNumbers.assign(cells.size(), 0u);
+
+	std::vector<uint32_t> grassCells(grassNumber);
+
+	for (uint32_t grassIndex = 0u; grassIndex < grassNumber; grassIndex++)
 	{
-		auto rotationAxis = XMVector3Cross(upVectorTarget, upVector);
+		const auto& vegetation = vegetations[grassIndex];
 
-		if (XMVector3Dot(rotationAxis, rotationAxis).m128_f32[0u] < std::numeric_limits<float>::epsilon())
-			rotationAxis = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+		auto quantizedPosition = static_cast<uint64_t>(vegetation.positionXY) |
+			(static_cast<uint64_t>(vegetation.positionZYaw & 0xFFFFu) << 32u);
 
-		auto pitch = XMQuaternionRotationAxis(rotationAxis, angle.m128_f32[0u]);
+		auto position = VertexCompressor::DequantizePosition(quantizedPosition, quantizationDesc);
 
-		rotation = XMQuaternionMultiply(rotation, pitch);
+		auto cellX = std::min(static_cast<uint32_t>((position.x - positionOffset.x) / cellSize), cellsPerWidth - 1u);
+		auto cellY = std::min(static_cast<uint32_t>((position.y - positionOffset.y) / cellSize), cellsPerHeight - 1u);
+		auto cellIndex = cellY * cellsPerWidth + cellX;
+
+		auto extent = std::max(std::max(XMConvertHalfToFloat(vegetation.scaleXY.x), XMConvertHalfToFloat(vegetation.scaleXY.y)),
+			std::abs(XMConvertHalfToFloat(vegetation.heightWindInfluence.x)));
+
+		auto& bounds = cells[cellIndex].bounds;
+		auto positionV = XMLoadFloat3(&position);
+		auto extentV = XMVectorReplicate(extent);
+
+		XMStoreFloat3(&bounds.minCorner, XMVectorMin(XMLoadFloat3(&bounds.minCorner), positionV - extentV));
+		XMStoreFloat3(&bounds.maxCorner, XMVectorMax(XMLoadFloat3(&bounds.maxCorner), positionV + extentV));
+
+		cells[cellIndex].grassNumber++;
+		grassCells[grassIndex] = cellIndex;
+	}
+
+	uint32_t startGrassIndex = 0u;
+
+	for (auto& cell : cells)
+	{
+		cell.startGrassIndex = startGrassIndex;
+		startGrassIndex += cell.grassNumber;
 	}
 
-	return rotation;
+	std::vector<uint64_t> grassOrder(grassNumber);
+	std::vector<uint32_t> cellFillNumbers(cells.size(), 0u);
+
+	for (uint32_t grassIndex = 0u; grassIndex < grassNumber; grassIndex++)
+	{
+		const auto& vegetation = vegetations[grassIndex];
+		auto key = HashedRandom::Hash(vegetation.positionXY ^ HashedRandom::Hash(vegetation.positionZYaw));
+
+		auto cellIndex = grassCells[grassIndex];
+		grassOrder[cells[cellIndex].startGrassIndex + cellFillNumbers[cellIndex]] = (static_cast<uint64_t>(key) << 32u) | grassIndex;
+		cellFillNumbers[cellIndex]++;
+	}
+
+	for (const auto& cell : cells)
+	{
+		auto cellBegin = grassOrder.begin() + cell.startGrassIndex;
+		std::sort(cellBegin, cellBegin + cell.grassNumber);
+	}
+
+	std::vector<Vegetation> sortedVegetations(grassNumber);
+
+	for (uint32_t grassIndex = 0u; grassIndex < grassNumber; grassIndex++)
+		sortedVegetations[grassIndex] = vegetations[static_cast<uint32_t>(grassOrder[grassIndex])];
+
+	std::memcpy(buffer.data(), sortedVegetations.data(), sizeof(Vegetation) * sortedVegetations.size());
+
+	vegetationBounds = emptyBounds;
+
+	for (const auto& cell : cells)
+		if (cell.grassNumber > 0u)
+			vegetationBounds = GeometryUtilities::MergeBoxes(vegetationBounds, cell.bounds);
+}
+
+void Common::Logic::SceneEntity::VegatationSystem::UpdateCellDensities(const float3& cameraPosition)
+{
+	auto hasFalloff = densityFalloffEnd > densityFalloffStart;
+
+	for (size_t cellIndex = 0u; cellIndex < cells.size(); cellIndex++)
+	{
+		const auto& cell = cells[cellIndex];
+
+		if (!hasFalloff || cell.grassNumber == 0u)
+		{
+			cellGrassNumbers[cellIndex] = cell.grassNumber;
+			continue;
+		}
+
+		auto distance = GeometryUtilities::DistanceToBox(cell.bounds, cameraPosition);
+		auto density = std::clamp((densityFalloffEnd - distance) / (densityFalloffEnd - densityFalloffStart), 0.0f, 1.0f);
+
+		cellGrassNumbers[cellIndex] = static_cast<uint32_t>(std::ceil(cell.grassNumber * density));
+	}
+}
+
+void Common::Logic::SceneEntity::VegatationSystem::SelectCells(const Graphics::Assets::Frustum* frustums,
+	uint32_t frustumsNumber, uint32_t activeFaceMask, std::vector<CellDrawItem>& drawItems) const
+{
+	drawItems.clear();
+
+	for (size_t cellIndex = 0u; cellIndex < cells.size(); cellIndex++)
+	{
+		const auto& cell = cells[cellIndex];
+		auto grassNumber = cellGrassNumbers[cellIndex];
+
+		if (grassNumber == 0u)
+			continue;
+
+		auto faceMask = frustumsNumber == 0u ? activeFaceMask : 0u;
+
+		for (uint32_t frustumIndex = 0u; frustumIndex < frustumsNumber; frustumIndex++)
+		{
+			if ((activeFaceMask & (1u << frustumIndex)) != 0u && frustums[frustumIndex].Intersects(cell.bounds))
+				faceMask |= 1u << frustumIndex;
+		}
+
+		if (faceMask == 0u)
+			continue;
+
+		if (!drawItems.empty())
+		{
+			auto& lastDrawItem = drawItems.back();
+
+			if (lastDrawItem.faceMask == faceMask &&
+				lastDrawItem.startGrassIndex + lastDrawItem.grassNumber == cell.startGrassIndex)
+			{
+				lastDrawItem.grassNumber += grassNumber;
+				continue;
+			}
+		}
+
+		drawItems.push_back({ cell.startGrassIndex, grassNumber, faceMask });
+	}
+}
+
+void Common::Logic::SceneEntity::VegatationSystem::DrawCells(ID3D12GraphicsCommandList* commandList,
+	Graphics::Assets::Material* material, const std::vector<CellDrawItem>& drawItems) const
+{
+	_mesh->SetInputAssemblerOnly(commandList);
+
+	for (const auto& drawItem : drawItems)
+	{
+		material->SetRootConstant(commandList, DRAW_CONSTANTS_REGISTER, &drawItem.startGrassIndex);
+		_mesh->DrawOnly(commandList, drawItem.grassNumber * QUADS_PER_GRASS);
+	}
+}
+
+void Common::Logic::SceneEntity::VegatationSystem::DrawCellsCube(ID3D12GraphicsCommandList* commandList,
+	uint32_t lightMatrixStartIndex, const std::vector<CellDrawItem>& drawItems) const
+{
+	std::array<uint32_t, 2u> cubePassConstants{ lightMatrixStartIndex, 0u };
+
+	materialDepthCubePass->Set(commandList);
+	_mesh->SetInputAssemblerOnly(commandList);
+
+	for (const auto& drawItem : drawItems)
+	{
+		if (drawItem.faceMask != cubePassConstants[1u])
+		{
+			cubePassConstants[1u] = drawItem.faceMask;
+			materialDepthCubePass->SetRootConstants(commandList, 0u, 2u, cubePassConstants.data());
+		}
+
+		materialDepthCubePass->SetRootConstant(commandList, DRAW_CONSTANTS_REGISTER, &drawItem.startGrassIndex);
+		_mesh->DrawOnly(commandList, drawItem.grassNumber * QUADS_PER_GRASS);
+	}
 }
 
 Common::Logic::SceneEntity::VegatationSystem::GrassVertex Common::Logic::SceneEntity::VegatationSystem::SetVertex(const float3& position,
@@ -659,25 +1072,44 @@ Common::Logic::SceneEntity::VegatationSystem::GrassVertex Common::Logic::SceneEn
 	return vertex;
 }
 
-void Common::Logic::SceneEntity::VegatationSystem::LoadCache(const std::filesystem::path& fileName,
-	std::vector<uint8_t>& buffer)
+bool Common::Logic::SceneEntity::VegatationSystem::LoadCache(const std::filesystem::path& fileName,
+	const VegetationSystemDesc& desc, std::vector<uint8_t>& buffer)
 {
 	std::ifstream vegetationFile(fileName, std::ios::binary);
 
-	uint32_t bufferSize{};
-	vegetationFile.read(reinterpret_cast<char*>(&bufferSize), sizeof(uint32_t));
+	VegetationCacheHeader header{};
+	vegetationFile.read(reinterpret_cast<char*>(&header), sizeof(VegetationCacheHeader));
+
+	if (!vegetationFile || header.instanceStride != sizeof(Vegetation))
+		return false;
+
+	if (header.scattering != desc.scattering || header.blueNoiseDistance != desc.blueNoiseDistance)
+		return false;
 
+	auto bufferSize = static_cast<size_t>(header.instancesNumber) * header.instanceStride;
 	buffer.resize(bufferSize);
 
 	vegetationFile.read(reinterpret_cast<char*>(buffer.data()), bufferSize);
+
+	if (!vegetationFile)
+		return false;
+
+	quantizationDesc = header.quantizationDesc;
+
+	return true;
 }
 
 void Common::Logic::SceneEntity::VegatationSystem::SaveCache(const std::filesystem::path& fileName,
-	const uint8_t* buffer, size_t size)
+	const VegetationSystemDesc& desc, const uint8_t* buffer, size_t size)
 {
-	auto _size = size;
+	VegetationCacheHeader header{};
+	header.instanceStride = sizeof(Vegetation);
+	header.instancesNumber = static_cast<uint32_t>(size / sizeof(Vegetation));
+	header.scattering = desc.scattering;
+	header.blueNoiseDistance = desc.blueNoiseDistance;
+	header.quantizationDesc = quantizationDesc;
 
 	std::ofstream vegetationFile(fileName, std::ios::binary);
-	vegetationFile.write(reinterpret_cast<const char*>(&_size), sizeof(uint32_t));
+	vegetationFile.write(reinterpret_cast<const char*>(&header), sizeof(VegetationCacheHeader));
 	vegetationFile.write(reinterpret_cast<const char*>(buffer), size);
 }
@@ -4,8 +4,10 @@
 #include "IDrawable.h"
 #include "../../../Graphics/Assets/Material.h"
 #include "../../../Graphics/Assets/Mesh.h"
+#include "../../../Graphics/Assets/Frustum.h"
 #include "../../../Graphics/DirectX12Renderer.h"
 #include "Terrain.h"
+#include "../../Utilities.h"
 
 namespace Common::Logic::SceneEntity
 {
@@ -17,6 +19,12 @@ namespace Common::Logic::SceneEntity
 		float windInfluence;
 	};
 
+	enum class VegetationScattering : uint32_t
+	{
+		GRID_JITTER = 0u,
+		BLUE_NOISE = 1u
+	};
+
 	struct VegetationSystemDesc
 	{
 	public:
@@ -30,6 +38,8 @@ namespace Common::Logic::SceneEntity
 		bool hasDepthPass;
 		bool hasDepthCubePass;
 		bool hasParticleLighting;
+		bool hasClusteredLighting;
+		bool hasCascadedShadows;
 		bool outputVelocity;
 
 		uint32_t lightMatricesNumber;
@@ -41,10 +51,20 @@ namespace Common::Logic::SceneEntity
 
 		float2 perlinNoiseTiling;
 
+		float cellSize;
+		float densityFalloffStart;
+		float densityFalloffEnd;
+
+		VegetationScattering scattering;
+		float blueNoiseDistance;
+
 		Graphics::Resources::ResourceID perlinNoiseId;
 		Graphics::Resources::ResourceID lightConstantBufferId;
 		Graphics::Resources::ResourceID lightParticleBufferId;
 		Graphics::Resources::ResourceID lightMatricesConstantBufferId;
+		Graphics::Resources::ResourceID lightClusterConstantBufferId;
+		Graphics::Resources::ResourceID lightClusterCountBufferId;
+		Graphics::Resources::ResourceID lightClusterIndexBufferId;
 		
 		std::vector<Graphics::Resources::ResourceID> shadowMapIds;
 		const std::vector<DxcDefine>* shaderDefines;
@@ -72,8 +92,13 @@ namespace Common::Logic::SceneEntity
 		void DrawShadows(ID3D12GraphicsCommandList* commandList, uint32_t lightMatrixStartIndex) override;
 		void DrawShadowsCube(ID3D12GraphicsCommandList* commandList, uint32_t lightMatrixStartIndex) override;
 
+		void DrawShadows(ID3D12GraphicsCommandList* commandList, const LightDesc& lightDesc);
+		void DrawShadowsCube(ID3D12GraphicsCommandList* commandList, const LightDesc& lightDesc);
+
 		void Draw(ID3D12GraphicsCommandList* commandList) override;
 
+		bool GetBounds(Graphics::Assets::AxisAlignedBox& bounds, Graphics::Assets::BoundingSphere& boundingSphere) const override;
+
 		void Release(Graphics::Resources::ResourceManager* resourceManager) override;
 
 	private:
@@ -85,6 +110,8 @@ namespace Common::Logic::SceneEntity
 		void CreateConstantBuffers(ID3D12Device* device, ID3D12GraphicsCommandList* commandList,
 			Graphics::Resources::ResourceManager* resourceManager, const VegetationSystemDesc& desc);
 
+		void UploadMutableConstants();
+
 		void CreateBuffers(ID3D12Device* device, ID3D12GraphicsCommandList* commandList,
 			Graphics::Resources::ResourceManager* resourceManager, const VegetationSystemDesc& desc);
 
@@ -99,11 +126,23 @@ namespace Common::Logic::SceneEntity
 
 		struct VegetationBufferDesc
 		{
-			uint8_t* buffer;
+			std::vector<uint8_t>& buffer;
 			const Graphics::Resources::TextureDesc& vegetationMapDesc;
 			const VegetationSystemDesc& vegetationSystemDesc;
 			float3 grassSizeMin;
 			float3 grassSizeMax;
+
+			std::vector<float2> blueNoisePoints;
+			uint2 blueNoiseTiles;
+			float blueNoiseTileSize;
+		};
+
+		struct GrassPlacement
+		{
+		public:
+			uint32_t mapPointIndex;
+			float2 planarPosition;
+			float yaw;
 		};
 
 		struct GrassVertex
@@ -118,25 +157,71 @@ namespace Common::Logic::SceneEntity
 		};
 
 		void FillVegetationBuffer(const VegetationBufferDesc& desc, uint32_t& resultGrassNumber);
-		void GetLocationData(const VegetationBufferDesc& desc, uint32_t mapPointIndex, bool isCap,
-			floatN& position, floatN& upVector);
+		void FillVegetationBlock(const VegetationBufferDesc& desc, uint32_t startCandidateIndex,
+			uint32_t endCandidateIndex, uint32_t startGrassIndex) const;
 
-		floatN CalculateRotation(const floatN& upVector, const floatN& upVectorTarget);
+		uint32_t GetCandidatesNumber(const VegetationBufferDesc& desc) const;
+		void CollectPlacements(const VegetationBufferDesc& desc, uint32_t startCandidateIndex,
+			uint32_t endCandidateIndex, std::vector<GrassPlacement>& placements) const;
+		bool SampleVegetationMap(const VegetationBufferDesc& desc, const float2& planarPosition, float threshold,
+			uint32_t& mapPointIndex) const;
+
+		float2 GetPlanarPosition(const VegetationBufferDesc& desc, uint32_t mapPointIndex,
+			Common::HashedRandom& random) const;
+		floatN GetUpVector(const float3& normal) const;
+
+		struct VegetationCell
+		{
+		public:
+			Graphics::Assets::AxisAlignedBox bounds;
+			uint32_t startGrassIndex;
+			uint32_t grassNumber;
+		};
+
+		struct CellDrawItem
+		{
+		public:
+			uint32_t startGrassIndex;
+			uint32_t grassNumber;
+			uint32_t faceMask;
+		};
+
+		void BuildCells(std::vector<uint8_t>& buffer, float cellSize);
+		void UpdateCellDensities(const float3& cameraPosition);
+		void SelectCells(const Graphics::Assets::Frustum* frustums, uint32_t frustumsNumber,
+			uint32_t activeFaceMask, std::vector<CellDrawItem>& drawItems) const;
+		void DrawCells(ID3D12GraphicsCommandList* commandList, Graphics::Assets::Material* material,
+			const std::vector<CellDrawItem>& drawItems) const;
+		void DrawCellsCube(ID3D12GraphicsCommandList* commandList, uint32_t lightMatrixStartIndex,
+			const std::vector<CellDrawItem>& drawItems) const;
 
 		GrassVertex SetVertex(const float3& position, uint64_t normal, uint64_t tangent,
 			const DirectX::PackedVector::XMHALF2& texCoord);
 
-		void LoadCache(const std::filesystem::path& fileName, std::vector<uint8_t>& buffer);
-		void SaveCache(const std::filesystem::path& fileName, const uint8_t* buffer, size_t size);
+		bool LoadCache(const std::filesystem::path& fileName, const VegetationSystemDesc& desc,
+			std::vector<uint8_t>& buffer);
+		void SaveCache(const std::filesystem::path& fileName, const VegetationSystemDesc& desc,
+			const uint8_t* buffer, size_t size);
 
 		struct Vegetation
 		{
 		public:
-			float4x4 world;
+			uint32_t positionXY;
+			uint32_t positionZYaw;
+			uint32_t upVector;
+			DirectX::PackedVector::XMHALF2 scaleXY;
+			DirectX::PackedVector::XMHALF2 heightWindInfluence;
+			uint32_t atlasCell;
+		};
 
-			float2 atlasElementOffset;
-			float windInfluence;
-			float height;
+		struct VegetationCacheHeader
+		{
+		public:
+			uint32_t instanceStride;
+			uint32_t instancesNumber;
+			VegetationScattering scattering;
+			float blueNoiseDistance;
+			Graphics::Assets::VertexQuantizationDesc quantizationDesc;
 		};
 
 		struct MutableConstants
@@ -162,19 +247,48 @@ namespace Common::Logic::SceneEntity
 			float lastWindStrength;
 
 			float4x4 lastViewProjection;
+
+			float3 positionOffset;
+			float padding0;
+			float3 positionScale;
+			float padding1;
 		};
 
 		static constexpr uint32_t QUADS_PER_GRASS = 3u;
+		static constexpr float YAW_QUANTIZATION_MAX = 65535.0f;
 
 		static constexpr float GRASS_WIND_INFLUENCE = 1.0f;
 		static constexpr float GRASS_CAP_WIND_INFLUENCE = 0.1f;
 		static constexpr float GRASS_SCATTERING = 0.01f;
 
-		uint32_t instancesNumber;
+		static constexpr uint32_t CANDIDATES_PER_BLOCK = 4096u;
+		static constexpr float BLUE_NOISE_TILE_SCALE = 32.0f;
+		static constexpr uint32_t CUBE_FACES_NUMBER = 6u;
+		static constexpr uint32_t ALL_FACES_MASK = 0x3Fu;
+		static constexpr uint32_t DRAW_CONSTANTS_REGISTER = 3u;
+		static constexpr uint32_t RANDOM_SEED = 0x9E3779B9u;
+
+		Graphics::Assets::VertexQuantizationDesc quantizationDesc;
+
+		Graphics::Assets::AxisAlignedBox vegetationBounds;
+		std::vector<VegetationCell> cells;
+		std::vector<uint32_t> cellGrassNumbers;
+		std::vector<CellDrawItem> visibleCells;
+		std::vector<CellDrawItem> shadowCells;
+
+		Graphics::Assets::Frustum cameraFrustum;
+		std::array<Graphics::Assets::Frustum, CUBE_FACES_NUMBER> shadowFrustums;
+
+		float densityFalloffStart;
+		float densityFalloffEnd;
 
 		const Camera* _camera;
 
+		MutableConstants mutableConstants;
 		MutableConstants* mutableConstantsBuffer;
+		D3D12_GPU_VIRTUAL_ADDRESS mutableConstantsAddress;
+
+		Graphics::FrameAllocator* frameAllocator;
 		float3* windDirection;
 		float* windStrength;
 
@@ -200,7 +314,5 @@ namespace Common::Logic::SceneEntity
 		Graphics::Assets::Material* materialDepthPrepass;
 		Graphics::Assets::Material* materialDepthPass;
 		Graphics::Assets::Material* materialDepthCubePass;
-
-		std::mt19937 randomEngine;
 	};
 }
@@ -39,17 +39,25 @@ Common::Logic::Scene::IScene* Common::Logic::SceneManager::GetCurrentScene()
 
 void Common::Logic::SceneManager::LoadScene(Scene::SceneID id, Graphics::DirectX12Renderer* renderer)
 {
-	if (scenes[id]->IsLoaded())
+	if (id == currentScene && scenes[id]->IsLoaded())
 		return;
 
 	_renderer = renderer;
 
-	_renderer->FlushQueue();
+	if (scenes[id]->IsLoaded())
+		_renderer->FlushQueue();
+
+	auto previousScene = scenes[currentScene];
 
-	scenes[currentScene]->Unload(renderer);
 	scenes[id]->Load(renderer);
 
 	currentScene = id;
+
+	if (previousScene->IsLoaded())
+		_renderer->GetDeferredReleaseQueue()->Enqueue([previousScene, renderer]()
+			{
+				previousScene->Unload(renderer);
+			});
 }
 
 void Common::Logic::SceneManager::SwitchToNextScene(Graphics::DirectX12Renderer* renderer)
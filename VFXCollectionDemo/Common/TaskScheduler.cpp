@@ -0,0 +1,120 @@
+#include "TaskScheduler.h"
+
+Common::TaskScheduler::TaskScheduler(uint32_t workersNumber)
+	: isStopping(false)
+{
+	workers.reserve(workersNumber);
+
+	for (uint32_t workerIndex = 0u; workerIndex < workersNumber; workerIndex++)
+		workers.push_back(std::thread(&TaskScheduler::WorkerFunc, this));
+}
+
+Common::TaskScheduler::~TaskScheduler()
+{
+	{
+		std::lock_guard<std::mutex> lock(tasksMutex);
+		isStopping = true;
+	}
+
+	tasksCondition.notify_all();
+
+	for (auto& worker : workers)
+		if (worker.joinable())
+			worker.join();
+}
+
+void Common::TaskScheduler::ParallelFor(uint32_t startIndex, uint32_t endIndex, uint32_t minRangeSize,
+	const RangeFunction& rangeFunction)
+{
+	if (startIndex >= endIndex)
+		return;
+
+	auto elementsNumber = endIndex - startIndex;
+	auto rangesNumber = std::min(elementsNumber / std::max(minRangeSize, 1u), GetWorkersNumber() + 1u);
+
+	if (rangesNumber <= 1u)
+	{
+		rangeFunction(startIndex, endIndex);
+		return;
+	}
+
+	std::atomic<uint32_t> pendingTasksNumber(rangesNumber - 1u);
+
+	auto getRangeStart = [startIndex, elementsNumber, rangesNumber](uint32_t rangeIndex)
+	{
+		return startIndex + static_cast<uint32_t>(static_cast<uint64_t>(elementsNumber) * rangeIndex / rangesNumber);
+	};
+
+	{
+		std::lock_guard<std::mutex> lock(tasksMutex);
+
+		for (uint32_t rangeIndex = 1u; rangeIndex < rangesNumber; rangeIndex++)
+			tasks.push({ &rangeFunction, &pendingTasksNumber, getRangeStart(rangeIndex), getRangeStart(rangeIndex + 1u) });
+	}
+
+	tasksCondition.notify_all();
+
+	rangeFunction(startIndex, getRangeStart(1u));
+
+	while (pendingTasksNumber.load(std::memory_order_acquire) != 0u)
+		if (!TryRunTask())
+			std::this_thread::yield();
+}
+
+uint32_t Common::TaskScheduler::GetWorkersNumber() const noexcept
+{
+	return static_cast<uint32_t>(workers.size());
+}
+
+Common::TaskScheduler* Common::TaskScheduler::GetShared()
+{
+	static TaskScheduler sharedScheduler(std::max(std::thread::hardware_concurrency(), 2u) - 1u);
+
+	return &sharedScheduler;
+}
+
+void Common::TaskScheduler::WorkerFunc()
+{
+	while (true)
+	{
+		RangeTask task{};
+
+		{
+			std::unique_lock<std::mutex> lock(tasksMutex);
+			tasksCondition.wait(lock, [this] { return isStopping || !tasks.empty(); });
+
+			if (tasks.empty())
+				return;
+
+			task = tasks.front();
+			tasks.pop();
+		}
+
+		RunTask(task);
+	}
+}
+
+bool Common::TaskScheduler::TryRunTask()
+{
+	RangeTask task{};
+
+	{
+		std::lock_guard<std::mutex> lock(tasksMutex);
+
+		if (tasks.empty())
+			return false;
+
+		task = tasks.front();
+		tasks.pop();
+	}
+
+	RunTask(task);
+
+	return true;
+}
+
+void Common::TaskScheduler::RunTask(const RangeTask& task)
+{
+	(*task.rangeFunction)(task.startIndex, task.endIndex);
+	task.pendingTasksNumber->fetch_sub(1u, std::memory_order_release);
+}
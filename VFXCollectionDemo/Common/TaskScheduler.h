@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../Includes.h"
+
+namespace Common
+{
+	using RangeFunction = std::function<void(uint32_t startIndex, uint32_t endIndex)>;
+
+	class TaskScheduler final
+	{
+	public:
+		TaskScheduler(uint32_t workersNumber);
+		~TaskScheduler();
+
+		void ParallelFor(uint32_t startIndex, uint32_t endIndex, uint32_t minRangeSize, const RangeFunction& rangeFunction);
+
+		uint32_t GetWorkersNumber() const noexcept;
+
+		static TaskScheduler* GetShared();
+
+	private:
+		TaskScheduler() = delete;
+		TaskScheduler(const TaskScheduler&) = delete;
+		TaskScheduler(TaskScheduler&&) = delete;
+		TaskScheduler& operator=(const TaskScheduler&) = delete;
+		TaskScheduler& operator=(TaskScheduler&&) = delete;
+
+		struct RangeTask
+		{
+		public:
+			const RangeFunction* rangeFunction;
+			std::atomic<uint32_t>* pendingTasksNumber;
+			uint32_t startIndex;
+			uint32_t endIndex;
+		};
+
+		void WorkerFunc();
+		bool TryRunTask();
+		static void RunTask(const RangeTask& task);
+
+		std::vector<std::thread> workers;
+		std::queue<RangeTask> tasks;
+		std::mutex tasksMutex;
+		std::condition_variable tasksCondition;
+
+		bool isStopping;
+	};
+}
@@ -5,6 +5,46 @@
 
 namespace Common
 {
+	class HashedRandom final
+	{
+	public:
+		using result_type = uint32_t;
+
+		HashedRandom(uint32_t seed, uint32_t index) noexcept
+			: state(Hash(seed ^ Hash(index)))
+		{
+
+		}
+
+		result_type operator()() noexcept
+		{
+			state = Hash(state);
+
+			return state;
+		}
+
+		static constexpr result_type min() noexcept
+		{
+			return 0u;
+		}
+
+		static constexpr result_type max() noexcept
+		{
+			return std::numeric_limits<result_type>::max();
+		}
+
+		static constexpr uint32_t Hash(uint32_t value) noexcept
+		{
+			auto state = value * 747796405u + 2891336453u;
+			auto word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+
+			return (word >> 22u) ^ word;
+		}
+
+	private:
+		uint32_t state;
+	};
+
 	class Utilities
 	{
 	public:
@@ -0,0 +1,67 @@
+#include "Frustum.h"
+
+using namespace DirectX;
+
+Graphics::Assets::Frustum::Frustum()
+	: planes{}
+{
+
+}
+
+Graphics::Assets::Frustum::Frustum(const float4x4& viewProjection)
+{
+	Update(viewProjection);
+}
+
+Graphics::Assets::Frustum::~Frustum()
+{
+
+}
+
+void Graphics::Assets::Frustum::Update(const float4x4& viewProjection)
+{
+	auto columns = XMMatrixTranspose(viewProjection);
+
+	planes[0u] = columns.r[3u] + columns.r[0u];
+	planes[1u] = columns.r[3u] - columns.r[0u];
+	planes[2u] = columns.r[3u] + columns.r[1u];
+	planes[3u] = columns.r[3u] - columns.r[1u];
+	planes[4u] = columns.r[2u];
+	planes[5u] = columns.r[3u] - columns.r[2u];
+
+	for (auto& plane : planes)
+		plane = XMPlaneNormalize(plane);
+}
+
+bool Graphics::Assets::Frustum::Intersects(const AxisAlignedBox& box) const
+{
+	auto minCorner = XMLoadFloat3(&box.minCorner);
+	auto maxCorner = XMLoadFloat3(&box.maxCorner);
+	auto zero = XMVectorZero();
+
+	for (const auto& plane : planes)
+	{
+		auto positiveVertex = XMVectorSelect(minCorner, maxCorner, XMVectorGreater(plane, zero));
+
+		if (XMVectorGetX(XMPlaneDotCoord(plane, positiveVertex)) < 0.0f)
+			return false;
+	}
+
+	return true;
+}
+
+bool Graphics::Assets::Frustum::Intersects(const float3& center, float radius) const
+{
+	auto centerV = XMLoadFloat3(&center);
+
+	for (const auto& plane : planes)
+		if (XMVectorGetX(XMPlaneDotCoord(plane, centerV)) < -radius)
+			return false;
+
+	return true;
+}
+
+const std::array<floatN, Graphics::Assets::Frustum::PLANES_NUMBER>& Graphics::Assets::Frustum::GetPlanes() const noexcept
+{
+	return planes;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "../DirectX12Includes.h"
+#include "MeshDesc.h"
+
+namespace Graphics::Assets
+{
+	class Frustum final
+	{
+	public:
+		static constexpr uint32_t PLANES_NUMBER = 6u;
+
+		Frustum();
+		Frustum(const float4x4& viewProjection);
+		~Frustum();
+
+		void Update(const float4x4& viewProjection);
+
+		bool Intersects(const AxisAlignedBox& box) const;
+		bool Intersects(const float3& center, float radius) const;
+
+		const std::array<floatN, PLANES_NUMBER>& GetPlanes() const noexcept;
+
+	private:
+		std::array<floatN, PLANES_NUMBER> planes;
+	};
+}
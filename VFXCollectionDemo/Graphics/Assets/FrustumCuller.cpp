@@ -0,0 +1,264 @@
+#include "FrustumCuller.h"
+#include <intrin.h>
+#include <immintrin.h>
+
+using namespace DirectX;
+
+void Graphics::Assets::FrustumCuller::Resize(BoundingSphereBatch& batch, uint32_t objectsNumber)
+{
+	auto alignedNumber = static_cast<size_t>((objectsNumber + BATCH_ALIGNMENT - 1u) / BATCH_ALIGNMENT * BATCH_ALIGNMENT);
+
+	batch.objectsNumber = objectsNumber;
+	batch.centerX.resize(alignedNumber, 0.0f);
+	batch.centerY.resize(alignedNumber, 0.0f);
+	batch.centerZ.resize(alignedNumber, 0.0f);
+	batch.radius.resize(alignedNumber, 0.0f);
+}
+
+void Graphics::Assets::FrustumCuller::Resize(AxisAlignedBoxBatch& batch, uint32_t objectsNumber)
+{
+	auto alignedNumber = static_cast<size_t>((objectsNumber + BATCH_ALIGNMENT - 1u) / BATCH_ALIGNMENT * BATCH_ALIGNMENT);
+
+	batch.objectsNumber = objectsNumber;
+	batch.centerX.resize(alignedNumber, 0.0f);
+	batch.centerY.resize(alignedNumber, 0.0f);
+	batch.centerZ.resize(alignedNumber, 0.0f);
+	batch.extentX.resize(alignedNumber, 0.0f);
+	batch.extentY.resize(alignedNumber, 0.0f);
+	batch.extentZ.resize(alignedNumber, 0.0f);
+}
+
+void Graphics::Assets::FrustumCuller::SetSphere(BoundingSphereBatch& batch, uint32_t index, const float3& center,
+	float radius) noexcept
+{
+	batch.centerX[index] = center.x;
+	batch.centerY[index] = center.y;
+	batch.centerZ[index] = center.z;
+	batch.radius[index] = radius;
+}
+
+void Graphics::Assets::FrustumCuller::SetBox(AxisAlignedBoxBatch& batch, uint32_t index,
+	const AxisAlignedBox& box) noexcept
+{
+	batch.centerX[index] = 0.5f * (box.maxCorner.x + box.minCorner.x);
+	batch.centerY[index] = 0.5f * (box.maxCorner.y + box.minCorner.y);
+	batch.centerZ[index] = 0.5f * (box.maxCorner.z + box.minCorner.z);
+	batch.extentX[index] = 0.5f * (box.maxCorner.x - box.minCorner.x);
+	batch.extentY[index] = 0.5f * (box.maxCorner.y - box.minCorner.y);
+	batch.extentZ[index] = 0.5f * (box.maxCorner.z - box.minCorner.z);
+}
+
+void Graphics::Assets::FrustumCuller::Cull(const Frustum& frustum, const BoundingSphereBatch& batch,
+	std::vector<uint32_t>& visibilityMask)
+{
+	static const bool isAVXSupported = IsAVXSupported();
+
+	auto maskWordsNumber = GetMaskWordsNumber(batch.objectsNumber);
+	visibilityMask.assign(maskWordsNumber, 0u);
+
+	if (batch.objectsNumber == 0u)
+		return;
+
+	auto planes = GetPlanes(frustum);
+
+	if (isAVXSupported)
+		CullSpheresAVX(planes, batch, visibilityMask.data());
+	else
+		CullSpheresSSE(planes, batch, visibilityMask.data());
+
+	if (batch.objectsNumber % MASK_WORD_BITS != 0u)
+		visibilityMask[maskWordsNumber - 1u] &= (1u << (batch.objectsNumber % MASK_WORD_BITS)) - 1u;
+}
+
+void Graphics::Assets::FrustumCuller::Cull(const Frustum& frustum, const AxisAlignedBoxBatch& batch,
+	std::vector<uint32_t>& visibilityMask)
+{
+	static const bool isAVXSupported = IsAVXSupported();
+
+	auto maskWordsNumber = GetMaskWordsNumber(batch.objectsNumber);
+	visibilityMask.assign(maskWordsNumber, 0u);
+
+	if (batch.objectsNumber == 0u)
+		return;
+
+	auto planes = GetPlanes(frustum);
+
+	if (isAVXSupported)
+		CullBoxesAVX(planes, batch, visibilityMask.data());
+	else
+		CullBoxesSSE(planes, batch, visibilityMask.data());
+
+	if (batch.objectsNumber % MASK_WORD_BITS != 0u)
+		visibilityMask[maskWordsNumber - 1u] &= (1u << (batch.objectsNumber % MASK_WORD_BITS)) - 1u;
+}
+
+bool Graphics::Assets::FrustumCuller::IsVisible(const std::vector<uint32_t>& visibilityMask, uint32_t index) noexcept
+{
+	return (visibilityMask[index / MASK_WORD_BITS] & (1u << (index % MASK_WORD_BITS))) != 0u;
+}
+
+bool Graphics::Assets::FrustumCuller::IsAVXSupported() noexcept
+{
+	int cpuInfo[4]{};
+	__cpuid(cpuInfo, 1);
+
+	auto hasAVX = (cpuInfo[2] & (1 << 28)) != 0;
+	auto hasOSXSave = (cpuInfo[2] & (1 << 27)) != 0;
+
+	if (!hasAVX || !hasOSXSave)
+		return false;
+
+	return (_xgetbv(0) & 6u) == 6u;
+}
+
+Graphics::Assets::FrustumCuller::FrustumPlanes Graphics::Assets::FrustumCuller::GetPlanes(const Frustum& frustum) noexcept
+{
+	FrustumPlanes result{};
+
+	for (uint32_t planeIndex = 0u; planeIndex < Frustum::PLANES_NUMBER; planeIndex++)
+	{
+		float4 plane{};
+		XMStoreFloat4(&plane, frustum.GetPlanes()[planeIndex]);
+
+		result.x[planeIndex] = plane.x;
+		result.y[planeIndex] = plane.y;
+		result.z[planeIndex] = plane.z;
+		result.w[planeIndex] = plane.w;
+	}
+
+	return result;
+}
+
+uint32_t Graphics::Assets::FrustumCuller::GetMaskWordsNumber(uint32_t objectsNumber) noexcept
+{
+	return (objectsNumber + MASK_WORD_BITS - 1u) / MASK_WORD_BITS;
+}
+
+void Graphics::Assets::FrustumCuller::CullSpheresSSE(const FrustumPlanes& planes, const BoundingSphereBatch& batch,
+	uint32_t* visibilityMask) noexcept
+{
+	for (uint32_t objectIndex = 0u; objectIndex < batch.objectsNumber; objectIndex += 4u)
+	{
+		auto centerX = _mm_loadu_ps(batch.centerX.data() + objectIndex);
+		auto centerY = _mm_loadu_ps(batch.centerY.data() + objectIndex);
+		auto centerZ = _mm_loadu_ps(batch.centerZ.data() + objectIndex);
+		auto negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(batch.radius.data() + objectIndex));
+
+		auto visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+		for (uint32_t planeIndex = 0u; planeIndex < Frustum::PLANES_NUMBER; planeIndex++)
+		{
+			auto distance = _mm_add_ps(_mm_mul_ps(centerX, _mm_set1_ps(planes.x[planeIndex])), _mm_set1_ps(planes.w[planeIndex]));
+			distance = _mm_add_ps(distance, _mm_mul_ps(centerY, _mm_set1_ps(planes.y[planeIndex])));
+			distance = _mm_add_ps(distance, _mm_mul_ps(centerZ, _mm_set1_ps(planes.z[planeIndex])));
+
+			visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, negativeRadius));
+		}
+
+		auto mask = static_cast<uint32_t>(_mm_movemask_ps(visible));
+		visibilityMask[objectIndex / MASK_WORD_BITS] |= mask << (objectIndex % MASK_WORD_BITS);
+	}
+}
+
+void Graphics::Assets::FrustumCuller::CullSpheresAVX(const FrustumPlanes& planes, const BoundingSphereBatch& batch,
+	uint32_t* visibilityMask) noexcept
+{
+	for (uint32_t objectIndex = 0u; objectIndex < batch.objectsNumber; objectIndex += 8u)
+	{
+		auto centerX = _mm256_loadu_ps(batch.centerX.data() + objectIndex);
+		auto centerY = _mm256_loadu_ps(batch.centerY.data() + objectIndex);
+		auto centerZ = _mm256_loadu_ps(batch.centerZ.data() + objectIndex);
+		auto negativeRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(batch.radius.data() + objectIndex));
+
+		auto visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+		for (uint32_t planeIndex = 0u; planeIndex < Frustum::PLANES_NUMBER; planeIndex++)
+		{
+			auto distance = _mm256_add_ps(_mm256_mul_ps(centerX, _mm256_set1_ps(planes.x[planeIndex])),
+				_mm256_set1_ps(planes.w[planeIndex]));
+			distance = _mm256_add_ps(distance, _mm256_mul_ps(centerY, _mm256_set1_ps(planes.y[planeIndex])));
+			distance = _mm256_add_ps(distance, _mm256_mul_ps(centerZ, _mm256_set1_ps(planes.z[planeIndex])));
+
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(distance, negativeRadius, _CMP_GE_OQ));
+		}
+
+		auto mask = static_cast<uint32_t>(_mm256_movemask_ps(visible));
+		visibilityMask[objectIndex / MASK_WORD_BITS] |= mask << (objectIndex % MASK_WORD_BITS);
+	}
+}
+
+void Graphics::Assets::FrustumCuller::CullBoxesSSE(const FrustumPlanes& planes, const AxisAlignedBoxBatch& batch,
+	uint32_t* visibilityMask) noexcept
+{
+	auto absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+	for (uint32_t objectIndex = 0u; objectIndex < batch.objectsNumber; objectIndex += 4u)
+	{
+		auto centerX = _mm_loadu_ps(batch.centerX.data() + objectIndex);
+		auto centerY = _mm_loadu_ps(batch.centerY.data() + objectIndex);
+		auto centerZ = _mm_loadu_ps(batch.centerZ.data() + objectIndex);
+		auto extentX = _mm_loadu_ps(batch.extentX.data() + objectIndex);
+		auto extentY = _mm_loadu_ps(batch.extentY.data() + objectIndex);
+		auto extentZ = _mm_loadu_ps(batch.extentZ.data() + objectIndex);
+
+		auto visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+		for (uint32_t planeIndex = 0u; planeIndex < Frustum::PLANES_NUMBER; planeIndex++)
+		{
+			auto planeX = _mm_set1_ps(planes.x[planeIndex]);
+			auto planeY = _mm_set1_ps(planes.y[planeIndex]);
+			auto planeZ = _mm_set1_ps(planes.z[planeIndex]);
+
+			auto distance = _mm_add_ps(_mm_mul_ps(centerX, planeX), _mm_set1_ps(planes.w[planeIndex]));
+			distance = _mm_add_ps(distance, _mm_mul_ps(centerY, planeY));
+			distance = _mm_add_ps(distance, _mm_mul_ps(centerZ, planeZ));
+
+			auto radius = _mm_mul_ps(extentX, _mm_and_ps(planeX, absMask));
+			radius = _mm_add_ps(radius, _mm_mul_ps(extentY, _mm_and_ps(planeY, absMask)));
+			radius = _mm_add_ps(radius, _mm_mul_ps(extentZ, _mm_and_ps(planeZ, absMask)));
+
+			visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+		}
+
+		auto mask = static_cast<uint32_t>(_mm_movemask_ps(visible));
+		visibilityMask[objectIndex / MASK_WORD_BITS] |= mask << (objectIndex % MASK_WORD_BITS);
+	}
+}
+
+void Graphics::Assets::FrustumCuller::CullBoxesAVX(const FrustumPlanes& planes, const AxisAlignedBoxBatch& batch,
+	uint32_t* visibilityMask) noexcept
+{
+	auto absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+	for (uint32_t objectIndex = 0u; objectIndex < batch.objectsNumber; objectIndex += 8u)
+	{
+		auto centerX = _mm256_loadu_ps(batch.centerX.data() + objectIndex);
+		auto centerY = _mm256_loadu_ps(batch.centerY.data() + objectIndex);
+		auto centerZ = _mm256_loadu_ps(batch.centerZ.data() + objectIndex);
+		auto extentX = _mm256_loadu_ps(batch.extentX.data() + objectIndex);
+		auto extentY = _mm256_loadu_ps(batch.extentY.data() + objectIndex);
+		auto extentZ = _mm256_loadu_ps(batch.extentZ.data() + objectIndex);
+
+		auto visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+		for (uint32_t planeIndex = 0u; planeIndex < Frustum::PLANES_NUMBER; planeIndex++)
+		{
+			auto planeX = _mm256_set1_ps(planes.x[planeIndex]);
+			auto planeY = _mm256_set1_ps(planes.y[planeIndex]);
+			auto planeZ = _mm256_set1_ps(planes.z[planeIndex]);
+
+			auto distance = _mm256_add_ps(_mm256_mul_ps(centerX, planeX), _mm256_set1_ps(planes.w[planeIndex]));
+			distance = _mm256_add_ps(distance, _mm256_mul_ps(centerY, planeY));
+			distance = _mm256_add_ps(distance, _mm256_mul_ps(centerZ, planeZ));
+
+			auto radius = _mm256_mul_ps(extentX, _mm256_and_ps(planeX, absMask));
+			radius = _mm256_add_ps(radius, _mm256_mul_ps(extentY, _mm256_and_ps(planeY, absMask)));
+			radius = _mm256_add_ps(radius, _mm256_mul_ps(extentZ, _mm256_and_ps(planeZ, absMask)));
+
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_GE_OQ));
+		}
+
+		auto mask = static_cast<uint32_t>(_mm256_movemask_ps(visible));
+		visibilityMask[objectIndex / MASK_WORD_BITS] |= mask << (objectIndex % MASK_WORD_BITS);
+	}
+}
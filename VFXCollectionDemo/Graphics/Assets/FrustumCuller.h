@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../DirectX12Includes.h"
+#include "MeshDesc.h"
+#include "Frustum.h"
+
+namespace Graphics::Assets
+{
+	struct BoundingSphereBatch
+	{
+	public:
+		uint32_t objectsNumber;
+
+		std::vector<float> centerX;
+		std::vector<float> centerY;
+		std::vector<float> centerZ;
+		std::vector<float> radius;
+	};
+
+	struct AxisAlignedBoxBatch
+	{
+	public:
+		uint32_t objectsNumber;
+
+		std::vector<float> centerX;
+		std::vector<float> centerY;
+		std::vector<float> centerZ;
+		std::vector<float> extentX;
+		std::vector<float> extentY;
+		std::vector<float> extentZ;
+	};
+
+	class FrustumCuller final
+	{
+	public:
+		static void Resize(BoundingSphereBatch& batch, uint32_t objectsNumber);
+		static void Resize(AxisAlignedBoxBatch& batch, uint32_t objectsNumber);
+
+		static void SetSphere(BoundingSphereBatch& batch, uint32_t index, const float3& center, float radius) noexcept;
+		static void SetBox(AxisAlignedBoxBatch& batch, uint32_t index, const AxisAlignedBox& box) noexcept;
+
+		static void Cull(const Frustum& frustum, const BoundingSphereBatch& batch, std::vector<uint32_t>& visibilityMask);
+		static void Cull(const Frustum& frustum, const AxisAlignedBoxBatch& batch, std::vector<uint32_t>& visibilityMask);
+
+		static bool IsVisible(const std::vector<uint32_t>& visibilityMask, uint32_t index) noexcept;
+		static bool IsAVXSupported() noexcept;
+
+		static constexpr uint32_t BATCH_ALIGNMENT = 8u;
+		static constexpr uint32_t MASK_WORD_BITS = 32u;
+
+	private:
+		FrustumCuller() = delete;
+		~FrustumCuller() = delete;
+		FrustumCuller(const FrustumCuller&) = delete;
+		FrustumCuller(FrustumCuller&&) = delete;
+		FrustumCuller& operator=(const FrustumCuller&) = delete;
+		FrustumCuller& operator=(FrustumCuller&&) = delete;
+
+		struct FrustumPlanes
+		{
+		public:
+			std::array<float, Frustum::PLANES_NUMBER> x;
+			std::array<float, Frustum::PLANES_NUMBER> y;
+			std::array<float, Frustum::PLANES_NUMBER> z;
+			std::array<float, Frustum::PLANES_NUMBER> w;
+		};
+
+		static FrustumPlanes GetPlanes(const Frustum& frustum) noexcept;
+		static uint32_t GetMaskWordsNumber(uint32_t objectsNumber) noexcept;
+
+		static void CullSpheresSSE(const FrustumPlanes& planes, const BoundingSphereBatch& batch,
+			uint32_t* visibilityMask) noexcept;
+		static void CullSpheresAVX(const FrustumPlanes& planes, const BoundingSphereBatch& batch,
+			uint32_t* visibilityMask) noexcept;
+
+		static void CullBoxesSSE(const FrustumPlanes& planes, const AxisAlignedBoxBatch& batch,
+			uint32_t* visibilityMask) noexcept;
+		static void CullBoxesAVX(const FrustumPlanes& planes, const AxisAlignedBoxBatch& batch,
+			uint32_t* visibilityMask) noexcept;
+	};
+}
@@ -0,0 +1,126 @@
+#include "PoissonDiskGenerator.h"
+#include "../../../Common/Utilities.h"
+#include "../../../Common/TaskScheduler.h"
+
+using namespace Common;
+
+Graphics::Assets::Generators::PoissonDiskGenerator::PoissonDiskGenerator()
+	: cellsPerSide(0u), cellSize(0.0f), _tileSize(0.0f)
+{
+
+}
+
+Graphics::Assets::Generators::PoissonDiskGenerator::~PoissonDiskGenerator()
+{
+
+}
+
+void Graphics::Assets::Generators::PoissonDiskGenerator::Generate(float tileSize, float minDistance, uint32_t seed,
+	std::vector<float2>& points)
+{
+	points.clear();
+
+	if (tileSize <= 0.0f || minDistance <= 0.0f)
+		return;
+
+	cellsPerSide = static_cast<uint32_t>(tileSize * static_cast<float>(std::numbers::sqrt2) / minDistance);
+	cellsPerSide = std::max(cellsPerSide - cellsPerSide % PHASE_STRIDE, MIN_CELLS_PER_SIDE);
+	cellSize = tileSize / cellsPerSide;
+	_tileSize = tileSize;
+
+	auto cellsNumber = static_cast<size_t>(cellsPerSide) * cellsPerSide;
+	cellPoints.assign(cellsNumber, float2{});
+	cellOccupancy.assign(cellsNumber, 0u);
+
+	auto minDistanceSquared = minDistance * minDistance;
+	auto phaseCellsPerSide = cellsPerSide / PHASE_STRIDE;
+	auto phaseCellsNumber = phaseCellsPerSide * phaseCellsPerSide;
+
+	auto taskScheduler = TaskScheduler::GetShared();
+
+	for (uint32_t attemptIndex = 0u; attemptIndex < ATTEMPTS_NUMBER; attemptIndex++)
+	{
+		auto attemptSeed = seed ^ HashedRandom::Hash(attemptIndex);
+
+		for (uint32_t phaseIndex = 0u; phaseIndex < PHASES_NUMBER; phaseIndex++)
+		{
+			auto phaseX = phaseIndex % PHASE_STRIDE;
+			auto phaseY = phaseIndex / PHASE_STRIDE;
+
+			taskScheduler->ParallelFor(0u, phaseCellsNumber, CELLS_PER_TASK, [&](uint32_t startIndex, uint32_t endIndex)
+			{
+				for (auto phaseCellIndex = startIndex; phaseCellIndex < endIndex; phaseCellIndex++)
+				{
+					auto cellX = (phaseCellIndex % phaseCellsPerSide) * PHASE_STRIDE + phaseX;
+					auto cellY = (phaseCellIndex / phaseCellsPerSide) * PHASE_STRIDE + phaseY;
+					auto cellIndex = static_cast<size_t>(cellY) * cellsPerSide + cellX;
+
+					if (cellOccupancy[cellIndex] != 0u)
+						continue;
+
+					HashedRandom random(attemptSeed, static_cast<uint32_t>(cellIndex));
+
+					float2 candidate
+					{
+						(cellX + Utilities::Random(random)) * cellSize,
+						(cellY + Utilities::Random(random)) * cellSize
+					};
+
+					if (!IsFarEnough(candidate, static_cast<int32_t>(cellX), static_cast<int32_t>(cellY), minDistanceSquared))
+						continue;
+
+					cellPoints[cellIndex] = candidate;
+					cellOccupancy[cellIndex] = 1u;
+				}
+			});
+		}
+	}
+
+	for (size_t cellIndex = 0u; cellIndex < cellsNumber; cellIndex++)
+	{
+		if (cellOccupancy[cellIndex] != 0u)
+			points.push_back(cellPoints[cellIndex]);
+	}
+}
+
+bool Graphics::Assets::Generators::PoissonDiskGenerator::IsFarEnough(const float2& candidate,
+	int32_t cellX, int32_t cellY, float minDistanceSquared) const
+{
+	auto cellsPerSideSigned = static_cast<int32_t>(cellsPerSide);
+
+	for (int32_t offsetY = -NEIGHBOUR_RADIUS; offsetY <= NEIGHBOUR_RADIUS; offsetY++)
+	{
+		auto neighbourY = (cellY + offsetY + cellsPerSideSigned) % cellsPerSideSigned;
+
+		for (int32_t offsetX = -NEIGHBOUR_RADIUS; offsetX <= NEIGHBOUR_RADIUS; offsetX++)
+		{
+			auto neighbourX = (cellX + offsetX + cellsPerSideSigned) % cellsPerSideSigned;
+			auto neighbourIndex = static_cast<size_t>(neighbourY) * cellsPerSide + neighbourX;
+
+			if (cellOccupancy[neighbourIndex] == 0u)
+				continue;
+
+			const auto& neighbour = cellPoints[neighbourIndex];
+			auto distanceX = WrapDistance(candidate.x - neighbour.x);
+			auto distanceY = WrapDistance(candidate.y - neighbour.y);
+
+			if (distanceX * distanceX + distanceY * distanceY < minDistanceSquared)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+float Graphics::Assets::Generators::PoissonDiskGenerator::WrapDistance(float distance) const noexcept
+{
+	auto halfTileSize = 0.5f * _tileSize;
+
+	if (distance > halfTileSize)
+		return distance - _tileSize;
+
+	if (distance < -halfTileSize)
+		return distance + _tileSize;
+
+	return distance;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../../DirectX12Includes.h"
+
+namespace Graphics::Assets::Generators
+{
+	class PoissonDiskGenerator
+	{
+	public:
+		PoissonDiskGenerator();
+		~PoissonDiskGenerator();
+
+		void Generate(float tileSize, float minDistance, uint32_t seed, std::vector<float2>& points);
+
+	private:
+		bool IsFarEnough(const float2& candidate, int32_t cellX, int32_t cellY, float minDistanceSquared) const;
+		float WrapDistance(float distance) const noexcept;
+
+		static constexpr uint32_t ATTEMPTS_NUMBER = 30u;
+		static constexpr uint32_t PHASE_STRIDE = 3u;
+		static constexpr uint32_t PHASES_NUMBER = PHASE_STRIDE * PHASE_STRIDE;
+		static constexpr uint32_t MIN_CELLS_PER_SIDE = PHASE_STRIDE * 2u;
+		static constexpr uint32_t CELLS_PER_TASK = 256u;
+		static constexpr int32_t NEIGHBOUR_RADIUS = 2;
+
+		std::vector<float2> cellPoints;
+		std::vector<uint8_t> cellOccupancy;
+
+		uint32_t cellsPerSide;
+		float cellSize;
+		float _tileSize;
+	};
+}
@@ -1,4 +1,6 @@
 #include "GeometryUtilities.h"
+#include <intrin.h>
+#include <immintrin.h>
 
 using namespace DirectX;
 
@@ -256,3 +258,105 @@ uint64_t Graphics::Assets::GeometryUtilities::Vector3ToHalf4(const float3& value
 
 	return result;
 }
+
+uint64_t Graphics::Assets::GeometryUtilities::VectorToHalf4(const floatN& value) noexcept
+{
+	static const bool isF16CSupported = IsF16CSupported();
+
+	if (isF16CSupported)
+		return static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT)));
+
+	uint64_t result{};
+	DirectX::PackedVector::XMStoreHalf4(reinterpret_cast<DirectX::PackedVector::XMHALF4*>(&result), value);
+
+	return result;
+}
+
+bool Graphics::Assets::GeometryUtilities::IsF16CSupported() noexcept
+{
+	int cpuInfo[4]{};
+	__cpuid(cpuInfo, 1);
+
+	auto hasF16C = (cpuInfo[2] & (1 << 29)) != 0;
+	auto hasOSXSave = (cpuInfo[2] & (1 << 27)) != 0;
+
+	if (!hasF16C || !hasOSXSave)
+		return false;
+
+	return (_xgetbv(0) & 6u) == 6u;
+}
+
+Graphics::Assets::AxisAlignedBox Graphics::Assets::GeometryUtilities::MergeBoxes(const AxisAlignedBox& box0,
+	const AxisAlignedBox& box1) noexcept
+{
+	AxisAlignedBox result{};
+	XMStoreFloat3(&result.minCorner, XMVectorMin(XMLoadFloat3(&box0.minCorner), XMLoadFloat3(&box1.minCorner)));
+	XMStoreFloat3(&result.maxCorner, XMVectorMax(XMLoadFloat3(&box0.maxCorner), XMLoadFloat3(&box1.maxCorner)));
+
+	return result;
+}
+
+float Graphics::Assets::GeometryUtilities::DistanceToBox(const AxisAlignedBox& box, const float3& point) noexcept
+{
+	auto pointV = XMLoadFloat3(&point);
+	auto closestPoint = XMVectorClamp(pointV, XMLoadFloat3(&box.minCorner), XMLoadFloat3(&box.maxCorner));
+
+	return XMVectorGetX(XMVector3Length(pointV - closestPoint));
+}
+
+bool Graphics::Assets::GeometryUtilities::SphereIntersectsBox(const AxisAlignedBox& box, const float3& center,
+	float radius) noexcept
+{
+	return DistanceToBox(box, center) <= radius;
+}
+
+void Graphics::Assets::GeometryUtilities::CalculateBounds(const uint8_t* vertexData, uint32_t verticesNumber,
+	size_t stride, AxisAlignedBox& box, BoundingSphere& sphere) noexcept
+{
+	if (verticesNumber == 0u)
+	{
+		box = {};
+		sphere = {};
+
+		return;
+	}
+
+	auto minCorner = XMVectorReplicate(std::numeric_limits<float>::max());
+	auto maxCorner = XMVectorReplicate(-std::numeric_limits<float>::max());
+
+	for (uint32_t vertexIndex = 0u; vertexIndex < verticesNumber; vertexIndex++)
+	{
+		auto position = XMLoadFloat3(reinterpret_cast<const float3*>(vertexData + vertexIndex * stride));
+
+		minCorner = XMVectorMin(minCorner, position);
+		maxCorner = XMVectorMax(maxCorner, position);
+	}
+
+	XMStoreFloat3(&box.minCorner, minCorner);
+	XMStoreFloat3(&box.maxCorner, maxCorner);
+
+	auto center = 0.5f * (minCorner + maxCorner);
+	auto radiusSquared = XMVectorZero();
+
+	for (uint32_t vertexIndex = 0u; vertexIndex < verticesNumber; vertexIndex++)
+	{
+		auto position = XMLoadFloat3(reinterpret_cast<const float3*>(vertexData + vertexIndex * stride));
+		radiusSquared = XMVectorMax(radiusSquared, XMVector3LengthSq(position - center));
+	}
+
+	XMStoreFloat3(&sphere.center, center);
+	sphere.radius = XMVectorGetX(XMVectorSqrt(radiusSquared));
+}
+
+Graphics::Assets::BoundingSphere Graphics::Assets::GeometryUtilities::CalculateBoundingSphere(
+	const AxisAlignedBox& box) noexcept
+{
+	auto minCorner = XMLoadFloat3(&box.minCorner);
+	auto maxCorner = XMLoadFloat3(&box.maxCorner);
+
+	BoundingSphere result{};
+	XMStoreFloat3(&result.center, 0.5f * (minCorner + maxCorner));
+	result.radius = 0.5f * XMVectorGetX(XMVector3Length(maxCorner - minCorner));
+
+	return result;
+}
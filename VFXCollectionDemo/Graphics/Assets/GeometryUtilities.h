@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../DirectX12Includes.h"
+#include "MeshDesc.h"
 
 namespace Graphics::Assets
 {
@@ -24,6 +25,16 @@ namespace Graphics::Assets
 		static void CalculateTangents(size_t stride, std::vector<uint8_t>& vertexBuffer);
 
 		static uint64_t Vector3ToHalf4(const float3& value);
+		static uint64_t VectorToHalf4(const floatN& value) noexcept;
+		static bool IsF16CSupported() noexcept;
+
+		static AxisAlignedBox MergeBoxes(const AxisAlignedBox& box0, const AxisAlignedBox& box1) noexcept;
+		static float DistanceToBox(const AxisAlignedBox& box, const float3& point) noexcept;
+		static bool SphereIntersectsBox(const AxisAlignedBox& box, const float3& center, float radius) noexcept;
+
+		static void CalculateBounds(const uint8_t* vertexData, uint32_t verticesNumber, size_t stride,
+			AxisAlignedBox& box, BoundingSphere& sphere) noexcept;
+		static BoundingSphere CalculateBoundingSphere(const AxisAlignedBox& box) noexcept;
 
 		static constexpr float EPSILON = 1E-5f;
 
@@ -0,0 +1,216 @@
+#include "HeightFieldSampler.h"
+
+using namespace DirectX;
+
+Graphics::Assets::HeightFieldSampler::HeightFieldSampler()
+	: _normalHeightData(nullptr), _samplesPerWidth(0u), _samplesPerHeight(0u), _minCorner{}, _positionScale{},
+	_maxCoord{}
+{
+
+}
+
+Graphics::Assets::HeightFieldSampler::HeightFieldSampler(const floatN* normalHeightData, uint32_t samplesPerWidth,
+	uint32_t samplesPerHeight, const float3& minCorner, const float3& size)
+{
+	Reset(normalHeightData, samplesPerWidth, samplesPerHeight, minCorner, size);
+}
+
+Graphics::Assets::HeightFieldSampler::~HeightFieldSampler()
+{
+
+}
+
+void Graphics::Assets::HeightFieldSampler::Reset(const floatN* normalHeightData, uint32_t samplesPerWidth,
+	uint32_t samplesPerHeight, const float3& minCorner, const float3& size)
+{
+	_normalHeightData = normalHeightData;
+	_samplesPerWidth = samplesPerWidth;
+	_samplesPerHeight = samplesPerHeight;
+	_minCorner = minCorner;
+
+	_maxCoord = float2(static_cast<float>(samplesPerWidth - 1u), static_cast<float>(samplesPerHeight - 1u));
+	_positionScale = float2(_maxCoord.x / size.x, _maxCoord.y / size.y);
+}
+
+float Graphics::Assets::HeightFieldSampler::GetHeight(const float2& position) const noexcept
+{
+	return InterpolateHeight(CalculateWeights(position));
+}
+
+float3 Graphics::Assets::HeightFieldSampler::GetNormal(const float2& position) const noexcept
+{
+	return InterpolateNormal(CalculateWeights(position));
+}
+
+void Graphics::Assets::HeightFieldSampler::Sample(const float2& position, float& height, float3& normal) const noexcept
+{
+	auto weights = CalculateWeights(position);
+
+	height = InterpolateHeight(weights);
+	normal = InterpolateNormal(weights);
+}
+
+void Graphics::Assets::HeightFieldSampler::GetHeights(const float2* positions, size_t positionsNumber,
+	float* heights) const noexcept
+{
+	Sample(positions, positionsNumber, heights, nullptr);
+}
+
+void Graphics::Assets::HeightFieldSampler::GetNormals(const float2* positions, size_t positionsNumber,
+	float3* normals) const noexcept
+{
+	Sample(positions, positionsNumber, nullptr, normals);
+}
+
+void Graphics::Assets::HeightFieldSampler::Sample(const float2* positions, size_t positionsNumber, float* heights,
+	float3* normals) const noexcept
+{
+	std::array<SampleWeights, BATCH_SIZE> batchWeights;
+	size_t positionIndex = 0u;
+
+	for (; positionIndex + BATCH_SIZE <= positionsNumber; positionIndex += BATCH_SIZE)
+	{
+		CalculateWeights(positions + positionIndex, batchWeights.data());
+
+		for (size_t laneIndex = 0u; laneIndex < BATCH_SIZE; laneIndex++)
+		{
+			if (heights != nullptr)
+				heights[positionIndex + laneIndex] = InterpolateHeight(batchWeights[laneIndex]);
+
+			if (normals != nullptr)
+				normals[positionIndex + laneIndex] = InterpolateNormal(batchWeights[laneIndex]);
+		}
+	}
+
+	for (; positionIndex < positionsNumber; positionIndex++)
+	{
+		auto weights = CalculateWeights(positions[positionIndex]);
+
+		if (heights != nullptr)
+			heights[positionIndex] = InterpolateHeight(weights);
+
+		if (normals != nullptr)
+			normals[positionIndex] = InterpolateNormal(weights);
+	}
+}
+
+Graphics::Assets::HeightFieldSampler::SampleWeights Graphics::Assets::HeightFieldSampler::CalculateWeights(
+	const float2& position) const noexcept
+{
+	auto coordX = std::clamp((position.x - _minCorner.x) * _positionScale.x, 0.0f, _maxCoord.x);
+	auto coordY = std::clamp((position.y - _minCorner.y) * _positionScale.y, 0.0f, _maxCoord.y);
+
+	auto cellX = std::min(std::floor(coordX), _maxCoord.x - 1.0f);
+	auto cellY = std::min(std::floor(coordY), _maxCoord.y - 1.0f);
+
+	auto fractionX = coordX - cellX;
+	auto fractionY = coordY - cellY;
+
+	auto index00 = static_cast<uint32_t>(cellX) + static_cast<uint32_t>(cellY) * _samplesPerWidth;
+
+	SampleWeights weights{};
+	weights.index10 = index00 + 1u;
+	weights.index01 = index00 + _samplesPerWidth;
+
+	if (fractionX + fractionY > 1.0f)
+	{
+		weights.indexCorner = index00 + _samplesPerWidth + 1u;
+		weights.weightCorner = fractionX + fractionY - 1.0f;
+		weights.weight10 = 1.0f - fractionY;
+		weights.weight01 = 1.0f - fractionX;
+	}
+	else
+	{
+		weights.indexCorner = index00;
+		weights.weightCorner = 1.0f - fractionX - fractionY;
+		weights.weight10 = fractionX;
+		weights.weight01 = fractionY;
+	}
+
+	return weights;
+}
+
+void Graphics::Assets::HeightFieldSampler::CalculateWeights(const float2* positions,
+	SampleWeights* weights) const noexcept
+{
+	auto positionX = XMVectorSet(positions[0u].x, positions[1u].x, positions[2u].x, positions[3u].x);
+	auto positionY = XMVectorSet(positions[0u].y, positions[1u].y, positions[2u].y, positions[3u].y);
+
+	auto one = XMVectorSplatOne();
+	auto maxCoordX = XMVectorReplicate(_maxCoord.x);
+	auto maxCoordY = XMVectorReplicate(_maxCoord.y);
+
+	auto coordX = (positionX - XMVectorReplicate(_minCorner.x)) * XMVectorReplicate(_positionScale.x);
+	auto coordY = (positionY - XMVectorReplicate(_minCorner.y)) * XMVectorReplicate(_positionScale.y);
+
+	coordX = XMVectorClamp(coordX, XMVectorZero(), maxCoordX);
+	coordY = XMVectorClamp(coordY, XMVectorZero(), maxCoordY);
+
+	auto cellX = XMVectorMin(XMVectorFloor(coordX), maxCoordX - one);
+	auto cellY = XMVectorMin(XMVectorFloor(coordY), maxCoordY - one);
+
+	auto fractionX = coordX - cellX;
+	auto fractionY = coordY - cellY;
+
+	auto cornerWeight = fractionX + fractionY - one;
+	auto upperTriangle = XMVectorGreater(cornerWeight, XMVectorZero());
+
+	auto weightCorner = XMVectorAbs(cornerWeight);
+	auto weight10 = XMVectorSelect(fractionX, one - fractionY, upperTriangle);
+	auto weight01 = XMVectorSelect(fractionY, one - fractionX, upperTriangle);
+
+	XMUINT4 cellXLanes;
+	XMUINT4 cellYLanes;
+	XMUINT4 upperTriangleLanes;
+	XMStoreUInt4(&cellXLanes, cellX);
+	XMStoreUInt4(&cellYLanes, cellY);
+	XMStoreInt4(&upperTriangleLanes.x, upperTriangle);
+
+	XMFLOAT4A weightCornerLanes;
+	XMFLOAT4A weight10Lanes;
+	XMFLOAT4A weight01Lanes;
+	XMStoreFloat4A(&weightCornerLanes, weightCorner);
+	XMStoreFloat4A(&weight10Lanes, weight10);
+	XMStoreFloat4A(&weight01Lanes, weight01);
+
+	const uint32_t* cellXPtr = &cellXLanes.x;
+	const uint32_t* cellYPtr = &cellYLanes.x;
+	const uint32_t* upperTrianglePtr = &upperTriangleLanes.x;
+	const float* weightCornerPtr = &weightCornerLanes.x;
+	const float* weight10Ptr = &weight10Lanes.x;
+	const float* weight01Ptr = &weight01Lanes.x;
+
+	for (size_t laneIndex = 0u; laneIndex < BATCH_SIZE; laneIndex++)
+	{
+		auto index00 = cellXPtr[laneIndex] + cellYPtr[laneIndex] * _samplesPerWidth;
+
+		auto& laneWeights = weights[laneIndex];
+		laneWeights.indexCorner = upperTrianglePtr[laneIndex] != 0u ? index00 + _samplesPerWidth + 1u : index00;
+		laneWeights.index10 = index00 + 1u;
+		laneWeights.index01 = index00 + _samplesPerWidth;
+		laneWeights.weightCorner = weightCornerPtr[laneIndex];
+		laneWeights.weight10 = weight10Ptr[laneIndex];
+		laneWeights.weight01 = weight01Ptr[laneIndex];
+	}
+}
+
+float Graphics::Assets::HeightFieldSampler::InterpolateHeight(const SampleWeights& weights) const noexcept
+{
+	auto height = XMVectorGetW(_normalHeightData[weights.indexCorner]) * weights.weightCorner;
+	height += XMVectorGetW(_normalHeightData[weights.index10]) * weights.weight10;
+	height += XMVectorGetW(_normalHeightData[weights.index01]) * weights.weight01;
+
+	return height + _minCorner.z;
+}
+
+float3 Graphics::Assets::HeightFieldSampler::InterpolateNormal(const SampleWeights& weights) const noexcept
+{
+	auto normalV = _normalHeightData[weights.indexCorner] * weights.weightCorner;
+	normalV = XMVectorMultiplyAdd(_normalHeightData[weights.index10], XMVectorReplicate(weights.weight10), normalV);
+	normalV = XMVectorMultiplyAdd(_normalHeightData[weights.index01], XMVectorReplicate(weights.weight01), normalV);
+
+	float3 normal;
+	XMStoreFloat3(&normal, XMVector3Normalize(normalV));
+
+	return normal;
+}
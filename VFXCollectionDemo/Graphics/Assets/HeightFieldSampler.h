@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../DirectX12Includes.h"
+
+namespace Graphics::Assets
+{
+	class HeightFieldSampler final
+	{
+	public:
+		HeightFieldSampler();
+		HeightFieldSampler(const floatN* normalHeightData, uint32_t samplesPerWidth, uint32_t samplesPerHeight,
+			const float3& minCorner, const float3& size);
+		~HeightFieldSampler();
+
+		void Reset(const floatN* normalHeightData, uint32_t samplesPerWidth, uint32_t samplesPerHeight,
+			const float3& minCorner, const float3& size);
+
+		float GetHeight(const float2& position) const noexcept;
+		float3 GetNormal(const float2& position) const noexcept;
+		void Sample(const float2& position, float& height, float3& normal) const noexcept;
+
+		void GetHeights(const float2* positions, size_t positionsNumber, float* heights) const noexcept;
+		void GetNormals(const float2* positions, size_t positionsNumber, float3* normals) const noexcept;
+		void Sample(const float2* positions, size_t positionsNumber, float* heights, float3* normals) const noexcept;
+
+		static constexpr size_t BATCH_SIZE = 4u;
+
+	private:
+		struct SampleWeights
+		{
+		public:
+			uint32_t indexCorner;
+			uint32_t index10;
+			uint32_t index01;
+
+			float weightCorner;
+			float weight10;
+			float weight01;
+		};
+
+		SampleWeights CalculateWeights(const float2& position) const noexcept;
+		void CalculateWeights(const float2* positions, SampleWeights* weights) const noexcept;
+
+		float InterpolateHeight(const SampleWeights& weights) const noexcept;
+		float3 InterpolateNormal(const SampleWeights& weights) const noexcept;
+
+		const floatN* _normalHeightData;
+
+		uint32_t _samplesPerWidth;
+		uint32_t _samplesPerHeight;
+
+		float3 _minCorner;
+		float2 _positionScale;
+		float2 _maxCoord;
+	};
+}
@@ -0,0 +1,179 @@
+#include "HeightMapResampler.h"
+#include "../../Common/TaskScheduler.h"
+
+using namespace DirectX;
+using namespace DirectX::PackedVector;
+
+bool Graphics::Assets::HeightMapResampler::Decode(const Resources::TextureDesc& textureDesc, std::vector<float>& heights)
+{
+	auto pixelsNumber = static_cast<size_t>(textureDesc.width) * textureDesc.height;
+	heights.resize(pixelsNumber);
+
+	if (textureDesc.format == DXGI_FORMAT_R8_UNORM && textureDesc.data.size() >= pixelsNumber)
+	{
+		auto sourcePtr = textureDesc.data.data();
+
+		for (size_t pixelIndex = 0u; pixelIndex < pixelsNumber; pixelIndex++)
+			heights[pixelIndex] = sourcePtr[pixelIndex] / 255.0f;
+
+		return true;
+	}
+
+	if (textureDesc.format == DXGI_FORMAT_R16_UNORM && textureDesc.data.size() >= pixelsNumber * sizeof(uint16_t))
+	{
+		auto sourcePtr = reinterpret_cast<const uint16_t*>(textureDesc.data.data());
+
+		for (size_t pixelIndex = 0u; pixelIndex < pixelsNumber; pixelIndex++)
+			heights[pixelIndex] = sourcePtr[pixelIndex] / 65535.0f;
+
+		return true;
+	}
+
+	if (textureDesc.format == DXGI_FORMAT_R16_FLOAT && textureDesc.data.size() >= pixelsNumber * sizeof(HALF))
+	{
+		XMConvertHalfToFloatStream(heights.data(), sizeof(float), reinterpret_cast<const HALF*>(textureDesc.data.data()),
+			sizeof(HALF), pixelsNumber);
+
+		return true;
+	}
+
+	if (textureDesc.format == DXGI_FORMAT_R32_FLOAT && textureDesc.data.size() >= pixelsNumber * sizeof(float))
+	{
+		std::memcpy(heights.data(), textureDesc.data.data(), pixelsNumber * sizeof(float));
+
+		return true;
+	}
+
+	heights.clear();
+
+	return false;
+}
+
+void Graphics::Assets::HeightMapResampler::Resample(const std::vector<float>& sourceHeights, uint32_t sourceWidth,
+	uint32_t sourceHeight, uint32_t targetWidth, uint32_t targetHeight, std::vector<float>& targetHeights)
+{
+	FilterTaps horizontalTaps{};
+	FilterTaps verticalTaps{};
+
+	BuildFilterTaps(sourceWidth, targetWidth, horizontalTaps);
+	BuildFilterTaps(sourceHeight, targetHeight, verticalTaps);
+
+	auto paddedSourceWidth = (sourceWidth + 3u) & ~3u;
+
+	std::vector<float> paddedHeights(static_cast<size_t>(paddedSourceWidth) * sourceHeight, 0.0f);
+
+	for (uint32_t rowIndex = 0u; rowIndex < sourceHeight; rowIndex++)
+		std::memcpy(paddedHeights.data() + static_cast<size_t>(rowIndex) * paddedSourceWidth,
+			sourceHeights.data() + static_cast<size_t>(rowIndex) * sourceWidth, sourceWidth * sizeof(float));
+
+	targetHeights.resize(static_cast<size_t>(targetWidth) * targetHeight);
+
+	Common::TaskScheduler::GetShared()->ParallelFor(0u, targetHeight, ROWS_PER_TASK,
+		[&](uint32_t startRow, uint32_t endRow)
+		{
+			std::vector<float> filteredRow(paddedSourceWidth);
+
+			for (uint32_t rowIndex = startRow; rowIndex < endRow; rowIndex++)
+			{
+				FilterColumns(paddedHeights, paddedSourceWidth, verticalTaps, rowIndex, filteredRow.data());
+
+				auto targetRow = targetHeights.data() + static_cast<size_t>(rowIndex) * targetWidth;
+
+				for (uint32_t columnIndex = 0u; columnIndex < targetWidth; columnIndex++)
+				{
+					auto tapsStart = horizontalTaps.offsets[columnIndex];
+					auto tapsEnd = horizontalTaps.offsets[columnIndex + 1u];
+
+					auto height = 0.0f;
+
+					for (auto tapIndex = tapsStart; tapIndex < tapsEnd; tapIndex++)
+					{
+						const auto& tap = horizontalTaps.taps[tapIndex];
+						height += filteredRow[tap.sourceIndex] * tap.weight;
+					}
+
+					targetRow[columnIndex] = height;
+				}
+			}
+		});
+}
+
+void Graphics::Assets::HeightMapResampler::BuildFilterTaps(uint32_t sourceSize, uint32_t targetSize,
+	FilterTaps& filterTaps)
+{
+	filterTaps.offsets.resize(static_cast<size_t>(targetSize) + 1u);
+	filterTaps.taps.clear();
+
+	auto scale = targetSize > 1u ? static_cast<float>(sourceSize - 1u) / (targetSize - 1u) : 0.0f;
+	auto maxSourceIndex = sourceSize - 1u;
+
+	for (uint32_t targetIndex = 0u; targetIndex < targetSize; targetIndex++)
+	{
+		filterTaps.offsets[targetIndex] = static_cast<uint32_t>(filterTaps.taps.size());
+
+		auto center = targetSize > 1u ? targetIndex * scale : maxSourceIndex * 0.5f;
+
+		if (scale <= 1.0f)
+		{
+			auto sourceIndex = std::min(static_cast<uint32_t>(center), maxSourceIndex);
+			auto fraction = sourceIndex < maxSourceIndex ? center - sourceIndex : 0.0f;
+
+			filterTaps.taps.push_back({ sourceIndex, 1.0f - fraction });
+
+			if (fraction > 0.0f)
+				filterTaps.taps.push_back({ sourceIndex + 1u, fraction });
+
+			continue;
+		}
+
+		auto footprintStart = std::max(center - scale * 0.5f, -0.5f);
+		auto footprintEnd = std::min(center + scale * 0.5f, maxSourceIndex + 0.5f);
+
+		auto firstIndex = static_cast<uint32_t>(std::max(std::floor(footprintStart + 0.5f), 0.0f));
+		auto lastIndex = std::min(static_cast<uint32_t>(std::floor(footprintEnd + 0.5f)), maxSourceIndex);
+
+		auto tapsStart = filterTaps.taps.size();
+		auto weightSum = 0.0f;
+
+		for (auto sourceIndex = firstIndex; sourceIndex <= lastIndex; sourceIndex++)
+		{
+			auto coverageStart = std::max(footprintStart, sourceIndex - 0.5f);
+			auto coverageEnd = std::min(footprintEnd, sourceIndex + 0.5f);
+			auto weight = coverageEnd - coverageStart;
+
+			if (weight <= 0.0f)
+				continue;
+
+			filterTaps.taps.push_back({ sourceIndex, weight });
+			weightSum += weight;
+		}
+
+		for (auto tapIndex = tapsStart; tapIndex < filterTaps.taps.size(); tapIndex++)
+			filterTaps.taps[tapIndex].weight /= weightSum;
+	}
+
+	filterTaps.offsets[targetSize] = static_cast<uint32_t>(filterTaps.taps.size());
+}
+
+void Graphics::Assets::HeightMapResampler::FilterColumns(const std::vector<float>& sourceHeights, uint32_t width,
+	const FilterTaps& filterTaps, uint32_t targetRowIndex, float* targetRow)
+{
+	auto tapsStart = filterTaps.offsets[targetRowIndex];
+	auto tapsEnd = filterTaps.offsets[targetRowIndex + 1u];
+
+	for (uint32_t columnIndex = 0u; columnIndex < width; columnIndex += 4u)
+	{
+		auto sum = XMVectorZero();
+
+		for (auto tapIndex = tapsStart; tapIndex < tapsEnd; tapIndex++)
+		{
+			const auto& tap = filterTaps.taps[tapIndex];
+			auto sourcePtr = sourceHeights.data() + static_cast<size_t>(tap.sourceIndex) * width + columnIndex;
+
+			sum = XMVectorMultiplyAdd(XMLoadFloat4(reinterpret_cast<const float4*>(sourcePtr)),
+				XMVectorReplicate(tap.weight), sum);
+		}
+
+		XMStoreFloat4(reinterpret_cast<float4*>(targetRow + columnIndex), sum);
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../DirectX12Includes.h"
+#include "../Resources/IResourceDesc.h"
+
+namespace Graphics::Assets
+{
+	class HeightMapResampler final
+	{
+	public:
+		static bool Decode(const Resources::TextureDesc& textureDesc, std::vector<float>& heights);
+
+		static void Resample(const std::vector<float>& sourceHeights, uint32_t sourceWidth, uint32_t sourceHeight,
+			uint32_t targetWidth, uint32_t targetHeight, std::vector<float>& targetHeights);
+
+	private:
+		HeightMapResampler() = delete;
+		~HeightMapResampler() = delete;
+		HeightMapResampler(const HeightMapResampler&) = delete;
+		HeightMapResampler(HeightMapResampler&&) = delete;
+		HeightMapResampler& operator=(const HeightMapResampler&) = delete;
+		HeightMapResampler& operator=(HeightMapResampler&&) = delete;
+
+		struct FilterTap
+		{
+		public:
+			uint32_t sourceIndex;
+			float weight;
+		};
+
+		struct FilterTaps
+		{
+		public:
+			std::vector<uint32_t> offsets;
+			std::vector<FilterTap> taps;
+		};
+
+		static void BuildFilterTaps(uint32_t sourceSize, uint32_t targetSize, FilterTaps& filterTaps);
+
+		static void FilterColumns(const std::vector<float>& sourceHeights, uint32_t width, const FilterTaps& filterTaps,
+			uint32_t targetRowIndex, float* targetRow);
+
+		static constexpr uint32_t ROWS_PER_TASK = 16u;
+	};
+}
@@ -149,6 +149,9 @@ void Graphics::Assets::Loaders::OBJLoader::Load(std::filesystem::path filePath,
 	}
 
 	meshDesc.topology = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+
+	GeometryUtilities::CalculateBounds(verticesData.data(), verticesNumber, stride, meshDesc.bounds,
+		meshDesc.boundingSphere);
 }
 
 Graphics::Assets::Loaders::OBJLoader::TokenType Graphics::Assets::Loaders::OBJLoader::GetToken(std::stringstream& objLineStream)
@@ -6,11 +6,20 @@ Graphics::Assets::Material::Material(ID3D12RootSignature* rootSignature, ID3D12P
 	const std::vector<DescriptorTableSlot>& textureSlots)
 	: _rootSignature(rootSignature), _pipelineState(pipelineState), _rootConstantIndices(rootConstantIndices),
 	_constantBufferSlots(constantBufferSlots), _bufferSlots(bufferSlots), _rwBufferSlots(rwBufferSlots),
-	_textureSlots(textureSlots)
+	_textureSlots(textureSlots), isBindless(false)
 {
 
 }
 
+Graphics::Assets::Material::Material(ID3D12RootSignature* bindlessRootSignature, ID3D12PipelineState* pipelineState,
+	const std::vector<DescriptorSlot>& constantBufferSlots, const std::vector<uint32_t>& bindlessIndices)
+	: _rootSignature(bindlessRootSignature), _pipelineState(pipelineState), _constantBufferSlots(constantBufferSlots),
+	isBindless(true), _bindlessIndices(bindlessIndices)
+{
+	_bindlessIndices.resize(BINDLESS_INDICES_NUMBER, 0u);
+	_rootSignature->AddRef();
+}
+
 Graphics::Assets::Material::~Material()
 {
 	_pipelineState->Release();
@@ -59,6 +68,12 @@ void Graphics::Assets::Material::UpdateTable(uint32_t registerIndex, DescriptorT
 		}
 }
 
+void Graphics::Assets::Material::UpdateBindlessIndex(uint32_t slotIndex, uint32_t descriptorIndex)
+{
+	if (slotIndex < _bindlessIndices.size())
+		_bindlessIndices[slotIndex] = descriptorIndex;
+}
+
 void Graphics::Assets::Material::SetRootConstant(ID3D12GraphicsCommandList* commandList, uint32_t cRegisterIndex,
 	const void* value)
 {
@@ -78,6 +93,10 @@ void Graphics::Assets::Material::Set(ID3D12GraphicsCommandList* commandList)
 	commandList->SetPipelineState(_pipelineState);
 	commandList->SetGraphicsRootSignature(_rootSignature);
 
+	if (isBindless)
+		commandList->SetGraphicsRoot32BitConstants(BINDLESS_INDICES_ROOT_PARAMETER_INDEX, BINDLESS_INDICES_NUMBER,
+			_bindlessIndices.data(), 0u);
+
 	for (auto& constantBufferSlot : _constantBufferSlots)
 		commandList->SetGraphicsRootConstantBufferView(constantBufferSlot.rootParameterIndex, constantBufferSlot.gpuAddress);
 
@@ -35,12 +35,15 @@ namespace Graphics::Assets
 			const std::map<uint32_t, uint32_t>& rootConstantIndices, const std::vector<DescriptorSlot>& constantBufferSlots,
 			const std::vector<DescriptorSlot>& bufferSlots, const std::vector<DescriptorSlot>& rwBufferSlots,
 			const std::vector<DescriptorTableSlot>& textureSlots);
+		Material(ID3D12RootSignature* bindlessRootSignature, ID3D12PipelineState* pipelineState,
+			const std::vector<DescriptorSlot>& constantBufferSlots, const std::vector<uint32_t>& bindlessIndices);
 		~Material();
 
 		void UpdateConstantBuffer(uint32_t cRegisterIndex, D3D12_GPU_VIRTUAL_ADDRESS newGPUAddress);
 		void UpdateBuffer(uint32_t tRegisterIndex, D3D12_GPU_VIRTUAL_ADDRESS newGPUAddress);
 		void UpdateRWBuffer(uint32_t uRegisterIndex, D3D12_GPU_VIRTUAL_ADDRESS newGPUAddress);
 		void UpdateTable(uint32_t registerIndex, DescriptorTableType tableType, D3D12_GPU_DESCRIPTOR_HANDLE newGPUDescriptorHandle);
+		void UpdateBindlessIndex(uint32_t slotIndex, uint32_t descriptorIndex);
 
 		void SetRootConstant(ID3D12GraphicsCommandList* commandList, uint32_t cRegisterIndex, const void* value);
 		void SetRootConstants(ID3D12GraphicsCommandList* commandList, uint32_t cRegisterIndex,
@@ -48,6 +51,11 @@ namespace Graphics::Assets
 
 		void Set(ID3D12GraphicsCommandList* commandList);
 
+		static constexpr uint32_t BINDLESS_INDICES_NUMBER = 16u;
+		static constexpr uint32_t BINDLESS_INDICES_REGISTER_SPACE = 1u;
+		static constexpr uint32_t BINDLESS_INDICES_ROOT_PARAMETER_INDEX = 0u;
+		static constexpr uint32_t BINDLESS_CONSTANT_BUFFERS_NUMBER = 4u;
+
 	private:
 		Material() = delete;
 
@@ -59,5 +67,8 @@ namespace Graphics::Assets
 		std::vector<DescriptorSlot> _bufferSlots;
 		std::vector<DescriptorSlot> _rwBufferSlots;
 		std::vector<DescriptorTableSlot> _textureSlots;
+
+		bool isBindless;
+		std::vector<uint32_t> _bindlessIndices;
 	};
 }
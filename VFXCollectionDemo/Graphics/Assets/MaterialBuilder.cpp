@@ -66,6 +66,22 @@ void Graphics::Assets::MaterialBuilder::SetSampler(uint32_t registerIndex,
 	SetDescriptorTableParameter(registerIndex, D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER, gpuDescriptor, visibility);
 }
 
+void Graphics::Assets::MaterialBuilder::SetBindlessIndex(uint32_t slotIndex, uint32_t descriptorIndex)
+{
+	if (slotIndex >= Material::BINDLESS_INDICES_NUMBER)
+	{
+#ifdef _DEBUG
+		OutputDebugStringA("MaterialBuilder::SetBindlessIndex: slot index is out of range\n");
+#endif
+		return;
+	}
+
+	if (slotIndex >= bindlessIndices.size())
+		bindlessIndices.resize(slotIndex + 1u, 0u);
+
+	bindlessIndices[slotIndex] = descriptorIndex;
+}
+
 void Graphics::Assets::MaterialBuilder::SetVertexShader(D3D12_SHADER_BYTECODE shaderBytecode)
 {
 	vertexShader = shaderBytecode;
@@ -111,12 +127,21 @@ void Graphics::Assets::MaterialBuilder::SetGeometryFormat(VertexFormat format, D
 	if ((format & VertexFormat::POSITION) == VertexFormat::POSITION)
 		inputElements.push_back({ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, appendParameter, classification, 0 });
 
+	if ((format & VertexFormat::POSITION_QUANTIZED) == VertexFormat::POSITION_QUANTIZED)
+		inputElements.push_back({ "POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, appendParameter, classification, 0 });
+
 	if ((format & VertexFormat::NORMAL) == VertexFormat::NORMAL)
 		inputElements.push_back({ "NORMAL", 0, DXGI_FORMAT_R16G16B16A16_FLOAT, 0, appendParameter, classification, 0 });
 
+	if ((format & VertexFormat::NORMAL_OCTAHEDRAL) == VertexFormat::NORMAL_OCTAHEDRAL)
+		inputElements.push_back({ "NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, appendParameter, classification, 0 });
+
 	if ((format & VertexFormat::TANGENT) == VertexFormat::TANGENT)
 		inputElements.push_back({ "TANGENT", 0, DXGI_FORMAT_R16G16B16A16_FLOAT, 0, appendParameter, classification, 0 });
 
+	if ((format & VertexFormat::TANGENT_OCTAHEDRAL) == VertexFormat::TANGENT_OCTAHEDRAL)
+		inputElements.push_back({ "TANGENT", 0, DXGI_FORMAT_R16G16_SNORM, 0, appendParameter, classification, 0 });
+
 	if ((format & VertexFormat::COLOR0) == VertexFormat::COLOR0)
 		inputElements.push_back({ "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, appendParameter, classification, 0 });
 
@@ -236,6 +261,39 @@ Graphics::Assets::Material* Graphics::Assets::MaterialBuilder::ComposeMeshletize
 	return newMaterial;
 }
 
+Graphics::Assets::Material* Graphics::Assets::MaterialBuilder::ComposeBindless(ID3D12Device* device,
+	ID3D12RootSignature* bindlessRootSignature)
+{
+#ifdef _DEBUG
+	if (!rootConstantIndices.empty() || !bufferSlots.empty() || !rwBufferSlots.empty() || !textureSlots.empty())
+		OutputDebugStringA("MaterialBuilder::ComposeBindless: root constants, root views and tables are ignored\n");
+#endif
+
+	std::vector<DescriptorSlot> bindlessConstantBufferSlots;
+
+	for (auto slot : constantBufferSlots)
+	{
+		if (slot.shaderRegisterIndex >= Material::BINDLESS_CONSTANT_BUFFERS_NUMBER)
+		{
+#ifdef _DEBUG
+			OutputDebugStringA("MaterialBuilder::ComposeBindless: constant buffer register is out of range\n");
+#endif
+			continue;
+		}
+
+		slot.rootParameterIndex = Material::BINDLESS_INDICES_ROOT_PARAMETER_INDEX + 1u + slot.shaderRegisterIndex;
+		bindlessConstantBufferSlots.push_back(slot);
+	}
+
+	auto pipelineState = CreateGraphicsPipelineState(device, bindlessRootSignature);
+
+	auto newMaterial = new Material(bindlessRootSignature, pipelineState, bindlessConstantBufferSlots, bindlessIndices);
+
+	Reset();
+
+	return newMaterial;
+}
+
 void Graphics::Assets::MaterialBuilder::Reset()
 {
 	vertexShader = {};
@@ -266,6 +324,7 @@ void Graphics::Assets::MaterialBuilder::Reset()
 	bufferSlots.clear();
 	rwBufferSlots.clear();
 	textureSlots.clear();
+	bindlessIndices.clear();
 
 	for (auto& parameter : rootParameters)
 		if (parameter.ParameterType == D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE)
@@ -276,6 +335,59 @@ void Graphics::Assets::MaterialBuilder::Reset()
 	inputElements.clear();
 }
 
+ID3D12RootSignature* Graphics::Assets::MaterialBuilder::CreateBindlessRootSignature(ID3D12Device* device)
+{
+	std::array<D3D12_ROOT_PARAMETER1, 1u + Material::BINDLESS_CONSTANT_BUFFERS_NUMBER> bindlessRootParameters{};
+
+	auto& indicesParameter = bindlessRootParameters[Material::BINDLESS_INDICES_ROOT_PARAMETER_INDEX];
+	indicesParameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+	indicesParameter.Constants.ShaderRegister = 0u;
+	indicesParameter.Constants.RegisterSpace = Material::BINDLESS_INDICES_REGISTER_SPACE;
+	indicesParameter.Constants.Num32BitValues = Material::BINDLESS_INDICES_NUMBER;
+	indicesParameter.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+	for (uint32_t registerIndex = 0u; registerIndex < Material::BINDLESS_CONSTANT_BUFFERS_NUMBER; registerIndex++)
+	{
+		auto& parameter = bindlessRootParameters[Material::BINDLESS_INDICES_ROOT_PARAMETER_INDEX + 1u + registerIndex];
+		parameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+		parameter.Descriptor.ShaderRegister = registerIndex;
+		parameter.Descriptor.RegisterSpace = 0u;
+		parameter.Descriptor.Flags = D3D12_ROOT_DESCRIPTOR_FLAG_DATA_VOLATILE;
+		parameter.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+	}
+
+	D3D12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc{};
+	rootSignatureDesc.Version = D3D_ROOT_SIGNATURE_VERSION_1_1;
+	rootSignatureDesc.Desc_1_1.NumParameters = static_cast<uint32_t>(bindlessRootParameters.size());
+	rootSignatureDesc.Desc_1_1.pParameters = bindlessRootParameters.data();
+	rootSignatureDesc.Desc_1_1.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT |
+		D3D12_ROOT_SIGNATURE_FLAG_CBV_SRV_UAV_HEAP_DIRECTLY_INDEXED |
+		D3D12_ROOT_SIGNATURE_FLAG_SAMPLER_HEAP_DIRECTLY_INDEXED;
+
+	ID3DBlob* signature = nullptr;
+	ID3DBlob* error = nullptr;
+
+	D3D12SerializeVersionedRootSignature(&rootSignatureDesc, &signature, &error);
+
+	if (error != nullptr)
+	{
+		OutputDebugStringA(reinterpret_cast<char*>(error->GetBufferPointer()));
+
+		error->Release();
+	}
+
+	if (signature == nullptr)
+		return nullptr;
+
+	ID3D12RootSignature* rootSignature = nullptr;
+
+	device->CreateRootSignature(0, signature->GetBufferPointer(), signature->GetBufferSize(), IID_PPV_ARGS(&rootSignature));
+
+	signature->Release();
+
+	return rootSignature;
+}
+
 void Graphics::Assets::MaterialBuilder::SetDescriptorParameter(uint32_t registerIndex,
 	D3D12_ROOT_PARAMETER_TYPE parameterType, D3D12_GPU_VIRTUAL_ADDRESS gpuAddress,
 	D3D12_SHADER_VISIBILITY visibility, std::vector<DescriptorSlot>& slots)
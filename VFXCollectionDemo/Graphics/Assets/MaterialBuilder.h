@@ -27,6 +27,7 @@ namespace Graphics::Assets
 			D3D12_SHADER_VISIBILITY visibility = D3D12_SHADER_VISIBILITY_ALL);
 		void SetSampler(uint32_t registerIndex, D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptor,
 			D3D12_SHADER_VISIBILITY visibility = D3D12_SHADER_VISIBILITY_ALL);
+		void SetBindlessIndex(uint32_t slotIndex, uint32_t descriptorIndex);
 
 		void SetVertexShader(D3D12_SHADER_BYTECODE shaderBytecode);
 		void SetHullShader(D3D12_SHADER_BYTECODE shaderBytecode);
@@ -48,9 +49,12 @@ namespace Graphics::Assets
 		
 		Material* ComposeStandard(ID3D12Device* device);
 		Material* ComposeMeshletized(ID3D12Device2* device);
+		Material* ComposeBindless(ID3D12Device* device, ID3D12RootSignature* bindlessRootSignature);
 
 		void Reset();
 
+		static ID3D12RootSignature* CreateBindlessRootSignature(ID3D12Device* device);
+
 	private:
 		MaterialBuilder(const MaterialBuilder&) = delete;
 		MaterialBuilder(MaterialBuilder&&) = delete;
@@ -164,6 +168,7 @@ namespace Graphics::Assets
 		std::vector<DescriptorSlot> bufferSlots;
 		std::vector<DescriptorSlot> rwBufferSlots;
 		std::vector<DescriptorTableSlot> textureSlots;
+		std::vector<uint32_t> bindlessIndices;
 		
 		std::vector<D3D12_ROOT_PARAMETER> rootParameters;
 
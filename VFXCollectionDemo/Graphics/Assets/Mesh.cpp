@@ -34,10 +34,9 @@ Graphics::Assets::Mesh::Mesh(std::filesystem::path filePath, ID3D12Device* devic
 	}
 
 	if (loadCache)
-	{
-		LoadCache(filePathCache, _meshDesc, vbDesc.data, ibDesc.data);
-	}
-	else
+		loadCache = LoadCache(filePathCache, _meshDesc, vbDesc.data, ibDesc.data);
+
+	if (!loadCache)
 	{
 		if (filePath.extension() == ".obj" || filePath.extension() == ".OBJ")
 			OBJLoader::Load(filePath, recalculateNormals, addTangents, _meshDesc, vbDesc.data, ibDesc.data);
@@ -91,6 +90,12 @@ void Graphics::Assets::Mesh::DrawOnly(ID3D12GraphicsCommandList* commandList, ui
 	commandList->DrawIndexedInstanced(_meshDesc.indicesNumber, instancesNumber, 0, 0, 0);
 }
 
+void Graphics::Assets::Mesh::DrawRange(ID3D12GraphicsCommandList* commandList, uint32_t indicesNumber,
+	uint32_t startIndex, int32_t baseVertex, uint32_t instancesNumber) const
+{
+	commandList->DrawIndexedInstanced(indicesNumber, instancesNumber, startIndex, baseVertex, 0);
+}
+
 const Graphics::Assets::MeshDesc& Graphics::Assets::Mesh::GetDesc() const
 {
 	return _meshDesc;
@@ -106,10 +111,17 @@ const D3D12_INDEX_BUFFER_VIEW& Graphics::Assets::Mesh::GetIndexBufferView() cons
 	return *indexBufferView;
 }
 
-void Graphics::Assets::Mesh::LoadCache(std::filesystem::path filePath, MeshDesc& meshDesc,
+bool Graphics::Assets::Mesh::LoadCache(std::filesystem::path filePath, MeshDesc& meshDesc,
 	std::vector<uint8_t>& verticesData, std::vector<uint8_t>& indicesData)
 {
 	std::ifstream meshFile(filePath, std::ios::binary);
+
+	MeshCacheHeader header{};
+	meshFile.read(reinterpret_cast<char*>(&header), sizeof(MeshCacheHeader));
+
+	if (!meshFile || header.magic != CACHE_MAGIC || header.version != CACHE_VERSION)
+		return false;
+
 	meshFile.read(reinterpret_cast<char*>(&meshDesc), sizeof(MeshDesc));
 
 	auto vertexBufferSize = static_cast<size_t>(meshDesc.verticesNumber) * VertexStride(meshDesc.vertexFormat);
@@ -120,12 +132,17 @@ void Graphics::Assets::Mesh::LoadCache(std::filesystem::path filePath, MeshDesc&
 	indexBufferSize *= meshDesc.indexFormat == IndexFormat::UINT16_INDEX ? 2u : 4u;
 	indicesData.resize(indexBufferSize);
 	meshFile.read(reinterpret_cast<char*>(indicesData.data()), indexBufferSize);
+
+	return static_cast<bool>(meshFile);
 }
 
 void Graphics::Assets::Mesh::SaveCache(std::filesystem::path filePath, const MeshDesc& meshDesc,
 	const std::vector<uint8_t>& verticesData, const std::vector<uint8_t>& indicesData)
 {
+	MeshCacheHeader header{ CACHE_MAGIC, CACHE_VERSION };
+
 	std::ofstream meshFile(filePath, std::ios::binary);
+	meshFile.write(reinterpret_cast<const char*>(&header), sizeof(MeshCacheHeader));
 	meshFile.write(reinterpret_cast<const char*>(&meshDesc), sizeof(MeshDesc));
 	meshFile.write(reinterpret_cast<const char*>(verticesData.data()), verticesData.size());
 	meshFile.write(reinterpret_cast<const char*>(indicesData.data()), indicesData.size());
@@ -22,15 +22,20 @@ namespace Graphics::Assets
 
 		void SetInputAssemblerOnly(ID3D12GraphicsCommandList* commandList) const;
 		void DrawOnly(ID3D12GraphicsCommandList* commandList, uint32_t instancesNumber = 1u) const;
+		void DrawRange(ID3D12GraphicsCommandList* commandList, uint32_t indicesNumber, uint32_t startIndex,
+			int32_t baseVertex, uint32_t instancesNumber = 1u) const;
 
 		const MeshDesc& GetDesc() const;
 		const D3D12_VERTEX_BUFFER_VIEW& GetVertexBufferView() const;
 		const D3D12_INDEX_BUFFER_VIEW& GetIndexBufferView() const;
 
+		static constexpr uint32_t CACHE_MAGIC = 0x4853454Du;
+		static constexpr uint32_t CACHE_VERSION = 1u;
+
 	private:
 		Mesh() = delete;
 
-		void LoadCache(std::filesystem::path filePath, MeshDesc& meshDesc, std::vector<uint8_t>& verticesData,
+		bool LoadCache(std::filesystem::path filePath, MeshDesc& meshDesc, std::vector<uint8_t>& verticesData,
 			std::vector<uint8_t>& indicesData);
 
 		void SaveCache(std::filesystem::path filePath, const MeshDesc& meshDesc, const std::vector<uint8_t>& verticesData,
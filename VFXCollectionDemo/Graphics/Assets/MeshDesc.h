@@ -11,6 +11,20 @@ namespace Graphics::Assets
 		UINT32_INDEX = 1U
 	};
 
+	struct AxisAlignedBox
+	{
+	public:
+		float3 minCorner;
+		float3 maxCorner;
+	};
+
+	struct BoundingSphere
+	{
+	public:
+		float3 center;
+		float radius;
+	};
+
 	struct MeshDesc
 	{
 	public:
@@ -19,5 +33,22 @@ namespace Graphics::Assets
 		D3D12_PRIMITIVE_TOPOLOGY topology;
 		uint32_t verticesNumber;
 		uint32_t indicesNumber;
+
+		AxisAlignedBox bounds;
+		BoundingSphere boundingSphere;
+	};
+
+	struct MeshCacheHeader
+	{
+	public:
+		uint32_t magic;
+		uint32_t version;
+	};
+
+	struct VertexQuantizationDesc
+	{
+	public:
+		float3 positionOffset;
+		float3 positionScale;
 	};
 }
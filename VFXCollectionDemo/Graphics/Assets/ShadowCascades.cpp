@@ -0,0 +1,116 @@
+#include "ShadowCascades.h"
+
+using namespace DirectX;
+
+void Graphics::Assets::ShadowCascades::CalculateSplits(float zNear, float zFar, float lambda, uint32_t cascadesNumber,
+	float* splits)
+{
+	auto ratio = zFar / zNear;
+	auto range = zFar - zNear;
+
+	for (uint32_t cascadeIndex = 0u; cascadeIndex < cascadesNumber; cascadeIndex++)
+	{
+		auto fraction = static_cast<float>(cascadeIndex + 1u) / static_cast<float>(cascadesNumber);
+
+		auto logSplit = zNear * std::pow(ratio, fraction);
+		auto uniformSplit = zNear + range * fraction;
+
+		splits[cascadeIndex] = std::lerp(uniformSplit, logSplit, lambda);
+	}
+
+	splits[cascadesNumber - 1u] = zFar;
+}
+
+float4x4 Graphics::Assets::ShadowCascades::BuildCascadeMatrix(const ShadowCascadesDesc& desc, float splitNear,
+	float splitFar)
+{
+	auto tanHalfFovY = std::tan(desc.fovY * 0.5f);
+	auto tanHalfFovX = tanHalfFovY * desc.aspectRatio;
+	auto invView = XMMatrixInverse(nullptr, desc.cameraView);
+
+	std::array<floatN, 8u> corners{};
+	auto center = XMVectorZero();
+
+	for (uint32_t cornerIndex = 0u; cornerIndex < corners.size(); cornerIndex++)
+	{
+		auto depth = (cornerIndex & 4u) != 0u ? splitFar : splitNear;
+		auto x = ((cornerIndex & 1u) != 0u ? 1.0f : -1.0f) * depth * tanHalfFovX;
+		auto y = ((cornerIndex & 2u) != 0u ? 1.0f : -1.0f) * depth * tanHalfFovY;
+
+		corners[cornerIndex] = XMVector3TransformCoord(XMVectorSet(x, y, -depth, 1.0f), invView);
+		center += corners[cornerIndex];
+	}
+
+	center /= static_cast<float>(corners.size());
+
+	float radius = 0.0f;
+
+	for (auto& corner : corners)
+		radius = std::max(radius, XMVectorGetX(XMVector3Length(corner - center)));
+
+	radius = std::ceil(radius * RADIUS_QUANTIZATION) / RADIUS_QUANTIZATION;
+
+	auto lightView = BuildLightView(desc.lightDirection);
+	auto lightCenter = XMVector3TransformCoord(center, lightView);
+
+	auto texelSize = 2.0f * radius / static_cast<float>(desc.shadowMapSize);
+	auto centerX = std::floor(XMVectorGetX(lightCenter) / texelSize) * texelSize;
+	auto centerY = std::floor(XMVectorGetY(lightCenter) / texelSize) * texelSize;
+
+	auto zNear = -XMVectorGetZ(lightCenter) - radius;
+	auto zFar = -XMVectorGetZ(lightCenter) + radius;
+
+	float minDepth = 0.0f;
+	float maxDepth = 0.0f;
+
+	GetDepthRange(lightView, desc.casterBounds, minDepth, maxDepth);
+	zNear = std::min(zNear, minDepth);
+
+	GetDepthRange(lightView, desc.receiverBounds, minDepth, maxDepth);
+	zFar = std::max(std::min(zFar, maxDepth), zNear + texelSize);
+
+	auto projection = XMMatrixOrthographicOffCenterRH(centerX - radius, centerX + radius, centerY - radius, centerY + radius,
+		zNear, zFar);
+
+	return lightView * projection;
+}
+
+void Graphics::Assets::ShadowCascades::Build(const ShadowCascadesDesc& desc, float4x4* viewProjections, float* splits)
+{
+	auto cascadesNumber = std::clamp(desc.cascadesNumber, 1u, MAX_CASCADES_NUMBER);
+
+	CalculateSplits(desc.zNear, desc.zFar, desc.splitLambda, cascadesNumber, splits);
+
+	for (uint32_t cascadeIndex = 0u; cascadeIndex < cascadesNumber; cascadeIndex++)
+	{
+		auto splitNear = cascadeIndex == 0u ? desc.zNear : splits[cascadeIndex - 1u];
+		viewProjections[cascadeIndex] = BuildCascadeMatrix(desc, splitNear, splits[cascadeIndex]);
+	}
+}
+
+float4x4 Graphics::Assets::ShadowCascades::BuildLightView(const float3& lightDirection)
+{
+	auto direction = XMVector3Normalize(XMLoadFloat3(&lightDirection));
+	auto up = std::abs(lightDirection.z) > 0.99f ? XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f) : XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+
+	return XMMatrixLookToRH(XMVectorZero(), direction, up);
+}
+
+void Graphics::Assets::ShadowCascades::GetDepthRange(const float4x4& lightView, const AxisAlignedBox& box,
+	float& minDepth, float& maxDepth)
+{
+	minDepth = std::numeric_limits<float>::max();
+	maxDepth = std::numeric_limits<float>::lowest();
+
+	for (uint32_t cornerIndex = 0u; cornerIndex < 8u; cornerIndex++)
+	{
+		auto corner = XMVectorSet((cornerIndex & 1u) != 0u ? box.maxCorner.x : box.minCorner.x,
+			(cornerIndex & 2u) != 0u ? box.maxCorner.y : box.minCorner.y,
+			(cornerIndex & 4u) != 0u ? box.maxCorner.z : box.minCorner.z, 1.0f);
+
+		auto depth = -XMVectorGetZ(XMVector3TransformCoord(corner, lightView));
+
+		minDepth = std::min(minDepth, depth);
+		maxDepth = std::max(maxDepth, depth);
+	}
+}
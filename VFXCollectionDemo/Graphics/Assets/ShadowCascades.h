@@ -0,0 +1,49 @@
+#pragma once
+
+#include "../DirectX12Includes.h"
+#include "MeshDesc.h"
+
+namespace Graphics::Assets
+{
+	struct ShadowCascadesDesc
+	{
+	public:
+		float4x4 cameraView;
+		float fovY;
+		float aspectRatio;
+		float zNear;
+		float zFar;
+		float splitLambda;
+
+		float3 lightDirection;
+		uint32_t cascadesNumber;
+		uint32_t shadowMapSize;
+
+		AxisAlignedBox casterBounds;
+		AxisAlignedBox receiverBounds;
+	};
+
+	class ShadowCascades final
+	{
+	public:
+		static void CalculateSplits(float zNear, float zFar, float lambda, uint32_t cascadesNumber, float* splits);
+		static float4x4 BuildCascadeMatrix(const ShadowCascadesDesc& desc, float splitNear, float splitFar);
+		static void Build(const ShadowCascadesDesc& desc, float4x4* viewProjections, float* splits);
+
+		static constexpr uint32_t MAX_CASCADES_NUMBER = 4u;
+		static constexpr float DEFAULT_SPLIT_LAMBDA = 0.75f;
+
+	private:
+		ShadowCascades() = delete;
+		~ShadowCascades() = delete;
+		ShadowCascades(const ShadowCascades&) = delete;
+		ShadowCascades(ShadowCascades&&) = delete;
+		ShadowCascades& operator=(const ShadowCascades&) = delete;
+		ShadowCascades& operator=(ShadowCascades&&) = delete;
+
+		static float4x4 BuildLightView(const float3& lightDirection);
+		static void GetDepthRange(const float4x4& lightView, const AxisAlignedBox& box, float& minDepth, float& maxDepth);
+
+		static constexpr float RADIUS_QUANTIZATION = 16.0f;
+	};
+}
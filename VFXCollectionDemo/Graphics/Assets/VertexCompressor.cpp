@@ -0,0 +1,236 @@
+#include "VertexCompressor.h"
+
+using namespace DirectX;
+using namespace DirectX::PackedVector;
+
+bool Graphics::Assets::VertexCompressor::Compress(const MeshDesc& sourceDesc, const std::vector<uint8_t>& sourceData,
+	MeshDesc& targetDesc, VertexQuantizationDesc& quantizationDesc, std::vector<uint8_t>& targetData,
+	VertexCompressionReport& report)
+{
+	report = {};
+
+	if ((sourceDesc.vertexFormat & VertexFormat::POSITION) != VertexFormat::POSITION || sourceDesc.verticesNumber == 0u)
+		return false;
+
+	auto hasNormal = (sourceDesc.vertexFormat & VertexFormat::NORMAL) == VertexFormat::NORMAL;
+	auto hasTangent = (sourceDesc.vertexFormat & VertexFormat::TANGENT) == VertexFormat::TANGENT;
+
+	auto sourceStride = static_cast<uint32_t>(sourceData.size() / sourceDesc.verticesNumber);
+	auto sourceHeadSize = 12u + (hasNormal ? 8u : 0u) + (hasTangent ? 8u : 0u);
+
+	if (sourceStride < sourceHeadSize)
+		return false;
+
+	auto tailSize = sourceStride - sourceHeadSize;
+	auto targetStride = 8u + (hasNormal ? 4u : 0u) + (hasTangent ? 4u : 0u) + tailSize;
+
+	auto boundsMin = XMVectorReplicate(std::numeric_limits<float>::max());
+	auto boundsMax = XMVectorReplicate(-std::numeric_limits<float>::max());
+
+	for (uint32_t vertexIndex = 0u; vertexIndex < sourceDesc.verticesNumber; vertexIndex++)
+	{
+		auto position = XMLoadFloat3(reinterpret_cast<const float3*>(sourceData.data() +
+			static_cast<size_t>(vertexIndex) * sourceStride));
+
+		boundsMin = XMVectorMin(boundsMin, position);
+		boundsMax = XMVectorMax(boundsMax, position);
+	}
+
+	XMStoreFloat3(&quantizationDesc.positionOffset, boundsMin);
+	XMStoreFloat3(&quantizationDesc.positionScale, boundsMax - boundsMin);
+
+	targetDesc = sourceDesc;
+	targetDesc.vertexFormat = GetCompressedFormat(sourceDesc.vertexFormat);
+
+	targetData.resize(static_cast<size_t>(sourceDesc.verticesNumber) * targetStride);
+
+	for (uint32_t vertexIndex = 0u; vertexIndex < sourceDesc.verticesNumber; vertexIndex++)
+	{
+		auto sourcePtr = sourceData.data() + static_cast<size_t>(vertexIndex) * sourceStride;
+		auto targetPtr = targetData.data() + static_cast<size_t>(vertexIndex) * targetStride;
+
+		auto position = *reinterpret_cast<const float3*>(sourcePtr);
+		auto quantizedPosition = QuantizePosition(position, quantizationDesc);
+		std::memcpy(targetPtr, &quantizedPosition, sizeof(uint64_t));
+
+		auto restoredPosition = DequantizePosition(quantizedPosition, quantizationDesc);
+		auto positionError = XMVector3Length(XMLoadFloat3(&restoredPosition) - XMLoadFloat3(&position));
+		report.maxPositionError = std::max(report.maxPositionError, XMVectorGetX(positionError));
+
+		sourcePtr += 12u;
+		targetPtr += 8u;
+
+		if (hasNormal)
+		{
+			auto normal = LoadHalf4(sourcePtr);
+			auto encodedNormal = EncodeOctahedral(normal);
+			std::memcpy(targetPtr, &encodedNormal, sizeof(uint32_t));
+
+			report.maxNormalAngleError = std::max(report.maxNormalAngleError,
+				AngleBetween(normal, DecodeOctahedral(encodedNormal)));
+
+			sourcePtr += 8u;
+			targetPtr += 4u;
+		}
+
+		if (hasTangent)
+		{
+			auto tangent = LoadHalf4(sourcePtr);
+			auto encodedTangent = EncodeOctahedral(tangent);
+			std::memcpy(targetPtr, &encodedTangent, sizeof(uint32_t));
+
+			report.maxTangentAngleError = std::max(report.maxTangentAngleError,
+				AngleBetween(tangent, DecodeOctahedral(encodedTangent)));
+
+			sourcePtr += 8u;
+			targetPtr += 4u;
+		}
+
+		std::memcpy(targetPtr, sourcePtr, tailSize);
+	}
+
+	report.sourceStride = sourceStride;
+	report.targetStride = targetStride;
+
+	return true;
+}
+
+Graphics::VertexFormat Graphics::Assets::VertexCompressor::GetCompressedFormat(VertexFormat format) noexcept
+{
+	auto result = format & ~(VertexFormat::POSITION | VertexFormat::NORMAL | VertexFormat::TANGENT);
+
+	if ((format & VertexFormat::POSITION) == VertexFormat::POSITION)
+		result |= VertexFormat::POSITION_QUANTIZED;
+
+	if ((format & VertexFormat::NORMAL) == VertexFormat::NORMAL)
+		result |= VertexFormat::NORMAL_OCTAHEDRAL;
+
+	if ((format & VertexFormat::TANGENT) == VertexFormat::TANGENT)
+		result |= VertexFormat::TANGENT_OCTAHEDRAL;
+
+	return result;
+}
+
+float4x4 Graphics::Assets::VertexCompressor::GetDequantizationMatrix(const VertexQuantizationDesc& quantizationDesc) noexcept
+{
+	auto scale = XMMatrixScaling(quantizationDesc.positionScale.x, quantizationDesc.positionScale.y,
+		quantizationDesc.positionScale.z);
+
+	auto translation = XMMatrixTranslation(quantizationDesc.positionOffset.x, quantizationDesc.positionOffset.y,
+		quantizationDesc.positionOffset.z);
+
+	return scale * translation;
+}
+
+uint64_t Graphics::Assets::VertexCompressor::QuantizePosition(const float3& position,
+	const VertexQuantizationDesc& quantizationDesc) noexcept
+{
+	auto quantize = [](float value, float offset, float scale)
+	{
+		if (scale < std::numeric_limits<float>::epsilon())
+			return 0ui64;
+
+		auto normalized = std::clamp((value - offset) / scale, 0.0f, 1.0f);
+
+		return static_cast<uint64_t>(std::lround(normalized * QUANTIZATION_MAX));
+	};
+
+	auto x = quantize(position.x, quantizationDesc.positionOffset.x, quantizationDesc.positionScale.x);
+	auto y = quantize(position.y, quantizationDesc.positionOffset.y, quantizationDesc.positionScale.y);
+	auto z = quantize(position.z, quantizationDesc.positionOffset.z, quantizationDesc.positionScale.z);
+
+	return x | (y << 16u) | (z << 32u);
+}
+
+float3 Graphics::Assets::VertexCompressor::DequantizePosition(uint64_t value,
+	const VertexQuantizationDesc& quantizationDesc) noexcept
+{
+	auto x = static_cast<float>(value & 0xFFFFui64) / QUANTIZATION_MAX;
+	auto y = static_cast<float>((value >> 16u) & 0xFFFFui64) / QUANTIZATION_MAX;
+	auto z = static_cast<float>((value >> 32u) & 0xFFFFui64) / QUANTIZATION_MAX;
+
+	return float3
+	(
+		quantizationDesc.positionOffset.x + x * quantizationDesc.positionScale.x,
+		quantizationDesc.positionOffset.y + y * quantizationDesc.positionScale.y,
+		quantizationDesc.positionOffset.z + z * quantizationDesc.positionScale.z
+	);
+}
+
+uint32_t Graphics::Assets::VertexCompressor::EncodeOctahedral(const float3& vector) noexcept
+{
+	auto signNotZero = [](float value)
+	{
+		return value >= 0.0f ? 1.0f : -1.0f;
+	};
+
+	auto absSum = std::abs(vector.x) + std::abs(vector.y) + std::abs(vector.z);
+
+	if (absSum < std::numeric_limits<float>::epsilon())
+		return 0u;
+
+	auto octX = vector.x / absSum;
+	auto octY = vector.y / absSum;
+
+	if (vector.z < 0.0f)
+	{
+		auto foldedX = (1.0f - std::abs(octY)) * signNotZero(octX);
+		auto foldedY = (1.0f - std::abs(octX)) * signNotZero(octY);
+
+		octX = foldedX;
+		octY = foldedY;
+	}
+
+	auto x = static_cast<int16_t>(std::lround(std::clamp(octX, -1.0f, 1.0f) * OCTAHEDRAL_MAX));
+	auto y = static_cast<int16_t>(std::lround(std::clamp(octY, -1.0f, 1.0f) * OCTAHEDRAL_MAX));
+
+	return static_cast<uint32_t>(static_cast<uint16_t>(x)) | (static_cast<uint32_t>(static_cast<uint16_t>(y)) << 16u);
+}
+
+float3 Graphics::Assets::VertexCompressor::DecodeOctahedral(uint32_t value) noexcept
+{
+	auto octX = std::max(static_cast<int16_t>(value & 0xFFFFu) / OCTAHEDRAL_MAX, -1.0f);
+	auto octY = std::max(static_cast<int16_t>(value >> 16u) / OCTAHEDRAL_MAX, -1.0f);
+
+	auto vector = XMVectorSet(octX, octY, 1.0f - std::abs(octX) - std::abs(octY), 0.0f);
+	auto fold = std::max(-XMVectorGetZ(vector), 0.0f);
+
+	vector = XMVectorSetX(vector, octX + (octX >= 0.0f ? -fold : fold));
+	vector = XMVectorSetY(vector, octY + (octY >= 0.0f ? -fold : fold));
+
+	float3 result;
+	XMStoreFloat3(&result, XMVector3Normalize(vector));
+
+	return result;
+}
+
+std::string Graphics::Assets::VertexCompressor::FormatReport(const VertexCompressionReport& report)
+{
+	std::stringstream reportStream;
+	reportStream << "VertexCompressor: stride " << report.sourceStride << " -> " << report.targetStride << " bytes";
+	reportStream << ", max position error " << report.maxPositionError;
+	reportStream << ", max normal error " << XMConvertToDegrees(report.maxNormalAngleError) << " deg";
+	reportStream << ", max tangent error " << XMConvertToDegrees(report.maxTangentAngleError) << " deg\n";
+
+	return reportStream.str();
+}
+
+float3 Graphics::Assets::VertexCompressor::LoadHalf4(const uint8_t* data) noexcept
+{
+	auto halfData = reinterpret_cast<const HALF*>(data);
+
+	auto vector = XMVectorSet(XMConvertHalfToFloat(halfData[0u]), XMConvertHalfToFloat(halfData[1u]),
+		XMConvertHalfToFloat(halfData[2u]), 0.0f);
+
+	float3 result;
+	XMStoreFloat3(&result, XMVector3Normalize(vector));
+
+	return result;
+}
+
+float Graphics::Assets::VertexCompressor::AngleBetween(const float3& vector0, const float3& vector1) noexcept
+{
+	auto angle = XMVector3AngleBetweenNormals(XMLoadFloat3(&vector0), XMLoadFloat3(&vector1));
+
+	return XMVectorGetX(angle);
+}
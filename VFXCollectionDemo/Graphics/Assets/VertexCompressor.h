@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../DirectX12Includes.h"
+#include "MeshDesc.h"
+
+namespace Graphics::Assets
+{
+	struct VertexCompressionReport
+	{
+	public:
+		float maxPositionError;
+		float maxNormalAngleError;
+		float maxTangentAngleError;
+
+		uint32_t sourceStride;
+		uint32_t targetStride;
+	};
+
+	class VertexCompressor final
+	{
+	public:
+		static bool Compress(const MeshDesc& sourceDesc, const std::vector<uint8_t>& sourceData,
+			MeshDesc& targetDesc, VertexQuantizationDesc& quantizationDesc, std::vector<uint8_t>& targetData,
+			VertexCompressionReport& report);
+
+		static VertexFormat GetCompressedFormat(VertexFormat format) noexcept;
+		static float4x4 GetDequantizationMatrix(const VertexQuantizationDesc& quantizationDesc) noexcept;
+
+		static uint64_t QuantizePosition(const float3& position, const VertexQuantizationDesc& quantizationDesc) noexcept;
+		static float3 DequantizePosition(uint64_t value, const VertexQuantizationDesc& quantizationDesc) noexcept;
+
+		static uint32_t EncodeOctahedral(const float3& vector) noexcept;
+		static float3 DecodeOctahedral(uint32_t value) noexcept;
+
+		static std::string FormatReport(const VertexCompressionReport& report);
+
+		static constexpr float QUANTIZATION_MAX = 65535.0f;
+		static constexpr float OCTAHEDRAL_MAX = 32767.0f;
+
+	private:
+		VertexCompressor() = delete;
+		~VertexCompressor() = delete;
+		VertexCompressor(const VertexCompressor&) = delete;
+		VertexCompressor(VertexCompressor&&) = delete;
+		VertexCompressor& operator=(const VertexCompressor&) = delete;
+		VertexCompressor& operator=(VertexCompressor&&) = delete;
+
+		static float3 LoadHalf4(const uint8_t* data) noexcept;
+		static float AngleBetween(const float3& vector0, const float3& vector1) noexcept;
+	};
+}
@@ -1,6 +1,7 @@
 #include "BufferManager.h"
 
-Graphics::BufferManager::BufferManager()
+Graphics::BufferManager::BufferManager(HeapManager* heapManager)
+	: _heapManager(heapManager)
 {
 
 }
@@ -28,48 +29,20 @@ Graphics::BufferAllocation Graphics::BufferManager::Allocate(ID3D12Device* devic
 
 	auto alignedSize = AlignValue(size, DEFAULT_BUFFER_ALIGNMENT);
 
-	if (type != BufferAllocationType::UPLOAD &&
-		type != BufferAllocationType::COMMON &&
-		type != BufferAllocationType::UNORDERED_ACCESS &&
-		type != BufferAllocationType::ACCELERATION_STRUCTURE &&
-		type != BufferAllocationType::UNORDERED_ACCESS_TEMP)
+	if (IsSuballocated(type))
 		for (auto& buffer : buffers)
 		{
-			if (buffer.type != type)
+			uint64_t offset = 0u;
+
+			if (buffer.type != type || !buffer.allocator.Allocate(alignedSize, offset))
 				continue;
 
-			auto alignedOffset = AlignValue(buffer.chunk.offset, DEFAULT_BUFFER_ALIGNMENT);
-
-			if ((alignedOffset + alignedSize) <= buffer.chunk.size)
-			{
-				allocation.resource = buffer.resource;
-
-				for (auto& chunk : buffer.freeSpace)
-					if (chunk.size <= alignedSize)
-					{
-						allocation.cpuAddress = buffer.cpuStartAddress + chunk.offset;
-						allocation.gpuAddress = buffer.gpuStartAddress + chunk.offset;
-						allocation.resourceOffset = chunk.offset;
-
-						if ((chunk.size - alignedSize) < DEFAULT_BUFFER_ALIGNMENT)
-						{
-							std::swap(chunk, buffer.freeSpace.back());
-							buffer.freeSpace.resize(buffer.freeSpace.size() - 1u);
-						}
-						else
-							chunk.size = AlignValue(chunk.size - alignedSize, DEFAULT_BUFFER_ALIGNMENT);
-
-						return allocation;
-					}
-
-				allocation.cpuAddress = buffer.cpuStartAddress + alignedOffset;
-				allocation.gpuAddress = buffer.gpuStartAddress + alignedOffset;
-				allocation.resourceOffset = alignedOffset;
-				
-				buffer.chunk.offset = alignedOffset + alignedSize;
-
-				return allocation;
-			}
+			allocation.resource = buffer.resource;
+			allocation.cpuAddress = buffer.cpuStartAddress != nullptr ? buffer.cpuStartAddress + offset : nullptr;
+			allocation.gpuAddress = buffer.gpuStartAddress + offset;
+			allocation.resourceOffset = offset;
+
+			return allocation;
 		}
 
 	D3D12_HEAP_PROPERTIES heapProperties{};
@@ -82,8 +55,7 @@ Graphics::BufferAllocation Graphics::BufferManager::Allocate(ID3D12Device* devic
 	heapProperties.CreationNodeMask = 1u;
 	heapProperties.VisibleNodeMask = 1u;
 
-	uint64_t resourceSize = (alignedSize < DEFAULT_BUFFER_SIZE &&
-		(type == BufferAllocationType::VERTEX_CONSTANT || type == BufferAllocationType::INDEX)) ?
+	uint64_t resourceSize = (alignedSize < DEFAULT_BUFFER_SIZE && IsSuballocated(type)) ?
 		DEFAULT_BUFFER_SIZE : alignedSize;
 
 	D3D12_RESOURCE_DESC resourceDesc{};
@@ -117,9 +89,11 @@ Graphics::BufferAllocation Graphics::BufferManager::Allocate(ID3D12Device* devic
 	else
 		state = D3D12_RESOURCE_STATE_COPY_DEST;
 	
-	ID3D12Resource* resource{};
-	auto hResult = device->CreateCommittedResource(&heapProperties, flags, &resourceDesc,
-		state, nullptr, IID_PPV_ARGS(&resource));
+	auto resource = _heapManager->CreateResource(device, heapProperties.Type, resourceDesc, state, nullptr);
+
+	if (resource == nullptr)
+		device->CreateCommittedResource(&heapProperties, flags, &resourceDesc,
+			state, nullptr, IID_PPV_ARGS(&resource));
 
 	allocation.resource = new Resources::GPUResource(resource, state);
 
@@ -134,10 +108,16 @@ Graphics::BufferAllocation Graphics::BufferManager::Allocate(ID3D12Device* devic
 	newBufferSpace.resource = allocation.resource;
 	newBufferSpace.cpuStartAddress = allocation.cpuAddress;
 	newBufferSpace.gpuStartAddress = allocation.gpuAddress;
-	newBufferSpace.chunk.offset = alignedSize;
-	newBufferSpace.chunk.size = resourceSize;
 	newBufferSpace.type = type;
 
+	if (IsSuballocated(type))
+	{
+		uint64_t offset = 0u;
+
+		newBufferSpace.allocator = TLSFAllocator(resourceSize, DEFAULT_BUFFER_ALIGNMENT);
+		newBufferSpace.allocator.Allocate(alignedSize, offset);
+	}
+
 	if (type == BufferAllocationType::UPLOAD ||
 		type == BufferAllocationType::UNORDERED_ACCESS_TEMP)
 		uploadBuffers.push_back(std::move(newBufferSpace));
@@ -150,45 +130,32 @@ Graphics::BufferAllocation Graphics::BufferManager::Allocate(ID3D12Device* devic
 void Graphics::BufferManager::Deallocate(Resources::GPUResource* allocatedResource,
 	D3D12_GPU_VIRTUAL_ADDRESS address, uint64_t size)
 {
-	for (auto& buffer : buffers)
-		if (buffer.resource == allocatedResource)
+	for (size_t bufferIndex = 0u; bufferIndex < buffers.size(); bufferIndex++)
+	{
+		auto& buffer = buffers[bufferIndex];
+
+		if (buffer.resource != allocatedResource)
+			continue;
+
+		if (!IsSuballocated(buffer.type))
 		{
-			auto alignedSize = AlignValue(size, DEFAULT_BUFFER_ALIGNMENT);
-			
-			if (buffer.chunk.size == alignedSize ||
-				buffer.type == BufferAllocationType::COMMON ||
-				buffer.type == BufferAllocationType::UNORDERED_ACCESS ||
-				buffer.type == BufferAllocationType::SHADER_TABLES ||
-				buffer.type == BufferAllocationType::ACCELERATION_STRUCTURE ||
-				buffer.type == BufferAllocationType::UNORDERED_ACCESS_TEMP)
-			{
-				if (buffer.type == BufferAllocationType::DYNAMIC_CONSTANT)
-					buffer.resource->Unmap();
-
-				delete buffer.resource;
-				buffer.resource = nullptr;
-
-				std::swap(buffer, buffers.back());
-				buffers.resize(buffers.size() - 1u);
-
-				return;
-			}
-
-			auto gpuAddress = buffer.gpuStartAddress + buffer.chunk.offset - alignedSize;
-
-			if (gpuAddress == address)
-				buffer.chunk.offset -= alignedSize;
-			else
-			{
-				BufferChunk freeChunk{};
-				freeChunk.offset = address - buffer.gpuStartAddress;
-				freeChunk.size = alignedSize;
-
-				buffer.freeSpace.push_back(std::move(freeChunk));
-			}
+			ReleaseBufferSpace(bufferIndex);
+			return;
+		}
 
+		if (!buffer.allocator.Deallocate(address - buffer.gpuStartAddress))
+		{
+#ifdef _DEBUG
+			OutputDebugStringA("BufferManager::Deallocate: address was not allocated from this buffer\n");
+#endif
 			return;
 		}
+
+		if (buffer.allocator.IsEmpty())
+			ReleaseBufferSpace(bufferIndex);
+
+		return;
+	}
 }
 
 void Graphics::BufferManager::ReleaseTempBuffers()
@@ -198,7 +165,7 @@ void Graphics::BufferManager::ReleaseTempBuffers()
 		if (buffer.type == BufferAllocationType::UPLOAD)
 			buffer.resource->Unmap();
 
-		delete buffer.resource;
+		ReleaseResource(buffer.resource);
 	}
 
 	uploadBuffers.clear();
@@ -208,3 +175,32 @@ constexpr uint64_t Graphics::BufferManager::AlignValue(uint64_t value, uint64_t
 {
 	return (value + alignment - 1u) & ~(alignment - 1u);
 }
+
+bool Graphics::BufferManager::IsSuballocated(BufferAllocationType type) const noexcept
+{
+	return type == BufferAllocationType::VERTEX_CONSTANT ||
+		type == BufferAllocationType::INDEX ||
+		type == BufferAllocationType::DYNAMIC_CONSTANT;
+}
+
+void Graphics::BufferManager::ReleaseBufferSpace(size_t bufferIndex)
+{
+	auto& buffer = buffers[bufferIndex];
+
+	if (buffer.type == BufferAllocationType::DYNAMIC_CONSTANT)
+		buffer.resource->Unmap();
+
+	ReleaseResource(buffer.resource);
+	buffer.resource = nullptr;
+
+	std::swap(buffer, buffers.back());
+	buffers.pop_back();
+}
+
+void Graphics::BufferManager::ReleaseResource(Resources::GPUResource* resource)
+{
+	auto placedResource = resource->GetResource();
+
+	delete resource;
+	_heapManager->Deallocate(placedResource);
+}
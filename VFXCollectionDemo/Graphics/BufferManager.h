@@ -2,6 +2,8 @@
 
 #include "DirectX12Includes.h"
 #include "Resources/GPUResource.h"
+#include "HeapManager.h"
+#include "TLSFAllocator.h"
 
 namespace Graphics
 {
@@ -31,7 +33,7 @@ namespace Graphics
 	class BufferManager
 	{
 	public:
-		BufferManager();
+		BufferManager(HeapManager* heapManager);
 		~BufferManager();
 
 		BufferAllocation Allocate(ID3D12Device* device, uint64_t size, BufferAllocationType type);
@@ -47,12 +49,8 @@ namespace Graphics
 		BufferManager& operator=(BufferManager&&) = delete;
 
 		constexpr uint64_t AlignValue(uint64_t value, uint64_t alignment);
-
-		struct BufferChunk
-		{
-			uint64_t offset;
-			uint64_t size;
-		};
+		bool IsSuballocated(BufferAllocationType type) const noexcept;
+		void ReleaseBufferSpace(size_t bufferIndex);
 
 		struct BufferSpace
 		{
@@ -60,14 +58,17 @@ namespace Graphics
 			Resources::GPUResource* resource;
 			uint8_t* cpuStartAddress;
 			D3D12_GPU_VIRTUAL_ADDRESS gpuStartAddress;
-			BufferChunk chunk;
 			BufferAllocationType type;
-			std::vector<BufferChunk> freeSpace;
+			TLSFAllocator allocator;
 		};
 
 		static constexpr uint64_t DEFAULT_BUFFER_SIZE = 2u * 1024u * 1024u;
 		static constexpr uint64_t DEFAULT_BUFFER_ALIGNMENT = 64u * 1024u;
 
+		void ReleaseResource(Resources::GPUResource* resource);
+
+		HeapManager* _heapManager;
+
 		std::vector<BufferSpace> buffers;
 		std::vector<BufferSpace> uploadBuffers;
 	};
@@ -0,0 +1,59 @@
+#include "CommandListPool.h"
+
+Graphics::CommandListPool::CommandListPool(CommandManager* commandManager, D3D12_COMMAND_LIST_TYPE type, uint32_t framesNumber)
+	: _commandManager(commandManager), _type(type), frameAllocators(framesNumber), currentFrameIndex(0u), usedNumber(0u)
+{
+
+}
+
+Graphics::CommandListPool::~CommandListPool()
+{
+
+}
+
+void Graphics::CommandListPool::BeginFrame(uint32_t frameIndex)
+{
+	currentFrameIndex = frameIndex;
+	usedNumber = 0u;
+}
+
+uint32_t Graphics::CommandListPool::Acquire(uint32_t listsNumber)
+{
+	auto firstIndex = usedNumber;
+	usedNumber += listsNumber;
+
+	while (commandLists.size() < usedNumber)
+	{
+		for (auto& allocators : frameAllocators)
+			allocators.push_back(_commandManager->CreateCommandAllocator(_type));
+
+		commandLists.push_back(_commandManager->CreateCommandList(frameAllocators[currentFrameIndex].back()));
+	}
+
+	return firstIndex;
+}
+
+ID3D12GraphicsCommandList* Graphics::CommandListPool::BeginRecord(uint32_t listIndex)
+{
+	return _commandManager->BeginRecord(commandLists[listIndex], frameAllocators[currentFrameIndex][listIndex]);
+}
+
+void Graphics::CommandListPool::EndRecord(uint32_t listIndex)
+{
+	_commandManager->EndRecord(commandLists[listIndex]);
+}
+
+Graphics::CommandListID Graphics::CommandListPool::GetCommandListID(uint32_t listIndex) const
+{
+	return commandLists[listIndex];
+}
+
+uint32_t Graphics::CommandListPool::GetUsedNumber() const noexcept
+{
+	return usedNumber;
+}
+
+uint32_t Graphics::CommandListPool::GetSize() const noexcept
+{
+	return static_cast<uint32_t>(commandLists.size());
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "DirectX12Includes.h"
+#include "CommandManager.h"
+
+namespace Graphics
+{
+	using CommandRecordFunction = std::function<void(ID3D12GraphicsCommandList* commandList)>;
+
+	class CommandListPool final
+	{
+	public:
+		CommandListPool(CommandManager* commandManager, D3D12_COMMAND_LIST_TYPE type, uint32_t framesNumber);
+		~CommandListPool();
+
+		void BeginFrame(uint32_t frameIndex);
+
+		uint32_t Acquire(uint32_t listsNumber);
+
+		ID3D12GraphicsCommandList* BeginRecord(uint32_t listIndex);
+		void EndRecord(uint32_t listIndex);
+
+		CommandListID GetCommandListID(uint32_t listIndex) const;
+
+		uint32_t GetUsedNumber() const noexcept;
+		uint32_t GetSize() const noexcept;
+
+	private:
+		CommandListPool() = delete;
+		CommandListPool(const CommandListPool&) = delete;
+		CommandListPool(CommandListPool&&) = delete;
+		CommandListPool& operator=(const CommandListPool&) = delete;
+		CommandListPool& operator=(CommandListPool&&) = delete;
+
+		CommandManager* _commandManager;
+		D3D12_COMMAND_LIST_TYPE _type;
+
+		std::vector<std::vector<CommandAllocatorID>> frameAllocators;
+		std::vector<CommandListID> commandLists;
+
+		uint32_t currentFrameIndex;
+		uint32_t usedNumber;
+	};
+}
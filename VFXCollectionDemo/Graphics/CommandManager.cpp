@@ -1,9 +1,9 @@
 #include "CommandManager.h"
 
 Graphics::CommandManager::CommandManager(ID3D12Device2* _device)
-	: device(_device), preparedCommandListsNumber(0u)
+	: device(_device)
 {
-	commandListsToSubmit.fill(nullptr);
+	commandListsToSubmit.reserve(RESERVED_COMMAND_LISTS_TO_SUBMIT);
 }
 
 Graphics::CommandManager::~CommandManager()
@@ -87,6 +87,11 @@ void Graphics::CommandManager::EndRecord(CommandListID commandListId)
 	d3dCommandList->Close();
 }
 
+ID3D12GraphicsCommandList* Graphics::CommandManager::GetCommandList(CommandListID commandListId)
+{
+	return commandLists[commandListId];
+}
+
 ID3D12CommandQueue* Graphics::CommandManager::GetQueue(CommandQueueID queueId)
 {
 	return commandQueues[queueId];
@@ -94,15 +99,13 @@ ID3D12CommandQueue* Graphics::CommandManager::GetQueue(CommandQueueID queueId)
 
 void Graphics::CommandManager::SubmitCommandList(CommandListID commandListId)
 {
-	commandListsToSubmit[preparedCommandListsNumber] = commandLists[commandListId];
-
-	preparedCommandListsNumber++;
+	commandListsToSubmit.push_back(commandLists[commandListId]);
 }
 
 void Graphics::CommandManager::ExecuteCommands(CommandQueueID queueId)
 {
 	auto& d3dQueue = commandQueues[queueId];
-	d3dQueue->ExecuteCommandLists(preparedCommandListsNumber, commandListsToSubmit.data());
+	d3dQueue->ExecuteCommandLists(static_cast<uint32_t>(commandListsToSubmit.size()), commandListsToSubmit.data());
 
-	preparedCommandListsNumber = 0u;
+	commandListsToSubmit.clear();
 }
@@ -21,12 +21,13 @@ namespace Graphics
 		ID3D12GraphicsCommandList* BeginRecord(CommandListID commandListId, CommandAllocatorID allocatorId);
 		void EndRecord(CommandListID commandList);
 
+		ID3D12GraphicsCommandList* GetCommandList(CommandListID commandListId);
 		ID3D12CommandQueue* GetQueue(CommandQueueID queueId);
 
 		void SubmitCommandList(CommandListID commandList);
 		void ExecuteCommands(CommandQueueID queueId);
 
-		static const size_t MAX_COMMAND_LISTS_TO_SUBMIT = 16;
+		static const size_t RESERVED_COMMAND_LISTS_TO_SUBMIT = 16;
 
 	private:
 		CommandManager() = delete;
@@ -43,8 +44,7 @@ namespace Graphics
 		std::vector<D3D12_COMMAND_LIST_TYPE> commandAllocatorsTypes;
 		std::vector<D3D12_COMMAND_LIST_TYPE> commandQueueTypes;
 
-		std::array<ID3D12CommandList*, MAX_COMMAND_LISTS_TO_SUBMIT> commandListsToSubmit;
-		uint32_t preparedCommandListsNumber;
+		std::vector<ID3D12CommandList*> commandListsToSubmit;
 
 		ID3D12Device2* device;
 	};
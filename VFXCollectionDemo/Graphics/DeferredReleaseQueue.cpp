@@ -0,0 +1,65 @@
+#include "DeferredReleaseQueue.h"
+
+Graphics::DeferredReleaseQueue::DeferredReleaseQueue(ID3D12Device* device)
+	: fence(nullptr), signaledFenceValue(0u)
+{
+	device->CreateFence(signaledFenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence));
+}
+
+Graphics::DeferredReleaseQueue::~DeferredReleaseQueue()
+{
+	ReleaseAll();
+
+	fence->Release();
+}
+
+void Graphics::DeferredReleaseQueue::Enqueue(std::function<void()> release)
+{
+	std::lock_guard<std::mutex> lock(releasesMutex);
+
+	releases.push({ signaledFenceValue + 1u, std::move(release) });
+}
+
+void Graphics::DeferredReleaseQueue::Signal(ID3D12CommandQueue* commandQueue)
+{
+	std::lock_guard<std::mutex> lock(releasesMutex);
+
+	signaledFenceValue++;
+	commandQueue->Signal(fence, signaledFenceValue);
+}
+
+void Graphics::DeferredReleaseQueue::Release()
+{
+	Release(fence->GetCompletedValue());
+}
+
+void Graphics::DeferredReleaseQueue::ReleaseAll()
+{
+	while (GetPendingNumber() > 0u)
+		Release(UINT64_MAX);
+}
+
+size_t Graphics::DeferredReleaseQueue::GetPendingNumber()
+{
+	std::lock_guard<std::mutex> lock(releasesMutex);
+
+	return releases.size();
+}
+
+void Graphics::DeferredReleaseQueue::Release(uint64_t completedFenceValue)
+{
+	std::vector<std::function<void()>> readyReleases;
+
+	{
+		std::lock_guard<std::mutex> lock(releasesMutex);
+
+		while (!releases.empty() && releases.front().fenceValue <= completedFenceValue)
+		{
+			readyReleases.push_back(std::move(releases.front().release));
+			releases.pop();
+		}
+	}
+
+	for (auto& release : readyReleases)
+		release();
+}
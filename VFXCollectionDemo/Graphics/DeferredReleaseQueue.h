@@ -0,0 +1,43 @@
+#pragma once
+
+#include "DirectX12Includes.h"
+
+namespace Graphics
+{
+	class DeferredReleaseQueue final
+	{
+	public:
+		DeferredReleaseQueue(ID3D12Device* device);
+		~DeferredReleaseQueue();
+
+		void Enqueue(std::function<void()> release);
+
+		void Signal(ID3D12CommandQueue* commandQueue);
+		void Release();
+		void ReleaseAll();
+
+		size_t GetPendingNumber();
+
+	private:
+		DeferredReleaseQueue() = delete;
+		DeferredReleaseQueue(const DeferredReleaseQueue&) = delete;
+		DeferredReleaseQueue(DeferredReleaseQueue&&) = delete;
+		DeferredReleaseQueue& operator=(const DeferredReleaseQueue&) = delete;
+		DeferredReleaseQueue& operator=(DeferredReleaseQueue&&) = delete;
+
+		void Release(uint64_t completedFenceValue);
+
+		struct DeferredRelease
+		{
+		public:
+			uint64_t fenceValue;
+			std::function<void()> release;
+		};
+
+		ID3D12Fence* fence;
+		uint64_t signaledFenceValue;
+
+		std::queue<DeferredRelease> releases;
+		std::mutex releasesMutex;
+	};
+}
@@ -1,92 +1,211 @@
 #include "DescriptorManager.h"
 
-Graphics::DescriptorManager::DescriptorManager(ID3D12Device* device)
+Graphics::DescriptorManager::DescriptorManager(ID3D12Device* device, uint32_t framesNumber)
+	: _device(device), _framesNumber(framesNumber)
 {
-	ID3D12DescriptorHeap* heap = nullptr;
+	CreateDescriptor(MAX_CBV_SRV_UAV_DESCRIPTORS_NUMBER, TRANSIENT_CBV_SRV_UAV_DESCRIPTORS_NUMBER, DescriptorType::CBV_SRV_UAV);
+	CreateDescriptor(MAX_SAMPLER_DESCRIPTORS_NUMBER, 0u, DescriptorType::SAMPLER);
+	CreateDescriptor(MAX_RTV_DESCRIPTORS_NUMBER, 0u, DescriptorType::RTV);
+	CreateDescriptor(MAX_DSV_DESCRIPTORS_NUMBER, 0u, DescriptorType::DSV);
+	CreateDescriptor(MAX_NON_SHADER_VISIBLE_DESCRIPTORS_NUMBER, 0u, DescriptorType::CBV_SRV_UAV_NON_SHADER_VISIBLE);
 
-	CreateDescriptor(device, MAX_CBV_SRV_UAV_DESCRIPTORS_NUMBER, DescriptorType::CBV_SRV_UAV);
-	CreateDescriptor(device, MAX_SAMPLER_DESCRIPTORS_NUMBER, DescriptorType::SAMPLER);
-	CreateDescriptor(device, MAX_RTV_DESCRIPTORS_NUMBER, DescriptorType::RTV);
-	CreateDescriptor(device, MAX_DSV_DESCRIPTORS_NUMBER, DescriptorType::DSV);
-	CreateDescriptor(device, MAX_NON_SHADER_VISIBLE_DESCRIPTORS_NUMBER, DescriptorType::CBV_SRV_UAV_NON_SHADER_VISIBLE);
+	BeginFrame(0u);
 }
 
 Graphics::DescriptorManager::~DescriptorManager()
 {
 	for (auto& descriptor : descriptors)
-		descriptor.second.heap->Release();
+		for (auto& heap : descriptor.heaps)
+			heap.heap->Release();
 }
 
-Graphics::DescriptorAllocation Graphics::DescriptorManager::Allocate(DescriptorType type)
+bool Graphics::DescriptorManager::Allocate(DescriptorType type, DescriptorAllocation& allocation)
 {
-	auto& descriptor = descriptors[type];
+	auto& descriptor = descriptors[static_cast<uint32_t>(type)];
 
-	SIZE_T cpuPtr{};
-	uint64_t gpuPtr{};
+	allocation = {};
 
-	if (descriptor.freeSpace.empty())
+	if (!descriptor.freeSpace.empty())
 	{
-		cpuPtr = descriptor.offset.base;
-		gpuPtr = descriptor.offset.gpuBase;
-
-		descriptor.offset.base += descriptor.incrementSize;
-		descriptor.offset.gpuBase += descriptor.incrementSize;
+		allocation = descriptor.freeSpace.back();
+		descriptor.freeSpace.pop_back();
 	}
 	else
 	{
-		auto& offset = descriptor.freeSpace.front();
+		if (descriptor.nextIndex == descriptor.capacity)
+		{
+			if (descriptor.isShaderVisible || !CreateHeap(type))
+			{
+#ifdef _DEBUG
+				OutputDebugStringA("DescriptorManager::Allocate: descriptor heap is full\n");
+#endif
+				descriptor.statistics.failedAllocationsNumber++;
+
+				return false;
+			}
+
+			descriptor.nextIndex = 0u;
+		}
 
-		cpuPtr = offset.base;
-		gpuPtr = offset.gpuBase;
+		auto& heap = descriptor.heaps.back();
+		auto offset = static_cast<uint64_t>(descriptor.nextIndex) * descriptor.incrementSize;
 
-		descriptor.freeSpace.pop();
+		allocation.cpuDescriptor.ptr = heap.cpuStart + static_cast<SIZE_T>(offset);
+
+		if (descriptor.isShaderVisible)
+			allocation.gpuDescriptor.ptr = heap.gpuStart + offset;
+
+		descriptor.nextIndex++;
 	}
 
-	DescriptorAllocation allocation{};
-	allocation.cpuDescriptor.ptr = cpuPtr;
-	allocation.gpuDescriptor.ptr = gpuPtr;
+	auto& statistics = descriptor.statistics;
+	statistics.allocatedNumber++;
+	statistics.peakAllocatedNumber = std::max(statistics.peakAllocatedNumber, statistics.allocatedNumber);
 
-	return allocation;
+	return true;
 }
 
 void Graphics::DescriptorManager::Deallocate(DescriptorType type, const DescriptorAllocation& allocation)
 {
-	if (allocation.cpuDescriptor.ptr == 0ull || allocation.gpuDescriptor.ptr == 0ull)
+	if (allocation.cpuDescriptor.ptr == 0ull)
 		return;
 
-	auto& descriptor = descriptors[type];
+	if (!IsAllocated(type, allocation))
+	{
+#ifdef _DEBUG
+		OutputDebugStringA("DescriptorManager::Deallocate: descriptor was not allocated from this heap\n");
+#endif
+		return;
+	}
+
+	auto& descriptor = descriptors[static_cast<uint32_t>(type)];
+
+	descriptor.freeSpace.push_back(allocation);
+	descriptor.statistics.allocatedNumber--;
+}
+
+bool Graphics::DescriptorManager::AllocateTransient(DescriptorType type, uint32_t number, DescriptorAllocation& allocation)
+{
+	auto& descriptor = descriptors[static_cast<uint32_t>(type)];
+
+	allocation = {};
+
+	if (descriptor.transientOffset + number > descriptor.transientEnd)
+	{
+#ifdef _DEBUG
+		OutputDebugStringA("DescriptorManager::AllocateTransient: frame descriptor range is full\n");
+#endif
+		descriptor.statistics.failedAllocationsNumber++;
+
+		return false;
+	}
+
+	auto& heap = descriptor.heaps.front();
+	auto offset = static_cast<uint64_t>(descriptor.transientOffset) * descriptor.incrementSize;
 
-	DescriptorOffset offset{};
-	offset.base = allocation.cpuDescriptor.ptr;
-	offset.gpuBase = allocation.gpuDescriptor.ptr;
+	allocation.cpuDescriptor.ptr = heap.cpuStart + static_cast<SIZE_T>(offset);
+	allocation.gpuDescriptor.ptr = heap.gpuStart + offset;
 
-	descriptor.freeSpace.push(std::move(offset));
+	descriptor.transientOffset += number;
+	descriptor.statistics.transientAllocatedNumber += number;
+
+	return true;
+}
+
+void Graphics::DescriptorManager::BeginFrame(uint32_t frameIndex)
+{
+	for (auto& descriptor : descriptors)
+	{
+		descriptor.transientOffset = descriptor.transientStart + descriptor.transientNumber * frameIndex;
+		descriptor.transientEnd = descriptor.transientOffset + descriptor.transientNumber;
+		descriptor.statistics.transientAllocatedNumber = 0u;
+	}
 }
 
 ID3D12DescriptorHeap* Graphics::DescriptorManager::GetHeap(DescriptorType type)
 {
-	return descriptors[type].heap;
+	return descriptors[static_cast<uint32_t>(type)].heaps.front().heap;
+}
+
+uint32_t Graphics::DescriptorManager::GetIncrementSize(DescriptorType type) const
+{
+	return descriptors[static_cast<uint32_t>(type)].incrementSize;
+}
+
+uint32_t Graphics::DescriptorManager::GetDescriptorIndex(DescriptorType type, const DescriptorAllocation& allocation) const
+{
+	auto& descriptor = descriptors[static_cast<uint32_t>(type)];
+
+	if (!descriptor.isShaderVisible || allocation.gpuDescriptor.ptr == 0ull)
+		return INVALID_DESCRIPTOR_INDEX;
+
+	auto& heap = descriptor.heaps.front();
+
+	if (allocation.gpuDescriptor.ptr < heap.gpuStart)
+		return INVALID_DESCRIPTOR_INDEX;
+
+	return static_cast<uint32_t>((allocation.gpuDescriptor.ptr - heap.gpuStart) / descriptor.incrementSize);
+}
+
+Graphics::DescriptorStatistics Graphics::DescriptorManager::GetStatistics(DescriptorType type) const
+{
+	return descriptors[static_cast<uint32_t>(type)].statistics;
+}
+
+void Graphics::DescriptorManager::CreateDescriptor(uint32_t number, uint32_t transientNumber, DescriptorType type)
+{
+	auto& descriptor = descriptors[static_cast<uint32_t>(type)];
+	descriptor.type = type;
+	descriptor.isShaderVisible = type == DescriptorType::CBV_SRV_UAV || type == DescriptorType::SAMPLER;
+	descriptor.incrementSize = _device->GetDescriptorHandleIncrementSize(ConvertType(type));
+	descriptor.capacity = number;
+	descriptor.transientStart = number;
+	descriptor.transientNumber = descriptor.isShaderVisible ? transientNumber : 0u;
+	descriptor.statistics.transientCapacity = descriptor.transientNumber;
+
+	CreateHeap(type);
 }
 
-void Graphics::DescriptorManager::CreateDescriptor(ID3D12Device* device, uint32_t number, DescriptorType type)
+bool Graphics::DescriptorManager::CreateHeap(DescriptorType type)
 {
+	auto& descriptor = descriptors[static_cast<uint32_t>(type)];
+
 	ID3D12DescriptorHeap* heap = nullptr;
 	D3D12_DESCRIPTOR_HEAP_DESC desc{};
 	desc.Type = ConvertType(type);
-	desc.NumDescriptors = number;
-	desc.Flags = (type == DescriptorType::CBV_SRV_UAV || type == DescriptorType::SAMPLER) ?
+	desc.NumDescriptors = descriptor.capacity + descriptor.transientNumber * _framesNumber;
+	desc.Flags = descriptor.isShaderVisible ?
 		D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE :
 		D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
 
-	device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&heap));
+	if (FAILED(_device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&heap))))
+		return false;
+
+	DescriptorHeap newHeap{};
+	newHeap.heap = heap;
+	newHeap.cpuStart = heap->GetCPUDescriptorHandleForHeapStart().ptr;
+
+	if (descriptor.isShaderVisible)
+		newHeap.gpuStart = heap->GetGPUDescriptorHandleForHeapStart().ptr;
+
+	descriptor.heaps.push_back(newHeap);
+
+	descriptor.statistics.heapsNumber++;
+	descriptor.statistics.capacity += descriptor.capacity;
+
+	return true;
+}
+
+bool Graphics::DescriptorManager::IsAllocated(DescriptorType type, const DescriptorAllocation& allocation) const
+{
+	auto& descriptor = descriptors[static_cast<uint32_t>(type)];
+	auto heapSize = static_cast<SIZE_T>(descriptor.capacity) * descriptor.incrementSize;
 
-	Descriptor descriptor{};
-	descriptor.heap = heap;
-	descriptor.offset.base = heap->GetCPUDescriptorHandleForHeapStart().ptr;
-	descriptor.offset.gpuBase = heap->GetGPUDescriptorHandleForHeapStart().ptr;
-	descriptor.incrementSize = device->GetDescriptorHandleIncrementSize(desc.Type);
+	for (auto& heap : descriptor.heaps)
+		if (allocation.cpuDescriptor.ptr >= heap.cpuStart && allocation.cpuDescriptor.ptr < heap.cpuStart + heapSize)
+			return (allocation.cpuDescriptor.ptr - heap.cpuStart) % descriptor.incrementSize == 0u;
 
-	descriptors.insert({ type , descriptor });
+	return false;
 }
 
 D3D12_DESCRIPTOR_HEAP_TYPE Graphics::DescriptorManager::ConvertType(DescriptorType type)
@@ -20,16 +20,37 @@ namespace Graphics
 		D3D12_GPU_DESCRIPTOR_HANDLE gpuDescriptor;
 	};
 
+	struct DescriptorStatistics
+	{
+	public:
+		uint32_t heapsNumber;
+		uint32_t capacity;
+		uint32_t allocatedNumber;
+		uint32_t peakAllocatedNumber;
+		uint32_t failedAllocationsNumber;
+		uint32_t transientCapacity;
+		uint32_t transientAllocatedNumber;
+	};
+
 	class DescriptorManager
 	{
 	public:
-		DescriptorManager(ID3D12Device* device);
+		DescriptorManager(ID3D12Device* device, uint32_t framesNumber);
 		~DescriptorManager();
 
-		DescriptorAllocation Allocate(DescriptorType type);
+		bool Allocate(DescriptorType type, DescriptorAllocation& allocation);
 		void Deallocate(DescriptorType type, const DescriptorAllocation& allocation);
 
+		bool AllocateTransient(DescriptorType type, uint32_t number, DescriptorAllocation& allocation);
+		void BeginFrame(uint32_t frameIndex);
+
 		ID3D12DescriptorHeap* GetHeap(DescriptorType type);
+		uint32_t GetIncrementSize(DescriptorType type) const;
+		uint32_t GetDescriptorIndex(DescriptorType type, const DescriptorAllocation& allocation) const;
+		DescriptorStatistics GetStatistics(DescriptorType type) const;
+
+		static const uint32_t DESCRIPTOR_TYPES_NUMBER = 5;
+		static const uint32_t INVALID_DESCRIPTOR_INDEX = UINT32_MAX;
 
 	private:
 		DescriptorManager() = delete;
@@ -38,43 +59,56 @@ namespace Graphics
 		DescriptorManager& operator=(const DescriptorManager&) = delete;
 		DescriptorManager& operator=(DescriptorManager&&) = delete;
 
-		void CreateDescriptor(ID3D12Device* device, uint32_t number, DescriptorType type);
+		void CreateDescriptor(uint32_t number, uint32_t transientNumber, DescriptorType type);
+		bool CreateHeap(DescriptorType type);
+		bool IsAllocated(DescriptorType type, const DescriptorAllocation& allocation) const;
 		D3D12_DESCRIPTOR_HEAP_TYPE ConvertType(DescriptorType type);
 
-		static const uint32_t MAX_CBV_SRV_UAV_DESCRIPTORS_NUMBER = 512;
+		static const uint32_t MAX_CBV_SRV_UAV_DESCRIPTORS_NUMBER = 4096;
 		static const uint32_t MAX_SAMPLER_DESCRIPTORS_NUMBER = 32;
 		static const uint32_t MAX_RTV_DESCRIPTORS_NUMBER = 64;
 		static const uint32_t MAX_DSV_DESCRIPTORS_NUMBER = 64;
 		static const uint32_t MAX_NON_SHADER_VISIBLE_DESCRIPTORS_NUMBER = 512;
+		static const uint32_t TRANSIENT_CBV_SRV_UAV_DESCRIPTORS_NUMBER = 256;
 
-		struct DescriptorOffset
+		struct DescriptorHeap
 		{
 		public:
-			DescriptorOffset()
-				: base{}, gpuBase{}
-			{
-
-			}
-
-			SIZE_T base;
-			uint64_t gpuBase;
+			ID3D12DescriptorHeap* heap;
+			SIZE_T cpuStart;
+			uint64_t gpuStart;
 		};
 
 		struct Descriptor
 		{
 		public:
 			Descriptor()
-				: heap{}, incrementSize{}
+				: type{}, isShaderVisible{}, incrementSize{}, capacity{}, nextIndex{}, transientStart{},
+				transientNumber{}, transientOffset{}, transientEnd{}, statistics{}
 			{
 
 			}
 
-			ID3D12DescriptorHeap* heap;
-			DescriptorOffset offset;
+			DescriptorType type;
+			bool isShaderVisible;
 			uint32_t incrementSize;
-			std::queue<DescriptorOffset> freeSpace;
+			uint32_t capacity;
+			uint32_t nextIndex;
+
+			uint32_t transientStart;
+			uint32_t transientNumber;
+			uint32_t transientOffset;
+			uint32_t transientEnd;
+
+			std::vector<DescriptorHeap> heaps;
+			std::vector<DescriptorAllocation> freeSpace;
+
+			DescriptorStatistics statistics;
 		};
 
-		std::map<DescriptorType, Descriptor> descriptors;
+		ID3D12Device* _device;
+		uint32_t _framesNumber;
+
+		std::array<Descriptor, DESCRIPTOR_TYPES_NUMBER> descriptors;
 	};
 }
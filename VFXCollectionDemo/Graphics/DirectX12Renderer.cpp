@@ -1,9 +1,14 @@
 #include "DirectX12Renderer.h"
 #include "DirectX12Utilities.h"
+#include "../Common/TaskScheduler.h"
+#include "Assets/MaterialBuilder.h"
 #include "../Common/Window.h"
 
 Graphics::DirectX12Renderer::DirectX12Renderer(const RECT& windowPlacement, HWND windowHandler, bool _isFullscreen)
-    : commandManager(nullptr), descriptorManager(nullptr), commandQueueId{},
+    : commandManager(nullptr), commandListPool(nullptr), commandListIndex(0u), descriptorManager(nullptr),
+    heapManager(nullptr), bufferManager(nullptr), textureManager(nullptr), frameAllocator(nullptr),
+    deferredReleaseQueue(nullptr), resourceManager(nullptr),
+    bindlessRootSignature(nullptr), commandQueueId{},
     isFullscreen(_isFullscreen), lastWindowRect{}, displaySize{}
 {
     currentWidth = windowPlacement.right - windowPlacement.left;
@@ -29,6 +34,8 @@ Graphics::DirectX12Renderer::~DirectX12Renderer()
 
     WaitForGPU(commandQueueId);
 
+    deferredReleaseQueue->ReleaseAll();
+
 #ifdef _DEBUG
     _debugDevice->Release();
     _debug->Release();
@@ -37,13 +44,20 @@ Graphics::DirectX12Renderer::~DirectX12Renderer()
     for (auto& buffer : backBuffers)
         buffer->Release();
 
+    if (bindlessRootSignature != nullptr)
+        bindlessRootSignature->Release();
+
     delete descriptorManager;
     delete resourceManager;
+    delete deferredReleaseQueue;
     delete textureManager;
+    delete frameAllocator;
     delete bufferManager;
+    delete heapManager;
 
     WaitForGPU(commandQueueId);
 
+    delete commandListPool;
     delete commandManager;
 
     fence->Release();
@@ -117,14 +131,11 @@ void Graphics::DirectX12Renderer::OnDeviceLost(HWND windowHandler)
 
 ID3D12GraphicsCommandList* Graphics::DirectX12Renderer::StartFrame()
 {
-    auto d3dCommandList = commandManager->BeginRecord(commandListId, commandAllocators[bufferIndex]);
+    commandListPool->BeginFrame(bufferIndex);
+    commandListIndex = commandListPool->Acquire(1u);
 
-    ID3D12DescriptorHeap* descriptorHeaps[] =
-    {
-        descriptorManager->GetHeap(DescriptorType::CBV_SRV_UAV),
-        descriptorManager->GetHeap(DescriptorType::SAMPLER)
-    };
-    d3dCommandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
+    auto d3dCommandList = commandListPool->BeginRecord(commandListIndex);
+    ResetDescriptorHeaps(d3dCommandList);
 
     return d3dCommandList;
 }
@@ -139,8 +150,8 @@ void Graphics::DirectX12Renderer::EndFrame(ID3D12GraphicsCommandList* commandLis
 
     commandList->ResourceBarrier(1u, &barrier);
 
-    commandManager->EndRecord(commandListId);
-    commandManager->SubmitCommandList(commandListId);
+    commandListPool->EndRecord(commandListIndex);
+    commandManager->SubmitCommandList(commandListPool->GetCommandListID(commandListIndex));
     commandManager->ExecuteCommands(commandQueueId);
 
     //swapChain->Present(0u, DXGI_PRESENT_ALLOW_TEARING);
@@ -149,6 +160,48 @@ void Graphics::DirectX12Renderer::EndFrame(ID3D12GraphicsCommandList* commandLis
     PrepareToNextFrame();
 }
 
+ID3D12GraphicsCommandList* Graphics::DirectX12Renderer::RecordParallel(ID3D12GraphicsCommandList* commandList,
+    const std::vector<CommandRecordFunction>& recordFunctions)
+{
+    if (recordFunctions.empty())
+        return commandList;
+
+    commandListPool->EndRecord(commandListIndex);
+    commandManager->SubmitCommandList(commandListPool->GetCommandListID(commandListIndex));
+
+    auto recordFunctionsNumber = static_cast<uint32_t>(recordFunctions.size());
+    auto firstListIndex = commandListPool->Acquire(recordFunctionsNumber);
+
+    Common::TaskScheduler::GetShared()->ParallelFor(0u, recordFunctionsNumber, 1u,
+        [&](uint32_t startIndex, uint32_t endIndex)
+        {
+            for (auto functionIndex = startIndex; functionIndex < endIndex; functionIndex++)
+            {
+                auto d3dCommandList = commandListPool->BeginRecord(firstListIndex + functionIndex);
+                ResetDescriptorHeaps(d3dCommandList);
+
+                recordFunctions[functionIndex](d3dCommandList);
+
+                commandListPool->EndRecord(firstListIndex + functionIndex);
+            }
+        });
+
+    for (uint32_t functionIndex = 0u; functionIndex < recordFunctionsNumber; functionIndex++)
+        commandManager->SubmitCommandList(commandListPool->GetCommandListID(firstListIndex + functionIndex));
+
+    commandListIndex = commandListPool->Acquire(1u);
+
+    auto d3dCommandList = commandListPool->BeginRecord(commandListIndex);
+    ResetDescriptorHeaps(d3dCommandList);
+
+    return d3dCommandList;
+}
+
+ID3D12GraphicsCommandList* Graphics::DirectX12Renderer::GetCommandList()
+{
+    return commandManager->GetCommandList(commandListPool->GetCommandListID(commandListIndex));
+}
+
 void Graphics::DirectX12Renderer::ResetDescriptorHeaps(ID3D12GraphicsCommandList* commandList)
 {
     ID3D12DescriptorHeap* descriptorHeaps[] =
@@ -202,11 +255,26 @@ Graphics::Resources::ResourceManager* Graphics::DirectX12Renderer::GetResourceMa
     return resourceManager;
 }
 
+Graphics::DeferredReleaseQueue* Graphics::DirectX12Renderer::GetDeferredReleaseQueue()
+{
+    return deferredReleaseQueue;
+}
+
 Graphics::BufferManager* Graphics::DirectX12Renderer::GetBufferManager()
 {
     return bufferManager;
 }
 
+Graphics::FrameAllocator* Graphics::DirectX12Renderer::GetFrameAllocator()
+{
+    return frameAllocator;
+}
+
+ID3D12RootSignature* Graphics::DirectX12Renderer::GetBindlessRootSignature()
+{
+    return bindlessRootSignature;
+}
+
 ID3D12GraphicsCommandList* Graphics::DirectX12Renderer::StartCreatingResources()
 {
     return commandManager->BeginRecord(resourceCommandListId, resourceCommandAllocators[bufferIndex]);
@@ -227,6 +295,8 @@ void Graphics::DirectX12Renderer::EndCreatingResources()
 void Graphics::DirectX12Renderer::FlushQueue()
 {
     WaitForGPU(commandQueueId);
+
+    deferredReleaseQueue->ReleaseAll();
 }
 
 void Graphics::DirectX12Renderer::FlushResourcesQueue()
@@ -255,15 +325,11 @@ void Graphics::DirectX12Renderer::CreateGPUResources(uint32_t width, uint32_t he
         bufferIndex = swapChain->GetCurrentBackBufferIndex();
 
         for (uint32_t backBufferId = 0u; backBufferId < BACK_BUFFER_NUMBER; backBufferId++)
-        {
-            commandAllocators[backBufferId] = commandManager->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT);
             resourceCommandAllocators[backBufferId] = commandManager->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT);
-        }
 
-        commandListId = commandManager->CreateCommandList(commandAllocators[bufferIndex]);
+        commandListPool = new CommandListPool(commandManager, D3D12_COMMAND_LIST_TYPE_DIRECT, BACK_BUFFER_NUMBER);
         resourceCommandListId = commandManager->CreateCommandList(resourceCommandAllocators[bufferIndex]);
         
-        commandManager->SubmitCommandList(commandListId);
         commandManager->SubmitCommandList(resourceCommandListId);
         commandManager->ExecuteCommands(commandQueueId);
     }
@@ -279,23 +345,37 @@ void Graphics::DirectX12Renderer::CreateGPUResources(uint32_t width, uint32_t he
 
     if (descriptorManager == nullptr)
     {
-        descriptorManager = new DescriptorManager(device);
+        descriptorManager = new DescriptorManager(device, BACK_BUFFER_NUMBER);
 
         for (uint32_t backBufferId = 0u; backBufferId < BACK_BUFFER_NUMBER; backBufferId++)
         {
-            auto allocation = descriptorManager->Allocate(DescriptorType::RTV);
+            DescriptorAllocation allocation{};
+            descriptorManager->Allocate(DescriptorType::RTV, allocation);
             backBufferCPUDescriptors[backBufferId] = allocation.cpuDescriptor;
         }
     }
 
+    if (heapManager == nullptr)
+        heapManager = new HeapManager();
+
     if (bufferManager == nullptr)
-        bufferManager = new BufferManager();
+        bufferManager = new BufferManager(heapManager);
 
     if (textureManager == nullptr)
-        textureManager = new TextureManager();
+        textureManager = new TextureManager(heapManager);
+
+    if (frameAllocator == nullptr)
+        frameAllocator = new FrameAllocator(device, bufferManager, FRAME_ALLOCATOR_SIZE, BACK_BUFFER_NUMBER);
+
+    if (deferredReleaseQueue == nullptr)
+        deferredReleaseQueue = new DeferredReleaseQueue(device);
 
     if (resourceManager == nullptr)
-        resourceManager = new Resources::ResourceManager(descriptorManager, bufferManager, textureManager);
+        resourceManager = new Resources::ResourceManager(descriptorManager, bufferManager, textureManager,
+            deferredReleaseQueue);
+
+    if (bindlessRootSignature == nullptr && IsBindlessSupported())
+        bindlessRootSignature = Assets::MaterialBuilder::CreateBindlessRootSignature(device);
 
     device->CreateFence(fenceValues[bufferIndex], D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence));
     fenceEvent = CreateEvent(nullptr, false, false, nullptr);
@@ -445,6 +525,22 @@ IDXGISwapChain3* Graphics::DirectX12Renderer::CreateSwapChain(uint32_t width, ui
     return newSwapChain;
 }
 
+bool Graphics::DirectX12Renderer::IsBindlessSupported() const
+{
+    D3D12_FEATURE_DATA_SHADER_MODEL shaderModel{ D3D_SHADER_MODEL_6_6 };
+
+    if (FAILED(device->CheckFeatureSupport(D3D12_FEATURE_SHADER_MODEL, &shaderModel, sizeof(shaderModel))) ||
+        shaderModel.HighestShaderModel < D3D_SHADER_MODEL_6_6)
+        return false;
+
+    D3D12_FEATURE_DATA_D3D12_OPTIONS options{};
+
+    if (FAILED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options))))
+        return false;
+
+    return options.ResourceBindingTier >= D3D12_RESOURCE_BINDING_TIER_3;
+}
+
 void Graphics::DirectX12Renderer::ResetSwapChain(uint32_t width, uint32_t height, HWND windowHandler)
 {
     WaitForGPU(commandQueueId);
@@ -480,6 +576,9 @@ void Graphics::DirectX12Renderer::ResetSwapChain(uint32_t width, uint32_t height
     bufferIndex = swapChain->GetCurrentBackBufferIndex();
 
     WaitForGPU(resourceCommandQueueId);
+
+    frameAllocator->BeginFrame(bufferIndex, fence->GetCompletedValue());
+    descriptorManager->BeginFrame(bufferIndex);
 }
 
 void Graphics::DirectX12Renderer::WaitForGPU(CommandQueueID _commandQueueId)
@@ -495,6 +594,8 @@ void Graphics::DirectX12Renderer::PrepareToNextFrame()
 
     auto commandQueue = commandManager->GetQueue(commandQueueId);
     commandQueue->Signal(fence, currentFenceValue);
+    frameAllocator->EndFrame(currentFenceValue);
+    deferredReleaseQueue->Signal(commandQueue);
 
     bufferIndex = swapChain->GetCurrentBackBufferIndex();
 
@@ -504,5 +605,9 @@ void Graphics::DirectX12Renderer::PrepareToNextFrame()
         WaitForSingleObjectEx(fenceEvent, INFINITE, FALSE);
     }
 
+    frameAllocator->BeginFrame(bufferIndex, fence->GetCompletedValue());
+    descriptorManager->BeginFrame(bufferIndex);
+    deferredReleaseQueue->Release();
+
     fenceValues[bufferIndex] = currentFenceValue + 1;
 }
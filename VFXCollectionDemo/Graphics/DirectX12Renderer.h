@@ -2,9 +2,13 @@
 
 #include "DirectX12Includes.h"
 #include "CommandManager.h"
+#include "CommandListPool.h"
 #include "DescriptorManager.h"
+#include "HeapManager.h"
 #include "BufferManager.h"
 #include "TextureManager.h"
+#include "FrameAllocator.h"
+#include "DeferredReleaseQueue.h"
 #include "Resources/ResourceManager.h"
 
 namespace Graphics
@@ -26,6 +30,10 @@ namespace Graphics
 		ID3D12GraphicsCommandList* StartFrame();
 		void EndFrame(ID3D12GraphicsCommandList* commandList);
 
+		ID3D12GraphicsCommandList* RecordParallel(ID3D12GraphicsCommandList* commandList,
+			const std::vector<CommandRecordFunction>& recordFunctions);
+		ID3D12GraphicsCommandList* GetCommandList();
+
 		void ResetDescriptorHeaps(ID3D12GraphicsCommandList* commandList);
 
 		void SetRenderToBackBuffer(ID3D12GraphicsCommandList* commandList);
@@ -40,6 +48,9 @@ namespace Graphics
 		CommandManager* GetCommandManager();
 		Resources::ResourceManager* GetResourceManager();
 		BufferManager* GetBufferManager();
+		FrameAllocator* GetFrameAllocator();
+		DeferredReleaseQueue* GetDeferredReleaseQueue();
+		ID3D12RootSignature* GetBindlessRootSignature();
 
 		ID3D12GraphicsCommandList* StartCreatingResources();
 		void EndCreatingResources();
@@ -48,6 +59,7 @@ namespace Graphics
 		void FlushResourcesQueue();
 
 		static const uint32_t BACK_BUFFER_NUMBER = 2u;
+		static const uint64_t FRAME_ALLOCATOR_SIZE = 1024u * 1024u;
 		static const DXGI_FORMAT BACK_BUFFER_FORMAT = DXGI_FORMAT_R10G10B10A2_UNORM;
 		static constexpr float BACK_BUFFER_COLOR[4] = { 1.0f, 0.5f, 0.75f, 1.0f };
 
@@ -66,6 +78,8 @@ namespace Graphics
 		IDXGISwapChain3* CreateSwapChain(uint32_t width, uint32_t height, HWND windowHandler,
 			IDXGIFactory4* factory, ID3D12CommandQueue* commandQueue);
 
+		bool IsBindlessSupported() const;
+
 		void ResetSwapChain(uint32_t width, uint32_t height, HWND windowHandler);
 
 		void WaitForGPU(CommandQueueID _commandQueueId);
@@ -82,8 +96,8 @@ namespace Graphics
 		HANDLE fenceEvent;
 		std::array<uint64_t, BACK_BUFFER_NUMBER> fenceValues;
 
-		CommandListID commandListId;
-		std::array<CommandAllocatorID, BACK_BUFFER_NUMBER> commandAllocators;
+		CommandListPool* commandListPool;
+		uint32_t commandListIndex;
 		CommandQueueID commandQueueId;
 
 		CommandListID resourceCommandListId;
@@ -92,10 +106,15 @@ namespace Graphics
 
 		CommandManager* commandManager;
 		DescriptorManager* descriptorManager;
+		HeapManager* heapManager;
 		BufferManager* bufferManager;
 		TextureManager* textureManager;
+		FrameAllocator* frameAllocator;
+		DeferredReleaseQueue* deferredReleaseQueue;
 		Resources::ResourceManager* resourceManager;
 
+		ID3D12RootSignature* bindlessRootSignature;
+
 		uint32_t currentWidth;
 		uint32_t currentHeight;
 		uint32_t bufferIndex;
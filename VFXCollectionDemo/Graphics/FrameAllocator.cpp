@@ -0,0 +1,94 @@
+#include "FrameAllocator.h"
+
+Graphics::FrameAllocator::FrameAllocator(ID3D12Device* device, BufferManager* bufferManager, uint64_t frameSize,
+	uint32_t framesNumber)
+	: _bufferManager(bufferManager), currentFrameIndex(0u), currentOffset(0u), isOverflowReported(false)
+{
+	_frameSize = AlignValue(frameSize, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+
+	buffer = _bufferManager->Allocate(device, _frameSize * framesNumber, BufferAllocationType::DYNAMIC_CONSTANT);
+
+	segments.resize(framesNumber);
+
+	for (uint32_t frameIndex = 0u; frameIndex < framesNumber; frameIndex++)
+	{
+		segments[frameIndex].startOffset = _frameSize * frameIndex;
+		segments[frameIndex].fenceValue = 0u;
+	}
+
+	currentFrameEnd = _frameSize;
+}
+
+Graphics::FrameAllocator::~FrameAllocator()
+{
+	_bufferManager->Deallocate(buffer.resource, buffer.gpuAddress, buffer.size);
+}
+
+bool Graphics::FrameAllocator::Allocate(uint64_t size, uint64_t alignment, FrameAllocation& allocation)
+{
+	auto alignedSize = AlignValue(size, alignment);
+	auto offset = currentOffset.load(std::memory_order_relaxed);
+	uint64_t alignedOffset = 0u;
+
+	do
+	{
+		alignedOffset = AlignValue(offset, alignment);
+
+		if (alignedOffset + alignedSize > currentFrameEnd)
+		{
+#ifdef _DEBUG
+			if (!isOverflowReported.exchange(true, std::memory_order_relaxed))
+				OutputDebugStringA("FrameAllocator::Allocate: frame budget exceeded\n");
+#endif
+
+			return false;
+		}
+	}
+	while (!currentOffset.compare_exchange_weak(offset, alignedOffset + alignedSize, std::memory_order_relaxed));
+
+	allocation.resource = buffer.resource->GetResource();
+	allocation.cpuAddress = buffer.cpuAddress + alignedOffset;
+	allocation.gpuAddress = buffer.gpuAddress + alignedOffset;
+	allocation.resourceOffset = buffer.resourceOffset + alignedOffset;
+	allocation.size = size;
+
+	return true;
+}
+
+void Graphics::FrameAllocator::EndFrame(uint64_t fenceValue)
+{
+	segments[currentFrameIndex].fenceValue = fenceValue;
+}
+
+bool Graphics::FrameAllocator::BeginFrame(uint32_t frameIndex, uint64_t completedFenceValue)
+{
+	auto& segment = segments[frameIndex];
+
+	currentFrameIndex = frameIndex;
+	currentFrameEnd = segment.startOffset + _frameSize;
+	isOverflowReported.store(false, std::memory_order_relaxed);
+
+	if (segment.fenceValue > completedFenceValue)
+	{
+#ifdef _DEBUG
+		OutputDebugStringA("FrameAllocator::BeginFrame: frame is still in flight, its space is not reclaimed\n");
+#endif
+		currentOffset.store(currentFrameEnd, std::memory_order_relaxed);
+
+		return false;
+	}
+
+	currentOffset.store(segment.startOffset, std::memory_order_relaxed);
+
+	return true;
+}
+
+uint64_t Graphics::FrameAllocator::GetFrameSize() const noexcept
+{
+	return _frameSize;
+}
+
+constexpr uint64_t Graphics::FrameAllocator::AlignValue(uint64_t value, uint64_t alignment) const noexcept
+{
+	return (value + alignment - 1u) & ~(alignment - 1u);
+}
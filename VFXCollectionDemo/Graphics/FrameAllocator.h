@@ -0,0 +1,70 @@
+#pragma once
+
+#include "DirectX12Includes.h"
+#include "BufferManager.h"
+
+namespace Graphics
+{
+	struct FrameAllocation
+	{
+	public:
+		ID3D12Resource* resource;
+		uint8_t* cpuAddress;
+		D3D12_GPU_VIRTUAL_ADDRESS gpuAddress;
+		uint64_t resourceOffset;
+		uint64_t size;
+	};
+
+	class FrameAllocator final
+	{
+	public:
+		FrameAllocator(ID3D12Device* device, BufferManager* bufferManager, uint64_t frameSize, uint32_t framesNumber);
+		~FrameAllocator();
+
+		bool Allocate(uint64_t size, uint64_t alignment, FrameAllocation& allocation);
+
+		template<typename T>
+		bool AllocateConstants(const T& data, FrameAllocation& allocation)
+		{
+			if (!Allocate(sizeof(T), D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT, allocation))
+				return false;
+
+			auto startAddress = reinterpret_cast<const uint8_t*>(&data);
+			std::copy(startAddress, startAddress + sizeof(T), allocation.cpuAddress);
+
+			return true;
+		}
+
+		void EndFrame(uint64_t fenceValue);
+		bool BeginFrame(uint32_t frameIndex, uint64_t completedFenceValue);
+
+		uint64_t GetFrameSize() const noexcept;
+
+	private:
+		FrameAllocator() = delete;
+		FrameAllocator(const FrameAllocator&) = delete;
+		FrameAllocator(FrameAllocator&&) = delete;
+		FrameAllocator& operator=(const FrameAllocator&) = delete;
+		FrameAllocator& operator=(FrameAllocator&&) = delete;
+
+		constexpr uint64_t AlignValue(uint64_t value, uint64_t alignment) const noexcept;
+
+		struct FrameSegment
+		{
+		public:
+			uint64_t startOffset;
+			uint64_t fenceValue;
+		};
+
+		BufferManager* _bufferManager;
+		BufferAllocation buffer;
+
+		uint64_t _frameSize;
+		uint32_t currentFrameIndex;
+		uint64_t currentFrameEnd;
+		std::atomic<uint64_t> currentOffset;
+		std::atomic<bool> isOverflowReported;
+
+		std::vector<FrameSegment> segments;
+	};
+}
@@ -0,0 +1,321 @@
+#include "HeapManager.h"
+
+Graphics::HeapManager::HeapManager()
+{
+
+}
+
+Graphics::HeapManager::~HeapManager()
+{
+	for (auto& pool : pools)
+		for (auto& heap : pool.heaps)
+			heap.heap->Release();
+
+	for (auto& group : aliasingGroups)
+		group.second.heap->Release();
+}
+
+ID3D12Resource* Graphics::HeapManager::CreateResource(ID3D12Device* device, D3D12_HEAP_TYPE heapType,
+	D3D12_RESOURCE_DESC resourceDesc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* clearValue,
+	uint32_t aliasingGroup)
+{
+	auto category = GetCategory(resourceDesc);
+
+	if (category == HeapCategory::BUFFERS)
+		resourceDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+	else if (category == HeapCategory::TEXTURES && resourceDesc.SampleDesc.Count <= 1u)
+		resourceDesc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+	else
+		resourceDesc.Alignment = 0u;
+
+	auto allocationInfo = device->GetResourceAllocationInfo(0u, 1u, &resourceDesc);
+
+	if (resourceDesc.Alignment == D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT &&
+		allocationInfo.Alignment != D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT)
+	{
+		resourceDesc.Alignment = 0u;
+		allocationInfo = device->GetResourceAllocationInfo(0u, 1u, &resourceDesc);
+	}
+
+	if (allocationInfo.SizeInBytes == UINT64_MAX)
+	{
+#ifdef _DEBUG
+		OutputDebugStringA("HeapManager::CreateResource: invalid resource description\n");
+#endif
+		return nullptr;
+	}
+
+	if (aliasingGroup != 0u && heapType == D3D12_HEAP_TYPE_DEFAULT && category != HeapCategory::BUFFERS)
+	{
+		auto resource = CreateAliasedResource(device, resourceDesc, allocationInfo, initialState, clearValue,
+			category, aliasingGroup);
+
+		if (resource != nullptr)
+			return resource;
+	}
+
+	auto poolIndex = GetPoolIndex(heapType, category, allocationInfo.Alignment);
+	auto& pool = pools[poolIndex];
+
+	uint64_t offset = 0u;
+	Heap* targetHeap = nullptr;
+
+	for (auto& heap : pool.heaps)
+		if (heap.allocator.Allocate(allocationInfo.SizeInBytes, offset))
+		{
+			targetHeap = &heap;
+			break;
+		}
+
+	if (targetHeap == nullptr)
+	{
+		auto heapSize = std::max(HEAP_SIZE, AlignValue(allocationInfo.SizeInBytes, pool.alignment));
+
+		Heap newHeap{};
+		newHeap.heap = CreateHeap(device, heapType, category, heapSize, pool.alignment);
+
+		if (newHeap.heap == nullptr)
+			return nullptr;
+
+		newHeap.allocator = TLSFAllocator(heapSize, pool.alignment);
+		newHeap.allocator.Allocate(allocationInfo.SizeInBytes, offset);
+
+		pool.heaps.push_back(std::move(newHeap));
+		targetHeap = &pool.heaps.back();
+	}
+
+	ID3D12Resource* resource = nullptr;
+
+	if (FAILED(device->CreatePlacedResource(targetHeap->heap, offset, &resourceDesc, initialState, clearValue,
+		IID_PPV_ARGS(&resource))))
+	{
+#ifdef _DEBUG
+		OutputDebugStringA("HeapManager::CreateResource: failed to create placed resource\n");
+#endif
+		targetHeap->allocator.Deallocate(offset);
+
+		return nullptr;
+	}
+
+	PlacedAllocation allocation{};
+	allocation.poolIndex = poolIndex;
+	allocation.heap = targetHeap->heap;
+	allocation.offset = offset;
+	allocation.aliasingGroup = 0u;
+
+	allocations.insert({ resource, allocation });
+
+	return resource;
+}
+
+void Graphics::HeapManager::Deallocate(ID3D12Resource* resource)
+{
+	auto allocationIterator = allocations.find(resource);
+
+	if (allocationIterator == allocations.end())
+		return;
+
+	auto allocation = allocationIterator->second;
+	allocations.erase(allocationIterator);
+
+	if (allocation.aliasingGroup != 0u)
+	{
+		auto groupIterator = aliasingGroups.find(allocation.aliasingGroup);
+
+		if (groupIterator == aliasingGroups.end())
+			return;
+
+		auto& group = groupIterator->second;
+		group.resourcesNumber--;
+
+		if (group.resourcesNumber == 0u)
+		{
+			group.heap->Release();
+			aliasingGroups.erase(groupIterator);
+		}
+
+		return;
+	}
+
+	auto& pool = pools[allocation.poolIndex];
+
+	for (size_t heapIndex = 0u; heapIndex < pool.heaps.size(); heapIndex++)
+	{
+		auto& heap = pool.heaps[heapIndex];
+
+		if (heap.heap != allocation.heap)
+			continue;
+
+		if (!heap.allocator.Deallocate(allocation.offset))
+		{
+#ifdef _DEBUG
+			OutputDebugStringA("HeapManager::Deallocate: offset was not allocated from this heap\n");
+#endif
+			return;
+		}
+
+		if (heap.allocator.IsEmpty() && (pool.heaps.size() > 1u || heap.allocator.GetCapacity() > HEAP_SIZE))
+		{
+			heap.heap->Release();
+
+			std::swap(heap, pool.heaps.back());
+			pool.heaps.pop_back();
+		}
+
+		return;
+	}
+}
+
+Graphics::HeapStatistics Graphics::HeapManager::GetStatistics() const
+{
+	HeapStatistics statistics{};
+	statistics.placedResourcesNumber = static_cast<uint32_t>(allocations.size());
+
+	for (auto& pool : pools)
+		for (auto& heap : pool.heaps)
+		{
+			auto heapStatistics = heap.allocator.GetStatistics();
+
+			statistics.heapsNumber++;
+			statistics.reservedSize += heapStatistics.capacity;
+			statistics.usedSize += heapStatistics.usedSize;
+		}
+
+	for (auto& group : aliasingGroups)
+	{
+		statistics.heapsNumber++;
+		statistics.aliasedResourcesNumber += group.second.resourcesNumber;
+		statistics.reservedSize += group.second.size;
+		statistics.usedSize += group.second.size;
+	}
+
+	return statistics;
+}
+
+constexpr uint64_t Graphics::HeapManager::AlignValue(uint64_t value, uint64_t alignment) const noexcept
+{
+	return (value + alignment - 1u) & ~(alignment - 1u);
+}
+
+Graphics::HeapCategory Graphics::HeapManager::GetCategory(const D3D12_RESOURCE_DESC& resourceDesc) const noexcept
+{
+	if (resourceDesc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+		return HeapCategory::BUFFERS;
+
+	if ((resourceDesc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) != 0)
+		return HeapCategory::RENDER_TARGETS;
+
+	return HeapCategory::TEXTURES;
+}
+
+uint32_t Graphics::HeapManager::GetPoolIndex(D3D12_HEAP_TYPE heapType, HeapCategory category, uint64_t alignment)
+{
+	for (uint32_t poolIndex = 0u; poolIndex < static_cast<uint32_t>(pools.size()); poolIndex++)
+	{
+		auto& pool = pools[poolIndex];
+
+		if (pool.type == heapType && pool.category == category && pool.alignment == alignment)
+			return poolIndex;
+	}
+
+	HeapPool newPool{};
+	newPool.type = heapType;
+	newPool.category = category;
+	newPool.alignment = alignment;
+
+	pools.push_back(std::move(newPool));
+
+	return static_cast<uint32_t>(pools.size() - 1u);
+}
+
+ID3D12Heap* Graphics::HeapManager::CreateHeap(ID3D12Device* device, D3D12_HEAP_TYPE heapType, HeapCategory category,
+	uint64_t size, uint64_t alignment) const
+{
+	D3D12_HEAP_DESC heapDesc{};
+	heapDesc.Alignment = std::max(alignment, static_cast<uint64_t>(D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT));
+	heapDesc.SizeInBytes = AlignValue(size, heapDesc.Alignment);
+	heapDesc.Properties.Type = heapType;
+	heapDesc.Properties.CreationNodeMask = 1u;
+	heapDesc.Properties.VisibleNodeMask = 1u;
+
+	if (category == HeapCategory::BUFFERS)
+		heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+	else if (category == HeapCategory::RENDER_TARGETS)
+		heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+	else
+		heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+
+	ID3D12Heap* heap = nullptr;
+
+	if (FAILED(device->CreateHeap(&heapDesc, IID_PPV_ARGS(&heap))))
+	{
+#ifdef _DEBUG
+		OutputDebugStringA("HeapManager::CreateHeap: failed to create heap\n");
+#endif
+		return nullptr;
+	}
+
+	return heap;
+}
+
+ID3D12Resource* Graphics::HeapManager::CreateAliasedResource(ID3D12Device* device, const D3D12_RESOURCE_DESC& resourceDesc,
+	const D3D12_RESOURCE_ALLOCATION_INFO& allocationInfo, D3D12_RESOURCE_STATES initialState,
+	const D3D12_CLEAR_VALUE* clearValue, HeapCategory category, uint32_t aliasingGroup)
+{
+	auto groupIterator = aliasingGroups.find(aliasingGroup);
+
+	if (groupIterator == aliasingGroups.end())
+	{
+		AliasingGroup newGroup{};
+		newGroup.category = category;
+		newGroup.alignment = std::max(allocationInfo.Alignment,
+			static_cast<uint64_t>(D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT));
+		newGroup.size = AlignValue(allocationInfo.SizeInBytes, newGroup.alignment);
+		newGroup.heap = CreateHeap(device, D3D12_HEAP_TYPE_DEFAULT, category, newGroup.size, newGroup.alignment);
+
+		if (newGroup.heap == nullptr)
+			return nullptr;
+
+		groupIterator = aliasingGroups.insert({ aliasingGroup, newGroup }).first;
+	}
+
+	auto& group = groupIterator->second;
+
+	if (group.category != category || group.size < allocationInfo.SizeInBytes || group.alignment < allocationInfo.Alignment)
+	{
+#ifdef _DEBUG
+		OutputDebugStringA("HeapManager::CreateResource: resource does not fit its aliasing group, placing it separately\n");
+#endif
+		return nullptr;
+	}
+
+	ID3D12Resource* resource = nullptr;
+
+	if (FAILED(device->CreatePlacedResource(group.heap, 0u, &resourceDesc, initialState, clearValue,
+		IID_PPV_ARGS(&resource))))
+	{
+#ifdef _DEBUG
+		OutputDebugStringA("HeapManager::CreateResource: failed to create aliased resource\n");
+#endif
+
+		if (group.resourcesNumber == 0u)
+		{
+			group.heap->Release();
+			aliasingGroups.erase(groupIterator);
+		}
+
+		return nullptr;
+	}
+
+	group.resourcesNumber++;
+
+	PlacedAllocation allocation{};
+	allocation.poolIndex = TLSFAllocator::INVALID_INDEX;
+	allocation.heap = group.heap;
+	allocation.offset = 0u;
+	allocation.aliasingGroup = aliasingGroup;
+
+	allocations.insert({ resource, allocation });
+
+	return resource;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "DirectX12Includes.h"
+#include "TLSFAllocator.h"
+
+namespace Graphics
+{
+	enum class HeapCategory : uint32_t
+	{
+		BUFFERS = 0u,
+		TEXTURES = 1u,
+		RENDER_TARGETS = 2u
+	};
+
+	struct HeapStatistics
+	{
+	public:
+		uint32_t heapsNumber;
+		uint32_t placedResourcesNumber;
+		uint32_t aliasedResourcesNumber;
+		uint64_t reservedSize;
+		uint64_t usedSize;
+	};
+
+	class HeapManager final
+	{
+	public:
+		HeapManager();
+		~HeapManager();
+
+		ID3D12Resource* CreateResource(ID3D12Device* device, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_DESC resourceDesc,
+			D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* clearValue, uint32_t aliasingGroup = 0u);
+
+		void Deallocate(ID3D12Resource* resource);
+
+		HeapStatistics GetStatistics() const;
+
+		static constexpr uint64_t HEAP_SIZE = 64u * 1024u * 1024u;
+
+	private:
+		HeapManager(const HeapManager&) = delete;
+		HeapManager(HeapManager&&) = delete;
+		HeapManager& operator=(const HeapManager&) = delete;
+		HeapManager& operator=(HeapManager&&) = delete;
+
+		struct Heap
+		{
+		public:
+			ID3D12Heap* heap;
+			TLSFAllocator allocator;
+		};
+
+		struct HeapPool
+		{
+		public:
+			D3D12_HEAP_TYPE type;
+			HeapCategory category;
+			uint64_t alignment;
+			std::vector<Heap> heaps;
+		};
+
+		struct PlacedAllocation
+		{
+		public:
+			uint32_t poolIndex;
+			ID3D12Heap* heap;
+			uint64_t offset;
+			uint32_t aliasingGroup;
+		};
+
+		struct AliasingGroup
+		{
+		public:
+			ID3D12Heap* heap;
+			HeapCategory category;
+			uint64_t size;
+			uint64_t alignment;
+			uint32_t resourcesNumber;
+		};
+
+		constexpr uint64_t AlignValue(uint64_t value, uint64_t alignment) const noexcept;
+		HeapCategory GetCategory(const D3D12_RESOURCE_DESC& resourceDesc) const noexcept;
+		uint32_t GetPoolIndex(D3D12_HEAP_TYPE heapType, HeapCategory category, uint64_t alignment);
+		ID3D12Heap* CreateHeap(ID3D12Device* device, D3D12_HEAP_TYPE heapType, HeapCategory category,
+			uint64_t size, uint64_t alignment) const;
+
+		ID3D12Resource* CreateAliasedResource(ID3D12Device* device, const D3D12_RESOURCE_DESC& resourceDesc,
+			const D3D12_RESOURCE_ALLOCATION_INFO& allocationInfo, D3D12_RESOURCE_STATES initialState,
+			const D3D12_CLEAR_VALUE* clearValue, HeapCategory category, uint32_t aliasingGroup);
+
+		std::vector<HeapPool> pools;
+		std::unordered_map<ID3D12Resource*, PlacedAllocation> allocations;
+		std::unordered_map<uint32_t, AliasingGroup> aliasingGroups;
+	};
+}
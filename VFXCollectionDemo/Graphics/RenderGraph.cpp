@@ -0,0 +1,819 @@
+#include "RenderGraph.h"
+
+Graphics::RenderGraph::RenderGraph(uint32_t firstAliasingGroup)
+	: _firstAliasingGroup(firstAliasingGroup), statistics{}, isCompiled(false)
+{
+
+}
+
+Graphics::RenderGraph::~RenderGraph()
+{
+	DeleteBarrierBatches();
+}
+
+Graphics::RenderGraphResourceID Graphics::RenderGraph::ImportResource(const std::string& name,
+	Resources::GPUResource* resource, D3D12_RESOURCE_STATES state)
+{
+	Resource newResource{};
+	newResource.name = name;
+	newResource.isTransient = false;
+	newResource.initialState = state;
+	newResource.gpuResource = resource;
+	newResource.firstUse = INVALID_INDEX;
+	newResource.lastUse = INVALID_INDEX;
+	newResource.aliasingGroupIndex = INVALID_INDEX;
+
+	resources.push_back(newResource);
+	isCompiled = false;
+
+	return static_cast<RenderGraphResourceID>(resources.size() - 1u);
+}
+
+Graphics::RenderGraphResourceID Graphics::RenderGraph::CreateTransientResource(const std::string& name,
+	const RenderGraphTransientDesc& desc)
+{
+	Resource newResource{};
+	newResource.name = name;
+	newResource.isTransient = true;
+	newResource.transientDesc = desc;
+	newResource.initialState = D3D12_RESOURCE_STATE_COMMON;
+	newResource.gpuResource = nullptr;
+	newResource.firstUse = INVALID_INDEX;
+	newResource.lastUse = INVALID_INDEX;
+	newResource.aliasingGroupIndex = INVALID_INDEX;
+
+	resources.push_back(newResource);
+	isCompiled = false;
+
+	return static_cast<RenderGraphResourceID>(resources.size() - 1u);
+}
+
+Graphics::RenderGraphPassID Graphics::RenderGraph::AddPass(const std::string& name, RenderGraphExecuteFunction execute,
+	bool hasSideEffects)
+{
+	Pass newPass{};
+	newPass.name = name;
+	newPass.execute = std::move(execute);
+	newPass.hasSideEffects = hasSideEffects;
+	newPass.isCulled = false;
+	newPass.branchIndex = INVALID_INDEX;
+
+	passes.push_back(std::move(newPass));
+	isCompiled = false;
+
+	return static_cast<RenderGraphPassID>(passes.size() - 1u);
+}
+
+void Graphics::RenderGraph::Read(RenderGraphPassID passId, RenderGraphResourceID resourceId, D3D12_RESOURCE_STATES state)
+{
+	AddAccess(passId, resourceId, state, false);
+}
+
+void Graphics::RenderGraph::Write(RenderGraphPassID passId, RenderGraphResourceID resourceId, D3D12_RESOURCE_STATES state)
+{
+	AddAccess(passId, resourceId, state, true);
+}
+
+bool Graphics::RenderGraph::Compile()
+{
+	statistics = {};
+	isCompiled = false;
+
+	if (!CullPasses())
+		return false;
+
+	BuildBranches();
+	AssignAliasingGroups();
+	DeriveBarriers();
+
+	DeleteBarrierBatches();
+
+	for (size_t branchIndex = 0u; branchIndex < branches.size(); branchIndex++)
+		barrierBatches.push_back(new Resources::BarrierBatch());
+
+	statistics.passesNumber = static_cast<uint32_t>(passes.size());
+	statistics.branchesNumber = static_cast<uint32_t>(branches.size());
+
+	for (auto& pass : passes)
+	{
+		if (pass.isCulled)
+			statistics.culledPassesNumber++;
+
+		statistics.barriersNumber += static_cast<uint32_t>(pass.barriers.size());
+	}
+
+	for (auto& exitBarriers : branchesExitBarriers)
+		statistics.barriersNumber += static_cast<uint32_t>(exitBarriers.size());
+
+#ifdef _DEBUG
+	if (Validate() > 0u)
+		OutputDebugStringA("RenderGraph::Compile: compiled graph has hazards or unbalanced states\n");
+#endif
+
+	isCompiled = true;
+
+	return true;
+}
+
+void Graphics::RenderGraph::Realize(ID3D12Device* device, ID3D12GraphicsCommandList* commandList,
+	Resources::ResourceManager* resourceManager)
+{
+	if (!isCompiled)
+	{
+#ifdef _DEBUG
+		OutputDebugStringA("RenderGraph::Realize: graph is not compiled\n");
+#endif
+		return;
+	}
+
+	Release(resourceManager);
+
+	std::vector<RenderGraphResourceID> transientIds;
+
+	for (RenderGraphResourceID resourceId = 0u; resourceId < resources.size(); resourceId++)
+		if (resources[resourceId].isTransient && resources[resourceId].aliasingGroupIndex != INVALID_INDEX)
+			transientIds.push_back(resourceId);
+
+	std::stable_sort(transientIds.begin(), transientIds.end(), [this](RenderGraphResourceID left, RenderGraphResourceID right)
+		{
+			return resources[left].transientDesc.size > resources[right].transientDesc.size;
+		});
+
+	for (auto resourceId : transientIds)
+	{
+		auto& resource = resources[resourceId];
+		auto& group = aliasingGroups[resource.aliasingGroupIndex];
+
+		auto textureDesc = resource.transientDesc.textureDesc;
+		textureDesc.aliasingGroup = group.resources.size() > 1u ? _firstAliasingGroup + resource.aliasingGroupIndex : 0u;
+
+		resource.id = resourceManager->CreateTextureResource(device, commandList, resource.transientDesc.type, textureDesc);
+
+		if (resource.transientDesc.type == Resources::TextureResourceType::DEPTH_STENCIL_TARGET)
+			resource.gpuResource = resourceManager->GetResource<Resources::DepthStencilTarget>(resource.id)->resource;
+		else if (resource.transientDesc.type == Resources::TextureResourceType::RENDER_TARGET)
+			resource.gpuResource = resourceManager->GetResource<Resources::RenderTarget>(resource.id)->resource;
+		else if (resource.transientDesc.type == Resources::TextureResourceType::RW_TEXTURE)
+			resource.gpuResource = resourceManager->GetResource<Resources::RWTexture>(resource.id)->resource;
+		else
+			resource.gpuResource = resourceManager->GetResource<Resources::Texture>(resource.id)->resource;
+	}
+}
+
+void Graphics::RenderGraph::Release(Resources::ResourceManager* resourceManager)
+{
+	for (auto& resource : resources)
+	{
+		if (!resource.isTransient || resource.gpuResource == nullptr)
+			continue;
+
+		if (resource.transientDesc.type == Resources::TextureResourceType::DEPTH_STENCIL_TARGET)
+			resourceManager->DeleteResource<Resources::DepthStencilTarget>(resource.id);
+		else if (resource.transientDesc.type == Resources::TextureResourceType::RENDER_TARGET)
+			resourceManager->DeleteResource<Resources::RenderTarget>(resource.id);
+		else if (resource.transientDesc.type == Resources::TextureResourceType::RW_TEXTURE)
+			resourceManager->DeleteResource<Resources::RWTexture>(resource.id);
+		else
+			resourceManager->DeleteResource<Resources::Texture>(resource.id);
+
+		resource.gpuResource = nullptr;
+		resource.id = {};
+	}
+}
+
+void Graphics::RenderGraph::Execute(uint32_t branchIndex, ID3D12GraphicsCommandList* commandList)
+{
+	if (!isCompiled || branchIndex >= branches.size())
+	{
+#ifdef _DEBUG
+		OutputDebugStringA("RenderGraph::Execute: graph is not compiled or branch does not exist\n");
+#endif
+		return;
+	}
+
+	auto& barrierBatch = *barrierBatches[branchIndex];
+
+	for (auto passId : branches[branchIndex])
+	{
+		auto& pass = passes[passId];
+
+		for (auto& barrier : pass.barriers)
+		{
+			auto gpuResource = resources[barrier.resourceId].gpuResource;
+
+			if (gpuResource == nullptr)
+				continue;
+
+			if (barrier.type == RenderGraphBarrierType::TRANSITION)
+				gpuResource->Barrier(barrierBatch, barrier.stateAfter);
+			else if (barrier.type == RenderGraphBarrierType::UAV)
+				gpuResource->UAVBarrier(barrierBatch);
+			else
+				gpuResource->AliasingBarrier(barrierBatch, nullptr);
+		}
+
+		barrierBatch.Flush(commandList);
+
+		for (auto resourceId : pass.discards)
+			if (resources[resourceId].gpuResource != nullptr)
+				commandList->DiscardResource(resources[resourceId].gpuResource->GetResource(), nullptr);
+
+		if (pass.execute)
+			pass.execute(commandList);
+	}
+
+	for (auto& barrier : branchesExitBarriers[branchIndex])
+		if (resources[barrier.resourceId].gpuResource != nullptr)
+			resources[barrier.resourceId].gpuResource->Barrier(barrierBatch, barrier.stateAfter);
+
+	barrierBatch.Flush(commandList);
+	barrierBatch.EndFrame();
+}
+
+uint32_t Graphics::RenderGraph::GetBranchesNumber() const noexcept
+{
+	return static_cast<uint32_t>(branches.size());
+}
+
+bool Graphics::RenderGraph::IsPassCulled(RenderGraphPassID passId) const
+{
+	return passes[passId].isCulled;
+}
+
+uint32_t Graphics::RenderGraph::GetPassBranchIndex(RenderGraphPassID passId) const
+{
+	return passes[passId].branchIndex;
+}
+
+const std::vector<Graphics::RenderGraphBarrier>& Graphics::RenderGraph::GetPassBarriers(RenderGraphPassID passId) const
+{
+	return passes[passId].barriers;
+}
+
+const Graphics::Resources::BarrierBatch& Graphics::RenderGraph::GetBarrierBatch(uint32_t branchIndex) const
+{
+	return *barrierBatches[branchIndex];
+}
+
+Graphics::Resources::ResourceID Graphics::RenderGraph::GetResourceID(RenderGraphResourceID resourceId) const
+{
+	return resources[resourceId].id;
+}
+
+Graphics::Resources::GPUResource* Graphics::RenderGraph::GetGPUResource(RenderGraphResourceID resourceId) const
+{
+	return resources[resourceId].gpuResource;
+}
+
+const Graphics::RenderGraphStatistics& Graphics::RenderGraph::GetStatistics() const noexcept
+{
+	return statistics;
+}
+
+void Graphics::RenderGraph::AddAccess(RenderGraphPassID passId, RenderGraphResourceID resourceId,
+	D3D12_RESOURCE_STATES state, bool isWrite)
+{
+	if (passId >= passes.size() || resourceId >= resources.size())
+	{
+#ifdef _DEBUG
+		OutputDebugStringA("RenderGraph::AddAccess: pass or resource does not exist\n");
+#endif
+		return;
+	}
+
+	isCompiled = false;
+
+	auto& pass = passes[passId];
+
+	for (auto& access : pass.accesses)
+	{
+		if (access.resourceId != resourceId)
+			continue;
+
+		if (!access.isWrite && !isWrite && IsReadState(access.state) && IsReadState(state))
+			access.state |= state;
+		else if (access.state == state)
+		{
+			access.isWrite = access.isWrite || isWrite;
+			access.isRead = access.isRead || !isWrite;
+		}
+#ifdef _DEBUG
+		else
+			OutputDebugStringA("RenderGraph::AddAccess: pass accesses one resource in different states\n");
+#endif
+
+		return;
+	}
+
+	pass.accesses.push_back({ resourceId, state, !isWrite, isWrite });
+}
+
+bool Graphics::RenderGraph::CullPasses()
+{
+	std::vector<bool> isWritten(resources.size(), false);
+
+	for (auto& pass : passes)
+	{
+		for (auto& access : pass.accesses)
+			if (access.isRead && resources[access.resourceId].isTransient && !isWritten[access.resourceId])
+			{
+#ifdef _DEBUG
+				OutputDebugStringA("RenderGraph::Compile: transient resource is read before it is written\n");
+#endif
+				return false;
+			}
+
+		for (auto& access : pass.accesses)
+			if (access.isWrite)
+				isWritten[access.resourceId] = true;
+	}
+
+	std::vector<bool> isNeeded(resources.size(), false);
+
+	for (auto passIterator = passes.rbegin(); passIterator != passes.rend(); ++passIterator)
+	{
+		auto& pass = *passIterator;
+		auto isPassNeeded = pass.hasSideEffects;
+
+		for (auto& access : pass.accesses)
+			if (access.isWrite && (!resources[access.resourceId].isTransient || isNeeded[access.resourceId]))
+				isPassNeeded = true;
+
+		pass.isCulled = !isPassNeeded;
+		pass.branchIndex = INVALID_INDEX;
+		pass.barriers.clear();
+		pass.discards.clear();
+
+		if (!isPassNeeded)
+			continue;
+
+		for (auto& access : pass.accesses)
+			if (access.isWrite)
+				isNeeded[access.resourceId] = false;
+
+		for (auto& access : pass.accesses)
+			if (access.isRead)
+				isNeeded[access.resourceId] = true;
+	}
+
+	return true;
+}
+
+void Graphics::RenderGraph::BuildBranches()
+{
+	std::vector<uint32_t> parents(passes.size());
+
+	for (uint32_t passIndex = 0u; passIndex < parents.size(); passIndex++)
+		parents[passIndex] = passIndex;
+
+	auto findRoot = [&parents](uint32_t passIndex)
+		{
+			while (parents[passIndex] != passIndex)
+			{
+				parents[passIndex] = parents[parents[passIndex]];
+				passIndex = parents[passIndex];
+			}
+
+			return passIndex;
+		};
+
+	std::vector<uint32_t> resourceOwners(resources.size(), INVALID_INDEX);
+
+	for (RenderGraphPassID passId = 0u; passId < passes.size(); passId++)
+	{
+		if (passes[passId].isCulled)
+			continue;
+
+		for (auto& access : passes[passId].accesses)
+		{
+			auto& owner = resourceOwners[access.resourceId];
+
+			if (owner == INVALID_INDEX)
+				owner = passId;
+			else
+				parents[findRoot(passId)] = findRoot(owner);
+		}
+	}
+
+	std::vector<uint32_t> rootBranches(passes.size(), INVALID_INDEX);
+	branches.clear();
+
+	for (RenderGraphPassID passId = 0u; passId < passes.size(); passId++)
+	{
+		if (passes[passId].isCulled)
+			continue;
+
+		auto& branchIndex = rootBranches[findRoot(passId)];
+
+		if (branchIndex == INVALID_INDEX)
+		{
+			branchIndex = static_cast<uint32_t>(branches.size());
+			branches.emplace_back();
+		}
+
+		passes[passId].branchIndex = branchIndex;
+		branches[branchIndex].push_back(passId);
+	}
+
+	for (auto& resource : resources)
+	{
+		resource.firstUse = INVALID_INDEX;
+		resource.lastUse = INVALID_INDEX;
+	}
+
+	uint32_t position = 0u;
+
+	for (auto& branch : branches)
+		for (auto passId : branch)
+		{
+			for (auto& access : passes[passId].accesses)
+			{
+				auto& resource = resources[access.resourceId];
+
+				if (resource.firstUse == INVALID_INDEX)
+					resource.firstUse = position;
+
+				resource.lastUse = position;
+			}
+
+			position++;
+		}
+}
+
+void Graphics::RenderGraph::AssignAliasingGroups()
+{
+	aliasingGroups.clear();
+
+	std::vector<RenderGraphResourceID> transientIds;
+
+	for (RenderGraphResourceID resourceId = 0u; resourceId < resources.size(); resourceId++)
+	{
+		auto& resource = resources[resourceId];
+		resource.aliasingGroupIndex = INVALID_INDEX;
+
+		if (resource.isTransient && resource.firstUse != INVALID_INDEX)
+			transientIds.push_back(resourceId);
+	}
+
+	std::stable_sort(transientIds.begin(), transientIds.end(), [this](RenderGraphResourceID left, RenderGraphResourceID right)
+		{
+			return resources[left].transientDesc.size > resources[right].transientDesc.size;
+		});
+
+	for (auto resourceId : transientIds)
+	{
+		auto& resource = resources[resourceId];
+		auto isRenderTargetCategory = IsRenderTargetCategory(resource.transientDesc.type);
+		auto groupIndex = INVALID_INDEX;
+
+		for (uint32_t candidateIndex = 0u; candidateIndex < aliasingGroups.size() && groupIndex == INVALID_INDEX; candidateIndex++)
+		{
+			auto& candidate = aliasingGroups[candidateIndex];
+
+			if (candidate.isRenderTargetCategory != isRenderTargetCategory)
+				continue;
+
+			auto overlaps = false;
+
+			for (auto memberId : candidate.resources)
+			{
+				auto& member = resources[memberId];
+
+				if (member.firstUse <= resource.lastUse && resource.firstUse <= member.lastUse)
+				{
+					overlaps = true;
+					break;
+				}
+			}
+
+			if (!overlaps)
+				groupIndex = candidateIndex;
+		}
+
+		if (groupIndex == INVALID_INDEX)
+		{
+			groupIndex = static_cast<uint32_t>(aliasingGroups.size());
+			aliasingGroups.push_back({ isRenderTargetCategory, 0u, {} });
+		}
+
+		auto& group = aliasingGroups[groupIndex];
+		group.size = std::max(group.size, resource.transientDesc.size);
+		group.resources.push_back(resourceId);
+
+		resource.aliasingGroupIndex = groupIndex;
+
+		statistics.transientSize += resource.transientDesc.size;
+	}
+
+	for (auto& group : aliasingGroups)
+		statistics.aliasedTransientSize += group.size;
+
+	statistics.transientResourcesNumber = static_cast<uint32_t>(transientIds.size());
+	statistics.aliasingGroupsNumber = static_cast<uint32_t>(aliasingGroups.size());
+}
+
+void Graphics::RenderGraph::DeriveBarriers()
+{
+	struct ResourceUse
+	{
+	public:
+		RenderGraphPassID passId;
+		uint32_t accessIndex;
+	};
+
+	std::vector<std::vector<ResourceUse>> resourcesUses(resources.size());
+	branchesExitBarriers.assign(branches.size(), {});
+
+	for (auto& branch : branches)
+		for (auto passId : branch)
+		{
+			auto& pass = passes[passId];
+
+			for (uint32_t accessIndex = 0u; accessIndex < pass.accesses.size(); accessIndex++)
+				resourcesUses[pass.accesses[accessIndex].resourceId].push_back({ passId, accessIndex });
+		}
+
+	for (RenderGraphResourceID resourceId = 0u; resourceId < resources.size(); resourceId++)
+	{
+		auto& resource = resources[resourceId];
+		auto& uses = resourcesUses[resourceId];
+
+		if (uses.empty())
+			continue;
+
+		auto isAliased = resource.isTransient && aliasingGroups[resource.aliasingGroupIndex].resources.size() > 1u;
+
+		auto walkUses = [&](D3D12_RESOURCE_STATES state, bool emitBarriers)
+			{
+				auto isPreviousWrite = false;
+
+				for (size_t useIndex = 0u; useIndex < uses.size(); useIndex++)
+				{
+					auto& pass = passes[uses[useIndex].passId];
+					auto& access = pass.accesses[uses[useIndex].accessIndex];
+
+					if (useIndex == 0u && isAliased && emitBarriers)
+					{
+						pass.barriers.push_back({ resourceId, RenderGraphBarrierType::ALIASING, state, state });
+
+						if (access.isWrite && !access.isRead && (access.state == D3D12_RESOURCE_STATE_RENDER_TARGET ||
+							access.state == D3D12_RESOURCE_STATE_DEPTH_WRITE || access.state == D3D12_RESOURCE_STATE_UNORDERED_ACCESS))
+							pass.discards.push_back(resourceId);
+					}
+
+					if (!access.isWrite && IsReadState(access.state))
+					{
+						if (!IsReadState(state) || (state & access.state) != access.state)
+						{
+							auto combinedState = access.state;
+
+							for (auto nextIndex = useIndex + 1u; nextIndex < uses.size(); nextIndex++)
+							{
+								auto& nextAccess = passes[uses[nextIndex].passId].accesses[uses[nextIndex].accessIndex];
+
+								if (nextAccess.isWrite || !IsReadState(nextAccess.state))
+									break;
+
+								combinedState |= nextAccess.state;
+							}
+
+							if (emitBarriers)
+								pass.barriers.push_back({ resourceId, RenderGraphBarrierType::TRANSITION, state, combinedState });
+
+							state = combinedState;
+						}
+					}
+					else if (state != access.state)
+					{
+						if (emitBarriers)
+							pass.barriers.push_back({ resourceId, RenderGraphBarrierType::TRANSITION, state, access.state });
+
+						state = access.state;
+					}
+					else if (state == D3D12_RESOURCE_STATE_UNORDERED_ACCESS && useIndex > 0u && (isPreviousWrite || access.isWrite))
+					{
+						if (emitBarriers)
+							pass.barriers.push_back({ resourceId, RenderGraphBarrierType::UAV, state, state });
+					}
+
+					isPreviousWrite = access.isWrite;
+				}
+
+				return state;
+			};
+
+		if (resource.isTransient)
+			resource.initialState = walkUses(passes[uses.front().passId].accesses[uses.front().accessIndex].state, false);
+
+		auto finalState = walkUses(resource.initialState, true);
+
+		if (!resource.isTransient && finalState != resource.initialState)
+			branchesExitBarriers[passes[uses.back().passId].branchIndex].push_back({ resourceId,
+				RenderGraphBarrierType::TRANSITION, finalState, resource.initialState });
+	}
+}
+
+uint32_t Graphics::RenderGraph::Validate() const
+{
+	static constexpr uint32_t UAV_ACCESS_NONE = 0u;
+	static constexpr uint32_t UAV_ACCESS_READ = 1u;
+	static constexpr uint32_t UAV_ACCESS_WRITE = 2u;
+
+	uint32_t errorsNumber = 0u;
+
+	std::vector<uint32_t> lastWriters(resources.size(), INVALID_INDEX);
+
+	for (RenderGraphPassID passId = 0u; passId < passes.size(); passId++)
+	{
+		auto& pass = passes[passId];
+
+		for (auto& access : pass.accesses)
+			if (!pass.isCulled && access.isRead && lastWriters[access.resourceId] != INVALID_INDEX &&
+				passes[lastWriters[access.resourceId]].isCulled)
+				errorsNumber++;
+
+		for (auto& access : pass.accesses)
+			if (access.isWrite)
+				lastWriters[access.resourceId] = passId;
+
+		if (pass.isCulled || pass.hasSideEffects)
+			continue;
+
+		auto isNeeded = false;
+
+		for (auto& access : pass.accesses)
+		{
+			if (!access.isWrite)
+				continue;
+
+			if (!resources[access.resourceId].isTransient)
+			{
+				isNeeded = true;
+				continue;
+			}
+
+			for (auto nextPassId = passId + 1u; nextPassId < passes.size(); nextPassId++)
+			{
+				if (passes[nextPassId].isCulled)
+					continue;
+
+				auto& nextAccesses = passes[nextPassId].accesses;
+				auto nextAccess = std::find_if(nextAccesses.begin(), nextAccesses.end(), [&access](const ResourceAccess& candidate)
+					{
+						return candidate.resourceId == access.resourceId;
+					});
+
+				if (nextAccess != nextAccesses.end())
+				{
+					isNeeded = isNeeded || nextAccess->isRead;
+					break;
+				}
+			}
+		}
+
+		if (!isNeeded)
+			errorsNumber++;
+	}
+
+	std::vector<uint32_t> resourceBranches(resources.size(), INVALID_INDEX);
+
+	for (RenderGraphPassID passId = 0u; passId < passes.size(); passId++)
+	{
+		auto& pass = passes[passId];
+
+		if (pass.isCulled != (pass.branchIndex == INVALID_INDEX))
+			errorsNumber++;
+
+		if (pass.isCulled)
+			continue;
+
+		for (auto& access : pass.accesses)
+		{
+			auto& branchIndex = resourceBranches[access.resourceId];
+
+			if (branchIndex == INVALID_INDEX)
+				branchIndex = pass.branchIndex;
+			else if (branchIndex != pass.branchIndex)
+				errorsNumber++;
+		}
+	}
+
+	for (auto& branch : branches)
+		if (!std::is_sorted(branch.begin(), branch.end()))
+			errorsNumber++;
+
+	for (uint32_t groupIndex = 0u; groupIndex < aliasingGroups.size(); groupIndex++)
+	{
+		auto& group = aliasingGroups[groupIndex];
+
+		for (size_t memberIndex = 0u; memberIndex < group.resources.size(); memberIndex++)
+		{
+			auto& member = resources[group.resources[memberIndex]];
+
+			if (member.aliasingGroupIndex != groupIndex || member.transientDesc.size > group.size ||
+				IsRenderTargetCategory(member.transientDesc.type) != group.isRenderTargetCategory)
+				errorsNumber++;
+
+			for (auto otherIndex = memberIndex + 1u; otherIndex < group.resources.size(); otherIndex++)
+			{
+				auto& other = resources[group.resources[otherIndex]];
+
+				if (member.firstUse <= other.lastUse && other.firstUse <= member.lastUse)
+					errorsNumber++;
+			}
+		}
+	}
+
+	std::vector<D3D12_RESOURCE_STATES> states(resources.size());
+	std::vector<uint32_t> uavAccesses(resources.size(), UAV_ACCESS_NONE);
+	std::vector<RenderGraphResourceID> activeResources(aliasingGroups.size(), INVALID_INDEX);
+
+	for (RenderGraphResourceID resourceId = 0u; resourceId < resources.size(); resourceId++)
+		states[resourceId] = resources[resourceId].initialState;
+
+	for (auto& branch : branches)
+		for (auto passId : branch)
+		{
+			auto& pass = passes[passId];
+
+			for (auto& barrier : pass.barriers)
+			{
+				if (barrier.type == RenderGraphBarrierType::TRANSITION)
+				{
+					if (states[barrier.resourceId] != barrier.stateBefore)
+						errorsNumber++;
+
+					states[barrier.resourceId] = barrier.stateAfter;
+					uavAccesses[barrier.resourceId] = UAV_ACCESS_NONE;
+				}
+				else if (barrier.type == RenderGraphBarrierType::UAV)
+					uavAccesses[barrier.resourceId] = UAV_ACCESS_NONE;
+				else
+					activeResources[resources[barrier.resourceId].aliasingGroupIndex] = barrier.resourceId;
+			}
+
+			for (auto& access : pass.accesses)
+			{
+				auto& resource = resources[access.resourceId];
+				auto state = states[access.resourceId];
+
+				if (resource.isTransient && aliasingGroups[resource.aliasingGroupIndex].resources.size() > 1u &&
+					activeResources[resource.aliasingGroupIndex] != access.resourceId)
+					errorsNumber++;
+
+				if (!access.isWrite && IsReadState(access.state))
+				{
+					if (!IsReadState(state) || (state & access.state) != access.state)
+						errorsNumber++;
+				}
+				else if (state != access.state)
+					errorsNumber++;
+
+				if (access.state != D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+					continue;
+
+				auto& uavAccess = uavAccesses[access.resourceId];
+
+				if (uavAccess == UAV_ACCESS_WRITE || (access.isWrite && uavAccess == UAV_ACCESS_READ))
+					errorsNumber++;
+
+				uavAccess = access.isWrite ? UAV_ACCESS_WRITE : std::max(uavAccess, UAV_ACCESS_READ);
+			}
+		}
+
+	for (auto& exitBarriers : branchesExitBarriers)
+		for (auto& barrier : exitBarriers)
+		{
+			if (states[barrier.resourceId] != barrier.stateBefore)
+				errorsNumber++;
+
+			states[barrier.resourceId] = barrier.stateAfter;
+		}
+
+	for (RenderGraphResourceID resourceId = 0u; resourceId < resources.size(); resourceId++)
+		if (states[resourceId] != resources[resourceId].initialState)
+			errorsNumber++;
+
+	return errorsNumber;
+}
+
+bool Graphics::RenderGraph::IsReadState(D3D12_RESOURCE_STATES state) const noexcept
+{
+	static constexpr D3D12_RESOURCE_STATES READ_STATES = D3D12_RESOURCE_STATE_GENERIC_READ |
+		D3D12_RESOURCE_STATE_DEPTH_READ | D3D12_RESOURCE_STATE_RESOLVE_SOURCE;
+
+	return state != D3D12_RESOURCE_STATE_COMMON && (state & ~READ_STATES) == 0;
+}
+
+bool Graphics::RenderGraph::IsRenderTargetCategory(Resources::TextureResourceType type) const noexcept
+{
+	return type == Resources::TextureResourceType::RENDER_TARGET || type == Resources::TextureResourceType::DEPTH_STENCIL_TARGET;
+}
+
+void Graphics::RenderGraph::DeleteBarrierBatches()
+{
+	for (auto barrierBatch : barrierBatches)
+		delete barrierBatch;
+
+	barrierBatches.clear();
+}
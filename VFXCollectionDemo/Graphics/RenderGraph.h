@@ -0,0 +1,160 @@
+#pragma once
+
+#include "DirectX12Includes.h"
+#include "Resources/ResourceManager.h"
+#include "Resources/BarrierBatch.h"
+
+namespace Graphics
+{
+	using RenderGraphResourceID = uint32_t;
+	using RenderGraphPassID = uint32_t;
+	using RenderGraphExecuteFunction = std::function<void(ID3D12GraphicsCommandList* commandList)>;
+
+	enum class RenderGraphBarrierType : uint32_t
+	{
+		TRANSITION = 0u,
+		UAV = 1u,
+		ALIASING = 2u
+	};
+
+	struct RenderGraphTransientDesc
+	{
+	public:
+		Resources::TextureResourceType type;
+		Resources::TextureDesc textureDesc;
+		uint64_t size;
+	};
+
+	struct RenderGraphBarrier
+	{
+	public:
+		RenderGraphResourceID resourceId;
+		RenderGraphBarrierType type;
+		D3D12_RESOURCE_STATES stateBefore;
+		D3D12_RESOURCE_STATES stateAfter;
+	};
+
+	struct RenderGraphStatistics
+	{
+	public:
+		uint32_t passesNumber;
+		uint32_t culledPassesNumber;
+		uint32_t barriersNumber;
+		uint32_t branchesNumber;
+		uint32_t transientResourcesNumber;
+		uint32_t aliasingGroupsNumber;
+		uint64_t transientSize;
+		uint64_t aliasedTransientSize;
+	};
+
+	class RenderGraph final
+	{
+	public:
+		RenderGraph(uint32_t firstAliasingGroup);
+		~RenderGraph();
+
+		RenderGraphResourceID ImportResource(const std::string& name, Resources::GPUResource* resource,
+			D3D12_RESOURCE_STATES state);
+		RenderGraphResourceID CreateTransientResource(const std::string& name, const RenderGraphTransientDesc& desc);
+
+		RenderGraphPassID AddPass(const std::string& name, RenderGraphExecuteFunction execute, bool hasSideEffects = false);
+		void Read(RenderGraphPassID passId, RenderGraphResourceID resourceId, D3D12_RESOURCE_STATES state);
+		void Write(RenderGraphPassID passId, RenderGraphResourceID resourceId, D3D12_RESOURCE_STATES state);
+
+		bool Compile();
+		void Realize(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, Resources::ResourceManager* resourceManager);
+		void Release(Resources::ResourceManager* resourceManager);
+
+		void Execute(uint32_t branchIndex, ID3D12GraphicsCommandList* commandList);
+
+		uint32_t Validate() const;
+
+		uint32_t GetBranchesNumber() const noexcept;
+		bool IsPassCulled(RenderGraphPassID passId) const;
+		uint32_t GetPassBranchIndex(RenderGraphPassID passId) const;
+		const std::vector<RenderGraphBarrier>& GetPassBarriers(RenderGraphPassID passId) const;
+		const Resources::BarrierBatch& GetBarrierBatch(uint32_t branchIndex) const;
+
+		Resources::ResourceID GetResourceID(RenderGraphResourceID resourceId) const;
+		Resources::GPUResource* GetGPUResource(RenderGraphResourceID resourceId) const;
+
+		const RenderGraphStatistics& GetStatistics() const noexcept;
+
+		static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+	private:
+		RenderGraph() = delete;
+		RenderGraph(const RenderGraph&) = delete;
+		RenderGraph(RenderGraph&&) = delete;
+		RenderGraph& operator=(const RenderGraph&) = delete;
+		RenderGraph& operator=(RenderGraph&&) = delete;
+
+		struct ResourceAccess
+		{
+		public:
+			RenderGraphResourceID resourceId;
+			D3D12_RESOURCE_STATES state;
+			bool isRead;
+			bool isWrite;
+		};
+
+		struct Pass
+		{
+		public:
+			std::string name;
+			RenderGraphExecuteFunction execute;
+			bool hasSideEffects;
+			bool isCulled;
+			uint32_t branchIndex;
+			std::vector<ResourceAccess> accesses;
+			std::vector<RenderGraphBarrier> barriers;
+			std::vector<RenderGraphResourceID> discards;
+		};
+
+		struct Resource
+		{
+		public:
+			std::string name;
+			bool isTransient;
+			RenderGraphTransientDesc transientDesc;
+			D3D12_RESOURCE_STATES initialState;
+			Resources::GPUResource* gpuResource;
+			Resources::ResourceID id;
+			uint32_t firstUse;
+			uint32_t lastUse;
+			uint32_t aliasingGroupIndex;
+		};
+
+		struct AliasingGroup
+		{
+		public:
+			bool isRenderTargetCategory;
+			uint64_t size;
+			std::vector<RenderGraphResourceID> resources;
+		};
+
+		void AddAccess(RenderGraphPassID passId, RenderGraphResourceID resourceId, D3D12_RESOURCE_STATES state, bool isWrite);
+
+		bool CullPasses();
+		void BuildBranches();
+		void AssignAliasingGroups();
+		void DeriveBarriers();
+
+		bool IsReadState(D3D12_RESOURCE_STATES state) const noexcept;
+		bool IsRenderTargetCategory(Resources::TextureResourceType type) const noexcept;
+		void DeleteBarrierBatches();
+
+		uint32_t _firstAliasingGroup;
+
+		std::vector<Pass> passes;
+		std::vector<Resource> resources;
+		std::vector<AliasingGroup> aliasingGroups;
+
+		std::vector<std::vector<RenderGraphPassID>> branches;
+		std::vector<std::vector<RenderGraphBarrier>> branchesExitBarriers;
+		std::vector<Resources::BarrierBatch*> barrierBatches;
+
+		RenderGraphStatistics statistics;
+		bool isCompiled;
+	};
+}
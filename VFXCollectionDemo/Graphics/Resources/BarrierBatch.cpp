@@ -0,0 +1,199 @@
+#include "BarrierBatch.h"
+
+Graphics::Resources::BarrierBatch::BarrierBatch()
+	: statistics{}, frameStatistics{}
+{
+	barriers.reserve(RESERVED_BARRIERS_NUMBER);
+}
+
+Graphics::Resources::BarrierBatch::~BarrierBatch()
+{
+#ifdef _DEBUG
+	if (!barriers.empty())
+		OutputDebugStringA("BarrierBatch::~BarrierBatch: pending barriers were never flushed\n");
+#endif
+}
+
+bool Graphics::Resources::BarrierBatch::AddTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES stateBefore,
+	D3D12_RESOURCE_STATES& stateAfter, D3D12_RESOURCE_BARRIER_FLAGS flags)
+{
+	statistics.requestedNumber++;
+
+	if (flags == D3D12_RESOURCE_BARRIER_FLAG_NONE && IsReadState(stateBefore) && IsReadState(stateAfter) &&
+		(stateBefore | stateAfter) != stateAfter)
+	{
+		stateAfter |= stateBefore;
+
+		if (stateAfter != stateBefore)
+			statistics.combinedReadNumber++;
+	}
+
+	if (stateBefore == stateAfter)
+	{
+		statistics.redundantNumber++;
+		return false;
+	}
+
+	auto lastBarrier = FindLastBarrier(resource);
+
+	if (lastBarrier != nullptr && lastBarrier->Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION)
+	{
+		auto& transition = lastBarrier->Transition;
+
+		if (flags == D3D12_RESOURCE_BARRIER_FLAG_NONE && lastBarrier->Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE &&
+			transition.StateAfter == stateBefore)
+		{
+			statistics.mergedNumber++;
+
+			if (transition.StateBefore == stateAfter)
+				barriers.erase(barriers.begin() + (lastBarrier - barriers.data()));
+			else
+				transition.StateAfter = stateAfter;
+
+			return true;
+		}
+
+		if (flags == D3D12_RESOURCE_BARRIER_FLAG_END_ONLY && lastBarrier->Flags == D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY &&
+			transition.StateBefore == stateBefore && transition.StateAfter == stateAfter)
+		{
+			statistics.mergedNumber++;
+			lastBarrier->Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+
+			return true;
+		}
+	}
+
+	D3D12_RESOURCE_BARRIER barrier{};
+	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+	barrier.Flags = flags;
+	barrier.Transition.pResource = resource;
+	barrier.Transition.StateBefore = stateBefore;
+	barrier.Transition.StateAfter = stateAfter;
+
+	barriers.push_back(barrier);
+
+	return true;
+}
+
+void Graphics::Resources::BarrierBatch::AddUAV(ID3D12Resource* resource)
+{
+	statistics.requestedNumber++;
+
+	auto lastBarrier = FindLastBarrier(resource);
+
+	if (lastBarrier != nullptr && lastBarrier->Type == D3D12_RESOURCE_BARRIER_TYPE_UAV)
+	{
+		statistics.redundantNumber++;
+		return;
+	}
+
+	D3D12_RESOURCE_BARRIER barrier{};
+	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+	barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+	barrier.UAV.pResource = resource;
+
+	barriers.push_back(barrier);
+}
+
+void Graphics::Resources::BarrierBatch::AddAliasing(ID3D12Resource* resourceBefore, ID3D12Resource* resourceAfter)
+{
+	statistics.requestedNumber++;
+
+	D3D12_RESOURCE_BARRIER barrier{};
+	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+	barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+	barrier.Aliasing.pResourceBefore = resourceBefore;
+	barrier.Aliasing.pResourceAfter = resourceAfter;
+
+	barriers.push_back(barrier);
+}
+
+void Graphics::Resources::BarrierBatch::Flush(ID3D12GraphicsCommandList* commandList)
+{
+	if (barriers.empty())
+		return;
+
+	commandList->ResourceBarrier(static_cast<uint32_t>(barriers.size()), barriers.data());
+
+	statistics.emittedNumber += static_cast<uint32_t>(barriers.size());
+	statistics.flushesNumber++;
+
+#ifdef _DEBUG
+	trace.insert(trace.end(), barriers.begin(), barriers.end());
+#endif
+	barriers.clear();
+}
+
+void Graphics::Resources::BarrierBatch::EndFrame()
+{
+	frameStatistics = statistics;
+	statistics = {};
+
+#ifdef _DEBUG
+	std::swap(trace, frameTrace);
+	trace.clear();
+#endif
+}
+
+bool Graphics::Resources::BarrierBatch::IsEmpty() const noexcept
+{
+	return barriers.empty();
+}
+
+const Graphics::Resources::BarrierStatistics& Graphics::Resources::BarrierBatch::GetFrameStatistics() const noexcept
+{
+	return frameStatistics;
+}
+
+#ifdef _DEBUG
+std::string Graphics::Resources::BarrierBatch::GetFrameTrace() const
+{
+	std::stringstream traceStream;
+	traceStream << "BarrierBatch: " << frameStatistics.requestedNumber << " requested, ";
+	traceStream << frameStatistics.emittedNumber << " emitted in " << frameStatistics.flushesNumber << " calls\n";
+	traceStream << "  redundant: " << frameStatistics.redundantNumber << ", merged: " << frameStatistics.mergedNumber;
+	traceStream << ", combined reads: " << frameStatistics.combinedReadNumber << "\n";
+
+	for (auto& barrier : frameTrace)
+	{
+		if (barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION)
+		{
+			traceStream << "  transition " << barrier.Transition.pResource << std::hex;
+			traceStream << " 0x" << barrier.Transition.StateBefore << " -> 0x" << barrier.Transition.StateAfter << std::dec;
+
+			if (barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY)
+				traceStream << " (begin)";
+			else if (barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_END_ONLY)
+				traceStream << " (end)";
+
+			traceStream << "\n";
+		}
+		else if (barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_UAV)
+			traceStream << "  uav " << barrier.UAV.pResource << "\n";
+		else
+			traceStream << "  aliasing " << barrier.Aliasing.pResourceBefore << " -> " << barrier.Aliasing.pResourceAfter << "\n";
+	}
+
+	return traceStream.str();
+}
+#endif
+
+bool Graphics::Resources::BarrierBatch::IsReadState(D3D12_RESOURCE_STATES state) const noexcept
+{
+	return state != D3D12_RESOURCE_STATE_COMMON && (state & ~READ_STATES) == 0;
+}
+
+D3D12_RESOURCE_BARRIER* Graphics::Resources::BarrierBatch::FindLastBarrier(ID3D12Resource* resource) noexcept
+{
+	for (auto barrierIterator = barriers.rbegin(); barrierIterator != barriers.rend(); ++barrierIterator)
+	{
+		auto& barrier = *barrierIterator;
+
+		if ((barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION && barrier.Transition.pResource == resource) ||
+			(barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_UAV && barrier.UAV.pResource == resource) ||
+			(barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_ALIASING && barrier.Aliasing.pResourceAfter == resource))
+			return &barrier;
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../DirectX12Includes.h"
+
+namespace Graphics::Resources
+{
+	struct BarrierStatistics
+	{
+	public:
+		uint32_t requestedNumber;
+		uint32_t redundantNumber;
+		uint32_t mergedNumber;
+		uint32_t combinedReadNumber;
+		uint32_t emittedNumber;
+		uint32_t flushesNumber;
+	};
+
+	class BarrierBatch final
+	{
+	public:
+		BarrierBatch();
+		~BarrierBatch();
+
+		bool AddTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES& stateAfter,
+			D3D12_RESOURCE_BARRIER_FLAGS flags);
+		void AddUAV(ID3D12Resource* resource);
+		void AddAliasing(ID3D12Resource* resourceBefore, ID3D12Resource* resourceAfter);
+
+		void Flush(ID3D12GraphicsCommandList* commandList);
+		void EndFrame();
+
+		bool IsEmpty() const noexcept;
+
+		const BarrierStatistics& GetFrameStatistics() const noexcept;
+#ifdef _DEBUG
+		std::string GetFrameTrace() const;
+#endif
+
+	private:
+		BarrierBatch(const BarrierBatch&) = delete;
+		BarrierBatch(BarrierBatch&&) = delete;
+		BarrierBatch& operator=(const BarrierBatch&) = delete;
+		BarrierBatch& operator=(BarrierBatch&&) = delete;
+
+		bool IsReadState(D3D12_RESOURCE_STATES state) const noexcept;
+		D3D12_RESOURCE_BARRIER* FindLastBarrier(ID3D12Resource* resource) noexcept;
+
+		static constexpr D3D12_RESOURCE_STATES READ_STATES = D3D12_RESOURCE_STATE_GENERIC_READ |
+			D3D12_RESOURCE_STATE_DEPTH_READ | D3D12_RESOURCE_STATE_RESOLVE_SOURCE;
+		static constexpr uint32_t RESERVED_BARRIERS_NUMBER = 16u;
+
+		std::vector<D3D12_RESOURCE_BARRIER> barriers;
+
+		BarrierStatistics statistics;
+		BarrierStatistics frameStatistics;
+
+#ifdef _DEBUG
+		std::vector<D3D12_RESOURCE_BARRIER> trace;
+		std::vector<D3D12_RESOURCE_BARRIER> frameTrace;
+#endif
+	};
+}
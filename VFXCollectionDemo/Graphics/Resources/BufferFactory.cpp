@@ -41,10 +41,10 @@ Graphics::Resources::IResource* Graphics::Resources::BufferFactory::CreateResour
 	newBuffer->resource = bufferAllocation.resource;
 	newBuffer->size = bufferAllocation.size;
 	newBuffer->resourceGPUAddress = bufferAllocation.gpuAddress;
-	newBuffer->srvDescriptor = _descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV);
 	auto srvDesc = DirectX12Utilities::CreateSRVDesc(bufferDesc);
 	
-	device->CreateShaderResourceView(destResource, &srvDesc, newBuffer->srvDescriptor.cpuDescriptor);
+	if (_descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV, newBuffer->srvDescriptor))
+		device->CreateShaderResourceView(destResource, &srvDesc, newBuffer->srvDescriptor.cpuDescriptor);
 
 	return static_cast<IResource*>(newBuffer);
 }
@@ -49,14 +49,14 @@ Graphics::Resources::IResource* Graphics::Resources::ConstantBufferFactory::Crea
 	newConstantBuffer->size = bufferAllocation.size;
 	newConstantBuffer->resourceCPUAddress = bufferAllocation.cpuAddress;
 	newConstantBuffer->resourceGPUAddress = bufferAllocation.gpuAddress;
-	newConstantBuffer->cbvDescriptor = _descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV);
 
 	D3D12_CONSTANT_BUFFER_VIEW_DESC viewDesc{};
 	viewDesc.BufferLocation = bufferAllocation.gpuAddress;
 	viewDesc.SizeInBytes = static_cast<uint32_t>(bufferDesc.data.size() + D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT - 1u) &
 		~(D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT - 1u);
 
-	device->CreateConstantBufferView(&viewDesc, newConstantBuffer->cbvDescriptor.cpuDescriptor);
+	if (_descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV, newConstantBuffer->cbvDescriptor))
+		device->CreateConstantBufferView(&viewDesc, newConstantBuffer->cbvDescriptor.cpuDescriptor);
 
 	return static_cast<IResource*>(newConstantBuffer);
 }
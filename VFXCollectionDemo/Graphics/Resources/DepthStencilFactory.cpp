@@ -24,12 +24,10 @@ Graphics::Resources::IResource* Graphics::Resources::DepthStencilFactory::Create
 
 	textureDesc.format = textureDesc.depthBit == 32u ? DXGI_FORMAT_R32_TYPELESS : DXGI_FORMAT_R24G8_TYPELESS;
 
-	auto textureAllocation = _textureManager->Allocate(device, D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL, clearValue, textureDesc);
+	auto textureAllocation = _textureManager->Allocate(device, commandList, D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL, clearValue, textureDesc);
 
 	auto depthStencilTarget = new DepthStencilTarget;
 	std::swap(depthStencilTarget->resource, textureAllocation.resource);
-	depthStencilTarget->srvDescriptor = _descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV);
-	depthStencilTarget->dsvDescriptor = _descriptorManager->Allocate(DescriptorType::DSV);
 
 	textureDesc.format = textureDesc.depthBit == 32u ? DXGI_FORMAT_R32_FLOAT : DXGI_FORMAT_R24_UNORM_X8_TYPELESS;
 	auto srvDesc = DirectX12Utilities::CreateSRVDesc(textureDesc);
@@ -39,8 +37,10 @@ Graphics::Resources::IResource* Graphics::Resources::DepthStencilFactory::Create
 
 	auto resource = depthStencilTarget->resource->GetResource();
 
-	device->CreateShaderResourceView(resource, &srvDesc, depthStencilTarget->srvDescriptor.cpuDescriptor);
-	device->CreateDepthStencilView(resource, &dsvDesc, depthStencilTarget->dsvDescriptor.cpuDescriptor);
+	if (_descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV, depthStencilTarget->srvDescriptor))
+		device->CreateShaderResourceView(resource, &srvDesc, depthStencilTarget->srvDescriptor.cpuDescriptor);
+	if (_descriptorManager->Allocate(DescriptorType::DSV, depthStencilTarget->dsvDescriptor))
+		device->CreateDepthStencilView(resource, &dsvDesc, depthStencilTarget->dsvDescriptor.cpuDescriptor);
 
 	return static_cast<IResource*>(depthStencilTarget);
 }
@@ -83,6 +83,61 @@ void Graphics::Resources::GPUResource::UAVBarrier(ID3D12GraphicsCommandList* com
 	commandList->ResourceBarrier(1u, &barrier);
 }
 
+void Graphics::Resources::GPUResource::AliasingBarrier(ID3D12GraphicsCommandList* commandList, GPUResource* resourceBefore)
+{
+	D3D12_RESOURCE_BARRIER aliasingBarrier{};
+	GetAliasingBarrier(resourceBefore, aliasingBarrier);
+
+	commandList->ResourceBarrier(1u, &aliasingBarrier);
+}
+
+void Graphics::Resources::GPUResource::Barrier(BarrierBatch& batch, D3D12_RESOURCE_STATES newState)
+{
+	if (!batch.AddTransition(resource, currentState, newState, D3D12_RESOURCE_BARRIER_FLAG_NONE))
+		return;
+
+	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+	barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+	barrier.Transition.StateBefore = currentState;
+	barrier.Transition.StateAfter = newState;
+
+	currentState = newState;
+}
+
+void Graphics::Resources::GPUResource::BeginBarrier(BarrierBatch& batch, D3D12_RESOURCE_STATES newState)
+{
+	if (!batch.AddTransition(resource, currentState, newState, D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY))
+		return;
+
+	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+	barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
+	barrier.Transition.StateBefore = currentState;
+	barrier.Transition.StateAfter = newState;
+
+	currentState = newState;
+}
+
+void Graphics::Resources::GPUResource::EndBarrier(BarrierBatch& batch)
+{
+	if (barrier.Transition.StateBefore == currentState)
+		return;
+
+	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+	barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+
+	batch.AddTransition(resource, barrier.Transition.StateBefore, currentState, D3D12_RESOURCE_BARRIER_FLAG_END_ONLY);
+}
+
+void Graphics::Resources::GPUResource::UAVBarrier(BarrierBatch& batch)
+{
+	batch.AddUAV(resource);
+}
+
+void Graphics::Resources::GPUResource::AliasingBarrier(BarrierBatch& batch, GPUResource* resourceBefore)
+{
+	batch.AddAliasing(resourceBefore != nullptr ? resourceBefore->resource : nullptr, resource);
+}
+
 bool Graphics::Resources::GPUResource::GetBarrier(D3D12_RESOURCE_STATES newState, D3D12_RESOURCE_BARRIER& outBarrier)
 {
 	if (currentState == newState)
@@ -137,3 +192,11 @@ void Graphics::Resources::GPUResource::GetUAVBarrier(D3D12_RESOURCE_BARRIER& out
 
 	outBarrier = barrier;
 }
+
+void Graphics::Resources::GPUResource::GetAliasingBarrier(GPUResource* resourceBefore, D3D12_RESOURCE_BARRIER& outBarrier)
+{
+	outBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+	outBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+	outBarrier.Aliasing.pResourceBefore = resourceBefore != nullptr ? resourceBefore->resource : nullptr;
+	outBarrier.Aliasing.pResourceAfter = resource;
+}
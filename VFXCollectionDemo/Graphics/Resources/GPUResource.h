@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../DirectX12Includes.h"
+#include "BarrierBatch.h"
 
 namespace Graphics::Resources
 {
@@ -19,11 +20,19 @@ namespace Graphics::Resources
 		void BeginBarrier(ID3D12GraphicsCommandList* commandList, D3D12_RESOURCE_STATES newState);
 		void EndBarrier(ID3D12GraphicsCommandList* commandList);
 		void UAVBarrier(ID3D12GraphicsCommandList* commandList);
+		void AliasingBarrier(ID3D12GraphicsCommandList* commandList, GPUResource* resourceBefore);
+
+		void Barrier(BarrierBatch& batch, D3D12_RESOURCE_STATES newState);
+		void BeginBarrier(BarrierBatch& batch, D3D12_RESOURCE_STATES newState);
+		void EndBarrier(BarrierBatch& batch);
+		void UAVBarrier(BarrierBatch& batch);
+		void AliasingBarrier(BarrierBatch& batch, GPUResource* resourceBefore);
 
 		bool GetBarrier(D3D12_RESOURCE_STATES newState, D3D12_RESOURCE_BARRIER& outBarrier);
 		bool GetBeginBarrier(D3D12_RESOURCE_STATES newState, D3D12_RESOURCE_BARRIER& outBarrier);
 		bool GetEndBarrier(D3D12_RESOURCE_BARRIER& outBarrier);
 		void GetUAVBarrier(D3D12_RESOURCE_BARRIER& outBarrier);
+		void GetAliasingBarrier(GPUResource* resourceBefore, D3D12_RESOURCE_BARRIER& outBarrier);
 
 	private:
 		GPUResource() = delete;
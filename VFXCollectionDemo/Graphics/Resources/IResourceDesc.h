@@ -67,6 +67,8 @@ namespace Graphics::Resources
 		D3D12_RESOURCE_DIMENSION dimension;
 		D3D12_SRV_DIMENSION srvDimension;
 
+		uint32_t aliasingGroup;
+
 		std::vector<uint8_t> data;
 	};
 }
@@ -39,16 +39,14 @@ Graphics::Resources::IResource* Graphics::Resources::RWBufferFactory::CreateReso
 	rwBuffer->counterResource = nullptr;
 	rwBuffer->size = bufferAllocation.size;
 	rwBuffer->resourceGPUAddress = bufferAllocation.gpuAddress;
-	rwBuffer->srvDescriptor = _descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV);
-	rwBuffer->uavDescriptor = _descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV);
 	rwBuffer->uavNonShaderVisibleDescriptor = {};
 	auto srvDesc = DirectX12Utilities::CreateSRVDesc(bufferDesc);
 	auto uavDesc = DirectX12Utilities::CreateUAVDesc(bufferDesc);
 	
 	if (bufferDesc.flag == BufferFlag::RAW)
 	{
-		rwBuffer->uavNonShaderVisibleDescriptor = _descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV_NON_SHADER_VISIBLE);
-		device->CreateUnorderedAccessView(destResource, nullptr, &uavDesc, rwBuffer->uavNonShaderVisibleDescriptor.cpuDescriptor);
+		if (_descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV_NON_SHADER_VISIBLE, rwBuffer->uavNonShaderVisibleDescriptor))
+			device->CreateUnorderedAccessView(destResource, nullptr, &uavDesc, rwBuffer->uavNonShaderVisibleDescriptor.cpuDescriptor);
 	}
 	else if (bufferDesc.flag == BufferFlag::ADD_COUNTER)
 	{
@@ -56,8 +54,10 @@ Graphics::Resources::IResource* Graphics::Resources::RWBufferFactory::CreateReso
 		rwBuffer->counterResource = counterAllocation.resource;
 	}
 
-	device->CreateShaderResourceView(destResource, &srvDesc, rwBuffer->srvDescriptor.cpuDescriptor);
-	device->CreateUnorderedAccessView(destResource, nullptr, &uavDesc, rwBuffer->uavDescriptor.cpuDescriptor);
+	if (_descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV, rwBuffer->srvDescriptor))
+		device->CreateShaderResourceView(destResource, &srvDesc, rwBuffer->srvDescriptor.cpuDescriptor);
+	if (_descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV, rwBuffer->uavDescriptor))
+		device->CreateUnorderedAccessView(destResource, nullptr, &uavDesc, rwBuffer->uavDescriptor.cpuDescriptor);
 	
 	return static_cast<IResource*>(rwBuffer);
 }
@@ -19,21 +19,21 @@ Graphics::Resources::IResource* Graphics::Resources::RWTextureFactory::CreateRes
 	D3D12_CLEAR_VALUE clearValue{};
 	clearValue.Format = textureDesc.format;
 
-	auto textureAllocation = _textureManager->Allocate(device, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS, clearValue, textureDesc);
+	auto textureAllocation = _textureManager->Allocate(device, commandList, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS, clearValue, textureDesc);
 	
 	auto rwTexture = new RWTexture;
 	std::swap(rwTexture->resource, textureAllocation.resource);
-	rwTexture->srvDescriptor = _descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV);
-	rwTexture->uavDescriptor = _descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV);
-	rwTexture->uavNonShaderVisibleDescriptor = _descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV_NON_SHADER_VISIBLE);
 	auto srvDesc = DirectX12Utilities::CreateSRVDesc(textureDesc);
 	auto uavDesc = DirectX12Utilities::CreateUAVDesc(textureDesc);
 	
 	auto resource = rwTexture->resource->GetResource();
 
-	device->CreateShaderResourceView(resource, &srvDesc, rwTexture->srvDescriptor.cpuDescriptor);
-	device->CreateUnorderedAccessView(resource, nullptr, &uavDesc, rwTexture->uavDescriptor.cpuDescriptor);
-	device->CreateUnorderedAccessView(resource, nullptr, &uavDesc, rwTexture->uavNonShaderVisibleDescriptor.cpuDescriptor);
+	if (_descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV, rwTexture->srvDescriptor))
+		device->CreateShaderResourceView(resource, &srvDesc, rwTexture->srvDescriptor.cpuDescriptor);
+	if (_descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV, rwTexture->uavDescriptor))
+		device->CreateUnorderedAccessView(resource, nullptr, &uavDesc, rwTexture->uavDescriptor.cpuDescriptor);
+	if (_descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV_NON_SHADER_VISIBLE, rwTexture->uavNonShaderVisibleDescriptor))
+		device->CreateUnorderedAccessView(resource, nullptr, &uavDesc, rwTexture->uavNonShaderVisibleDescriptor.cpuDescriptor);
 
 	return static_cast<IResource*>(rwTexture);
 }
@@ -19,19 +19,19 @@ Graphics::Resources::IResource* Graphics::Resources::RenderTargetFactory::Create
 	D3D12_CLEAR_VALUE clearValue{};
 	clearValue.Format = textureDesc.format;
 	
-	auto textureAllocation = _textureManager->Allocate(device, D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET, clearValue, textureDesc);
+	auto textureAllocation = _textureManager->Allocate(device, commandList, D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET, clearValue, textureDesc);
 
 	auto renderTarget = new RenderTarget;
 	std::swap(renderTarget->resource, textureAllocation.resource);
-	renderTarget->srvDescriptor = _descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV);
-	renderTarget->rtvDescriptor = _descriptorManager->Allocate(DescriptorType::RTV);
 	auto srvDesc = DirectX12Utilities::CreateSRVDesc(textureDesc);
 	auto rtvDesc = DirectX12Utilities::CreateRTVDesc(textureDesc);
 	
 	auto resource = renderTarget->resource->GetResource();
 
-	device->CreateShaderResourceView(resource, &srvDesc, renderTarget->srvDescriptor.cpuDescriptor);
-	device->CreateRenderTargetView(resource, &rtvDesc, renderTarget->rtvDescriptor.cpuDescriptor);
+	if (_descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV, renderTarget->srvDescriptor))
+		device->CreateShaderResourceView(resource, &srvDesc, renderTarget->srvDescriptor.cpuDescriptor);
+	if (_descriptorManager->Allocate(DescriptorType::RTV, renderTarget->rtvDescriptor))
+		device->CreateRenderTargetView(resource, &rtvDesc, renderTarget->rtvDescriptor.cpuDescriptor);
 
 	return static_cast<IResource*>(renderTarget);
 }
@@ -11,8 +11,9 @@
 #include "../DirectX12Utilities.h"
 
 Graphics::Resources::ResourceManager::ResourceManager(DescriptorManager* descriptorManager, BufferManager* bufferManager,
-	TextureManager* textureManager)
-	: _bufferManager(bufferManager), _textureManager(textureManager), _descriptorManager(descriptorManager)
+	TextureManager* textureManager, DeferredReleaseQueue* deferredReleaseQueue)
+	: _bufferManager(bufferManager), _textureManager(textureManager), _descriptorManager(descriptorManager),
+	_deferredReleaseQueue(deferredReleaseQueue)
 {
 	bufferFactories[EnumValue(BufferResourceType::BUFFER)] = new BufferFactory(_bufferManager, _descriptorManager);
 	bufferFactories[EnumValue(BufferResourceType::CONSTANT_BUFFER)] = new ConstantBufferFactory(_bufferManager, _descriptorManager);
@@ -28,9 +29,8 @@ Graphics::Resources::ResourceManager::ResourceManager(DescriptorManager* descrip
 
 Graphics::Resources::ResourceManager::~ResourceManager()
 {
-	for (auto& resource : resources)
-		if (resource != nullptr)
-			delete resource;
+	for (auto resource : resources)
+		delete resource;
 }
 
 Graphics::Resources::ResourceID Graphics::Resources::ResourceManager::CreateBufferResource(ID3D12Device* device,
@@ -39,19 +39,7 @@ Graphics::Resources::ResourceID Graphics::Resources::ResourceManager::CreateBuff
 	auto resourceDesc = static_cast<const IResourceDesc*>(&desc);
 	auto resource = bufferFactories[EnumValue(type)]->CreateResource(device, commandList, resourceDesc);
 
-	auto id = static_cast<ResourceID>(resources.size());
-
-	if (freeSlots.empty())
-		resources.push_back(std::move(resource));
-	else
-	{
-		id = freeSlots.front();
-		freeSlots.pop();
-
-		resources[id] = resource;
-	}
-
-	return id;
+	return resources.Insert(resource);
 }
 
 Graphics::Resources::ResourceID Graphics::Resources::ResourceManager::CreateTextureResource(ID3D12Device* device,
@@ -60,43 +48,19 @@ Graphics::Resources::ResourceID Graphics::Resources::ResourceManager::CreateText
 	auto resourceDesc = static_cast<const IResourceDesc*>(&desc);
 	auto resource = textureFactories[EnumValue(type)]->CreateResource(device, commandList, resourceDesc);
 	
-	auto id = static_cast<ResourceID>(resources.size());
-
-	if (freeSlots.empty())
-		resources.push_back(std::move(resource));
-	else
-	{
-		id = freeSlots.front();
-		freeSlots.pop();
-
-		resources[id] = resource;
-	}
-
-	return id;
+	return resources.Insert(resource);
 }
 
 Graphics::Resources::ResourceID Graphics::Resources::ResourceManager::CreateSamplerResource(ID3D12Device* device,
 	D3D12_SAMPLER_DESC desc)
 {
 	auto newSampler = new Sampler;
-	newSampler->samplerDescriptor = _descriptorManager->Allocate(DescriptorType::SAMPLER);
 	newSampler->samplerDesc = desc;
 
-	device->CreateSampler(&desc, newSampler->samplerDescriptor.cpuDescriptor);
-
-	auto id = static_cast<ResourceID>(resources.size());
+	if (_descriptorManager->Allocate(DescriptorType::SAMPLER, newSampler->samplerDescriptor))
+		device->CreateSampler(&desc, newSampler->samplerDescriptor.cpuDescriptor);
 
-	if (freeSlots.empty())
-		resources.push_back(std::move(newSampler));
-	else
-	{
-		id = freeSlots.front();
-		freeSlots.pop();
-
-		resources[id] = newSampler;
-	}
-
-	return id;
+	return resources.Insert(newSampler);
 }
 
 Graphics::Resources::ResourceID Graphics::Resources::ResourceManager::CreateShaderResource(ID3D12Device* device,
@@ -106,19 +70,7 @@ Graphics::Resources::ResourceID Graphics::Resources::ResourceManager::CreateShad
 	auto newShader = new Shader;
 	newShader->bytecode = Assets::Loaders::HLSLLoader::Load(filePath, type, version, defines);
 
-	auto id = static_cast<ResourceID>(resources.size());
-
-	if (freeSlots.empty())
-		resources.push_back(std::move(newShader));
-	else
-	{
-		id = freeSlots.front();
-		freeSlots.pop();
-
-		resources[id] = newShader;
-	}
-
-	return id;
+	return resources.Insert(newShader);
 }
 
 Graphics::Resources::Sampler* Graphics::Resources::ResourceManager::GetDefaultSampler(ID3D12Device* device,
@@ -137,3 +89,9 @@ Graphics::Resources::Sampler* Graphics::Resources::ResourceManager::GetDefaultSa
 
 	return GetResource<Sampler>(samplerId);
 }
+
+uint32_t Graphics::Resources::ResourceManager::GetBindlessIndex(DescriptorType type,
+	const DescriptorAllocation& descriptor) const
+{
+	return _descriptorManager->GetDescriptorIndex(type, descriptor);
+}
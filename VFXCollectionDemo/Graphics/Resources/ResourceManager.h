@@ -6,17 +6,21 @@
 #include "../DescriptorManager.h"
 #include "../BufferManager.h"
 #include "../TextureManager.h"
+#include "../DeferredReleaseQueue.h"
 #include "../Assets/Loaders/HLSLLoader.h"
 #include "IResource.h"
 #include "IResourceDesc.h"
 #include "IResourceFactory.h"
+#include "SlotMap.h"
+
+#include <cassert>
 
 namespace Graphics::Resources
 {
 	template<typename T>
 	concept ResourceType = std::derived_from<T, IResource>;
 
-	using ResourceID = uint32_t;
+	using ResourceID = SlotHandle;
 
 	enum class BufferResourceType : uint32_t
 	{
@@ -38,7 +42,8 @@ namespace Graphics::Resources
 	class ResourceManager
 	{
 	public:
-		ResourceManager(DescriptorManager* descriptorManager, BufferManager* bufferManager, TextureManager* textureManager);
+		ResourceManager(DescriptorManager* descriptorManager, BufferManager* bufferManager, TextureManager* textureManager,
+			DeferredReleaseQueue* deferredReleaseQueue);
 		~ResourceManager();
 
 		ResourceID CreateBufferResource(ID3D12Device* device, ID3D12GraphicsCommandList* commandList,
@@ -55,17 +60,65 @@ namespace Graphics::Resources
 		Sampler* GetDefaultSampler(ID3D12Device* device, Graphics::DefaultFilterSetup filter,
 			Graphics::DefaultFilterComparisonFunc comparisonFunc = Graphics::DefaultFilterComparisonFunc::COMPARISON_NEVER);
 
+		uint32_t GetBindlessIndex(DescriptorType type, const DescriptorAllocation& descriptor) const;
+
 		template<ResourceType T>
 		T* GetResource(ResourceID id)
 		{
-			return static_cast<T*>(resources[id]);
+			auto resource = resources.Get(id);
+
+			if (resource == nullptr)
+			{
+#ifdef _DEBUG
+				OutputDebugStringA("ResourceManager::GetResource: stale or invalid resource handle\n");
+				assert(!"ResourceManager::GetResource: stale or invalid resource handle");
+#endif
+				return nullptr;
+			}
+
+#ifdef _DEBUG
+			if (dynamic_cast<T*>(*resource) == nullptr)
+			{
+				OutputDebugStringA("ResourceManager::GetResource: resource handle refers to another resource type\n");
+				assert(!"ResourceManager::GetResource: resource handle refers to another resource type");
+			}
+#endif
+
+			return static_cast<T*>(*resource);
 		}
 
 		template<ResourceType T>
 		void DeleteResource(ResourceID id)
 		{
-			auto resource = static_cast<T*>(resources[id]);
+			auto storedResource = resources.Get(id);
+
+			if (storedResource == nullptr)
+				return;
+
+#ifdef _DEBUG
+			assert(dynamic_cast<T*>(*storedResource) != nullptr &&
+				"ResourceManager::DeleteResource: resource handle refers to another resource type");
+#endif
+
+			auto resource = static_cast<T*>(*storedResource);
+			resources.Erase(id);
 
+			_deferredReleaseQueue->Enqueue([this, resource]()
+				{
+					ReleaseResource<T>(resource);
+				});
+		}
+
+	private:
+		ResourceManager() = delete;
+		ResourceManager(const ResourceManager&) = delete;
+		ResourceManager(ResourceManager&&) = delete;
+		ResourceManager& operator=(const ResourceManager&) = delete;
+		ResourceManager& operator=(ResourceManager&&) = delete;
+
+		template<ResourceType T>
+		void ReleaseResource(T* resource)
+		{
 			if constexpr (std::is_same_v<T, Buffer> || std::is_same_v<T, DepthStencilTarget> ||
 				std::is_same_v<T, RenderTarget> || std::is_same_v<T, RWBuffer> ||
 				std::is_same_v<T, RWTexture> || std::is_same_v<T, Texture>)
@@ -96,19 +149,9 @@ namespace Graphics::Resources
 				std::is_same_v<T, RWTexture> || std::is_same_v<T, Texture>)
 				_textureManager->Deallocate(resource->resource);
 
-			delete resources[id];
-			resources[id] = nullptr;
-
-			freeSlots.push(id);
+			delete resource;
 		}
 
-	private:
-		ResourceManager() = delete;
-		ResourceManager(const ResourceManager&) = delete;
-		ResourceManager(ResourceManager&&) = delete;
-		ResourceManager& operator=(const ResourceManager&) = delete;
-		ResourceManager& operator=(ResourceManager&&) = delete;
-
 		template<typename T>
 		constexpr std::underlying_type_t<T> EnumValue(T value)
 		{
@@ -118,8 +161,7 @@ namespace Graphics::Resources
 		static constexpr size_t BUFFER_RESOURCE_TYPES_NUMBER = 5u;
 		static constexpr size_t TEXTURE_RESOURCE_TYPES_NUMBER = 4u;
 
-		std::vector<IResource*> resources;
-		std::queue<ResourceID> freeSlots;
+		SlotMap<IResource*> resources;
 
 		std::map<Graphics::DefaultFilterSetup, ResourceID> defaultSamplers;
 
@@ -129,5 +171,6 @@ namespace Graphics::Resources
 		BufferManager* _bufferManager;
 		TextureManager* _textureManager;
 		DescriptorManager* _descriptorManager;
+		DeferredReleaseQueue* _deferredReleaseQueue;
 	};
 }
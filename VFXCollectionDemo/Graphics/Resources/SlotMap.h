@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Graphics::Resources
+{
+	struct SlotHandle
+	{
+	public:
+		uint32_t index;
+		uint32_t generation;
+
+		bool operator==(const SlotHandle& other) const = default;
+	};
+
+	template<typename T>
+	class SlotMap final
+	{
+	public:
+		SlotMap() = default;
+		~SlotMap() = default;
+
+		SlotHandle Insert(const T& value)
+		{
+			uint32_t slotIndex = 0u;
+
+			if (freeSlots.empty())
+			{
+				slotIndex = static_cast<uint32_t>(slots.size());
+				slots.push_back({ INVALID_INDEX, FIRST_GENERATION });
+			}
+			else
+			{
+				slotIndex = freeSlots.back();
+				freeSlots.pop_back();
+			}
+
+			auto& slot = slots[slotIndex];
+			slot.denseIndex = static_cast<uint32_t>(values.size());
+
+			values.push_back(value);
+			valueSlots.push_back(slotIndex);
+
+			return { slotIndex, slot.generation };
+		}
+
+		bool Contains(SlotHandle handle) const noexcept
+		{
+			return handle.index < slots.size() && slots[handle.index].generation == handle.generation &&
+				slots[handle.index].denseIndex != INVALID_INDEX;
+		}
+
+		T* Get(SlotHandle handle) noexcept
+		{
+			return Contains(handle) ? &values[slots[handle.index].denseIndex] : nullptr;
+		}
+
+		const T* Get(SlotHandle handle) const noexcept
+		{
+			return Contains(handle) ? &values[slots[handle.index].denseIndex] : nullptr;
+		}
+
+		bool Erase(SlotHandle handle)
+		{
+			if (!Contains(handle))
+				return false;
+
+			auto& slot = slots[handle.index];
+			auto denseIndex = slot.denseIndex;
+			auto lastIndex = static_cast<uint32_t>(values.size() - 1u);
+
+			if (denseIndex != lastIndex)
+			{
+				values[denseIndex] = std::move(values[lastIndex]);
+				valueSlots[denseIndex] = valueSlots[lastIndex];
+				slots[valueSlots[denseIndex]].denseIndex = denseIndex;
+			}
+
+			values.pop_back();
+			valueSlots.pop_back();
+
+			slot.denseIndex = INVALID_INDEX;
+			slot.generation = slot.generation == UINT32_MAX ? FIRST_GENERATION : slot.generation + 1u;
+
+			freeSlots.push_back(handle.index);
+
+			return true;
+		}
+
+		void Clear()
+		{
+			for (uint32_t slotIndex : valueSlots)
+			{
+				auto& slot = slots[slotIndex];
+				slot.denseIndex = INVALID_INDEX;
+				slot.generation = slot.generation == UINT32_MAX ? FIRST_GENERATION : slot.generation + 1u;
+
+				freeSlots.push_back(slotIndex);
+			}
+
+			values.clear();
+			valueSlots.clear();
+		}
+
+		size_t Size() const noexcept
+		{
+			return values.size();
+		}
+
+		typename std::vector<T>::iterator begin() noexcept
+		{
+			return values.begin();
+		}
+
+		typename std::vector<T>::iterator end() noexcept
+		{
+			return values.end();
+		}
+
+		typename std::vector<T>::const_iterator begin() const noexcept
+		{
+			return values.begin();
+		}
+
+		typename std::vector<T>::const_iterator end() const noexcept
+		{
+			return values.end();
+		}
+
+		static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+	private:
+		SlotMap(const SlotMap&) = delete;
+		SlotMap(SlotMap&&) = delete;
+		SlotMap& operator=(const SlotMap&) = delete;
+		SlotMap& operator=(SlotMap&&) = delete;
+
+		static constexpr uint32_t FIRST_GENERATION = 1u;
+
+		struct Slot
+		{
+		public:
+			uint32_t denseIndex;
+			uint32_t generation;
+		};
+
+		std::vector<T> values;
+		std::vector<uint32_t> valueSlots;
+		std::vector<Slot> slots;
+		std::vector<uint32_t> freeSlots;
+	};
+}
@@ -19,7 +19,7 @@ Graphics::Resources::IResource* Graphics::Resources::TextureFactory::CreateResou
 	D3D12_CLEAR_VALUE clearValue{};
 	clearValue.Format = textureDesc.format;
 
-	auto textureAllocation = _textureManager->Allocate(device, D3D12_RESOURCE_FLAG_NONE, clearValue, textureDesc);
+	auto textureAllocation = _textureManager->Allocate(device, commandList, D3D12_RESOURCE_FLAG_NONE, clearValue, textureDesc);
 	auto uploadTextureAllocation = _textureManager->AllocateUploadBuffer(device, D3D12_RESOURCE_FLAG_NONE, clearValue, textureDesc);
 
 	textureAllocation.resource->Barrier(commandList, D3D12_RESOURCE_STATE_COPY_DEST);
@@ -32,10 +32,10 @@ Graphics::Resources::IResource* Graphics::Resources::TextureFactory::CreateResou
 
 	auto texture = new Texture;
 	std::swap(texture->resource, textureAllocation.resource);
-	texture->srvDescriptor = _descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV);
 	auto srvDesc = DirectX12Utilities::CreateSRVDesc(textureDesc);
 
-	device->CreateShaderResourceView(destResource, &srvDesc, texture->srvDescriptor.cpuDescriptor);
+	if (_descriptorManager->Allocate(DescriptorType::CBV_SRV_UAV, texture->srvDescriptor))
+		device->CreateShaderResourceView(destResource, &srvDesc, texture->srvDescriptor.cpuDescriptor);
 
 	return static_cast<IResource*>(texture);
 }
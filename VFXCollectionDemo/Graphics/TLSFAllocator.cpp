@@ -0,0 +1,281 @@
+#include "TLSFAllocator.h"
+#include <bit>
+#include <algorithm>
+
+Graphics::TLSFAllocator::TLSFAllocator()
+	: TLSFAllocator(0u, 1u)
+{
+
+}
+
+Graphics::TLSFAllocator::TLSFAllocator(uint64_t capacity, uint64_t alignment)
+	: _alignment(std::max(alignment, uint64_t{ 1u })), _capacity{}, usedSize{}, firstLevelBitmap{}, secondLevelBitmaps{}
+{
+	for (auto& secondLevelLists : freeLists)
+		secondLevelLists.fill(INVALID_INDEX);
+
+	_capacity = capacity / _alignment * _alignment;
+
+	if (_capacity > 0u)
+		InsertFreeBlock(CreateBlock(0u, _capacity));
+}
+
+Graphics::TLSFAllocator::~TLSFAllocator()
+{
+
+}
+
+bool Graphics::TLSFAllocator::Allocate(uint64_t size, uint64_t& offset)
+{
+	auto alignedSize = (std::max(size, uint64_t{ 1u }) + _alignment - 1u) / _alignment * _alignment;
+
+	if (alignedSize > _capacity - usedSize)
+		return false;
+
+	auto blockIndex = FindFreeBlock(alignedSize / _alignment);
+
+	if (blockIndex == INVALID_INDEX)
+		return false;
+
+	RemoveFreeBlock(blockIndex);
+
+	if (blocks[blockIndex].size > alignedSize)
+	{
+		auto remainderIndex = CreateBlock(blocks[blockIndex].offset + alignedSize, blocks[blockIndex].size - alignedSize);
+		auto nextIndex = blocks[blockIndex].nextPhysical;
+
+		blocks[remainderIndex].previousPhysical = blockIndex;
+		blocks[remainderIndex].nextPhysical = nextIndex;
+
+		if (nextIndex != INVALID_INDEX)
+			blocks[nextIndex].previousPhysical = remainderIndex;
+
+		blocks[blockIndex].nextPhysical = remainderIndex;
+		blocks[blockIndex].size = alignedSize;
+
+		InsertFreeBlock(remainderIndex);
+	}
+
+	offset = blocks[blockIndex].offset;
+	usedSize += alignedSize;
+	allocatedBlocks[offset] = blockIndex;
+
+	return true;
+}
+
+bool Graphics::TLSFAllocator::Deallocate(uint64_t offset)
+{
+	auto blockIterator = allocatedBlocks.find(offset);
+
+	if (blockIterator == allocatedBlocks.end())
+		return false;
+
+	auto blockIndex = blockIterator->second;
+	allocatedBlocks.erase(blockIterator);
+
+	usedSize -= blocks[blockIndex].size;
+
+	auto nextIndex = blocks[blockIndex].nextPhysical;
+
+	if (nextIndex != INVALID_INDEX && blocks[nextIndex].isFree)
+	{
+		RemoveFreeBlock(nextIndex);
+
+		blocks[blockIndex].size += blocks[nextIndex].size;
+		blocks[blockIndex].nextPhysical = blocks[nextIndex].nextPhysical;
+
+		if (blocks[blockIndex].nextPhysical != INVALID_INDEX)
+			blocks[blocks[blockIndex].nextPhysical].previousPhysical = blockIndex;
+
+		ReleaseBlock(nextIndex);
+	}
+
+	auto previousIndex = blocks[blockIndex].previousPhysical;
+
+	if (previousIndex != INVALID_INDEX && blocks[previousIndex].isFree)
+	{
+		RemoveFreeBlock(previousIndex);
+
+		blocks[previousIndex].size += blocks[blockIndex].size;
+		blocks[previousIndex].nextPhysical = blocks[blockIndex].nextPhysical;
+
+		if (blocks[previousIndex].nextPhysical != INVALID_INDEX)
+			blocks[blocks[previousIndex].nextPhysical].previousPhysical = previousIndex;
+
+		ReleaseBlock(blockIndex);
+		blockIndex = previousIndex;
+	}
+
+	InsertFreeBlock(blockIndex);
+
+	return true;
+}
+
+bool Graphics::TLSFAllocator::IsEmpty() const noexcept
+{
+	return allocatedBlocks.empty();
+}
+
+uint64_t Graphics::TLSFAllocator::GetCapacity() const noexcept
+{
+	return _capacity;
+}
+
+Graphics::TLSFStatistics Graphics::TLSFAllocator::GetStatistics() const
+{
+	TLSFStatistics statistics{};
+	statistics.capacity = _capacity;
+	statistics.usedSize = usedSize;
+	statistics.allocationsNumber = static_cast<uint32_t>(allocatedBlocks.size());
+
+	for (const auto& block : blocks)
+	{
+		if (!block.isFree)
+			continue;
+
+		statistics.freeBlocksNumber++;
+		statistics.largestFreeBlock = std::max(statistics.largestFreeBlock, block.size);
+	}
+
+	return statistics;
+}
+
+void Graphics::TLSFAllocator::Mapping(uint64_t units, uint32_t& firstLevel, uint32_t& secondLevel) const noexcept
+{
+	if (units < SL_INDEX_COUNT)
+	{
+		firstLevel = 0u;
+		secondLevel = static_cast<uint32_t>(units);
+
+		return;
+	}
+
+	auto mostSignificantBit = static_cast<uint32_t>(std::bit_width(units)) - 1u;
+
+	firstLevel = mostSignificantBit - SL_INDEX_COUNT_LOG2 + 1u;
+	secondLevel = static_cast<uint32_t>(units >> (mostSignificantBit - SL_INDEX_COUNT_LOG2)) ^ SL_INDEX_COUNT;
+}
+
+uint32_t Graphics::TLSFAllocator::FindFreeBlock(uint64_t units) const noexcept
+{
+	if (units >= SL_INDEX_COUNT)
+	{
+		auto mostSignificantBit = static_cast<uint32_t>(std::bit_width(units)) - 1u;
+		units += (1ull << (mostSignificantBit - SL_INDEX_COUNT_LOG2)) - 1u;
+	}
+
+	uint32_t firstLevel = 0u;
+	uint32_t secondLevel = 0u;
+	Mapping(units, firstLevel, secondLevel);
+
+	if (firstLevel >= FL_INDEX_COUNT)
+		return INVALID_INDEX;
+
+	auto secondLevelBitmap = secondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+
+	if (secondLevelBitmap == 0u)
+	{
+		auto firstLevelBitmap = firstLevel + 1u < 64u ? this->firstLevelBitmap & (~0ull << (firstLevel + 1u)) : 0ull;
+
+		if (firstLevelBitmap == 0u)
+			return INVALID_INDEX;
+
+		firstLevel = static_cast<uint32_t>(std::countr_zero(firstLevelBitmap));
+		secondLevelBitmap = secondLevelBitmaps[firstLevel];
+	}
+
+	secondLevel = static_cast<uint32_t>(std::countr_zero(secondLevelBitmap));
+
+	return freeLists[firstLevel][secondLevel];
+}
+
+void Graphics::TLSFAllocator::InsertFreeBlock(uint32_t blockIndex)
+{
+	uint32_t firstLevel = 0u;
+	uint32_t secondLevel = 0u;
+	Mapping(blocks[blockIndex].size / _alignment, firstLevel, secondLevel);
+
+	auto headIndex = freeLists[firstLevel][secondLevel];
+
+	auto& block = blocks[blockIndex];
+	block.isFree = true;
+	block.previousFree = INVALID_INDEX;
+	block.nextFree = headIndex;
+
+	if (headIndex != INVALID_INDEX)
+		blocks[headIndex].previousFree = blockIndex;
+
+	freeLists[firstLevel][secondLevel] = blockIndex;
+	firstLevelBitmap |= 1ull << firstLevel;
+	secondLevelBitmaps[firstLevel] |= 1u << secondLevel;
+}
+
+void Graphics::TLSFAllocator::RemoveFreeBlock(uint32_t blockIndex)
+{
+	uint32_t firstLevel = 0u;
+	uint32_t secondLevel = 0u;
+	Mapping(blocks[blockIndex].size / _alignment, firstLevel, secondLevel);
+
+	auto& block = blocks[blockIndex];
+	block.isFree = false;
+
+	if (block.previousFree != INVALID_INDEX)
+		blocks[block.previousFree].nextFree = block.nextFree;
+
+	if (block.nextFree != INVALID_INDEX)
+		blocks[block.nextFree].previousFree = block.previousFree;
+
+	if (freeLists[firstLevel][secondLevel] == blockIndex)
+	{
+		freeLists[firstLevel][secondLevel] = block.nextFree;
+
+		if (block.nextFree == INVALID_INDEX)
+		{
+			secondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+
+			if (secondLevelBitmaps[firstLevel] == 0u)
+				firstLevelBitmap &= ~(1ull << firstLevel);
+		}
+	}
+
+	block.previousFree = INVALID_INDEX;
+	block.nextFree = INVALID_INDEX;
+}
+
+uint32_t Graphics::TLSFAllocator::CreateBlock(uint64_t offset, uint64_t size)
+{
+	uint32_t blockIndex = 0u;
+
+	if (unusedBlocks.empty())
+	{
+		blockIndex = static_cast<uint32_t>(blocks.size());
+		blocks.emplace_back();
+	}
+	else
+	{
+		blockIndex = unusedBlocks.back();
+		unusedBlocks.pop_back();
+	}
+
+	auto& block = blocks[blockIndex];
+	block.offset = offset;
+	block.size = size;
+	block.previousPhysical = INVALID_INDEX;
+	block.nextPhysical = INVALID_INDEX;
+	block.previousFree = INVALID_INDEX;
+	block.nextFree = INVALID_INDEX;
+	block.isFree = false;
+
+	return blockIndex;
+}
+
+void Graphics::TLSFAllocator::ReleaseBlock(uint32_t blockIndex)
+{
+	auto& block = blocks[blockIndex];
+	block.size = 0u;
+	block.isFree = false;
+	block.previousPhysical = INVALID_INDEX;
+	block.nextPhysical = INVALID_INDEX;
+
+	unusedBlocks.push_back(blockIndex);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <unordered_map>
+
+namespace Graphics
+{
+	struct TLSFStatistics
+	{
+	public:
+		uint64_t capacity;
+		uint64_t usedSize;
+		uint64_t largestFreeBlock;
+		uint32_t allocationsNumber;
+		uint32_t freeBlocksNumber;
+	};
+
+	class TLSFAllocator final
+	{
+	public:
+		TLSFAllocator();
+		TLSFAllocator(uint64_t capacity, uint64_t alignment);
+		~TLSFAllocator();
+
+		TLSFAllocator(TLSFAllocator&&) = default;
+		TLSFAllocator& operator=(TLSFAllocator&&) = default;
+
+		bool Allocate(uint64_t size, uint64_t& offset);
+		bool Deallocate(uint64_t offset);
+
+		bool IsEmpty() const noexcept;
+		uint64_t GetCapacity() const noexcept;
+		TLSFStatistics GetStatistics() const;
+
+		static constexpr uint32_t SL_INDEX_COUNT_LOG2 = 4u;
+		static constexpr uint32_t SL_INDEX_COUNT = 1u << SL_INDEX_COUNT_LOG2;
+		static constexpr uint32_t FL_INDEX_COUNT = 64u - SL_INDEX_COUNT_LOG2 + 1u;
+		static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+	private:
+		TLSFAllocator(const TLSFAllocator&) = delete;
+		TLSFAllocator& operator=(const TLSFAllocator&) = delete;
+
+		struct Block
+		{
+		public:
+			uint64_t offset;
+			uint64_t size;
+			uint32_t previousPhysical;
+			uint32_t nextPhysical;
+			uint32_t previousFree;
+			uint32_t nextFree;
+			bool isFree;
+		};
+
+		void Mapping(uint64_t units, uint32_t& firstLevel, uint32_t& secondLevel) const noexcept;
+		uint32_t FindFreeBlock(uint64_t units) const noexcept;
+
+		void InsertFreeBlock(uint32_t blockIndex);
+		void RemoveFreeBlock(uint32_t blockIndex);
+
+		uint32_t CreateBlock(uint64_t offset, uint64_t size);
+		void ReleaseBlock(uint32_t blockIndex);
+
+		uint64_t _alignment;
+		uint64_t _capacity;
+		uint64_t usedSize;
+
+		uint64_t firstLevelBitmap;
+		std::array<uint32_t, FL_INDEX_COUNT> secondLevelBitmaps;
+		std::array<std::array<uint32_t, SL_INDEX_COUNT>, FL_INDEX_COUNT> freeLists;
+
+		std::vector<Block> blocks;
+		std::vector<uint32_t> unusedBlocks;
+		std::unordered_map<uint64_t, uint32_t> allocatedBlocks;
+	};
+}
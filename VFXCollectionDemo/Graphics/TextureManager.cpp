@@ -1,6 +1,7 @@
 #include "TextureManager.h"
 
-Graphics::TextureManager::TextureManager()
+Graphics::TextureManager::TextureManager(HeapManager* heapManager)
+	: _heapManager(heapManager)
 {
 
 }
@@ -13,8 +14,8 @@ Graphics::TextureManager::~TextureManager()
 	ReleaseTempBuffers();
 }
 
-Graphics::TextureAllocation Graphics::TextureManager::Allocate(ID3D12Device* device, D3D12_RESOURCE_FLAGS resourceFlags,
-	const D3D12_CLEAR_VALUE& clearValue, const Resources::TextureDesc& desc)
+Graphics::TextureAllocation Graphics::TextureManager::Allocate(ID3D12Device* device, ID3D12GraphicsCommandList* commandList,
+	D3D12_RESOURCE_FLAGS resourceFlags, const D3D12_CLEAR_VALUE& clearValue, const Resources::TextureDesc& desc)
 {
 	D3D12_HEAP_PROPERTIES heapProperties{};
 	heapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
@@ -44,10 +45,18 @@ Graphics::TextureAllocation Graphics::TextureManager::Allocate(ID3D12Device* dev
 
 	TextureAllocation allocation{};
 
+	auto isTarget = initState != D3D12_RESOURCE_STATE_COMMON;
 	ID3D12Resource* resource = nullptr;
 
-	device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, initState, clearValuePtr,
-		IID_PPV_ARGS(&resource));
+	if (!isTarget || commandList != nullptr)
+		resource = _heapManager->CreateResource(device, D3D12_HEAP_TYPE_DEFAULT, resourceDesc, initState, clearValuePtr,
+			desc.aliasingGroup);
+
+	if (resource == nullptr)
+		device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, initState, clearValuePtr,
+			IID_PPV_ARGS(&resource));
+	else if (isTarget)
+		commandList->DiscardResource(resource, nullptr);
 
 	allocation.resource = new Resources::GPUResource(resource, initState);
 
@@ -91,10 +100,11 @@ Graphics::TextureAllocation Graphics::TextureManager::AllocateUploadBuffer(ID3D1
 
 	TextureAllocation allocation{};
 
-	ID3D12Resource* resource = nullptr;
+	auto resource = _heapManager->CreateResource(device, D3D12_HEAP_TYPE_UPLOAD, resourceDesc, initState, nullptr);
 
-	device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, initState, nullptr,
-		IID_PPV_ARGS(&resource));
+	if (resource == nullptr)
+		device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc, initState, nullptr,
+			IID_PPV_ARGS(&resource));
 
 	allocation.resource = new Resources::GPUResource(resource, initState);
 	allocation.cpuAddress = allocation.resource->Map();
@@ -109,7 +119,11 @@ void Graphics::TextureManager::Deallocate(Resources::GPUResource* allocatedResou
 	for (auto& resource : resources)
 		if (resource == allocatedResource)
 		{
+			auto placedResource = resource->GetResource();
+
 			delete resource;
+			_heapManager->Deallocate(placedResource);
+
 			std::swap(resource, resources.back());
 
 			resources.resize(resources.size() - 1u);
@@ -123,7 +137,11 @@ void Graphics::TextureManager::ReleaseTempBuffers()
 	for (auto& buffer : uploadBuffers)
 	{
 		buffer->Unmap();
+
+		auto placedResource = buffer->GetResource();
+
 		delete buffer;
+		_heapManager->Deallocate(placedResource);
 	}
 
 	uploadBuffers.clear();
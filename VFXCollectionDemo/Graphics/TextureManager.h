@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DirectX12Includes.h"
+#include "HeapManager.h"
 #include "Resources/IResourceDesc.h"
 #include "Resources/GPUResource.h"
 
@@ -16,11 +17,11 @@ namespace Graphics
 	class TextureManager
 	{
 	public:
-		TextureManager();
+		TextureManager(HeapManager* heapManager);
 		~TextureManager();
 
-		TextureAllocation Allocate(ID3D12Device* device, D3D12_RESOURCE_FLAGS resourceFlags, const D3D12_CLEAR_VALUE& clearValue,
-			const Resources::TextureDesc& desc);
+		TextureAllocation Allocate(ID3D12Device* device, ID3D12GraphicsCommandList* commandList, D3D12_RESOURCE_FLAGS resourceFlags,
+			const D3D12_CLEAR_VALUE& clearValue, const Resources::TextureDesc& desc);
 		TextureAllocation AllocateUploadBuffer(ID3D12Device* device, D3D12_RESOURCE_FLAGS resourceFlags, const D3D12_CLEAR_VALUE& clearValue,
 			const Resources::TextureDesc& desc);
 
@@ -34,6 +35,8 @@ namespace Graphics
 		TextureManager& operator=(const TextureManager&) = delete;
 		TextureManager& operator=(TextureManager&&) = delete;
 
+		HeapManager* _heapManager;
+
 		std::vector<Resources::GPUResource*> resources;
 		std::vector<Resources::GPUResource*> uploadBuffers;
 	};
@@ -27,7 +27,10 @@ namespace Graphics
 		TEXCOORD6 = POSITION << 17u,
 		TEXCOORD7 = POSITION << 18u,
 		BLENDINDICES = POSITION << 19u,
-		BLENDWEIGHT = POSITION << 20u
+		BLENDWEIGHT = POSITION << 20u,
+		POSITION_QUANTIZED = POSITION << 21u,
+		NORMAL_OCTAHEDRAL = POSITION << 22u,
+		TANGENT_OCTAHEDRAL = POSITION << 23u
 	};
 
 	inline VertexFormat operator|(const VertexFormat& leftValue, const VertexFormat& rightValue)
@@ -87,8 +90,11 @@ namespace Graphics
 	{
 		uint32_t result = 0u;
 		result += (format & VertexFormat::POSITION) == VertexFormat::POSITION ? 12u : 0u;
+		result += (format & VertexFormat::POSITION_QUANTIZED) == VertexFormat::POSITION_QUANTIZED ? 8u : 0u;
 		result += (format & VertexFormat::NORMAL) == VertexFormat::NORMAL ? 8u : 0u;
+		result += (format & VertexFormat::NORMAL_OCTAHEDRAL) == VertexFormat::NORMAL_OCTAHEDRAL ? 4u : 0u;
 		result += (format & VertexFormat::TANGENT) == VertexFormat::TANGENT ? 8u : 0u;
+		result += (format & VertexFormat::TANGENT_OCTAHEDRAL) == VertexFormat::TANGENT_OCTAHEDRAL ? 4u : 0u;
 		result += (format & VertexFormat::COLOR0) == VertexFormat::COLOR0 ? 4u : 0u;
 		result += (format & VertexFormat::COLOR1) == VertexFormat::COLOR1 ? 4u : 0u;
 		result += (format & VertexFormat::COLOR2) == VertexFormat::COLOR2 ? 4u : 0u;
@@ -0,0 +1,9 @@
+cbuffer BindlessIndices : register(b0, space1)
+{
+	uint4 bindlessIndices[4];
+};
+
+uint GetBindlessIndex(uint slotIndex)
+{
+	return bindlessIndices[slotIndex >> 2u][slotIndex & 3u];
+}
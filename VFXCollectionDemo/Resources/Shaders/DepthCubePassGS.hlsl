@@ -2,6 +2,7 @@ cbuffer RootConstants : register(b0)
 {
 	float4x4 world;
 	uint lightMatrixStartIndex;
+	uint faceMask;
 };
 
 cbuffer LightConstants : register(b1)
@@ -26,6 +27,9 @@ void main(triangle Input input[3], inout TriangleStream<Output> outputStream)
 	[unroll]
 	for (uint faceIndex = 0; faceIndex < 6; faceIndex++)
 	{
+		if ((faceMask & (1u << faceIndex)) == 0)
+			continue;
+		
 		Output output = (Output)0;
 		output.targetIndex = faceIndex;
 		
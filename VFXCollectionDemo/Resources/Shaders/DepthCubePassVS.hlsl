@@ -2,6 +2,7 @@ cbuffer RootConstants : register(b0)
 {
 	float4x4 world;
 	uint lightMatrixStartIndex;
+	uint faceMask;
 };
 
 struct Input
@@ -29,16 +29,28 @@ struct Output
 	float4 color : SV_TARGET0;
 };
 
+#ifdef BINDLESS
+#include "../Bindless.hlsli"
+#else
 Texture2D spectrumMap : register(t0);
 Texture3D volumeNoise : register(t1);
 Texture2D perlinNoise : register(t2);
 
 SamplerState samplerLinear : register(s0);
+#endif
 
 Output main(Input input)
 {
 	Output output = (Output)0;
 	
+#ifdef BINDLESS
+	Texture2D spectrumMap = ResourceDescriptorHeap[GetBindlessIndex(0u)];
+	Texture3D volumeNoise = ResourceDescriptorHeap[GetBindlessIndex(1u)];
+	Texture2D perlinNoise = ResourceDescriptorHeap[GetBindlessIndex(2u)];
+	
+	SamplerState samplerLinear = SamplerDescriptorHeap[GetBindlessIndex(3u)];
+#endif
+	
 	float3 volumeCoord = all(input.worldPos) ? normalize(input.worldPos) : 0.0f.xxx;
 	float dist = length(input.worldPos) * 0.5f;
 	
@@ -27,15 +27,26 @@ struct Output
 	float4 color : SV_TARGET0;
 };
 
+#ifdef BINDLESS
+#include "../Bindless.hlsli"
+#else
 Texture2D perlinNoise : register(t0);
 Texture2D haloSpectrum : register(t1);
 
 SamplerState samplerLinear : register(s0);
+#endif
 
 Output main(Input input)
 {
 	Output output = (Output)0;
 	
+#ifdef BINDLESS
+	Texture2D perlinNoise = ResourceDescriptorHeap[GetBindlessIndex(0u)];
+	Texture2D haloSpectrum = ResourceDescriptorHeap[GetBindlessIndex(1u)];
+	
+	SamplerState samplerLinear = SamplerDescriptorHeap[GetBindlessIndex(2u)];
+#endif
+	
 	float2 distortion = perlinNoise.Sample(samplerLinear, input.texCoordScroll.xy).xy * 2.0f - 1.0f.xx;
 	distortion *= distortionStrength;
 	
@@ -0,0 +1,43 @@
+#include "Lighting/PBRLighting.hlsli"
+#include "Lighting/LightClusters.hlsli"
+
+static const uint NUM_THREADS = 64;
+
+StructuredBuffer<PointLight> lightBuffer : register(t0);
+
+RWStructuredBuffer<uint> clusterLightCounts : register(u0);
+RWStructuredBuffer<uint> clusterLightIndices : register(u1);
+
+[numthreads(NUM_THREADS, 1, 1)]
+void main(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+	uint clusterIndex = dispatchThreadId.x;
+	
+	if (clusterIndex >= clustersNumber.x * clustersNumber.y * clustersNumber.z)
+		return;
+	
+	float3 minCorner;
+	float3 maxCorner;
+	GetClusterBounds(clusterIndex, minCorner, maxCorner);
+	
+	uint lightCount = 0u;
+	uint startIndex = clusterIndex * maxLightsPerCluster;
+	
+	for (uint lightIndex = 0u; lightIndex < clusterLightsNumber && lightCount < maxLightsPerCluster; lightIndex++)
+	{
+		PointLight light = lightBuffer[lightIndex];
+		
+		if (!any(light.color > 0.0f.xxx))
+			continue;
+		
+		float3 viewPosition = mul(clusterView, float4(light.position, 1.0f)).xyz;
+		
+		if (!SphereIntersectsBox(viewPosition, light.range, minCorner, maxCorner))
+			continue;
+		
+		clusterLightIndices[startIndex + lightCount] = lightIndex;
+		lightCount++;
+	}
+	
+	clusterLightCounts[clusterIndex] = lightCount;
+}
@@ -0,0 +1,56 @@
+cbuffer LightClusterConstants : register(b4)
+{
+	float4x4 clusterView;
+	
+	float2 clusterTanHalfFov;
+	float2 clusterRenderSize;
+	
+	float clusterZNear;
+	float clusterZFar;
+	float clusterDepthScale;
+	uint clusterLightsNumber;
+	
+	uint3 clustersNumber;
+	uint maxLightsPerCluster;
+};
+
+float GetClusterViewDepth(float3 worldPosition)
+{
+	return -mul(clusterView, float4(worldPosition, 1.0f)).z;
+}
+
+uint GetClusterIndex(float2 screenPosition, float viewDepth)
+{
+	uint2 tile = (uint2)max(screenPosition / clusterRenderSize * (float2)clustersNumber.xy, 0.0f.xx);
+	uint slice = (uint)max(log(max(viewDepth, clusterZNear) / clusterZNear) * clusterDepthScale, 0.0f);
+	
+	tile = min(tile, clustersNumber.xy - 1u);
+	slice = min(slice, clustersNumber.z - 1u);
+	
+	return tile.x + (tile.y + slice * clustersNumber.y) * clustersNumber.x;
+}
+
+void GetClusterBounds(uint clusterIndex, out float3 minCorner, out float3 maxCorner)
+{
+	uint tileX = clusterIndex % clustersNumber.x;
+	uint tileY = (clusterIndex / clustersNumber.x) % clustersNumber.y;
+	uint slice = clusterIndex / (clustersNumber.x * clustersNumber.y);
+	
+	float nearDepth = clusterZNear * exp((float)slice / clusterDepthScale);
+	float farDepth = clusterZNear * exp((float)(slice + 1u) / clusterDepthScale);
+	
+	float minX = ((float)tileX / clustersNumber.x * 2.0f - 1.0f) * clusterTanHalfFov.x;
+	float maxX = ((float)(tileX + 1u) / clustersNumber.x * 2.0f - 1.0f) * clusterTanHalfFov.x;
+	float minY = (1.0f - (float)(tileY + 1u) / clustersNumber.y * 2.0f) * clusterTanHalfFov.y;
+	float maxY = (1.0f - (float)tileY / clustersNumber.y * 2.0f) * clusterTanHalfFov.y;
+	
+	minCorner = float3(min(minX * nearDepth, minX * farDepth), min(minY * nearDepth, minY * farDepth), -farDepth);
+	maxCorner = float3(max(maxX * nearDepth, maxX * farDepth), max(maxY * nearDepth, maxY * farDepth), -nearDepth);
+}
+
+bool SphereIntersectsBox(float3 center, float radius, float3 minCorner, float3 maxCorner)
+{
+	float3 closest = clamp(center, minCorner, maxCorner) - center;
+	
+	return dot(closest, closest) <= radius * radius;
+}
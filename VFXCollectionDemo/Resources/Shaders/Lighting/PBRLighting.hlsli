@@ -1,4 +1,5 @@
 static const uint AREA_LIGHT_SAMPLES_NUMBER = 8;
+static const uint MAX_CASCADES_NUMBER = 4;
 
 static const float PI = 3.14159265f;
 static const float EPSILON = 0.59604645E-7f;
@@ -47,9 +48,10 @@ static const float3 AREA_LIGHT_SAMPLES[AREA_LIGHT_SAMPLES_NUMBER] =
 struct DirectionalLight
 {
 	float3 direction;
-	float padding0;
+	uint cascadesNumber;
 	float3 color;
-	float padding1;
+	uint lightMatrixStartIndex;
+	float4 cascadeSplits;
 };
 
 struct PointLight
@@ -108,6 +110,15 @@ struct ShadowCubeData
 	SamplerComparisonState shadowSampler;
 };
 
+struct ShadowCascadeData
+{
+	float4x4 lightViewProjections[MAX_CASCADES_NUMBER];
+	float4 cascadeSplits;
+	uint cascadesNumber;
+	Texture2DArray shadowMap;
+	SamplerComparisonState shadowSampler;
+};
+
 struct LightData
 {
 	float3 direction;
@@ -259,6 +270,24 @@ float CalculateShadowCube(ShadowCubeData shadowData, float3 worldPosition, float
 	return dot(occlusions, 0.25f.xxxx);
 }
 
+float CalculateShadowCascades(ShadowCascadeData shadowData, float3 worldPosition, float viewDepth)
+{
+	uint cascadeIndex = 0;
+	
+	[unroll]
+	for (uint splitIndex = 0; splitIndex < MAX_CASCADES_NUMBER - 1; splitIndex++)
+		cascadeIndex += (splitIndex + 1 < shadowData.cascadesNumber && viewDepth > shadowData.cascadeSplits[splitIndex]) ? 1 : 0;
+	
+	float4 lightPosition = mul(shadowData.lightViewProjections[cascadeIndex], float4(worldPosition, 1.0f));
+	float3 shadowPosition = lightPosition.xyz / lightPosition.w;
+	float2 texCoord = shadowPosition.xy * float2(0.5f, -0.5f) + 0.5f.xx;
+	
+	float4 occlusions = shadowData.shadowMap.GatherCmpRed(shadowData.shadowSampler, float3(texCoord, cascadeIndex),
+		shadowPosition.z - 0.0001f);
+	
+	return dot(occlusions, 0.25f.xxxx);
+}
+
 float RayleighScatteringPhase(float cosAngle2)
 {
 	return 1.0f + cosAngle2;
@@ -441,3 +470,11 @@ void CalculateAreaLight(ShadowCubeData shadowData, AreaLight areaLight, Surface
 		light += lightRate * occlusion;
 	}
 }
+
+void CalculateDirectionalLight(ShadowCascadeData shadowData, DirectionalLight directionalLight, Surface surface, Material material,
+	float3 viewDir, float viewDepth, out float3 light)
+{
+	CalculateDirectionalLight(directionalLight, surface, material, viewDir, light);
+	
+	light *= CalculateShadowCascades(shadowData, surface.position, viewDepth);
+}
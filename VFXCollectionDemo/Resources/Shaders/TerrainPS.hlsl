@@ -1,5 +1,9 @@
 #include "Lighting/PBRLighting.hlsli"
 
+#ifdef CLUSTERED_LIGHTING
+#include "Lighting/LightClusters.hlsli"
+#endif
+
 cbuffer LightConstantBuffer : register(b0)
 {
 #ifdef AREA_LIGHT
@@ -27,11 +31,23 @@ cbuffer MutableConstants : register(b1)
 	float mipBias;
 	float padding;
 	
+	float3 positionOffset;
+	float padding1;
+	float3 positionScale;
+	float padding2;
+	
 #ifdef OUTPUT_VELOCITY
 	float4x4 lastViewProjection;
 #endif
 };
 
+#ifdef CASCADED_SHADOWS
+cbuffer LightMatrices : register(b2)
+{
+	float4x4 lightViewProjections[LIGHT_MATRICES_NUMBER];
+};
+#endif
+
 struct Input
 {
 	float4 position : SV_Position;
@@ -67,6 +83,8 @@ Texture2D blendMap : register(t8);
 
 #ifdef AREA_LIGHT
 TextureCube shadowMap : register(t9);
+#elif defined(CASCADED_SHADOWS)
+Texture2DArray shadowMap : register(t9);
 #else
 Texture2D shadowMap : register(t9);
 #endif
@@ -75,6 +93,11 @@ Texture2D shadowMap : register(t9);
 StructuredBuffer<PointLight> particleLightBuffer : register(t10);
 #endif
 
+#ifdef CLUSTERED_LIGHTING
+StructuredBuffer<uint> clusterLightCounts : register(t11);
+StructuredBuffer<uint> clusterLightIndices : register(t12);
+#endif
+
 SamplerState samplerAnisotropic : register(s0);
 SamplerComparisonState shadowSampler : register(s1);
 
@@ -151,18 +174,46 @@ Output main(Input input)
 	
 	CalculateAmbientLight(ambientLight, surface, material, view, light);
 	lightSum += light;
+#elif defined(CASCADED_SHADOWS)
+	ShadowCascadeData shadowData = (ShadowCascadeData)0;
+	shadowData.cascadeSplits = directionalLight.cascadeSplits;
+	shadowData.cascadesNumber = directionalLight.cascadesNumber;
+	shadowData.shadowMap = shadowMap;
+	shadowData.shadowSampler = shadowSampler;
+	
+	[unroll]
+	for (uint cascadeIndex = 0u; cascadeIndex < MAX_CASCADES_NUMBER; cascadeIndex++)
+		shadowData.lightViewProjections[cascadeIndex] = lightViewProjections[min(directionalLight.lightMatrixStartIndex + cascadeIndex,
+			LIGHT_MATRICES_NUMBER - 1)];
+	
+	float viewDepth = mul(viewProjection, float4(input.worldPosition, 1.0f)).w;
+	
+	CalculateDirectionalLight(shadowData, directionalLight, surface, material, view, viewDepth, light);
+	lightSum += light;
 #else
 	CalculateDirectionalLight(directionalLight, surface, material, view, light);
 	lightSum += light;
 #endif
 	
 #if (PARTICLE_LIGHT_SOURCE_NUMBER > 0)
+#ifdef CLUSTERED_LIGHTING
+	uint clusterIndex = GetClusterIndex(input.position.xy, GetClusterViewDepth(input.worldPosition));
+	uint clusterLightCount = clusterLightCounts[clusterIndex];
+	uint clusterStartIndex = clusterIndex * maxLightsPerCluster;
+	
+	for (uint clusterLightIndex = 0u; clusterLightIndex < clusterLightCount; clusterLightIndex++)
+	{
+		CalculatePointLight(particleLightBuffer[clusterLightIndices[clusterStartIndex + clusterLightIndex]], surface, material, view, light);
+		lightSum += light;
+	}
+#else
 	[unroll]
 	for (uint particleIndex = 0u; particleIndex < PARTICLE_LIGHT_SOURCE_NUMBER; particleIndex++)
 	{
 		CalculatePointLight(particleLightBuffer[particleIndex], surface, material, view, light);
 		lightSum += light;
 	}
+#endif
 #endif
 	
 	output.color = float4(lightSum, 0.0f);
@@ -15,6 +15,11 @@ cbuffer MutableConstants : register(b1)
 	float mipBias;
 	float padding;
 	
+	float3 positionOffset;
+	float padding1;
+	float3 positionScale;
+	float padding2;
+	
 #ifdef OUTPUT_VELOCITY
 	float4x4 lastViewProjection;
 #endif
@@ -22,9 +27,15 @@ cbuffer MutableConstants : register(b1)
 
 struct Input
 {
+#ifdef QUANTIZED_VERTICES
+	float4 position : POSITION;
+	float2 normal : NORMAL;
+	float2 tangent : TANGENT;
+#else
 	float3 position : POSITION;
 	half4 normal : NORMAL;
 	half4 tangent : TANGENT;
+#endif
 	half2 texCoord : TEXCOORD0;
 };
 
@@ -43,23 +54,44 @@ struct Output
 #endif
 };
 
+#ifdef QUANTIZED_VERTICES
+float3 DecodeOctahedral(float2 value)
+{
+	float3 result = float3(value, 1.0f - abs(value.x) - abs(value.y));
+	float fold = saturate(-result.z);
+	result.xy -= (step(0.0f, result.xy) * 2.0f - 1.0f) * fold;
+	
+	return normalize(result);
+}
+#endif
+
 Output main(Input input)
 {
 	Output output = (Output)0;
 	
-	output.position = mul(viewProj, float4(input.position, 1.0f));
-	output.normal = normalize(input.normal.xyz);
-	output.tangent = normalize(input.tangent.xyz);
+#ifdef QUANTIZED_VERTICES
+	float3 position = positionOffset + input.position.xyz * positionScale;
+	float3 normal = DecodeOctahedral(input.normal);
+	float3 tangent = DecodeOctahedral(input.tangent);
+#else
+	float3 position = input.position;
+	float3 normal = input.normal.xyz;
+	float3 tangent = input.tangent.xyz;
+#endif
+	
+	output.position = mul(viewProj, float4(position, 1.0f));
+	output.normal = normalize(normal);
+	output.tangent = normalize(tangent);
 	output.binormal = cross(output.tangent, output.normal);
 	output.texCoord = input.texCoord;
 	output.texCoord01.xy = input.texCoord * mapTiling0;
 	output.texCoord01.zw = input.texCoord * mapTiling1;
 	output.texCoord23.xy = input.texCoord * mapTiling2;
 	output.texCoord23.zw = input.texCoord * mapTiling3;
-	output.worldPosition = input.position;
+	output.worldPosition = position;
 	
 #ifdef OUTPUT_VELOCITY
-	float4 lastNonHomogeneousPos = mul(lastViewProjection, float4(input.position, 1.0f));
+	float4 lastNonHomogeneousPos = mul(lastViewProjection, float4(position, 1.0f));
 	lastNonHomogeneousPos.xy /= lastNonHomogeneousPos.w;
 	
 	float2 nonHomogeneousPos = output.position.xy / output.position.w;
@@ -0,0 +1,109 @@
+static const uint QUADS_PER_GRASS = 3;
+
+static const float GRASS_ROLL = 2.09439510f;
+static const float GRASS_CAP_OFFSET = 0.05f;
+static const float YAW_SCALE = 6.28318531f / 65535.0f;
+
+struct Vegetation
+{
+	uint positionXY;
+	uint positionZYaw;
+	uint upVector;
+	uint scaleXY;
+	uint heightWindInfluence;
+	uint atlasCell;
+};
+
+struct VegetationInstance
+{
+	float3 position;
+	float3x3 rotationScale;
+	float2 atlasElementOffset;
+	float windInfluence;
+	float height;
+	bool isCap;
+};
+
+float3 DecodeUpVector(uint value)
+{
+	float2 octahedral = max(float2(int2(value << 16, value) >> 16) / 32767.0f, -1.0f);
+	
+	float3 result = float3(octahedral, 1.0f - abs(octahedral.x) - abs(octahedral.y));
+	float fold = saturate(-result.z);
+	result.xy -= (step(0.0f, result.xy) * 2.0f - 1.0f) * fold;
+	
+	return normalize(result);
+}
+
+float3x3 CalculateTilt(float3 up)
+{
+	float k = 1.0f / (1.0f + up.z);
+	
+	return float3x3
+	(
+		1.0f - up.x * up.x * k, -up.x * up.y * k, up.x,
+		-up.x * up.y * k, 1.0f - up.y * up.y * k, up.y,
+		-up.x, -up.y, up.z
+	);
+}
+
+VegetationInstance DecodeVegetation(Vegetation vegetation, uint quadIndex, float3 positionOffset,
+	float3 positionScale, float2 atlasElementSize)
+{
+	VegetationInstance instance = (VegetationInstance)0;
+	
+	float3 quantizedPosition = float3(vegetation.positionXY & 0xFFFF, vegetation.positionXY >> 16,
+		vegetation.positionZYaw & 0xFFFF) / 65535.0f;
+	
+	float2 scaleXY = f16tof32(uint2(vegetation.scaleXY, vegetation.scaleXY >> 16));
+	float2 heightWindInfluence = f16tof32(uint2(vegetation.heightWindInfluence, vegetation.heightWindInfluence >> 16));
+	
+	instance.height = abs(heightWindInfluence.x);
+	instance.windInfluence = heightWindInfluence.y;
+	instance.isCap = heightWindInfluence.x < 0.0f;
+	instance.position = positionOffset + quantizedPosition * positionScale;
+	instance.atlasElementOffset = float2(vegetation.atlasCell & 0xFFFF, vegetation.atlasCell >> 16) * atlasElementSize;
+	
+	float yaw = (vegetation.positionZYaw >> 16) * YAW_SCALE + (instance.isCap ? 0.0f : quadIndex * GRASS_ROLL);
+	
+	float sinYaw;
+	float cosYaw;
+	sincos(yaw, sinYaw, cosYaw);
+	
+	float3x3 rotation = float3x3
+	(
+		cosYaw, -sinYaw, 0.0f,
+		sinYaw, cosYaw, 0.0f,
+		0.0f, 0.0f, 1.0f
+	);
+	
+	float3 scale = float3(scaleXY, instance.height);
+	
+	if (instance.isCap)
+	{
+		float3x3 capRotation = float3x3
+		(
+			1.0f, 0.0f, 0.0f,
+			0.0f, 0.0f, -1.0f,
+			0.0f, 1.0f, 0.0f
+		);
+		
+		rotation = mul(rotation, capRotation);
+		scale = scaleXY.xxx;
+		instance.position.z += instance.height * GRASS_CAP_OFFSET;
+	}
+	
+	float3x3 scaleMatrix = float3x3
+	(
+		scale.x, 0.0f, 0.0f,
+		0.0f, scale.y, 0.0f,
+		0.0f, 0.0f, scale.z
+	);
+	
+	instance.rotationScale = mul(CalculateTilt(DecodeUpVector(vegetation.upVector)), mul(rotation, scaleMatrix));
+	
+	if (instance.isCap && quadIndex > 0)
+		instance.rotationScale = (float3x3)0;
+	
+	return instance;
+}
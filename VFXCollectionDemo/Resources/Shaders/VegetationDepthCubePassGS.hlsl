@@ -1,14 +1,7 @@
-struct Vegetation
-{
-	float4x4 world;
-	float2 atlasElementOffset;
-	float tiltAmplitude;
-	float height;
-};
-
 cbuffer RootConstants : register(b0)
 {
 	uint lightMatrixStartIndex;
+	uint faceMask;
 };
 
 cbuffer MutableConstants : register(b1)
@@ -49,6 +42,9 @@ void main(triangle Input input[3], inout TriangleStream<Output> outputStream)
 	[unroll]
 	for (uint faceIndex = 0; faceIndex < 6; faceIndex++)
 	{
+		if ((faceMask & (1u << faceIndex)) == 0)
+			continue;
+		
 		Output output = (Output)0;
 		output.targetIndex = faceIndex;
 		
@@ -1,10 +1,4 @@
-struct Vegetation
-{
-	float4x4 world;
-	float2 atlasElementOffset;
-	float windInfluence;
-	float height;
-};
+#include "Vegetation/VegetationInstance.hlsli"
 
 cbuffer MutableConstants : register(b1)
 {
@@ -28,6 +22,16 @@ cbuffer MutableConstants : register(b1)
 	float lastWindStrength;
 	
 	float4x4 lastViewProjection;
+	
+	float3 positionOffset;
+	float padding0;
+	float3 positionScale;
+	float padding1;
+};
+
+cbuffer DrawConstants : register(b3)
+{
+	uint instanceOffset;
 };
 
 struct Input
@@ -54,13 +58,13 @@ Output main(Input input)
 {
 	Output output = (Output)0;
 	
-	Vegetation vegetation = vegetationBuffer[input.instanceId];
+	VegetationInstance vegetation = DecodeVegetation(vegetationBuffer[instanceOffset + input.instanceId / QUADS_PER_GRASS],
+		input.instanceId % QUADS_PER_GRASS, positionOffset, positionScale, atlasElementSize);
 	
-	float4 localPosition = float4(input.position, 1.0f);
-	float4 worldPosition = mul(vegetation.world, localPosition);
+	float4 worldPosition = float4(vegetation.position + mul(vegetation.rotationScale, input.position), 1.0f);
 	
-	float2 noiseXZTexCoord = vegetation.world[3].xz * perlinNoiseTiling;
-	float2 noiseYZTexCoord = vegetation.world[3].yz * perlinNoiseTiling;
+	float2 noiseXZTexCoord = vegetation.position.xz * perlinNoiseTiling;
+	float2 noiseYZTexCoord = vegetation.position.yz * perlinNoiseTiling;
 	
 	float noiseXZ = perlinNoise.SampleLevel(samplerLinear, noiseXZTexCoord, 0.0f).x;
 	float noiseYZ = perlinNoise.SampleLevel(samplerLinear, noiseYZTexCoord, 0.0f).x;
@@ -68,8 +72,8 @@ Output main(Input input)
 	
 	float t = saturate(sin(time * windStrength * noise) * 0.5f + 0.5f);
 	
-	float height = abs(vegetation.height);
-	bool isCap = vegetation.height < 0.0f;
+	float height = vegetation.height;
+	bool isCap = vegetation.isCap;
 	
 	float3 shift = windDirection;
 	shift.z -= 0.5f * height * dot(windDirection, windDirection);
@@ -1,10 +1,4 @@
-struct Vegetation
-{
-	float4x4 world;
-	float2 atlasElementOffset;
-	float windInfluence;
-	float height;
-};
+#include "Vegetation/VegetationInstance.hlsli"
 
 cbuffer MutableConstants : register(b1)
 {
@@ -28,6 +22,16 @@ cbuffer MutableConstants : register(b1)
 	float lastWindStrength;
 	
 	float4x4 lastViewProjection;
+	
+	float3 positionOffset;
+	float padding0;
+	float3 positionScale;
+	float padding1;
+};
+
+cbuffer DrawConstants : register(b3)
+{
+	uint instanceOffset;
 };
 
 struct Input
@@ -61,13 +65,13 @@ Output main(Input input)
 {
 	Output output = (Output)0;
 	
-	Vegetation vegetation = vegetationBuffer[input.instanceId];
+	VegetationInstance vegetation = DecodeVegetation(vegetationBuffer[instanceOffset + input.instanceId / QUADS_PER_GRASS],
+		input.instanceId % QUADS_PER_GRASS, positionOffset, positionScale, atlasElementSize);
 	
-	float4 localPosition = float4(input.position, 1.0f);
-	float4 worldPosition = mul(vegetation.world, localPosition);
+	float4 worldPosition = float4(vegetation.position + mul(vegetation.rotationScale, input.position), 1.0f);
 	
-	float2 noiseXZTexCoord = vegetation.world[3].xz * perlinNoiseTiling * 2.0f;
-	float2 noiseYZTexCoord = vegetation.world[3].yz * perlinNoiseTiling * 2.0f;
+	float2 noiseXZTexCoord = vegetation.position.xz * perlinNoiseTiling * 2.0f;
+	float2 noiseYZTexCoord = vegetation.position.yz * perlinNoiseTiling * 2.0f;
 	
 	float noiseXZ = perlinNoise.SampleLevel(samplerLinear, noiseXZTexCoord, 0.0f).x;
 	float noiseYZ = perlinNoise.SampleLevel(samplerLinear, noiseYZTexCoord, 0.0f).x;
@@ -75,9 +79,9 @@ Output main(Input input)
 	
 	float t = saturate(sin(time * windStrength * noise) * 0.5f + 0.5f);
 	
-	float height = abs(vegetation.height);
+	float height = vegetation.height;
 	float halfHeight = 0.5f * height;
-	bool isCap = vegetation.height < 0.0f;
+	bool isCap = vegetation.isCap;
 	
 	float3 shift = windDirection;
 	shift.z -= halfHeight * dot(windDirection, windDirection);
@@ -88,8 +92,8 @@ Output main(Input input)
 	
 	output.position = mul(viewProjection, float4(output.worldPosition, worldPosition.w));
 	
-	float3 normal = normalize(mul((float3x3)vegetation.world, input.normal.xyz));
-	float3 tangent = normalize(mul((float3x3)vegetation.world, input.tangent.xyz));
+	float3 normal = normalize(mul(vegetation.rotationScale, input.normal.xyz));
+	float3 tangent = normalize(mul(vegetation.rotationScale, input.tangent.xyz));
 	
 	output.normal = isCap ? float3(0.0f, 0.0f, 1.0f) : normal;
 	output.tangent = isCap ? float3(0.0f, -1.0f, 0.0f) : tangent;
@@ -0,0 +1,146 @@
+#include "Tests.h"
+#include "../Graphics/Resources/BarrierBatch.h"
+
+using namespace Graphics::Resources;
+
+Tests::TestResult Tests::TestBarrierBatch(uint32_t framesNumber)
+{
+	static constexpr uint64_t BUFFER_SIZE = 256u;
+	static constexpr uint32_t BUFFERS_NUMBER = 4u;
+
+	static constexpr uint32_t EXPECTED_REQUESTED_NUMBER = 10u;
+	static constexpr uint32_t EXPECTED_REDUNDANT_NUMBER = 2u;
+	static constexpr uint32_t EXPECTED_MERGED_NUMBER = 3u;
+	static constexpr uint32_t EXPECTED_COMBINED_READ_NUMBER = 1u;
+	static constexpr uint32_t EXPECTED_EMITTED_NUMBER = 4u;
+
+	std::stringstream reportStream;
+	uint32_t errorsNumber = 0u;
+
+	CComPtr<IDXGIFactory4> factory;
+	CComPtr<IDXGIAdapter> warpAdapter;
+	CComPtr<ID3D12Device> device;
+
+	if (FAILED(CreateDXGIFactory2(0u, IID_PPV_ARGS(&factory))) ||
+		FAILED(factory->EnumWarpAdapter(IID_PPV_ARGS(&warpAdapter))) ||
+		FAILED(D3D12CreateDevice(warpAdapter, D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&device))))
+	{
+		reportStream << "BarrierBatch: no WARP device, skipped\n";
+
+		return { reportStream.str(), errorsNumber };
+	}
+
+	D3D12_HEAP_PROPERTIES heapProperties{};
+	heapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+	D3D12_RESOURCE_DESC bufferDesc{};
+	bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+	bufferDesc.Width = BUFFER_SIZE;
+	bufferDesc.Height = 1u;
+	bufferDesc.DepthOrArraySize = 1u;
+	bufferDesc.MipLevels = 1u;
+	bufferDesc.SampleDesc.Count = 1u;
+	bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+	bufferDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+
+	std::array<CComPtr<ID3D12Resource>, BUFFERS_NUMBER> buffers;
+
+	for (auto& buffer : buffers)
+		if (FAILED(device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &bufferDesc,
+			D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&buffer))))
+		{
+			reportStream << "BarrierBatch: buffer creation failed\n";
+
+			return { reportStream.str(), ++errorsNumber };
+		}
+
+	CComPtr<ID3D12CommandAllocator> commandAllocator;
+	CComPtr<ID3D12GraphicsCommandList> commandList;
+
+	device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator));
+	device->CreateCommandList(0u, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocator, nullptr, IID_PPV_ARGS(&commandList));
+
+	auto addTransition = [](BarrierBatch& batch, ID3D12Resource* resource, D3D12_RESOURCE_STATES stateBefore,
+		D3D12_RESOURCE_STATES stateAfter, D3D12_RESOURCE_BARRIER_FLAGS flags)
+		{
+			return batch.AddTransition(resource, stateBefore, stateAfter, flags);
+		};
+
+	BarrierBatch barrierBatch;
+
+	for (uint32_t frameIndex = 0u; frameIndex < framesNumber; frameIndex++)
+	{
+		auto uavBuffer = buffers[0u].p;
+		auto readBuffer = buffers[1u].p;
+		auto cancelledBuffer = buffers[2u].p;
+		auto splitBuffer = buffers[3u].p;
+
+		addTransition(barrierBatch, uavBuffer, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+			D3D12_RESOURCE_BARRIER_FLAG_NONE);
+
+		if (addTransition(barrierBatch, uavBuffer, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+			D3D12_RESOURCE_BARRIER_FLAG_NONE))
+			errorsNumber++;
+
+		addTransition(barrierBatch, uavBuffer, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE,
+			D3D12_RESOURCE_BARRIER_FLAG_NONE);
+
+		auto combinedState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+		barrierBatch.AddTransition(readBuffer, D3D12_RESOURCE_STATE_COPY_SOURCE, combinedState, D3D12_RESOURCE_BARRIER_FLAG_NONE);
+
+		if (combinedState != (D3D12_RESOURCE_STATE_COPY_SOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE))
+			errorsNumber++;
+
+		barrierBatch.AddUAV(uavBuffer);
+		barrierBatch.AddUAV(uavBuffer);
+
+		addTransition(barrierBatch, cancelledBuffer, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST,
+			D3D12_RESOURCE_BARRIER_FLAG_NONE);
+		addTransition(barrierBatch, cancelledBuffer, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_COMMON,
+			D3D12_RESOURCE_BARRIER_FLAG_NONE);
+
+		addTransition(barrierBatch, splitBuffer, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST,
+			D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY);
+		addTransition(barrierBatch, splitBuffer, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST,
+			D3D12_RESOURCE_BARRIER_FLAG_END_ONLY);
+
+		barrierBatch.Flush(commandList);
+		barrierBatch.Flush(commandList);
+
+		if (!barrierBatch.IsEmpty())
+			errorsNumber++;
+
+		barrierBatch.EndFrame();
+
+		auto& statistics = barrierBatch.GetFrameStatistics();
+
+		if (statistics.requestedNumber != EXPECTED_REQUESTED_NUMBER || statistics.redundantNumber != EXPECTED_REDUNDANT_NUMBER ||
+			statistics.mergedNumber != EXPECTED_MERGED_NUMBER || statistics.combinedReadNumber != EXPECTED_COMBINED_READ_NUMBER ||
+			statistics.emittedNumber != EXPECTED_EMITTED_NUMBER || statistics.flushesNumber != 1u)
+			errorsNumber++;
+
+#ifdef _DEBUG
+		auto trace = barrierBatch.GetFrameTrace();
+		uint32_t tracedNumber = 0u;
+
+		for (auto entry : { "\n  transition ", "\n  uav ", "\n  aliasing " })
+			for (auto position = trace.find(entry); position != std::string::npos; position = trace.find(entry, position + 1u))
+				tracedNumber++;
+
+		if (tracedNumber != EXPECTED_EMITTED_NUMBER)
+			errorsNumber++;
+#endif
+	}
+
+	barrierBatch.EndFrame();
+
+	if (barrierBatch.GetFrameStatistics().requestedNumber != 0u)
+		errorsNumber++;
+
+	commandList->Close();
+
+	reportStream << "BarrierBatch: " << framesNumber << " frames, " << EXPECTED_REQUESTED_NUMBER << " requests and ";
+	reportStream << EXPECTED_EMITTED_NUMBER << " emitted barriers per frame, errors: " << errorsNumber << "\n";
+
+	return { reportStream.str(), errorsNumber };
+}
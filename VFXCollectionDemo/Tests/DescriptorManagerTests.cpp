@@ -0,0 +1,122 @@
+#include "Tests.h"
+#include "../Graphics/DescriptorManager.h"
+
+using namespace Graphics;
+
+Tests::TestResult Tests::TestDescriptorManager(uint32_t framesNumber)
+{
+	static constexpr uint32_t TRANSIENT_BLOCK_SIZE = 16u;
+	static constexpr uint32_t PERSISTENT_ALLOCATIONS_NUMBER = 64u;
+
+	std::stringstream reportStream;
+	uint32_t errorsNumber = 0u;
+
+	CComPtr<IDXGIFactory4> factory;
+	CComPtr<IDXGIAdapter> warpAdapter;
+	CComPtr<ID3D12Device> device;
+
+	if (FAILED(CreateDXGIFactory2(0u, IID_PPV_ARGS(&factory))) ||
+		FAILED(factory->EnumWarpAdapter(IID_PPV_ARGS(&warpAdapter))) ||
+		FAILED(D3D12CreateDevice(warpAdapter, D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&device))))
+	{
+		reportStream << "DescriptorManager: no WARP device, skipped\n";
+
+		return { reportStream.str(), errorsNumber };
+	}
+
+	DescriptorManager descriptorManager(device, framesNumber);
+	auto incrementSize = descriptorManager.GetIncrementSize(DescriptorType::CBV_SRV_UAV);
+
+	std::vector<DescriptorAllocation> allocations(PERSISTENT_ALLOCATIONS_NUMBER);
+
+	for (auto& allocation : allocations)
+		if (!descriptorManager.Allocate(DescriptorType::CBV_SRV_UAV, allocation))
+			errorsNumber++;
+
+	auto statistics = descriptorManager.GetStatistics(DescriptorType::CBV_SRV_UAV);
+
+	if (statistics.allocatedNumber != PERSISTENT_ALLOCATIONS_NUMBER ||
+		statistics.peakAllocatedNumber != PERSISTENT_ALLOCATIONS_NUMBER || statistics.heapsNumber != 1u)
+		errorsNumber++;
+
+	for (uint32_t allocationIndex = 0u; allocationIndex < PERSISTENT_ALLOCATIONS_NUMBER / 2u; allocationIndex++)
+		descriptorManager.Deallocate(DescriptorType::CBV_SRV_UAV, allocations[allocationIndex]);
+
+	statistics = descriptorManager.GetStatistics(DescriptorType::CBV_SRV_UAV);
+
+	if (statistics.allocatedNumber != PERSISTENT_ALLOCATIONS_NUMBER / 2u ||
+		statistics.peakAllocatedNumber != PERSISTENT_ALLOCATIONS_NUMBER)
+		errorsNumber++;
+
+	auto transientCapacity = statistics.transientCapacity;
+	auto blocksNumber = transientCapacity / TRANSIENT_BLOCK_SIZE;
+	std::vector<uint64_t> frameStarts(framesNumber);
+
+	for (uint32_t frameIndex = 0u; frameIndex < framesNumber; frameIndex++)
+	{
+		descriptorManager.BeginFrame(frameIndex);
+
+		DescriptorAllocation firstBlock{};
+		DescriptorAllocation previousBlock{};
+
+		for (uint32_t blockIndex = 0u; blockIndex < blocksNumber; blockIndex++)
+		{
+			DescriptorAllocation block{};
+
+			if (!descriptorManager.AllocateTransient(DescriptorType::CBV_SRV_UAV, TRANSIENT_BLOCK_SIZE, block))
+			{
+				errorsNumber++;
+				continue;
+			}
+
+			if (blockIndex == 0u)
+				firstBlock = block;
+			else if (block.gpuDescriptor.ptr != previousBlock.gpuDescriptor.ptr +
+				static_cast<uint64_t>(TRANSIENT_BLOCK_SIZE) * incrementSize)
+				errorsNumber++;
+
+			for (auto& allocation : allocations)
+				if (allocation.gpuDescriptor.ptr >= block.gpuDescriptor.ptr &&
+					allocation.gpuDescriptor.ptr < block.gpuDescriptor.ptr + static_cast<uint64_t>(TRANSIENT_BLOCK_SIZE) * incrementSize)
+					errorsNumber++;
+
+			previousBlock = block;
+		}
+
+		DescriptorAllocation overflowBlock{};
+
+		if (descriptorManager.AllocateTransient(DescriptorType::CBV_SRV_UAV, transientCapacity, overflowBlock))
+			errorsNumber++;
+
+		statistics = descriptorManager.GetStatistics(DescriptorType::CBV_SRV_UAV);
+
+		if (statistics.transientAllocatedNumber != blocksNumber * TRANSIENT_BLOCK_SIZE)
+			errorsNumber++;
+
+		frameStarts[frameIndex] = firstBlock.gpuDescriptor.ptr;
+
+		for (uint32_t previousFrameIndex = 0u; previousFrameIndex < frameIndex; previousFrameIndex++)
+			if (frameStarts[previousFrameIndex] + static_cast<uint64_t>(transientCapacity) * incrementSize > frameStarts[frameIndex])
+				errorsNumber++;
+	}
+
+	descriptorManager.BeginFrame(0u);
+
+	DescriptorAllocation rewoundBlock{};
+
+	if (!descriptorManager.AllocateTransient(DescriptorType::CBV_SRV_UAV, TRANSIENT_BLOCK_SIZE, rewoundBlock) ||
+		rewoundBlock.gpuDescriptor.ptr != frameStarts[0u])
+		errorsNumber++;
+
+	statistics = descriptorManager.GetStatistics(DescriptorType::CBV_SRV_UAV);
+
+	if (statistics.transientAllocatedNumber != TRANSIENT_BLOCK_SIZE || statistics.failedAllocationsNumber != framesNumber)
+		errorsNumber++;
+
+	reportStream << "DescriptorManager: " << framesNumber << " frames, " << transientCapacity << " transient descriptors per frame\n";
+	reportStream << "  persistent: " << statistics.allocatedNumber << " allocated, " << statistics.peakAllocatedNumber;
+	reportStream << " peak of " << statistics.capacity << ", failed: " << statistics.failedAllocationsNumber;
+	reportStream << ", errors: " << errorsNumber << "\n";
+
+	return { reportStream.str(), errorsNumber };
+}
@@ -0,0 +1,99 @@
+#include "Tests.h"
+#include "../Graphics/Assets/FrustumCuller.h"
+#include "../Common/Utilities.h"
+
+using namespace DirectX;
+using namespace Graphics::Assets;
+
+Tests::TestResult Tests::TestFrustumCuller(uint32_t objectsNumber, uint32_t iterationsNumber)
+{
+	static constexpr uint32_t RANDOM_SEED = 0x85EBCA6Bu;
+	static constexpr float SCENE_EXTENT = 100.0f;
+	static constexpr float MIN_OBJECT_SIZE = 0.5f;
+	static constexpr float MAX_OBJECT_SIZE = 2.0f;
+
+	auto view = XMMatrixLookAtRH(XMVectorZero(), XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f), XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f));
+	auto projection = XMMatrixPerspectiveFovRH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, SCENE_EXTENT);
+	Frustum frustum(view * projection);
+
+	BoundingSphereBatch sphereBatch{};
+	AxisAlignedBoxBatch boxBatch{};
+	FrustumCuller::Resize(sphereBatch, objectsNumber);
+	FrustumCuller::Resize(boxBatch, objectsNumber);
+
+	std::vector<float3> centers(objectsNumber);
+	std::vector<float> radiuses(objectsNumber);
+	std::vector<AxisAlignedBox> boxes(objectsNumber);
+
+	for (uint32_t objectIndex = 0u; objectIndex < objectsNumber; objectIndex++)
+	{
+		Common::HashedRandom random(RANDOM_SEED, objectIndex);
+
+		auto position = Common::Utilities::Random3(random);
+		auto size = std::lerp(MIN_OBJECT_SIZE, MAX_OBJECT_SIZE, Common::Utilities::Random(random));
+
+		centers[objectIndex] = float3((position.x * 2.0f - 1.0f) * SCENE_EXTENT, (position.y * 2.0f - 1.0f) * SCENE_EXTENT,
+			(position.z * 2.0f - 1.0f) * SCENE_EXTENT);
+		radiuses[objectIndex] = size;
+
+		auto& box = boxes[objectIndex];
+		box.minCorner = float3(centers[objectIndex].x - size, centers[objectIndex].y - size, centers[objectIndex].z - size);
+		box.maxCorner = float3(centers[objectIndex].x + size, centers[objectIndex].y + size, centers[objectIndex].z + size);
+
+		FrustumCuller::SetSphere(sphereBatch, objectIndex, centers[objectIndex], size);
+		FrustumCuller::SetBox(boxBatch, objectIndex, box);
+	}
+
+	auto measure = [iterationsNumber, objectsNumber](const std::function<void()>& cull)
+	{
+		auto startTimePoint = std::chrono::high_resolution_clock::now();
+
+		for (uint32_t iterationIndex = 0u; iterationIndex < iterationsNumber; iterationIndex++)
+			cull();
+
+		auto elapsedTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTimePoint);
+
+		return static_cast<double>(objectsNumber) * iterationsNumber / std::max(elapsedTime.count(), 1e-6);
+	};
+
+	std::vector<uint32_t> sphereMask;
+	std::vector<uint32_t> boxMask;
+	std::vector<uint8_t> scalarSphereVisibility(objectsNumber);
+	std::vector<uint8_t> scalarBoxVisibility(objectsNumber);
+
+	auto sphereRate = measure([&]() { FrustumCuller::Cull(frustum, sphereBatch, sphereMask); });
+	auto boxRate = measure([&]() { FrustumCuller::Cull(frustum, boxBatch, boxMask); });
+
+	auto scalarSphereRate = measure([&]()
+	{
+		for (uint32_t objectIndex = 0u; objectIndex < objectsNumber; objectIndex++)
+			scalarSphereVisibility[objectIndex] = frustum.Intersects(centers[objectIndex], radiuses[objectIndex]) ? 1u : 0u;
+	});
+
+	auto scalarBoxRate = measure([&]()
+	{
+		for (uint32_t objectIndex = 0u; objectIndex < objectsNumber; objectIndex++)
+			scalarBoxVisibility[objectIndex] = frustum.Intersects(boxes[objectIndex]) ? 1u : 0u;
+	});
+
+	uint32_t visibleNumber = 0u;
+	uint32_t mismatchesNumber = 0u;
+
+	for (uint32_t objectIndex = 0u; objectIndex < objectsNumber; objectIndex++)
+	{
+		auto sphereVisible = FrustumCuller::IsVisible(sphereMask, objectIndex);
+		visibleNumber += sphereVisible ? 1u : 0u;
+
+		mismatchesNumber += sphereVisible != (scalarSphereVisibility[objectIndex] != 0u) ? 1u : 0u;
+		mismatchesNumber += FrustumCuller::IsVisible(boxMask, objectIndex) != (scalarBoxVisibility[objectIndex] != 0u) ? 1u : 0u;
+	}
+
+	std::stringstream reportStream;
+	reportStream << "FrustumCuller (" << (FrustumCuller::IsAVXSupported() ? "AVX" : "SSE") << "): " << objectsNumber << " objects x ";
+	reportStream << iterationsNumber << " iterations, " << visibleNumber << " visible\n";
+	reportStream << "  spheres: " << sphereRate << " objects/ms (scalar " << scalarSphereRate << " objects/ms)\n";
+	reportStream << "  boxes: " << boxRate << " objects/ms (scalar " << scalarBoxRate << " objects/ms)\n";
+	reportStream << "  mismatches with scalar tests: " << mismatchesNumber << "\n";
+
+	return { reportStream.str(), mismatchesNumber };
+}
@@ -0,0 +1,120 @@
+#include "Tests.h"
+#include "../Common/Logic/SceneEntity/LightClusterBuilder.h"
+#include "../Common/Utilities.h"
+
+using namespace DirectX;
+using namespace Common;
+using namespace Common::Logic::SceneEntity;
+
+Tests::TestResult Tests::TestLightClusterBuilder(uint32_t lightsNumber, uint32_t samplesNumber)
+{
+	static constexpr uint32_t RANDOM_SEED = 0x27D4EB2Fu;
+	static constexpr float SCENE_EXTENT = 40.0f;
+	static constexpr float MIN_LIGHT_RANGE = 0.5f;
+	static constexpr float MAX_LIGHT_RANGE = 4.0f;
+	static constexpr float SAMPLE_MAX_DEPTH = 60.0f;
+
+	LightClusterDesc desc{};
+	desc.clustersPerWidth = 16u;
+	desc.clustersPerHeight = 9u;
+	desc.depthSlicesNumber = 24u;
+	desc.maxLightsPerCluster = 64u;
+	desc.lightsNumber = lightsNumber;
+
+	auto view = XMMatrixLookAtRH(XMVectorSet(0.0f, 0.0f, 2.0f, 1.0f), XMVectorSet(1.0f, 0.0f, 1.0f, 1.0f),
+		XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f));
+	auto invView = XMMatrixInverse(nullptr, view);
+
+	LightClusterConstants constants{};
+	LightClusterBuilder::SetConstants(view, XM_PIDIV4, 16.0f / 9.0f, 0.1f, 1000.0f, uint2(1920u, 1080u), desc, constants);
+
+	std::vector<PointLight> lights(lightsNumber);
+
+	for (uint32_t lightIndex = 0u; lightIndex < lightsNumber; lightIndex++)
+	{
+		HashedRandom random(RANDOM_SEED, lightIndex);
+
+		auto position = Utilities::Random3(random);
+
+		auto& light = lights[lightIndex];
+		light.position = float3(position.x * SCENE_EXTENT, (position.y * 2.0f - 1.0f) * SCENE_EXTENT * 0.5f, position.z * 4.0f);
+		light.range = std::lerp(MIN_LIGHT_RANGE, MAX_LIGHT_RANGE, Utilities::Random(random));
+		light.color = float3(1.0f, 1.0f, 1.0f);
+	}
+
+	std::vector<uint32_t> lightCounts;
+	std::vector<uint32_t> lightIndices;
+
+	auto startTimePoint = std::chrono::high_resolution_clock::now();
+	LightClusterBuilder::Build(constants, lights, lightCounts, lightIndices);
+	auto buildTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTimePoint);
+
+	uint32_t missesNumber = 0u;
+	uint32_t overflowsNumber = 0u;
+	uint64_t clusterLightsSum = 0u;
+	uint64_t bruteForceLightsSum = 0u;
+
+	for (uint32_t sampleIndex = 0u; sampleIndex < samplesNumber; sampleIndex++)
+	{
+		HashedRandom random(RANDOM_SEED ^ 0xFFFFFFFFu, sampleIndex);
+
+		auto screenPosition = Utilities::Random2(random);
+		screenPosition.x *= constants.renderSize.x;
+		screenPosition.y *= constants.renderSize.y;
+
+		auto depth = std::lerp(constants.zNear, SAMPLE_MAX_DEPTH, Utilities::Random(random));
+		auto ndcX = screenPosition.x / constants.renderSize.x * 2.0f - 1.0f;
+		auto ndcY = 1.0f - screenPosition.y / constants.renderSize.y * 2.0f;
+
+		auto viewPosition = XMVectorSet(ndcX * depth * constants.tanHalfFov.x, ndcY * depth * constants.tanHalfFov.y, -depth, 1.0f);
+		auto worldPosition = XMVector3TransformCoord(viewPosition, invView);
+
+		auto clusterIndex = LightClusterBuilder::GetClusterIndex(constants, screenPosition, depth);
+		auto lightCount = lightCounts[clusterIndex];
+		auto clusterLightsBegin = lightIndices.begin() + static_cast<size_t>(clusterIndex) * constants.maxLightsPerCluster;
+		auto clusterLightsEnd = clusterLightsBegin + lightCount;
+
+		clusterLightsSum += lightCount;
+
+		for (uint32_t lightIndex = 0u; lightIndex < lightsNumber; lightIndex++)
+		{
+			const auto& light = lights[lightIndex];
+			auto distance = XMVectorGetX(XMVector3Length(worldPosition - XMLoadFloat3(&light.position)));
+
+			if (distance >= light.range)
+				continue;
+
+			bruteForceLightsSum++;
+
+			if (std::find(clusterLightsBegin, clusterLightsEnd, lightIndex) != clusterLightsEnd)
+				continue;
+
+			if (lightCount == constants.maxLightsPerCluster)
+				overflowsNumber++;
+			else
+				missesNumber++;
+		}
+	}
+
+	uint32_t maxClusterLights = 0u;
+	uint32_t occupiedClustersNumber = 0u;
+
+	for (auto lightCount : lightCounts)
+	{
+		maxClusterLights = std::max(maxClusterLights, lightCount);
+		occupiedClustersNumber += lightCount > 0u ? 1u : 0u;
+	}
+
+	auto samplesDenominator = static_cast<double>(std::max(samplesNumber, 1u));
+
+	std::stringstream reportStream;
+	reportStream << "LightClusterBuilder: " << lightsNumber << " lights, " << lightCounts.size() << " clusters (";
+	reportStream << desc.clustersPerWidth << "x" << desc.clustersPerHeight << "x" << desc.depthSlicesNumber << "), built in ";
+	reportStream << buildTime.count() << " ms\n";
+	reportStream << "  occupied clusters: " << occupiedClustersNumber << ", max lights per cluster: " << maxClusterLights << "\n";
+	reportStream << "  lights per sample: " << clusterLightsSum / samplesDenominator << " clustered, ";
+	reportStream << bruteForceLightsSum / samplesDenominator << " in range, " << lightsNumber << " total\n";
+	reportStream << "  missed lights: " << missesNumber << ", dropped by cluster capacity: " << overflowsNumber << "\n";
+
+	return { reportStream.str(), missesNumber };
+}
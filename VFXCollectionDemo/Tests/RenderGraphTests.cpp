@@ -0,0 +1,311 @@
+#include "Tests.h"
+#include "../Graphics/RenderGraph.h"
+
+using namespace Graphics;
+using namespace Graphics::Resources;
+
+Tests::TestResult Tests::TestRenderGraph(uint32_t graphsNumber)
+{
+	static constexpr uint32_t RANDOM_SEED = 0x27D4EB2Fu;
+	static constexpr uint64_t MEGABYTE = 1024u * 1024u;
+
+	auto makeTransientDesc = [](TextureResourceType type, uint64_t size)
+		{
+			RenderGraphTransientDesc desc{};
+			desc.type = type;
+			desc.size = size;
+
+			return desc;
+		};
+
+	std::stringstream reportStream;
+	uint32_t errorsNumber = 0u;
+
+	{
+		RenderGraph graph(0u);
+
+		std::vector<std::string> resourceNames;
+		std::vector<std::string> passNames;
+
+		auto importResource = [&graph, &resourceNames](const std::string& name, D3D12_RESOURCE_STATES state)
+			{
+				resourceNames.push_back(name);
+
+				return graph.ImportResource(name, nullptr, state);
+			};
+
+		auto createTransientResource = [&graph, &resourceNames](const std::string& name, const RenderGraphTransientDesc& desc)
+			{
+				resourceNames.push_back(name);
+
+				return graph.CreateTransientResource(name, desc);
+			};
+
+		auto addPass = [&graph, &passNames](const std::string& name, bool hasSideEffects)
+			{
+				passNames.push_back(name);
+
+				return graph.AddPass(name, nullptr, hasSideEffects);
+			};
+
+		auto sceneColor = importResource("SceneColor", D3D12_RESOURCE_STATE_RENDER_TARGET);
+		auto sceneDepth = importResource("SceneDepth", D3D12_RESOURCE_STATE_DEPTH_WRITE);
+		auto backBuffer = importResource("BackBuffer", D3D12_RESOURCE_STATE_PRESENT);
+		auto particleBuffer = importResource("ParticleBuffer", D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+		auto motionVectors = createTransientResource("MotionVectors",
+			makeTransientDesc(TextureResourceType::RENDER_TARGET, 16u * MEGABYTE));
+		auto fogVolume = createTransientResource("FogVolume",
+			makeTransientDesc(TextureResourceType::RW_TEXTURE, 24u * MEGABYTE));
+		auto alphaMask = createTransientResource("AlphaMask",
+			makeTransientDesc(TextureResourceType::RW_TEXTURE, 8u * MEGABYTE));
+		auto upscaledColor = createTransientResource("UpscaledColor",
+			makeTransientDesc(TextureResourceType::RW_TEXTURE, 32u * MEGABYTE));
+		auto luminance = createTransientResource("Luminance",
+			makeTransientDesc(TextureResourceType::RW_TEXTURE, 4u * MEGABYTE));
+		auto bloom = createTransientResource("Bloom",
+			makeTransientDesc(TextureResourceType::RW_TEXTURE, 8u * MEGABYTE));
+		auto debugView = createTransientResource("DebugView",
+			makeTransientDesc(TextureResourceType::RENDER_TARGET, 8u * MEGABYTE));
+
+		auto gBufferPass = addPass("GBuffer", false);
+		graph.Write(gBufferPass, sceneColor, D3D12_RESOURCE_STATE_RENDER_TARGET);
+		graph.Write(gBufferPass, sceneDepth, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+		graph.Write(gBufferPass, motionVectors, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+		auto fogPass = addPass("VolumetricFog", false);
+		graph.Read(fogPass, sceneDepth, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		graph.Write(fogPass, fogVolume, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+		auto fogCompositePass = addPass("FogComposite", false);
+		graph.Read(fogCompositePass, fogVolume, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		graph.Read(fogCompositePass, sceneDepth, D3D12_RESOURCE_STATE_DEPTH_READ);
+		graph.Write(fogCompositePass, sceneColor, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+		auto copyAlphaPass = addPass("CopyAlpha", false);
+		graph.Read(copyAlphaPass, sceneColor, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		graph.Write(copyAlphaPass, alphaMask, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+		auto upscalePass = addPass("Upscale", false);
+		graph.Read(upscalePass, sceneColor, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		graph.Read(upscalePass, sceneDepth, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		graph.Read(upscalePass, motionVectors, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		graph.Read(upscalePass, alphaMask, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		graph.Write(upscalePass, upscaledColor, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+		auto luminancePass = addPass("Luminance", false);
+		graph.Read(luminancePass, upscaledColor, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		graph.Write(luminancePass, luminance, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+		auto bloomPass = addPass("Bloom", false);
+		graph.Read(bloomPass, upscaledColor, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+		graph.Write(bloomPass, bloom, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+		auto toneMappingPass = addPass("ToneMapping", false);
+		graph.Read(toneMappingPass, upscaledColor, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		graph.Read(toneMappingPass, luminance, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		graph.Read(toneMappingPass, bloom, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		graph.Write(toneMappingPass, backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+		auto debugPass = addPass("DebugOverlay", false);
+		graph.Read(debugPass, motionVectors, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		graph.Write(debugPass, debugView, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+		auto presentPass = addPass("Present", true);
+		graph.Read(presentPass, backBuffer, D3D12_RESOURCE_STATE_PRESENT);
+
+		auto particlePass = addPass("ParticleSimulation", false);
+		graph.Write(particlePass, particleBuffer, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+		if (!graph.Compile())
+			errorsNumber++;
+		else
+		{
+			errorsNumber += graph.Validate();
+
+			if (!graph.IsPassCulled(debugPass) || graph.IsPassCulled(luminancePass) || graph.GetBranchesNumber() != 2u ||
+				graph.GetPassBranchIndex(particlePass) == graph.GetPassBranchIndex(gBufferPass))
+				errorsNumber++;
+
+			auto& graphStatistics = graph.GetStatistics();
+
+			reportStream << "RenderGraph: postprocess graph, " << graphStatistics.passesNumber << " passes, ";
+			reportStream << graphStatistics.culledPassesNumber << " culled, " << graphStatistics.branchesNumber << " branches, ";
+			reportStream << graphStatistics.barriersNumber << " barriers\n";
+			reportStream << "  transient memory: " << graphStatistics.transientSize / MEGABYTE << " MB in ";
+			reportStream << graphStatistics.transientResourcesNumber << " resources, ";
+			reportStream << graphStatistics.aliasedTransientSize / MEGABYTE << " MB in ";
+			reportStream << graphStatistics.aliasingGroupsNumber << " aliasing groups\n";
+
+			for (uint32_t branchIndex = 0u; branchIndex < graph.GetBranchesNumber(); branchIndex++)
+				for (RenderGraphPassID passId = 0u; passId < passNames.size(); passId++)
+				{
+					if (graph.IsPassCulled(passId) || graph.GetPassBranchIndex(passId) != branchIndex)
+						continue;
+
+					reportStream << "  [" << branchIndex << "] " << passNames[passId] << "\n";
+
+					for (auto& barrier : graph.GetPassBarriers(passId))
+					{
+						reportStream << "    ";
+
+						if (barrier.type == RenderGraphBarrierType::TRANSITION)
+							reportStream << "transition " << resourceNames[barrier.resourceId] << std::hex << " 0x" <<
+								barrier.stateBefore << " -> 0x" << barrier.stateAfter << std::dec << "\n";
+						else if (barrier.type == RenderGraphBarrierType::UAV)
+							reportStream << "uav " << resourceNames[barrier.resourceId] << "\n";
+						else
+							reportStream << "aliasing " << resourceNames[barrier.resourceId] << "\n";
+					}
+				}
+		}
+	}
+
+	std::mt19937 generator(RANDOM_SEED);
+	std::uniform_real_distribution<float> chanceDistribution(0.0f, 1.0f);
+	std::uniform_int_distribution<uint32_t> resourcesNumberDistribution(4u, 24u);
+	std::uniform_int_distribution<uint32_t> passesNumberDistribution(4u, 32u);
+	std::uniform_int_distribution<uint32_t> typeDistribution(0u, 2u);
+	std::uniform_int_distribution<uint32_t> sizeDistribution(1u, 64u);
+	std::uniform_int_distribution<uint32_t> readsNumberDistribution(0u, 3u);
+	std::uniform_int_distribution<uint32_t> writesNumberDistribution(1u, 2u);
+
+	static constexpr std::array<D3D12_RESOURCE_STATES, 4u> READ_STATES =
+	{
+		D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
+		D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+		D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+		D3D12_RESOURCE_STATE_COPY_SOURCE
+	};
+
+	std::uniform_int_distribution<size_t> readStateDistribution(0u, READ_STATES.size() - 1u);
+
+	uint32_t compiledNumber = 0u;
+	uint64_t passesNumber = 0u;
+	uint64_t culledPassesNumber = 0u;
+	uint64_t barriersNumber = 0u;
+	uint64_t branchesNumber = 0u;
+	uint64_t transientSize = 0u;
+	uint64_t aliasedTransientSize = 0u;
+	std::chrono::duration<double, std::micro> compileTime{};
+
+	for (uint32_t graphIndex = 0u; graphIndex < graphsNumber; graphIndex++)
+	{
+		RenderGraph graph(0u);
+
+		auto resourcesNumber = resourcesNumberDistribution(generator);
+		std::vector<TextureResourceType> types(resourcesNumber);
+		std::vector<bool> isWritten(resourcesNumber, false);
+
+		auto getWriteState = [](TextureResourceType type)
+			{
+				if (type == TextureResourceType::DEPTH_STENCIL_TARGET)
+					return D3D12_RESOURCE_STATE_DEPTH_WRITE;
+				else if (type == TextureResourceType::RENDER_TARGET)
+					return D3D12_RESOURCE_STATE_RENDER_TARGET;
+				else
+					return D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+			};
+
+		for (uint32_t resourceIndex = 0u; resourceIndex < resourcesNumber; resourceIndex++)
+		{
+			auto type = static_cast<TextureResourceType>(typeDistribution(generator));
+			types[resourceIndex] = type;
+
+			if (chanceDistribution(generator) < 0.3f)
+			{
+				graph.ImportResource("Imported", nullptr, getWriteState(type));
+				isWritten[resourceIndex] = true;
+			}
+			else
+				graph.CreateTransientResource("Transient", makeTransientDesc(type, sizeDistribution(generator) * MEGABYTE));
+		}
+
+		std::uniform_int_distribution<uint32_t> resourceDistribution(0u, resourcesNumber - 1u);
+		auto graphPassesNumber = passesNumberDistribution(generator);
+
+		for (uint32_t passIndex = 0u; passIndex < graphPassesNumber; passIndex++)
+		{
+			auto passId = graph.AddPass("Pass", nullptr, chanceDistribution(generator) < 0.1f);
+			std::vector<RenderGraphResourceID> passResources;
+
+			auto isUsedInPass = [&passResources](RenderGraphResourceID resourceId)
+				{
+					return std::find(passResources.begin(), passResources.end(), resourceId) != passResources.end();
+				};
+
+			auto readsNumber = readsNumberDistribution(generator);
+
+			for (uint32_t readIndex = 0u; readIndex < readsNumber; readIndex++)
+			{
+				auto resourceId = resourceDistribution(generator);
+
+				if (!isWritten[resourceId] || isUsedInPass(resourceId))
+					continue;
+
+				passResources.push_back(resourceId);
+
+				if (types[resourceId] == TextureResourceType::RW_TEXTURE && chanceDistribution(generator) < 0.3f)
+				{
+					graph.Read(passId, resourceId, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+					if (chanceDistribution(generator) < 0.5f)
+						graph.Write(passId, resourceId, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+				}
+				else if (types[resourceId] == TextureResourceType::DEPTH_STENCIL_TARGET && chanceDistribution(generator) < 0.3f)
+					graph.Read(passId, resourceId, D3D12_RESOURCE_STATE_DEPTH_READ);
+				else
+					graph.Read(passId, resourceId, READ_STATES[readStateDistribution(generator)]);
+			}
+
+			auto writesNumber = writesNumberDistribution(generator);
+
+			for (uint32_t writeIndex = 0u; writeIndex < writesNumber; writeIndex++)
+			{
+				auto resourceId = resourceDistribution(generator);
+
+				if (isUsedInPass(resourceId))
+					continue;
+
+				passResources.push_back(resourceId);
+
+				if (chanceDistribution(generator) < 0.15f)
+					graph.Write(passId, resourceId, D3D12_RESOURCE_STATE_COPY_DEST);
+				else
+					graph.Write(passId, resourceId, getWriteState(types[resourceId]));
+
+				isWritten[resourceId] = true;
+			}
+		}
+
+		auto startTimePoint = std::chrono::high_resolution_clock::now();
+		auto isCompiled = graph.Compile();
+		compileTime += std::chrono::high_resolution_clock::now() - startTimePoint;
+
+		if (!isCompiled)
+		{
+			errorsNumber++;
+			continue;
+		}
+
+		errorsNumber += graph.Validate();
+		compiledNumber++;
+
+		auto& graphStatistics = graph.GetStatistics();
+		passesNumber += graphStatistics.passesNumber;
+		culledPassesNumber += graphStatistics.culledPassesNumber;
+		barriersNumber += graphStatistics.barriersNumber;
+		branchesNumber += graphStatistics.branchesNumber;
+		transientSize += graphStatistics.transientSize;
+		aliasedTransientSize += graphStatistics.aliasedTransientSize;
+	}
+
+	reportStream << "RenderGraph: " << compiledNumber << " of " << graphsNumber << " random graphs compiled, ";
+	reportStream << compileTime.count() / std::max(graphsNumber, 1u) << " us per compile\n";
+	reportStream << "  passes: " << passesNumber << ", culled: " << culledPassesNumber << ", branches: " << branchesNumber;
+	reportStream << ", barriers: " << barriersNumber << "\n";
+	reportStream << "  transient memory: " << transientSize / MEGABYTE << " MB, aliased: " << aliasedTransientSize / MEGABYTE << " MB\n";
+	reportStream << "  errors: " << errorsNumber << "\n";
+
+	return { reportStream.str(), errorsNumber };
+}
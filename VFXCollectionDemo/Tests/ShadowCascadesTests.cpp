@@ -0,0 +1,159 @@
+#include "Tests.h"
+#include "../Graphics/Assets/ShadowCascades.h"
+#include "../Common/Utilities.h"
+
+using namespace DirectX;
+using namespace Graphics::Assets;
+
+Tests::TestResult Tests::TestShadowCascades(uint32_t posesNumber)
+{
+	static constexpr uint32_t RANDOM_SEED = 0x165667B1u;
+	static constexpr uint32_t SAMPLES_PER_CASCADE = 64u;
+	static constexpr float SCENE_EXTENT = 200.0f;
+	static constexpr float CAMERA_EXTENT = 50.0f;
+	static constexpr float SUBTEXEL_OFFSET = 0.01f;
+	static constexpr float LEGACY_TEXEL_SIZE = 0.5f;
+	static constexpr float EPSILON = 1.0E-3f;
+
+	ShadowCascadesDesc desc{};
+	desc.fovY = XM_PIDIV4;
+	desc.aspectRatio = 16.0f / 9.0f;
+	desc.zNear = 0.1f;
+	desc.zFar = SCENE_EXTENT;
+	desc.splitLambda = ShadowCascades::DEFAULT_SPLIT_LAMBDA;
+	desc.cascadesNumber = ShadowCascades::MAX_CASCADES_NUMBER;
+	desc.shadowMapSize = 1024u;
+	XMStoreFloat3(&desc.lightDirection, XMVector3Normalize(XMVectorSet(0.3f, 0.2f, -1.0f, 0.0f)));
+	desc.receiverBounds.minCorner = float3(-SCENE_EXTENT, -SCENE_EXTENT, -5.0f);
+	desc.receiverBounds.maxCorner = float3(SCENE_EXTENT, SCENE_EXTENT, 5.0f);
+	desc.casterBounds.minCorner = float3(-SCENE_EXTENT, -SCENE_EXTENT, -5.0f);
+	desc.casterBounds.maxCorner = float3(SCENE_EXTENT, SCENE_EXTENT, 40.0f);
+
+	std::array<float4x4, ShadowCascades::MAX_CASCADES_NUMBER> viewProjections{};
+	std::array<float4x4, ShadowCascades::MAX_CASCADES_NUMBER> movedViewProjections{};
+	std::array<float, ShadowCascades::MAX_CASCADES_NUMBER> splits{};
+	std::array<double, ShadowCascades::MAX_CASCADES_NUMBER> texelSizes{};
+
+	uint32_t splitErrorsNumber = 0u;
+	uint32_t uncoveredSamplesNumber = 0u;
+	uint32_t testedSamplesNumber = 0u;
+	uint32_t unsnappedCascadesNumber = 0u;
+	uint32_t shimmeringCascadesNumber = 0u;
+	std::chrono::duration<double, std::micro> buildTime{};
+
+	auto tanHalfFovY = std::tan(desc.fovY * 0.5f);
+	auto tanHalfFovX = tanHalfFovY * desc.aspectRatio;
+
+	for (uint32_t poseIndex = 0u; poseIndex < posesNumber; poseIndex++)
+	{
+		Common::HashedRandom random(RANDOM_SEED, poseIndex);
+
+		auto position = Common::Utilities::Random3(random);
+		auto angles = Common::Utilities::Random2(random);
+
+		auto yaw = angles.x * XM_2PI;
+		auto pitch = (angles.y - 0.75f) * XM_PIDIV2;
+
+		auto eye = XMVectorSet((position.x * 2.0f - 1.0f) * CAMERA_EXTENT, (position.y * 2.0f - 1.0f) * CAMERA_EXTENT,
+			std::lerp(2.0f, 20.0f, position.z), 1.0f);
+		auto direction = XMVectorSet(std::cos(yaw) * std::cos(pitch), std::sin(yaw) * std::cos(pitch), std::sin(pitch), 0.0f);
+		auto up = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+
+		desc.cameraView = XMMatrixLookToRH(eye, direction, up);
+
+		auto startTimePoint = std::chrono::high_resolution_clock::now();
+		ShadowCascades::Build(desc, viewProjections.data(), splits.data());
+		buildTime += std::chrono::high_resolution_clock::now() - startTimePoint;
+
+		desc.cameraView = XMMatrixLookToRH(eye + XMVectorSet(SUBTEXEL_OFFSET, SUBTEXEL_OFFSET, 0.0f, 0.0f), direction, up);
+		ShadowCascades::Build(desc, movedViewProjections.data(), splits.data());
+
+		auto invView = XMMatrixInverse(nullptr, XMMatrixLookToRH(eye, direction, up));
+
+		for (uint32_t cascadeIndex = 0u; cascadeIndex < ShadowCascades::MAX_CASCADES_NUMBER; cascadeIndex++)
+		{
+			auto splitNear = cascadeIndex == 0u ? desc.zNear : splits[cascadeIndex - 1u];
+			auto splitFar = splits[cascadeIndex];
+
+			if (splitFar <= splitNear)
+				splitErrorsNumber++;
+
+			const auto& viewProjection = viewProjections[cascadeIndex];
+			const auto& movedViewProjection = movedViewProjections[cascadeIndex];
+
+			auto texelSize = 2.0 / (XMVectorGetX(XMVector3Length(XMVectorSet(XMVectorGetX(viewProjection.r[0u]),
+				XMVectorGetX(viewProjection.r[1u]), XMVectorGetX(viewProjection.r[2u]), 0.0f))) * desc.shadowMapSize);
+			texelSizes[cascadeIndex] += texelSize;
+
+			auto originTexel = (XMVectorGetX(viewProjection.r[3u]) * 0.5f + 0.5f) * desc.shadowMapSize;
+
+			if (std::abs(originTexel - std::round(originTexel)) > 0.01f)
+				unsnappedCascadesNumber++;
+
+			auto isShimmering = false;
+
+			for (uint32_t rowIndex = 0u; rowIndex < 3u; rowIndex++)
+			{
+				auto difference = XMVectorAbs(viewProjection.r[rowIndex] - movedViewProjection.r[rowIndex]);
+				isShimmering = isShimmering || XMVectorGetX(difference) > EPSILON * EPSILON || XMVectorGetY(difference) > EPSILON * EPSILON;
+			}
+
+			auto translationTexels = (viewProjection.r[3u] - movedViewProjection.r[3u]) * 0.5f *
+				static_cast<float>(desc.shadowMapSize);
+			auto translationRemainder = XMVectorAbs(translationTexels - XMVectorRound(translationTexels));
+			isShimmering = isShimmering || XMVectorGetX(translationRemainder) > 0.01f || XMVectorGetY(translationRemainder) > 0.01f;
+
+			if (isShimmering)
+				shimmeringCascadesNumber++;
+
+			for (uint32_t sampleIndex = 0u; sampleIndex < SAMPLES_PER_CASCADE; sampleIndex++)
+			{
+				auto sample = Common::Utilities::Random3(random);
+				auto depth = std::lerp(splitNear, splitFar, sample.z);
+				auto viewPosition = XMVectorSet((sample.x * 2.0f - 1.0f) * depth * tanHalfFovX,
+					(sample.y * 2.0f - 1.0f) * depth * tanHalfFovY, -depth, 1.0f);
+
+				float3 worldPosition{};
+				XMStoreFloat3(&worldPosition, XMVector3TransformCoord(viewPosition, invView));
+
+				const auto& receivers = desc.receiverBounds;
+
+				if (worldPosition.x < receivers.minCorner.x || worldPosition.y < receivers.minCorner.y ||
+					worldPosition.z < receivers.minCorner.z || worldPosition.x > receivers.maxCorner.x ||
+					worldPosition.y > receivers.maxCorner.y || worldPosition.z > receivers.maxCorner.z)
+					continue;
+
+				testedSamplesNumber++;
+
+				float3 clipPosition{};
+				XMStoreFloat3(&clipPosition, XMVector3TransformCoord(XMLoadFloat3(&worldPosition), viewProjection));
+
+				if (std::abs(clipPosition.x) > 1.0f + EPSILON || std::abs(clipPosition.y) > 1.0f + EPSILON ||
+					clipPosition.z < -EPSILON || clipPosition.z > 1.0f + EPSILON)
+					uncoveredSamplesNumber++;
+			}
+		}
+
+		if (std::abs(splits[ShadowCascades::MAX_CASCADES_NUMBER - 1u] - desc.zFar) > EPSILON)
+			splitErrorsNumber++;
+	}
+
+	auto posesDenominator = static_cast<double>(std::max(posesNumber, 1u));
+
+	std::stringstream reportStream;
+	reportStream << "ShadowCascades: " << posesNumber << " camera poses, " << ShadowCascades::MAX_CASCADES_NUMBER << " cascades at ";
+	reportStream << desc.shadowMapSize << "px, built in " << buildTime.count() / posesDenominator << " us per pose\n";
+	reportStream << "  texel size per cascade:";
+
+	for (auto texelSize : texelSizes)
+		reportStream << " " << texelSize / posesDenominator;
+
+	reportStream << " (single " << LEGACY_TEXEL_SIZE << " at 2048px)\n";
+	reportStream << "  split errors: " << splitErrorsNumber << ", uncovered receivers: " << uncoveredSamplesNumber;
+	reportStream << " of " << testedSamplesNumber << "\n";
+	reportStream << "  unsnapped cascades: " << unsnappedCascadesNumber << ", shimmering cascades: " << shimmeringCascadesNumber << "\n";
+
+	auto errorsNumber = splitErrorsNumber + uncoveredSamplesNumber + unsnappedCascadesNumber + shimmeringCascadesNumber;
+
+	return { reportStream.str(), errorsNumber };
+}
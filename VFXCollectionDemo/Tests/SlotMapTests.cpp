@@ -0,0 +1,123 @@
+#include "Tests.h"
+#include "../Graphics/Resources/SlotMap.h"
+
+using namespace Graphics::Resources;
+
+Tests::TestResult Tests::TestSlotMap(uint32_t operationsNumber)
+{
+	static constexpr uint32_t RANDOM_SEED = 0x85EBCA6Bu;
+
+	struct TestEntry
+	{
+	public:
+		SlotHandle handle;
+		uint64_t value;
+	};
+
+	SlotMap<uint64_t> slotMap;
+	std::vector<TestEntry> entries;
+	std::vector<SlotHandle> staleHandles;
+
+	std::mt19937 generator(RANDOM_SEED);
+	std::uniform_real_distribution<float> actionDistribution(0.0f, 1.0f);
+
+	uint32_t insertionsNumber = 0u;
+	uint32_t erasuresNumber = 0u;
+	uint32_t errorsNumber = 0u;
+	uint32_t staleChecksNumber = 0u;
+	size_t peakSize = 0u;
+	std::chrono::duration<double, std::nano> operationsTime{};
+
+	for (uint32_t operationIndex = 0u; operationIndex < operationsNumber; operationIndex++)
+	{
+		auto insertionBias = std::sin(static_cast<float>(operationIndex) * 0.001f) * 0.2f + 0.5f;
+
+		if (entries.empty() || actionDistribution(generator) < insertionBias)
+		{
+			TestEntry entry{};
+			entry.value = static_cast<uint64_t>(operationIndex) * 2654435761ull + 1u;
+
+			auto startTimePoint = std::chrono::high_resolution_clock::now();
+			entry.handle = slotMap.Insert(entry.value);
+			operationsTime += std::chrono::high_resolution_clock::now() - startTimePoint;
+
+			entries.push_back(entry);
+			insertionsNumber++;
+		}
+		else
+		{
+			std::uniform_int_distribution<size_t> indexDistribution(0u, entries.size() - 1u);
+			auto entryIndex = indexDistribution(generator);
+			auto entry = entries[entryIndex];
+
+			std::swap(entries[entryIndex], entries.back());
+			entries.pop_back();
+
+			auto startTimePoint = std::chrono::high_resolution_clock::now();
+			auto isErased = slotMap.Erase(entry.handle);
+			operationsTime += std::chrono::high_resolution_clock::now() - startTimePoint;
+
+			if (!isErased)
+				errorsNumber++;
+
+			staleHandles.push_back(entry.handle);
+			erasuresNumber++;
+		}
+
+		if (!entries.empty())
+		{
+			std::uniform_int_distribution<size_t> indexDistribution(0u, entries.size() - 1u);
+			auto& entry = entries[indexDistribution(generator)];
+			auto value = slotMap.Get(entry.handle);
+
+			if (value == nullptr || *value != entry.value)
+				errorsNumber++;
+		}
+
+		if (!staleHandles.empty())
+		{
+			std::uniform_int_distribution<size_t> indexDistribution(0u, staleHandles.size() - 1u);
+			auto& staleHandle = staleHandles[indexDistribution(generator)];
+
+			if (slotMap.Get(staleHandle) != nullptr || slotMap.Erase(staleHandle))
+				errorsNumber++;
+
+			staleChecksNumber++;
+		}
+
+		if (slotMap.Size() != entries.size())
+			errorsNumber++;
+
+		peakSize = std::max(peakSize, slotMap.Size());
+	}
+
+	uint64_t expectedSum = 0u;
+	uint64_t iteratedSum = 0u;
+
+	for (auto& entry : entries)
+		expectedSum += entry.value;
+
+	for (auto value : slotMap)
+		iteratedSum += value;
+
+	if (expectedSum != iteratedSum)
+		errorsNumber++;
+
+	slotMap.Clear();
+
+	for (auto& entry : entries)
+		if (slotMap.Get(entry.handle) != nullptr)
+			errorsNumber++;
+
+	if (slotMap.Get(SlotHandle{}) != nullptr)
+		errorsNumber++;
+
+	std::stringstream reportStream;
+	reportStream << "SlotMap: " << operationsNumber << " operations, ";
+	reportStream << operationsTime.count() / std::max(insertionsNumber + erasuresNumber, 1u) << " ns per operation\n";
+	reportStream << "  insertions: " << insertionsNumber << ", erasures: " << erasuresNumber;
+	reportStream << ", peak size: " << peakSize << "\n";
+	reportStream << "  stale handle checks: " << staleChecksNumber << ", errors: " << errorsNumber << "\n";
+
+	return { reportStream.str(), errorsNumber };
+}
@@ -0,0 +1,136 @@
+#include "Tests.h"
+#include "../Graphics/TLSFAllocator.h"
+
+using namespace Graphics;
+
+Tests::TestResult Tests::TestTLSFAllocator(uint32_t operationsNumber)
+{
+	static constexpr uint32_t RANDOM_SEED = 0x9E3779B9u;
+	static constexpr uint64_t CAPACITY = 64ull * 1024ull * 1024ull;
+	static constexpr uint64_t ALIGNMENT = 256u;
+	static constexpr uint64_t MIN_ALLOCATION_SIZE = 16u;
+	static constexpr uint64_t MAX_ALLOCATION_SIZE = 1024u * 1024u;
+
+	struct TestAllocation
+	{
+	public:
+		uint64_t offset;
+		uint64_t size;
+		uint32_t owner;
+	};
+
+	TLSFAllocator allocator(CAPACITY, ALIGNMENT);
+	std::vector<uint32_t> backingStore(CAPACITY / ALIGNMENT, TLSFAllocator::INVALID_INDEX);
+	std::vector<TestAllocation> allocations;
+
+	std::mt19937 generator(RANDOM_SEED);
+	std::uniform_real_distribution<float> sizeDistribution(std::log2(static_cast<float>(MIN_ALLOCATION_SIZE)),
+		std::log2(static_cast<float>(MAX_ALLOCATION_SIZE)));
+	std::uniform_real_distribution<float> actionDistribution(0.0f, 1.0f);
+
+	uint32_t allocationsNumber = 0u;
+	uint32_t failedAllocationsNumber = 0u;
+	uint32_t corruptionsNumber = 0u;
+	uint64_t peakUsedSize = 0u;
+	double fragmentationSum = 0.0;
+	uint32_t fragmentationSamplesNumber = 0u;
+	std::chrono::duration<double, std::nano> operationsTime{};
+
+	auto fill = [&backingStore, &corruptionsNumber](const TestAllocation& allocation, uint32_t expectedOwner, uint32_t newOwner)
+	{
+		auto firstUnit = allocation.offset / ALIGNMENT;
+		auto unitsNumber = (allocation.size + ALIGNMENT - 1u) / ALIGNMENT;
+
+		for (auto unit = firstUnit; unit < firstUnit + unitsNumber; unit++)
+		{
+			if (unit >= backingStore.size() || backingStore[unit] != expectedOwner)
+			{
+				corruptionsNumber++;
+				return;
+			}
+
+			backingStore[unit] = newOwner;
+		}
+	};
+
+	for (uint32_t operationIndex = 0u; operationIndex < operationsNumber; operationIndex++)
+	{
+		auto allocationBias = std::sin(static_cast<float>(operationIndex) * 0.001f) * 0.2f + 0.5f;
+
+		if (allocations.empty() || actionDistribution(generator) < allocationBias)
+		{
+			TestAllocation allocation{};
+			allocation.size = static_cast<uint64_t>(std::exp2(sizeDistribution(generator)));
+			allocation.owner = operationIndex;
+
+			auto startTimePoint = std::chrono::high_resolution_clock::now();
+			auto isAllocated = allocator.Allocate(allocation.size, allocation.offset);
+			operationsTime += std::chrono::high_resolution_clock::now() - startTimePoint;
+
+			if (!isAllocated)
+			{
+				failedAllocationsNumber++;
+
+				auto statistics = allocator.GetStatistics();
+				auto freeSize = statistics.capacity - statistics.usedSize;
+
+				if (freeSize > 0u)
+				{
+					fragmentationSum += 1.0 - static_cast<double>(statistics.largestFreeBlock) / static_cast<double>(freeSize);
+					fragmentationSamplesNumber++;
+				}
+
+				continue;
+			}
+
+			allocationsNumber++;
+			fill(allocation, TLSFAllocator::INVALID_INDEX, allocation.owner);
+			allocations.push_back(allocation);
+		}
+		else
+		{
+			std::uniform_int_distribution<size_t> indexDistribution(0u, allocations.size() - 1u);
+			auto allocationIndex = indexDistribution(generator);
+			auto allocation = allocations[allocationIndex];
+
+			std::swap(allocations[allocationIndex], allocations.back());
+			allocations.pop_back();
+
+			fill(allocation, allocation.owner, TLSFAllocator::INVALID_INDEX);
+
+			auto startTimePoint = std::chrono::high_resolution_clock::now();
+			auto isDeallocated = allocator.Deallocate(allocation.offset);
+			operationsTime += std::chrono::high_resolution_clock::now() - startTimePoint;
+
+			if (!isDeallocated)
+				corruptionsNumber++;
+		}
+
+		peakUsedSize = std::max(peakUsedSize, allocator.GetStatistics().usedSize);
+	}
+
+	std::shuffle(allocations.begin(), allocations.end(), generator);
+
+	for (const auto& allocation : allocations)
+	{
+		fill(allocation, allocation.owner, TLSFAllocator::INVALID_INDEX);
+
+		if (!allocator.Deallocate(allocation.offset))
+			corruptionsNumber++;
+	}
+
+	auto finalStatistics = allocator.GetStatistics();
+	auto isCoalesced = allocator.IsEmpty() && finalStatistics.freeBlocksNumber == 1u &&
+		finalStatistics.largestFreeBlock == CAPACITY;
+
+	std::stringstream reportStream;
+	reportStream << "TLSFAllocator: " << operationsNumber << " operations on " << CAPACITY / (1024u * 1024u) << " MB, ";
+	reportStream << operationsTime.count() / std::max(operationsNumber, 1u) << " ns per operation\n";
+	reportStream << "  allocations: " << allocationsNumber << ", failed: " << failedAllocationsNumber;
+	reportStream << ", peak usage: " << static_cast<double>(peakUsedSize) / CAPACITY * 100.0 << "%\n";
+	reportStream << "  fragmentation on failure: " << (fragmentationSamplesNumber > 0u ?
+		fragmentationSum / fragmentationSamplesNumber * 100.0 : 0.0) << "%\n";
+	reportStream << "  corruptions: " << corruptionsNumber << ", fully coalesced: " << (isCoalesced ? "yes" : "no") << "\n";
+
+	return { reportStream.str(), corruptionsNumber + (isCoalesced ? 0u : 1u) };
+}
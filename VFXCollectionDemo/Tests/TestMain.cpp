@@ -0,0 +1,56 @@
+#include "Tests.h"
+
+#include <iostream>
+
+static constexpr uint32_t LIGHT_CLUSTER_TEST_LIGHTS_NUMBER = 1024u;
+static constexpr uint32_t LIGHT_CLUSTER_TEST_SAMPLES_NUMBER = 100000u;
+static constexpr uint32_t SHADOW_CASCADES_TEST_POSES_NUMBER = 1000u;
+static constexpr uint32_t ALLOCATOR_TEST_OPERATIONS_NUMBER = 1000000u;
+static constexpr uint32_t SLOT_MAP_TEST_OPERATIONS_NUMBER = 1000000u;
+static constexpr uint32_t CULLING_TEST_OBJECTS_NUMBER = 100000u;
+static constexpr uint32_t CULLING_TEST_ITERATIONS_NUMBER = 100u;
+static constexpr uint32_t RENDER_GRAPH_TEST_GRAPHS_NUMBER = 10000u;
+static constexpr uint32_t DESCRIPTOR_TEST_FRAMES_NUMBER = 3u;
+static constexpr uint32_t BARRIER_TEST_FRAMES_NUMBER = 3u;
+
+struct TestCase
+{
+public:
+	const char* name;
+	std::function<Tests::TestResult()> run;
+};
+
+int main(int argc, char* argv[])
+{
+	std::vector<TestCase> testCases =
+	{
+		{ "lightcluster", []() { return Tests::TestLightClusterBuilder(LIGHT_CLUSTER_TEST_LIGHTS_NUMBER,
+			LIGHT_CLUSTER_TEST_SAMPLES_NUMBER); } },
+		{ "cascades", []() { return Tests::TestShadowCascades(SHADOW_CASCADES_TEST_POSES_NUMBER); } },
+		{ "allocator", []() { return Tests::TestTLSFAllocator(ALLOCATOR_TEST_OPERATIONS_NUMBER); } },
+		{ "slotmap", []() { return Tests::TestSlotMap(SLOT_MAP_TEST_OPERATIONS_NUMBER); } },
+		{ "culling", []() { return Tests::TestFrustumCuller(CULLING_TEST_OBJECTS_NUMBER, CULLING_TEST_ITERATIONS_NUMBER); } },
+		{ "rendergraph", []() { return Tests::TestRenderGraph(RENDER_GRAPH_TEST_GRAPHS_NUMBER); } },
+		{ "descriptors", []() { return Tests::TestDescriptorManager(DESCRIPTOR_TEST_FRAMES_NUMBER); } },
+		{ "barriers", []() { return Tests::TestBarrierBatch(BARRIER_TEST_FRAMES_NUMBER); } }
+	};
+
+	uint32_t failedTestsNumber = 0u;
+
+	for (const auto& testCase : testCases)
+	{
+		if (argc > 1 && std::find_if(argv + 1, argv + argc,
+			[&testCase](const char* name) { return std::string(name) == testCase.name; }) == argv + argc)
+			continue;
+
+		auto result = testCase.run();
+
+		std::cout << result.report;
+		std::cout << testCase.name << ": " << (result.errorsNumber == 0u ? "passed" : "FAILED") << "\n\n";
+
+		if (result.errorsNumber > 0u)
+			failedTestsNumber++;
+	}
+
+	return failedTestsNumber > 0u ? 1 : 0;
+}
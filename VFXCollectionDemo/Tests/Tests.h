@@ -0,0 +1,22 @@
+#pragma once
+
+#include "../Includes.h"
+
+namespace Tests
+{
+	struct TestResult
+	{
+	public:
+		std::string report;
+		uint32_t errorsNumber;
+	};
+
+	TestResult TestLightClusterBuilder(uint32_t lightsNumber, uint32_t samplesNumber);
+	TestResult TestShadowCascades(uint32_t posesNumber);
+	TestResult TestTLSFAllocator(uint32_t operationsNumber);
+	TestResult TestSlotMap(uint32_t operationsNumber);
+	TestResult TestFrustumCuller(uint32_t objectsNumber, uint32_t iterationsNumber);
+	TestResult TestRenderGraph(uint32_t graphsNumber);
+	TestResult TestDescriptorManager(uint32_t framesNumber);
+	TestResult TestBarrierBatch(uint32_t framesNumber);
+}